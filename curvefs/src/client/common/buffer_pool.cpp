@@ -0,0 +1,216 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-12
+ */
+
+#include "curvefs/src/client/common/buffer_pool.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <cstdlib>
+
+namespace curvefs {
+namespace client {
+namespace common {
+
+DECLARE_uint64(bufferPoolMaxCachedBytes);
+
+namespace {
+
+// limits of free buffers cached by every thread
+constexpr size_t kThreadCacheBytes = 8 * 1024 * 1024;
+constexpr size_t kThreadCacheBuffersPerClass = 8;
+
+}  // namespace
+
+constexpr size_t BufferPool::kBufferAlignment;
+constexpr size_t BufferPool::kMinClassSize;
+constexpr size_t BufferPool::kMaxClassSize;
+constexpr int BufferPool::kClassNum;
+
+struct BufferPool::ThreadCache {
+    std::vector<char*> freeLists[kClassNum];
+    size_t bytes = 0;
+    // bit i is set once this thread allocated a buffer of class i, only
+    // those classes are cached, so threads which merely free buffers
+    // allocated elsewhere (e.g. rpc callbacks) don't hoard them
+    uint32_t allocatedClasses = 0;
+
+    // return cached buffers to global cache when thread exits
+    ~ThreadCache() {
+        BufferPool& pool = BufferPool::GetInstance();
+        for (int i = 0; i < kClassNum; i++) {
+            size_t classSize = kMinClassSize << i;
+            for (char* buf : freeLists[i]) {
+                pool.cachedBytes_.fetch_sub(classSize,
+                                            std::memory_order_relaxed);
+                pool.FreeToGlobal(i, buf);
+            }
+        }
+    }
+};
+
+BufferPool& BufferPool::GetInstance() {
+    // never destroyed, thread caches may return buffers at exit
+    static BufferPool* pool = new BufferPool();
+    return *pool;
+}
+
+BufferPool::BufferPool()
+    : liveBytes_(0),
+      cachedBytes_(0),
+      globalCachedBytes_(0),
+      metric_(new metric::BufferPoolMetric(&liveBytes_, &cachedBytes_)) {}
+
+size_t BufferPool::ClassSize(size_t size) {
+    if (size > kMaxClassSize) {
+        return 0;
+    }
+
+    size_t classSize = kMinClassSize;
+    while (classSize < size) {
+        classSize <<= 1;
+    }
+    return classSize;
+}
+
+int BufferPool::ClassIndex(size_t classSize) {
+    int index = 0;
+    while ((kMinClassSize << index) < classSize) {
+        index++;
+    }
+    return index;
+}
+
+BufferPool::ThreadCache* BufferPool::GetThreadCache() {
+    thread_local static ThreadCache cache;
+    return &cache;
+}
+
+char* BufferPool::AlignedAlloc(size_t size) {
+    void* buf = nullptr;
+    int ret = posix_memalign(&buf, kBufferAlignment, size);
+    if (ret != 0) {
+        LOG(ERROR) << "allocate buffer failed, size = " << size
+                   << ", ret = " << ret;
+        return nullptr;
+    }
+    return static_cast<char*>(buf);
+}
+
+char* BufferPool::Allocate(size_t size) {
+    size_t classSize = ClassSize(size);
+    if (classSize == 0) {
+        char* buf = AlignedAlloc(size);
+        if (buf != nullptr) {
+            metric_->miss << 1;
+            int64_t live = liveBytes_.fetch_add(size) + size;
+            metric_->peakLiveBytes << live;
+        }
+        return buf;
+    }
+
+    int index = ClassIndex(classSize);
+    ThreadCache* cache = GetThreadCache();
+    cache->allocatedClasses |= 1u << index;
+    char* buf = nullptr;
+    if (!cache->freeLists[index].empty()) {
+        buf = cache->freeLists[index].back();
+        cache->freeLists[index].pop_back();
+        cache->bytes -= classSize;
+        cachedBytes_.fetch_sub(classSize, std::memory_order_relaxed);
+    } else {
+        buf = AllocateFromGlobal(index);
+    }
+
+    if (buf != nullptr) {
+        metric_->hit << 1;
+    } else {
+        metric_->miss << 1;
+        buf = AlignedAlloc(classSize);
+        if (buf == nullptr) {
+            return nullptr;
+        }
+    }
+
+    int64_t live = liveBytes_.fetch_add(classSize) + classSize;
+    metric_->peakLiveBytes << live;
+    return buf;
+}
+
+void BufferPool::Free(char* buf, size_t size) {
+    if (buf == nullptr) {
+        return;
+    }
+
+    size_t classSize = ClassSize(size);
+    if (classSize == 0) {
+        liveBytes_.fetch_sub(size);
+        std::free(buf);
+        return;
+    }
+
+    liveBytes_.fetch_sub(classSize);
+    int index = ClassIndex(classSize);
+    ThreadCache* cache = GetThreadCache();
+    if ((cache->allocatedClasses & (1u << index)) != 0 &&
+        cache->bytes + classSize <= kThreadCacheBytes &&
+        cache->freeLists[index].size() < kThreadCacheBuffersPerClass) {
+        cache->freeLists[index].push_back(buf);
+        cache->bytes += classSize;
+        cachedBytes_.fetch_add(classSize, std::memory_order_relaxed);
+        return;
+    }
+
+    FreeToGlobal(index, buf);
+}
+
+char* BufferPool::AllocateFromGlobal(int index) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (freeLists_[index].empty()) {
+        return nullptr;
+    }
+
+    size_t classSize = kMinClassSize << index;
+    char* buf = freeLists_[index].back();
+    freeLists_[index].pop_back();
+    globalCachedBytes_ -= classSize;
+    cachedBytes_.fetch_sub(classSize, std::memory_order_relaxed);
+    return buf;
+}
+
+void BufferPool::FreeToGlobal(int index, char* buf) {
+    size_t classSize = kMinClassSize << index;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (globalCachedBytes_ + classSize <= FLAGS_bufferPoolMaxCachedBytes) {
+            freeLists_[index].push_back(buf);
+            globalCachedBytes_ += classSize;
+            cachedBytes_.fetch_add(classSize, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    std::free(buf);
+}
+
+}  // namespace common
+}  // namespace client
+}  // namespace curvefs
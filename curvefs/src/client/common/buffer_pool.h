@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-12
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_COMMON_BUFFER_POOL_H_
+#define CURVEFS_SRC_CLIENT_COMMON_BUFFER_POOL_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "curvefs/src/client/metric/client_metric.h"
+
+namespace curvefs {
+namespace client {
+namespace common {
+
+// BufferPool caches the transient data buffers of client data path,
+// e.g. s3 objects downloaded for prefetch and data assembled for flush.
+//
+// Request size is rounded up to a power-of-two size class between
+// kMinClassSize and kMaxClassSize, and every buffer is aligned to
+// kBufferAlignment, so it can also be used for O_DIRECT io.
+// Freed buffers are cached in a small per-thread cache first (only if the
+// freeing thread also allocates that size class) and then in a global cache
+// whose total size is limited by `bufferPoolMaxCachedBytes`; requests
+// larger than kMaxClassSize are allocated and freed directly.
+class BufferPool {
+ public:
+    static constexpr size_t kBufferAlignment = 4096;
+    static constexpr size_t kMinClassSize = 4096;            // 4KiB
+    static constexpr size_t kMaxClassSize = 16 * 1024 * 1024;  // 16MiB
+
+    static BufferPool& GetInstance();
+
+    // Allocate a buffer at least |size| bytes, return nullptr on failure
+    char* Allocate(size_t size);
+
+    // Free a buffer returned by Allocate, |size| must be same as allocated
+    void Free(char* buf, size_t size);
+
+    int64_t GetLiveBytes() const {
+        return liveBytes_.load(std::memory_order_relaxed);
+    }
+
+    int64_t GetCachedBytes() const {
+        return cachedBytes_.load(std::memory_order_relaxed);
+    }
+
+    // Size class of a |size| bytes request, 0 if it is not pooled
+    static size_t ClassSize(size_t size);
+
+ private:
+    BufferPool();
+
+    struct ThreadCache;
+
+    static int ClassIndex(size_t classSize);
+
+    static ThreadCache* GetThreadCache();
+
+    char* AllocateFromGlobal(int index);
+
+    void FreeToGlobal(int index, char* buf);
+
+    static char* AlignedAlloc(size_t size);
+
+ private:
+    static constexpr int kClassNum = 13;  // 4KiB ... 16MiB
+
+    std::mutex mtx_;
+    std::vector<char*> freeLists_[kClassNum];
+    // bytes of buffers in freeLists_, protected by mtx_
+    uint64_t globalCachedBytes_;
+
+    std::atomic<int64_t> liveBytes_;
+    std::atomic<int64_t> cachedBytes_;
+    std::unique_ptr<metric::BufferPoolMetric> metric_;
+};
+
+// RAII wrapper of a buffer allocated from BufferPool
+class PooledBuffer {
+ public:
+    explicit PooledBuffer(size_t size)
+        : data_(BufferPool::GetInstance().Allocate(size)), size_(size) {}
+
+    // take over a buffer allocated from BufferPool
+    PooledBuffer(char* data, size_t size) : data_(data), size_(size) {}
+
+    ~PooledBuffer() {
+        if (data_ != nullptr) {
+            BufferPool::GetInstance().Free(data_, size_);
+        }
+    }
+
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+    char* Data() const { return data_; }
+
+    size_t Size() const { return size_; }
+
+ private:
+    char* data_;
+    size_t size_;
+};
+
+}  // namespace common
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_COMMON_BUFFER_POOL_H_
@@ -105,6 +105,10 @@ DEFINE_uint64(fuseClientBurstReadIopsSecs, 180,
               "the times that Read burst iops can continue");
 DEFINE_validator(fuseClientBurstReadIopsSecs, &pass_uint64);
 
+DEFINE_uint64(bufferPoolMaxCachedBytes, 256ULL * 1024 * 1024,
+              "max bytes of free buffers kept by client buffer pool");
+DEFINE_validator(bufferPoolMaxCachedBytes, &pass_uint64);
+
 void InitMdsOption(Configuration *conf, MdsOption *mdsOpt) {
     conf->GetValueFatalIfFail("mdsOpt.mdsMaxRetryMS", &mdsOpt->mdsMaxRetryMS);
     conf->GetValueFatalIfFail("mdsOpt.rpcRetryOpt.maxRPCTimeoutMS",
@@ -266,6 +270,10 @@ void InitVolumeOption(Configuration *conf, VolumeOption *volumeOpt) {
                               &volumeOpt->threshold);
     conf->GetValueFatalIfFail("volume.space.releaseInterSec",
                               &volumeOpt->releaseInterSec);
+    LOG_IF(WARNING, !conf->GetUInt64Value("volume.space.prefetchThreshold",
+                                          &volumeOpt->prefetchThreshold))
+        << "Not found `volume.space.prefetchThreshold` in conf, use default "
+           "value `" << volumeOpt->prefetchThreshold << '`';
 
     conf->GetValueFatalIfFail(
         "volume.blockGroup.allocateOnce",
@@ -282,6 +290,19 @@ void InitVolumeOption(Configuration *conf, VolumeOption *volumeOpt) {
     } else {
         CHECK(false) << "only support bitmap allocator";
     }
+
+    auto* journalOpt = &volumeOpt->journalOption;
+    LOG_IF(WARNING, !conf->GetStringValue("volume.journal.path",
+                                          &journalOpt->path))
+        << "Not found `volume.journal.path` in conf, write journal disabled";
+    LOG_IF(WARNING, !conf->GetUInt64Value("volume.journal.capacity",
+                                          &journalOpt->capacity))
+        << "Not found `volume.journal.capacity` in conf, use default value `"
+        << journalOpt->capacity << '`';
+    LOG_IF(WARNING, !conf->GetUInt32Value("volume.journal.flushIntervalMs",
+                                          &journalOpt->flushIntervalMs))
+        << "Not found `volume.journal.flushIntervalMs` in conf, use default "
+           "value `" << journalOpt->flushIntervalMs << '`';
 }
 
 void InitExtentManagerOption(Configuration *conf,
@@ -389,6 +410,11 @@ void InitFileSystemOption(Configuration* c, FileSystemOption* option) {
     {  // rpc option
         auto o = &option->rpcOption;
         c->GetValueFatalIfFail("fs.rpc.listDentryLimit", &o->listDentryLimit);
+        o->listDentryPlus = false;
+        LOG_IF(WARNING, !c->GetBoolValue("fs.rpc.listDentryPlus",
+                                         &o->listDentryPlus))
+            << "Not found `fs.rpc.listDentryPlus` in conf, use default value `"
+            << std::boolalpha << o->listDentryPlus << '`';
     }
     {  // defer sync option
         auto o = &option->deferSyncOption;
@@ -432,6 +458,14 @@ void InitFuseClientOption(Configuration *conf, FuseClientOption *clientOption) {
                               &clientOption->downloadMaxRetryTimes);
     conf->GetValueFatalIfFail("fuseClient.warmupThreadsNum",
                               &clientOption->warmupThreadsNum);
+    LOG_IF(WARNING, !conf->GetUInt64Value("fuseClient.warmup.bpsLimitMB",
+                                          &clientOption->warmupBpsLimitMB))
+        << "Not found `fuseClient.warmup.bpsLimitMB` in conf, use default "
+           "value `" << clientOption->warmupBpsLimitMB << '`';
+    LOG_IF(WARNING, !conf->GetUInt64Value("fuseClient.warmup.iopsLimit",
+                                          &clientOption->warmupIopsLimit))
+        << "Not found `fuseClient.warmup.iopsLimit` in conf, use default "
+           "value `" << clientOption->warmupIopsLimit << '`';
     LOG_IF(WARNING, conf->GetBoolValue("fuseClient.enableSplice",
                                        &clientOption->enableFuseSplice))
         << "Not found `fuseClient.enableSplice` in conf, use default value `"
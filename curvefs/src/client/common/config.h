@@ -162,6 +162,14 @@ struct VolumeAllocatorOption {
     BlockGroupOption blockGroupOption;
 };
 
+// local write journal of volume backend, disabled if `path` is empty
+struct VolumeJournalOption {
+    std::string path;
+    // journal size that triggers a synchronous flush before appending
+    uint64_t capacity{1ULL * 1024 * 1024 * 1024};
+    uint32_t flushIntervalMs{1000};
+};
+
 struct VolumeOption {
     uint64_t bigFileSize;
     uint64_t volBlockSize;
@@ -170,6 +178,9 @@ struct VolumeOption {
 
     double threshold{1.0};
     uint64_t releaseInterSec{300};
+    uint64_t prefetchThreshold{0};
+
+    VolumeJournalOption journalOption;
 };
 
 struct ExtentManagerOption {
@@ -229,6 +240,7 @@ struct OpenFilesOption {
 
 struct RPCOption {
     uint32_t listDentryLimit;
+    bool listDentryPlus;
 };
 
 struct DeferSyncOption {
@@ -273,6 +285,9 @@ struct FuseClientOption {
     bool enableFuseSplice = false;
     uint32_t downloadMaxRetryTimes;
     uint32_t warmupThreadsNum = 10;
+    // s3 bandwidth and iops of warmup per mount, 0 means unlimited
+    uint64_t warmupBpsLimitMB = 0;
+    uint64_t warmupIopsLimit = 0;
 };
 
 void InitFuseClientOption(Configuration *conf, FuseClientOption *clientOption);
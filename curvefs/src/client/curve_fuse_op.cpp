@@ -109,6 +109,42 @@ void EnableSplice(struct fuse_conn_info* conn) {
     }
 }
 
+// Every fuse worker thread reuses its own read buffer instead of allocating
+// one per request: fuse_reply_data() has written (or spliced) the data to the
+// kernel before it returns, so the buffer is free again for the next request.
+// Large per-request allocations are served by mmap/munmap in glibc, which
+// costs page faults on every read of hot data.
+//
+// Only buffers up to kMaxCachedReadBufferSize are kept, larger (rare) reads
+// get a one-off buffer, so a single huge read doesn't pin its size in every
+// worker thread. The buffer is never zero-filled, reads overwrite it anyway.
+constexpr size_t kMaxCachedReadBufferSize = 1024 * 1024;
+
+class ReadBuffer {
+ public:
+    explicit ReadBuffer(size_t size) {
+        thread_local static std::unique_ptr<char[]> cached;
+        thread_local static size_t cachedSize = 0;
+
+        if (size > kMaxCachedReadBufferSize) {
+            owned_.reset(new char[size]);
+            data_ = owned_.get();
+            return;
+        }
+        if (cachedSize < size) {
+            cached.reset(new char[size]);
+            cachedSize = size;
+        }
+        data_ = cached.get();
+    }
+
+    char* Data() const { return data_; }
+
+ private:
+    std::unique_ptr<char[]> owned_;
+    char* data_;
+};
+
 int GetFsInfo(const char* fsName, FsInfo* fsInfo) {
     MdsClientImpl mdsClient;
     MDSBaseClient mdsBase;
@@ -724,7 +760,8 @@ void FuseOpRead(fuse_req_t req,
                 struct fuse_file_info* fi) {
     CURVEFS_ERROR rc;
     size_t rSize = 0;
-    std::unique_ptr<char[]> buffer(new char[size]);
+    ReadBuffer readBuffer(size);
+    char* buffer = readBuffer.Data();
     auto client = Client();
     auto fs = client->GetFileSystem();
     MetricGuard(Read);
@@ -734,12 +771,12 @@ void FuseOpRead(fuse_req_t req,
     });
 
     ReadThrottleAdd(size);
-    rc = client->FuseOpRead(req, ino, size, off, fi, buffer.get(), &rSize);
+    rc = client->FuseOpRead(req, ino, size, off, fi, buffer, &rSize);
     if (rc != CURVEFS_ERROR::OK) {
         return fs->ReplyError(req, rc);
     }
     struct fuse_bufvec bufvec = FUSE_BUFVEC_INIT(rSize);
-    bufvec.buf[0].mem = buffer.get();
+    bufvec.buf[0].mem = buffer;
     return fs->ReplyData(req, &bufvec, FUSE_BUF_SPLICE_MOVE);
 }
 
@@ -156,5 +156,42 @@ CURVEFS_ERROR DentryCacheManagerImpl::ListDentry(uint64_t parent,
     return CURVEFS_ERROR::OK;
 }
 
+CURVEFS_ERROR DentryCacheManagerImpl::ListDentryPlus(
+    uint64_t parent, std::list<Dentry> *dentryList,
+    std::map<uint64_t, InodeAttr> *attrs, uint32_t limit) {
+    dentryList->clear();
+    attrs->clear();
+    std::string last = "";
+    bool perceed = true;
+    do {
+        std::list<Dentry> part;
+        std::map<uint64_t, InodeAttr> partAttrs;
+        MetaStatusCode ret = metaClient_->ListDentryPlus(
+            fsId_, parent, last, limit, &part, &partAttrs);
+        VLOG(6) << "ListDentryPlus fsId = " << fsId_ << ", parent = " << parent
+                << ", last = " << last << ", count = " << limit
+                << ", ret = " << ret << ", part.size() = " << part.size()
+                << ", attribute size = " << partAttrs.size();
+        if (ret != MetaStatusCode::OK) {
+            LOG(ERROR) << "metaClient_ ListDentryPlus failed"
+                       << ", MetaStatusCode_Name = " << MetaStatusCode_Name(ret)
+                       << ", parent = " << parent << ", last = " << last
+                       << ", count = " << limit;
+            return ToFSError(ret);
+        }
+
+        if (part.size() < limit) {
+            perceed = false;
+        }
+        if (!part.empty()) {
+            last = part.back().name();
+            dentryList->splice(dentryList->end(), part);
+        }
+        attrs->insert(partAttrs.begin(), partAttrs.end());
+    } while (perceed);
+
+    return CURVEFS_ERROR::OK;
+}
+
 }  // namespace client
 }  // namespace curvefs
@@ -70,6 +70,12 @@ class DentryCacheManager {
         std::list<Dentry> *dentryList, uint32_t limit,
         bool onlyDir = false, uint32_t nlink = 0) = 0;
 
+    // list all dentrys with attribute of inodes which
+    // belong to the same partition as |parent|, |limit| dentrys per rpc
+    virtual CURVEFS_ERROR ListDentryPlus(uint64_t parent,
+        std::list<Dentry> *dentryList,
+        std::map<uint64_t, InodeAttr> *attrs, uint32_t limit) = 0;
+
  protected:
     uint32_t fsId_;
 };
@@ -96,6 +102,10 @@ class DentryCacheManagerImpl : public DentryCacheManager {
         std::list<Dentry> *dentryList, uint32_t limit,
         bool dirOnly = false, uint32_t nlink = 0) override;
 
+    CURVEFS_ERROR ListDentryPlus(uint64_t parent,
+        std::list<Dentry> *dentryList,
+        std::map<uint64_t, InodeAttr> *attrs, uint32_t limit) override;
+
     std::string GetDentryCacheKey(uint64_t parent, const std::string &name) {
         return std::to_string(parent) + kDentryKeyDelimiter + name;
     }
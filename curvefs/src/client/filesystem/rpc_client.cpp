@@ -74,8 +74,16 @@ CURVEFS_ERROR RPCClient::ReadDir(Ino ino,
                                  std::shared_ptr<DirEntryList>* entries) {
     uint32_t limit = option_.listDentryLimit;
 
+    // attributes of inodes in the same partition are returned inline
+    // by ListDentryPlus, the others are fetched by BatchGetInodeAttrAsync
     std::list<Dentry> dentries;
-    CURVEFS_ERROR rc = dentryManager_->ListDentry(ino, &dentries, limit);
+    std::map<uint64_t, InodeAttr> attrs;
+    CURVEFS_ERROR rc;
+    if (option_.listDentryPlus) {
+        rc = dentryManager_->ListDentryPlus(ino, &dentries, &attrs, limit);
+    } else {
+        rc = dentryManager_->ListDentry(ino, &dentries, limit);
+    }
     if (rc != CURVEFS_ERROR::OK) {
         LOG(ERROR) << "rpc(readdir::ListDentry) failed, retCode = " << rc
                    << ", ino = " << ino;
@@ -87,7 +95,6 @@ CURVEFS_ERROR RPCClient::ReadDir(Ino ino,
     }
 
     std::set<uint64_t> inos;
-    std::map<uint64_t, InodeAttr> attrs;
     std::for_each(dentries.begin(), dentries.end(), [&](Dentry& dentry){
         inos.emplace(dentry.inodeid());
     });
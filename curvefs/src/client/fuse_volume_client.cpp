@@ -118,13 +118,32 @@ CURVEFS_ERROR FuseVolumeClient::FuseOpInit(void *userdata,
         volOpts_.allocatorOption.bitmapAllocatorOption.smallAllocProportion;
     option.threshold = volOpts_.threshold;
     option.releaseInterSec = volOpts_.releaseInterSec;
+    option.prefetchThreshold = volOpts_.prefetchThreshold;
 
     spaceManager_ = absl::make_unique<SpaceManagerImpl>(option, mdsClient_,
                                                         blockDeviceClient_);
     spaceManager_->Run();
 
+    if (!volOpts_.journalOption.path.empty()) {
+        // replay the journaled writes left by last mount before serving
+        journal_ = absl::make_unique<WriteJournal>(
+            volOpts_.journalOption, fsInfo_->fsid(), volName,
+            blockDeviceClient_.get());
+        if (!journal_->Init()) {
+            LOG(ERROR) << "Init write journal failed, path: "
+                       << volOpts_.journalOption.path;
+            return CURVEFS_ERROR::INTERNAL;
+        }
+
+        WriteJournal* journal = journal_.get();
+        inodeManager_->SetDataFlusher([journal](uint64_t ino) {
+            return journal->Flush(ino);
+        });
+    }
+
     storage_ = absl::make_unique<DefaultVolumeStorage>(
-        spaceManager_.get(), blockDeviceClient_.get(), inodeManager_.get());
+        spaceManager_.get(), blockDeviceClient_.get(), inodeManager_.get(),
+        journal_.get());
 
     ExtentCacheOption extentOpt;
     extentOpt.blockSize = vol.blocksize();
@@ -299,9 +318,55 @@ CURVEFS_ERROR FuseVolumeClient::FuseOpLink(fuse_req_t req,
 CURVEFS_ERROR FuseVolumeClient::FuseOpUnlink(fuse_req_t req, fuse_ino_t parent,
                                              const char *name) {
     VLOG(1) << "FuseOpUnlink, parent: " << parent << ", name: " << name;
+    CURVEFS_ERROR ret = FlushJournal(parent, name);
+    if (ret != CURVEFS_ERROR::OK) {
+        return ret;
+    }
     return RemoveNode(req, parent, name, FsFileType::TYPE_FILE);
 }
 
+CURVEFS_ERROR FuseVolumeClient::FuseOpRename(fuse_req_t req,
+                                             fuse_ino_t parent,
+                                             const char *name,
+                                             fuse_ino_t newparent,
+                                             const char *newname,
+                                             unsigned int flags) {
+    // the file at destination is removed if it exists
+    CURVEFS_ERROR ret = FlushJournal(newparent, newname);
+    if (ret != CURVEFS_ERROR::OK) {
+        return ret;
+    }
+    return FuseClient::FuseOpRename(req, parent, name, newparent, newname,
+                                    flags);
+}
+
+CURVEFS_ERROR FuseVolumeClient::FlushJournal(fuse_ino_t parent,
+                                             const char *name) {
+    if (journal_ == nullptr) {
+        return CURVEFS_ERROR::OK;
+    }
+
+    Dentry dentry;
+    CURVEFS_ERROR ret = dentryManager_->GetDentry(parent, name, &dentry);
+    if (ret == CURVEFS_ERROR::NOT_EXIST) {
+        return CURVEFS_ERROR::OK;
+    } else if (ret != CURVEFS_ERROR::OK) {
+        LOG(ERROR) << "GetDentry fail, parent: " << parent
+                   << ", name: " << name << ", error: " << ret;
+        return ret;
+    }
+
+    // space of a removed file is deallocated by metaserver and may be
+    // reallocated, its journaled data mustn't be flushed after that. it's
+    // flushed rather than discarded, because an opened file is still
+    // readable after being removed
+    if (!journal_->Flush(dentry.inodeid())) {
+        LOG(ERROR) << "Flush write journal fail, ino: " << dentry.inodeid();
+        return CURVEFS_ERROR::IO_ERROR;
+    }
+    return CURVEFS_ERROR::OK;
+}
+
 CURVEFS_ERROR FuseVolumeClient::FuseOpFsync(fuse_req_t req, fuse_ino_t ino,
                                             int datasync,
                                             struct fuse_file_info *fi) {
@@ -333,8 +398,13 @@ CURVEFS_ERROR FuseVolumeClient::FuseOpFsync(fuse_req_t req, fuse_ino_t ino,
 }
 
 CURVEFS_ERROR FuseVolumeClient::Truncate(InodeWrapper *inode, uint64_t length) {
-    (void)inode;
-    (void)length;
+    // journaled data of a file truncated to zero is never read again
+    if (length == 0 && journal_ != nullptr &&
+        !journal_->Discard(inode->GetInodeId())) {
+        LOG(ERROR) << "Discard write journal fail, ino: "
+                   << inode->GetInodeId();
+        return CURVEFS_ERROR::IO_ERROR;
+    }
     // Todo: call volume truncate
     return CURVEFS_ERROR::OK;
 }
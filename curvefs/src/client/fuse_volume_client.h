@@ -28,6 +28,7 @@
 
 #include "curvefs/src/client/fuse_client.h"
 #include "curvefs/src/client/volume/volume_storage.h"
+#include "curvefs/src/client/volume/write_journal.h"
 #include "curvefs/src/volume/block_device_client.h"
 #include "curvefs/src/volume/space_manager.h"
 
@@ -95,6 +96,13 @@ class FuseVolumeClient : public FuseClient {
     CURVEFS_ERROR FuseOpUnlink(fuse_req_t req, fuse_ino_t parent,
                                const char *name) override;
 
+    CURVEFS_ERROR FuseOpRename(fuse_req_t req,
+                               fuse_ino_t parent,
+                               const char *name,
+                               fuse_ino_t newparent,
+                               const char *newname,
+                               unsigned int flags) override;
+
     CURVEFS_ERROR FuseOpFsync(fuse_req_t req, fuse_ino_t ino, int datasync,
                               struct fuse_file_info *fi) override;
 
@@ -110,9 +118,13 @@ class FuseVolumeClient : public FuseClient {
  private:
     void FlushData() override;
 
+    // Flush journaled data of the file (parent, name) before it's removed
+    CURVEFS_ERROR FlushJournal(fuse_ino_t parent, const char *name);
+
  private:
     std::shared_ptr<BlockDeviceClient> blockDeviceClient_;
     std::unique_ptr<SpaceManager> spaceManager_;
+    std::unique_ptr<WriteJournal> journal_;
     std::unique_ptr<VolumeStorage> storage_;
 
     VolumeOption volOpts_;
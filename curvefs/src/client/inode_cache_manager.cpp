@@ -153,6 +153,7 @@ InodeCacheManagerImpl::GetInode(uint64_t inodeId,
     out = std::make_shared<InodeWrapper>(
         std::move(inode), metaClient_, s3ChunkInfoMetric_, option_.maxDataSize,
         option_.refreshDataIntervalSec);
+    out->SetDataFlusher(dataFlusher_);
 
     // refresh data
     VLOG(9) << "get inode: " << inodeId << " from icache fail, get from remote";
@@ -229,9 +230,20 @@ CURVEFS_ERROR InodeCacheManagerImpl::BatchGetInodeAttrAsync(
     auto watcher = std::make_shared<DeferWatcher>(cto, deferSync_);
     watcher->PreGetAttrs(*inodeIds);
 
+    std::set<uint64_t> missing;
+    for (const auto& ino : *inodeIds) {
+        if (attrs->find(ino) == attrs->end()) {
+            missing.emplace(ino);
+        }
+    }
+    if (missing.empty()) {
+        watcher->PostGetAttrs(attrs);
+        return CURVEFS_ERROR::OK;
+    }
+
     // split inodeIds by partitionId and batch limit
     std::vector<std::vector<uint64_t>> inodeGroups;
-    if (!metaClient_->SplitRequestInodes(fsId_, *inodeIds, &inodeGroups)) {
+    if (!metaClient_->SplitRequestInodes(fsId_, missing, &inodeGroups)) {
         return CURVEFS_ERROR::NOT_EXIST;
     }
 
@@ -286,6 +298,7 @@ CURVEFS_ERROR InodeCacheManagerImpl::CreateInode(
     out = std::make_shared<InodeWrapper>(std::move(inode), metaClient_,
         s3ChunkInfoMetric_, option_.maxDataSize,
         option_.refreshDataIntervalSec);
+    out->SetDataFlusher(dataFlusher_);
     return CURVEFS_ERROR::OK;
 }
 
@@ -303,6 +316,7 @@ CURVEFS_ERROR InodeCacheManagerImpl::CreateManageInode(
     out = std::make_shared<InodeWrapper>(std::move(inode), metaClient_,
         s3ChunkInfoMetric_, option_.maxDataSize,
         option_.refreshDataIntervalSec);
+    out->SetDataFlusher(dataFlusher_);
     return CURVEFS_ERROR::OK;
 }
 
@@ -81,6 +81,12 @@ class InodeCacheManager {
         fsId_ = fsId;
     }
 
+    // handed to every inode wrapper created afterwards,
+    // see InodeWrapper::SetDataFlusher()
+    void SetDataFlusher(DataFlusher flusher) {
+        dataFlusher_ = std::move(flusher);
+    }
+
     virtual CURVEFS_ERROR Init(RefreshDataOption option,
                                std::shared_ptr<OpenFiles> openFiles,
                                std::shared_ptr<DeferSync> deferSync) = 0;
@@ -95,6 +101,8 @@ class InodeCacheManager {
         std::set<uint64_t> *inodeIds,
         std::list<InodeAttr> *attrs) = 0;
 
+    // NOTE: inodes whose attribute already in |attrs| (e.g. returned
+    // inline by ListDentryPlus) will not be fetched from metaserver again
     virtual CURVEFS_ERROR BatchGetInodeAttrAsync(
         uint64_t parentId,
         std::set<uint64_t> *inodeIds,
@@ -116,6 +124,7 @@ class InodeCacheManager {
 
  protected:
     uint32_t fsId_;
+    DataFlusher dataFlusher_;
 };
 
 class DeferWatcher {
@@ -181,9 +181,26 @@ void InodeWrapper::GetInodeAttr(InodeAttr *attr) {
     GetInodeAttrLocked(attr);
 }
 
+bool InodeWrapper::FlushData() {
+    if (inode_.type() != FsFileType::TYPE_FILE || !dataFlusher_) {
+        return true;
+    }
+
+    if (!dataFlusher_(inode_.inodeid())) {
+        LOG(ERROR) << "Flush data before sync failed, inodeid: "
+                   << inode_.inodeid();
+        return false;
+    }
+    return true;
+}
+
 CURVEFS_ERROR InodeWrapper::SyncAttr(bool internal) {
     curve::common::UniqueLock lock = GetSyncingInodeUniqueLock();
     if (dirty_) {
+        if (!FlushData()) {
+            return CURVEFS_ERROR::IO_ERROR;
+        }
+
         MetaStatusCode ret = metaClient_->UpdateInodeAttrWithOutNlink(
             inode_.fsid(), inode_.inodeid(), dirtyAttr_,
             nullptr, internal);
@@ -256,6 +273,10 @@ CURVEFS_ERROR InodeWrapper::FlushVolumeExtent() {
         return CURVEFS_ERROR::OK;
     }
 
+    if (!FlushData()) {
+        return CURVEFS_ERROR::IO_ERROR;
+    }
+
     UpdateVolumeExtentClosure closure(shared_from_this(), true);
     auto dirtyExtents = extentCache_.GetDirtyExtents();
     VLOG(3) << "FlushVolumeExtent, ino: " << inode_.inodeid()
@@ -275,6 +296,11 @@ void InodeWrapper::FlushVolumeExtentAsync() {
         return;
     }
 
+    if (!FlushData()) {
+        syncingVolumeExtentsMtx_.unlock();
+        return;
+    }
+
     auto dirtyExtents = extentCache_.GetDirtyExtents();
     VLOG(3) << "FlushVolumeExtent, ino: " << inode_.inodeid()
             << ", dirty extents: " << dirtyExtents.ShortDebugString();
@@ -482,6 +508,15 @@ void InodeWrapper::AsyncFlushAttrAndExtents(MetaServerClientDone *done,
             << ", is dirty: " << dirty_
             << ", has dirty extents: " << extentCache_.HasDirtyExtents();
     if (dirty_ || extentCache_.HasDirtyExtents()) {
+        // keep everything dirty, the next sync will retry
+        if (!FlushData()) {
+            if (done != nullptr) {
+                done->SetMetaStatusCode(MetaStatusCode::UNKNOWN_ERROR);
+                done->Run();
+            }
+            return;
+        }
+
         LockSyncingInode();
         syncingVolumeExtentsMtx_.lock();
         DataIndices indices;
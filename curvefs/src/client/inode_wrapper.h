@@ -28,6 +28,7 @@
 #include <gtest/gtest_prod.h>
 #include <climits>
 #include <cstdint>
+#include <functional>
 #include <utility>
 #include <memory>
 #include <string>
@@ -74,6 +75,10 @@ void AppendS3ChunkInfoToMap(uint64_t chunkIndex, const S3ChunkInfo &info,
 
 extern bvar::Adder<int64_t> g_alive_inode_count;
 
+// Persist the file data which is not yet on the volume (e.g. still in the
+// write journal) for |ino|, return false if it failed.
+using DataFlusher = std::function<bool(uint64_t ino)>;
+
 class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
  public:
     InodeWrapper(Inode inode,
@@ -344,6 +349,13 @@ class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
         return time_;
     }
 
+    // Extents (and the length) of a volume file must not be synced before
+    // the data they point to has reached the volume, |flusher| is invoked
+    // ahead of every attr or extent sync of a TYPE_FILE inode.
+    void SetDataFlusher(DataFlusher flusher) {
+        dataFlusher_ = std::move(flusher);
+    }
+
  private:
     CURVEFS_ERROR SyncS3ChunkInfo(bool internal = false);
 
@@ -390,6 +402,8 @@ class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
     CURVEFS_ERROR FlushVolumeExtent();
     void FlushVolumeExtentAsync();
 
+    bool FlushData();
+
  private:
     FRIEND_TEST(TestInodeWrapper, TestUpdateInodeAttrIncrementally);
 
@@ -421,6 +435,8 @@ class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
 
     // timestamp when put in cache
     uint64_t time_;
+
+    DataFlusher dataFlusher_;
 };
 
 }  // namespace client
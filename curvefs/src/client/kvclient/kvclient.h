@@ -25,11 +25,27 @@
 #include <libmemcached-1.0/types/return.h>
 
 #include <string>
+#include <vector>
 
 namespace curvefs {
 
 namespace client {
 
+/**
+ * One key of a batch get, read [offset, offset + length) of the value
+ * into buffer.
+ */
+struct KVGetItem {
+    std::string key;
+    char* value;
+    uint64_t offset;
+    uint64_t length;
+    bool res;
+
+    KVGetItem(const std::string& k, char* v, uint64_t off, uint64_t len)
+        : key(k), value(v), offset(off), length(len), res(false) {}
+};
+
 /**
  * Single client to kv interface.
  */
@@ -54,6 +70,18 @@ class KVClient {
     virtual bool Get(const std::string& key, char* value, uint64_t offset,
                      uint64_t length, std::string* errorlog,
                      uint64_t* actLength, memcached_return_t* retCod) = 0;
+
+    /**
+     * @brief: get a batch of keys, res of every item tells whether it is
+     *         read successfully. Default implementation gets them one by one.
+     */
+    virtual void MGet(std::vector<KVGetItem>* items) {
+        for (auto& item : *items) {
+            std::string errorlog;
+            item.res = Get(item.key, item.value, item.offset, item.length,
+                           &errorlog, nullptr, nullptr);
+        }
+    }
 };
 
 }  // namespace client
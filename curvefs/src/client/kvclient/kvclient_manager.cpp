@@ -111,6 +111,27 @@ void KVClientManager::Get(std::shared_ptr<GetKVCacheTask> task) {
     });
 }
 
+void KVClientManager::MGet(std::shared_ptr<MGetKVCacheTask> task) {
+    kvClientManagerMetric_->getQueueSize << 1;
+    threadPool_.Enqueue([task, this]() {
+        client_->MGet(&task->items);
+        kvClientManagerMetric_->getQueueSize << -1;
+        task->timer.stop();
+        uint64_t length = 0;
+        for (const auto& item : task->items) {
+            if (item.res) {
+                kvClientManagerMetric_->hit << 1;
+                length += item.length;
+            } else {
+                kvClientManagerMetric_->miss << 1;
+            }
+        }
+        curve::client::CollectMetrics(&kvClientManagerMetric_->get, length,
+                                      task->timer.u_elapsed());
+        task->done(task);
+    });
+}
+
 void KVClientManager::Enqueue(std::shared_ptr<GetObjectAsyncContext> context) {
     auto task = [this, context]() { this->GetKvCache(context); };
     threadPool_.Enqueue(task);
@@ -30,6 +30,7 @@
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "curvefs/src/client/common/config.h"
@@ -46,6 +47,7 @@ namespace client {
 class KVClientManager;
 struct SetKVCacheTask;
 struct GetKVCacheTask;
+struct MGetKVCacheTask;
 
 class GetKvCacheContext;
 class SetKvCacheContext;
@@ -58,6 +60,8 @@ using SetKVCacheDone =
     std::function<void(const std::shared_ptr<SetKVCacheTask>&)>;
 using GetKVCacheDone =
     std::function<void(const std::shared_ptr<GetKVCacheTask>&)>;
+using MGetKVCacheDone =
+    std::function<void(const std::shared_ptr<MGetKVCacheTask>&)>;
 
 struct SetKVCacheTask {
     std::string key;
@@ -101,6 +105,19 @@ struct GetKVCacheTask {
           timer(butil::Timer::STARTED) {}
 };
 
+struct MGetKVCacheTask {
+    std::vector<KVGetItem> items;
+    MGetKVCacheDone done;
+    butil::Timer timer;
+
+    explicit MGetKVCacheTask(
+        std::vector<KVGetItem> items,
+        MGetKVCacheDone done = [](const std::shared_ptr<MGetKVCacheTask>&) {})
+        : items(std::move(items)),
+          done(std::move(done)),
+          timer(butil::Timer::STARTED) {}
+};
+
 using GetKvCacheCallBack =
     std::function<void(const std::shared_ptr<GetKvCacheContext>&)>;
 
@@ -146,6 +163,12 @@ class KVClientManager {
 
     void Get(std::shared_ptr<GetKVCacheTask> task);
 
+    /**
+     * Get a batch of keys in one task, e.g. all blocks of one read request,
+     * so they are fetched in one round trip instead of one by one.
+     */
+    void MGet(std::shared_ptr<MGetKVCacheTask> task);
+
     KVClientManagerMetric* GetMetricForTesting() {
         return kvClientManagerMetric_.get();
     }
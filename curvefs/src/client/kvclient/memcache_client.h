@@ -30,6 +30,8 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "curvefs/proto/topology.pb.h"
@@ -101,6 +103,12 @@ class MemCachedClient : public KVClient {
         memcached_behavior_set(client_, MEMCACHED_BEHAVIOR_DISTRIBUTION,
                                MEMCACHED_DISTRIBUTION_CONSISTENT);
         memcached_behavior_set(client_, MEMCACHED_BEHAVIOR_RETRY_TIMEOUT, 5);
+        // take the failed server out of the hash ring, so only keys on it
+        // are remapped instead of every request to it timing out
+        memcached_behavior_set(client_,
+                               MEMCACHED_BEHAVIOR_REMOVE_FAILED_SERVERS, 1);
+        memcached_behavior_set(client_, MEMCACHED_BEHAVIOR_SERVER_FAILURE_LIMIT,
+                               2);
 
         return PushServer();
     }
@@ -178,6 +186,91 @@ class MemCachedClient : public KVClient {
         return false;
     }
 
+    /**
+     * @brief: get a batch of keys by one memcached_mget, keys on the same
+     *         server are fetched in one round trip.
+     */
+    void MGet(std::vector<KVGetItem>* items) override {
+        if (items->empty()) {
+            return;
+        }
+        uint64_t start = butil::cpuwide_time_us();
+        if (nullptr == tcli) {
+            tcli = memcached_clone(nullptr, client_);
+        }
+
+        std::vector<const char*> keys;
+        std::vector<size_t> keyLens;
+        std::unordered_map<std::string, size_t> key2item;
+        keys.reserve(items->size());
+        keyLens.reserve(items->size());
+        for (size_t i = 0; i < items->size(); i++) {
+            const std::string& key = (*items)[i].key;
+            if (key2item.emplace(key, i).second) {
+                keys.push_back(key.c_str());
+                keyLens.push_back(key.length());
+            }
+        }
+
+        memcached_return_t ue =
+            memcached_mget(tcli, keys.data(), keyLens.data(), keys.size());
+        if (MEMCACHED_SUCCESS != ue) {
+            LOG_EVERY_N(WARNING, 1000) << "MGet " << keys.size()
+                                       << " keys error = " << ResError(ue);
+            memcached_free(tcli);
+            tcli = nullptr;
+            metric_->get.eps.count << 1;
+            return;
+        }
+
+        uint64_t bytes = 0;
+        memcached_result_st result;
+        memcached_result_create(tcli, &result);
+        while (memcached_fetch_result(tcli, &result, &ue) != nullptr) {
+            if (MEMCACHED_SUCCESS != ue) {
+                continue;
+            }
+            std::string key(memcached_result_key_value(&result),
+                            memcached_result_key_length(&result));
+            auto iter = key2item.find(key);
+            if (iter == key2item.end()) {
+                continue;
+            }
+            size_t valueLength = memcached_result_length(&result);
+            KVGetItem& item = (*items)[iter->second];
+            if (valueLength >= item.offset + item.length) {
+                memcpy(item.value, memcached_result_value(&result) + item.offset,
+                       item.length);
+                item.res = true;
+                bytes += valueLength;
+            }
+        }
+        memcached_result_free(&result);
+
+        if (ue != MEMCACHED_END && ue != MEMCACHED_NOTFOUND &&
+            ue != MEMCACHED_SUCCESS) {
+            LOG_EVERY_N(WARNING, 1000)
+                << "MGet fetch result error = " << ResError(ue);
+            memcached_free(tcli);
+            tcli = nullptr;
+            metric_->get.eps.count << 1;
+        }
+
+        // the same key may be requested more than once in a batch,
+        // only the first one is fetched by mget
+        for (size_t i = 0; i < items->size(); i++) {
+            KVGetItem& item = (*items)[i];
+            if (key2item[item.key] != i) {
+                std::string errorlog;
+                item.res = Get(item.key, item.value, item.offset, item.length,
+                               &errorlog, nullptr, nullptr);
+            }
+        }
+
+        curve::client::CollectMetrics(&metric_->get, bytes,
+                                      butil::cpuwide_time_us() - start);
+    }
+
     // transform the res to a error string
     const std::string ResError(const memcached_return_t res) {
         return memcached_strerror(nullptr, res);
@@ -305,6 +305,26 @@ struct DiskCacheMetric {
           trim_(prefix, fsName + "_diskcache_trim") {}
 };
 
+struct BufferPoolMetric {
+    static const std::string prefix;
+
+    // bytes of buffers handed out and not freed yet
+    bvar::PassiveStatus<uint64_t> liveBytes;
+    // bytes of free buffers kept for reuse
+    bvar::PassiveStatus<uint64_t> cachedBytes;
+    bvar::Maxer<int64_t> peakLiveBytes;
+    bvar::Adder<uint64_t> hit;
+    bvar::Adder<uint64_t> miss;
+
+    BufferPoolMetric(std::atomic<int64_t>* live, std::atomic<int64_t>* cached)
+        : liveBytes(prefix, "live_bytes", LoadAtomicValue<int64_t>, live),
+          cachedBytes(prefix, "cached_bytes", LoadAtomicValue<int64_t>,
+                      cached),
+          peakLiveBytes(prefix, "peak_live_bytes"),
+          hit(prefix, "hit"),
+          miss(prefix, "miss") {}
+};
+
 struct KVClientManagerMetric {
     static const std::string prefix;
 
@@ -236,6 +236,135 @@ MetaStatusCode MetaServerClientImpl::ListDentry(uint32_t fsId, uint64_t inodeid,
     return ConvertToMetaStatusCode(excutor.DoRPCTask());
 }
 
+namespace {
+
+struct ParseDentryPageCallBack {
+    ParseDentryPageCallBack(std::list<Dentry> *dentryList,
+                            std::map<uint64_t, InodeAttr> *attrs)
+        : dentryList(dentryList), attrs(attrs) {}
+
+    bool operator()(butil::IOBuf *data) const {
+        metaserver::ListDentryPage page;
+        if (!brpc::ParsePbFromIOBuf(&page, *data)) {
+            LOG(ERROR) << "Failed to parse dentry page";
+            return false;
+        }
+
+        for (auto &dentry : *page.mutable_dentrys()) {
+            dentryList->push_back(std::move(dentry));
+        }
+        for (auto &attr : *page.mutable_attrs()) {
+            uint64_t inodeId = attr.inodeid();
+            attrs->emplace(inodeId, std::move(attr));
+        }
+        return true;
+    }
+
+    std::list<Dentry> *dentryList;
+    std::map<uint64_t, InodeAttr> *attrs;
+};
+
+}  // namespace
+
+MetaStatusCode
+MetaServerClientImpl::ListDentryPlus(uint32_t fsId, uint64_t inodeid,
+                                     const std::string &last, uint32_t count,
+                                     std::list<Dentry> *dentryList,
+                                     std::map<uint64_t, InodeAttr> *attrs) {
+    auto task = RPCTask {
+        (void)taskExecutorDone;
+        metric_.listDentry.qps.count << 1;
+        LatencyUpdater updater(&metric_.listDentry.latency);
+        ListDentryRequest request;
+        ListDentryResponse response;
+        request.set_poolid(poolID);
+        request.set_copysetid(copysetID);
+        request.set_partitionid(partitionID);
+        request.set_fsid(fsId);
+        request.set_dirinodeid(inodeid);
+        request.set_txid(txId);
+        request.set_last(last);
+        request.set_count(count);
+        request.set_returninodeattr(true);
+        request.set_streaming(true);
+
+        // the task may be retried, so clear previous received data
+        dentryList->clear();
+        attrs->clear();
+
+        std::shared_ptr<StreamConnection> connection;
+        auto closeConn = absl::MakeCleanup([this, &connection]() {
+            if (connection != nullptr) {
+                streamClient_.Close(connection);
+            }
+        });
+
+        StreamOptions opts(opt_.rpcStreamIdleTimeoutMS);
+        connection = streamClient_.Connect(
+            cntl, ParseDentryPageCallBack{dentryList, attrs}, opts);
+        if (connection == nullptr) {
+            LOG(ERROR) << "Failed to connection remote side, parent: "
+                       << inodeid << ", poolid: " << poolID
+                       << ", copysetid: " << copysetID
+                       << ", remote side: " << cntl->remote_side();
+            return MetaStatusCode::RPC_STREAM_ERROR;
+        }
+
+        curvefs::metaserver::MetaServerService_Stub stub(channel);
+        stub.ListDentry(cntl, &request, &response, nullptr);
+
+        if (cntl->Failed()) {
+            metric_.listDentry.eps.count << 1;
+            LOG(WARNING) << "ListDentryPlus Failed, errorcode = "
+                         << cntl->ErrorCode()
+                         << ", error content:" << cntl->ErrorText()
+                         << ", log id = " << cntl->log_id();
+            return -cntl->ErrorCode();
+        }
+
+        MetaStatusCode ret = response.statuscode();
+        if (ret != MetaStatusCode::OK) {
+            LOG(WARNING) << "ListDentryPlus: fsId = " << fsId
+                         << ", inodeid = " << inodeid << ", last = " << last
+                         << ", count = " << count
+                         << ", errcode = " << ret
+                         << ", errmsg = " << MetaStatusCode_Name(ret);
+            return ret;
+        }
+
+        // metaserver which unsupport streaming return all dentrys
+        // in the response
+        if (!response.streaming()) {
+            for (auto &dentry : *response.mutable_dentrys()) {
+                dentryList->push_back(std::move(dentry));
+            }
+            for (auto &attr : *response.mutable_attrs()) {
+                uint64_t inodeId = attr.inodeid();
+                attrs->emplace(inodeId, std::move(attr));
+            }
+            return ret;
+        }
+
+        auto status = connection->WaitAllDataReceived();
+        if (status != StreamStatus::STREAM_OK) {
+            LOG(ERROR) << "Failed to receive data, status: " << status;
+            return MetaStatusCode::RPC_STREAM_ERROR;
+        }
+
+        VLOG(6) << "ListDentryPlus done, parent: " << inodeid
+                << ", dentry size: " << dentryList->size()
+                << ", attribute size: " << attrs->size();
+        return ret;
+    };
+
+    auto taskCtx = std::make_shared<TaskContext>(MetaServerOpType::ListDentry,
+                                                 task, fsId, inodeid, true,
+                                                 opt_.enableRenameParallel);
+    ListDentryExcutor excutor(opt_, metaCache_, channelManager_,
+                              std::move(taskCtx));
+    return ConvertToMetaStatusCode(excutor.DoRPCTask());
+}
+
 MetaStatusCode MetaServerClientImpl::CreateDentry(const Dentry &dentry) {
     auto task = RPCTask {
         (void)taskExecutorDone;
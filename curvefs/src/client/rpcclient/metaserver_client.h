@@ -101,6 +101,14 @@ class MetaServerClient {
                                       bool onlyDir,
                                       std::list<Dentry> *dentryList) = 0;
 
+    // list at most |count| dentrys after |last| under |inodeid| by stream,
+    // and return attribute of inodes which belong to the same partition
+    // as the directory inline
+    virtual MetaStatusCode ListDentryPlus(
+        uint32_t fsId, uint64_t inodeid, const std::string &last,
+        uint32_t count, std::list<Dentry> *dentryList,
+        std::map<uint64_t, InodeAttr> *attrs) = 0;
+
     virtual MetaStatusCode CreateDentry(const Dentry &dentry) = 0;
 
     virtual MetaStatusCode DeleteDentry(uint32_t fsId, uint64_t inodeid,
@@ -209,6 +217,11 @@ class MetaServerClientImpl : public MetaServerClient {
                               bool onlyDir,
                               std::list<Dentry> *dentryList) override;
 
+    MetaStatusCode ListDentryPlus(
+        uint32_t fsId, uint64_t inodeid, const std::string &last,
+        uint32_t count, std::list<Dentry> *dentryList,
+        std::map<uint64_t, InodeAttr> *attrs) override;
+
     MetaStatusCode CreateDentry(const Dentry &dentry) override;
 
     MetaStatusCode DeleteDentry(uint32_t fsId, uint64_t inodeid,
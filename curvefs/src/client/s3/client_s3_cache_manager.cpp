@@ -31,6 +31,7 @@
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/blocking_counter.h"
+#include "curvefs/src/client/common/buffer_pool.h"
 #include "curvefs/src/client/kvclient/kvclient_manager.h"
 #include "curvefs/src/client/metric/client_metric.h"
 #include "curvefs/src/client/s3/client_s3_adaptor.h"
@@ -52,6 +53,8 @@ DECLARE_bool(enableCto);
 }  // namespace client
 }  // namespace curvefs
 
+using ::curvefs::client::common::BufferPool;
+using ::curvefs::client::common::PooledBuffer;
 using ::curvefs::client::metric::S3MultiManagerMetric;
 static S3MultiManagerMetric *g_s3MultiManagerMetric =
     new S3MultiManagerMetric();
@@ -529,31 +532,32 @@ bool FileCacheManager::ReadKVRequestFromLocalCache(const std::string& name,
     return true;
 }
 
-bool FileCacheManager::ReadKVRequestFromRemoteCache(const std::string &name,
-                                                    char *databuf,
-                                                    uint64_t offset,
-                                                    uint64_t length) {
-    if (!kvClientManager_) {
-        return false;
+void FileCacheManager::ReadKVRequestFromRemoteCache(
+    std::vector<KVGetItem> *items) {
+    if (!kvClientManager_ || items->empty()) {
+        return;
     }
 
     CountDownEvent event(1);
-    GetKVCacheDone cb = [&](const std::shared_ptr<GetKVCacheTask>& task) {
-        if (task->res && s3ClientAdaptor_->s3Metric_ != nullptr) {
-            curve::client::CollectMetrics(
-                &s3ClientAdaptor_->s3Metric_->readFromKVCache, task->length,
-                task->timer.u_elapsed());
+    MGetKVCacheDone cb = [&](const std::shared_ptr<MGetKVCacheTask>& task) {
+        if (s3ClientAdaptor_->s3Metric_ != nullptr) {
+            for (const auto& item : task->items) {
+                if (item.res) {
+                    curve::client::CollectMetrics(
+                        &s3ClientAdaptor_->s3Metric_->readFromKVCache,
+                        item.length, task->timer.u_elapsed());
+                }
+            }
         }
         event.Signal();
         return;
     };
 
-    auto task =
-        std::make_shared<GetKVCacheTask>(name, databuf, offset, length, cb);
-    kvClientManager_->Get(task);
+    auto task = std::make_shared<MGetKVCacheTask>(std::move(*items), cb);
+    kvClientManager_->MGet(task);
     event.Wait();
 
-    return task->res;
+    *items = std::move(task->items);
 }
 
 bool FileCacheManager::ReadKVRequestFromS3(const std::string &name,
@@ -659,6 +663,7 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest &req, char *dataBuf,
     uint64_t currentReadLen = 0;
     uint64_t readBufOffset = 0;
     uint64_t objectOffset = req.objectOffset;
+    std::vector<KVGetItem> missedBlocks;
 
     while (length > 0) {
         currentReadLen =
@@ -669,37 +674,15 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest &req, char *dataBuf,
             objectPrefix);
         char *currentBuf = dataBuf + req.readOffset + readBufOffset;
 
-        // read from localcache -> remotecache -> s3
-        do {
-            if (ReadKVRequestFromLocalCache(name, currentBuf,
-                                            blockPos - objectOffset,
-                                            currentReadLen)) {
-                VLOG(9) << "read " << name << " from local cache ok";
-                break;
-            }
-
-            if (ReadKVRequestFromRemoteCache(name, currentBuf,
-                                             blockPos - objectOffset,
-                                             currentReadLen)) {
-                VLOG(9) << "read " << name << " from remote cache ok";
-                break;
-            }
-
-            int ret = 0;
-            if (ReadKVRequestFromS3(name, currentBuf, blockPos - objectOffset,
-                                    currentReadLen, &ret)) {
-                VLOG(9) << "read " << name << " from s3 ok";
-                break;
-            }
-
-            LOG(ERROR) << "read " << name << " fail";
-            // make sure variable is set only once
-            std::call_once(cancelFlag, [&]() {
-                isCanceled.store(true);
-                retCode.store(ret);
-            });
-            return;
-        } while (false);
+        // read from localcache first, blocks missed are read later
+        if (ReadKVRequestFromLocalCache(name, currentBuf,
+                                        blockPos - objectOffset,
+                                        currentReadLen)) {
+            VLOG(9) << "read " << name << " from local cache ok";
+        } else {
+            missedBlocks.emplace_back(name, currentBuf,
+                                      blockPos - objectOffset, currentReadLen);
+        }
 
         // update param
         {
@@ -711,6 +694,31 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest &req, char *dataBuf,
         }
     }
 
+    // read blocks missed in local cache from remotecache in one batch,
+    // and then from s3
+    ReadKVRequestFromRemoteCache(&missedBlocks);
+    for (const auto& block : missedBlocks) {
+        if (block.res) {
+            VLOG(9) << "read " << block.key << " from remote cache ok";
+            continue;
+        }
+
+        int ret = 0;
+        if (ReadKVRequestFromS3(block.key, block.value, block.offset,
+                                block.length, &ret)) {
+            VLOG(9) << "read " << block.key << " from s3 ok";
+            continue;
+        }
+
+        LOG(ERROR) << "read " << block.key << " fail";
+        // make sure variable is set only once
+        std::call_once(cancelFlag, [&]() {
+            isCanceled.store(true);
+            retCode.store(ret);
+        });
+        return;
+    }
+
     // add data to memory read cache
     if (!curvefs::client::common::FLAGS_enableCto) {
         auto chunkCacheManager = FindOrCreateChunkCacheManager(chunkIndex);
@@ -769,7 +777,7 @@ class AsyncPrefetchCallback {
                     const std::shared_ptr<GetObjectAsyncContext>& context) {
         VLOG(9) << "prefetch end: " << context->key << ", len " << context->len
                 << "actual len: " << context->actualLen << ", " << fromS3_;
-        std::unique_ptr<char[]> guard(context->buf);
+        PooledBuffer guard(context->buf, context->len);
         auto fileCache =
             s3Client_->GetFsCacheManager()->FindFileCacheManager(inode_);
 
@@ -847,7 +855,11 @@ void FileCacheManager::PrefetchS3Objs(
                 << ", from s3: " << fromS3;
         downloadingObj_.emplace(name);
 
-        char* dataCacheS3 = new char[readLen];
+        char* dataCacheS3 = BufferPool::GetInstance().Allocate(readLen);
+        if (dataCacheS3 == nullptr) {
+            downloadingObj_.erase(name);
+            continue;
+        }
         VLOG(9) << "prefetch start: " << name << ", len: " << readLen;
         if (fromS3) {
             auto context = std::make_shared<GetObjectAsyncContext>(
@@ -2376,7 +2388,8 @@ CURVEFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
     // generate flush task
     std::vector<std::shared_ptr<PutObjectAsyncContext>> s3Tasks;
     std::vector<std::shared_ptr<SetKVCacheTask>> kvCacheTasks;
-    char *data = new (std::nothrow) char[len_];
+    PooledBuffer buffer(len_);
+    char *data = buffer.Data();
     if (!data) {
         LOG(ERROR) << "new data failed.";
         return CURVEFS_ERROR::INTERNAL;
@@ -2392,7 +2405,6 @@ CURVEFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
 
     // exec flush task
     FlushTaskExecute(GetCachePolicy(toS3), s3Tasks, kvCacheTasks);
-    delete[] data;
 
     // inode ship to flush
     std::shared_ptr<InodeWrapper> inodeWrapper;
@@ -440,9 +440,9 @@ class FileCacheManager {
     bool ReadKVRequestFromLocalCache(const std::string &name, char *databuf,
                                      uint64_t offset, uint64_t len);
 
-    // read kv request from remote cache like memcached
-    bool ReadKVRequestFromRemoteCache(const std::string &name, char *databuf,
-                                      uint64_t offset, uint64_t length);
+    // read a batch of blocks from remote cache like memcached,
+    // res of every item tells whether it is read successfully
+    void ReadKVRequestFromRemoteCache(std::vector<KVGetItem> *items);
 
     // read kv request from s3
     bool ReadKVRequestFromS3(const std::string &name, char *databuf,
@@ -97,7 +97,12 @@ CURVEFS_ERROR DefaultVolumeStorage::Write(uint64_t ino,
     VLOG(9) << "write ino: " << ino << ", offset: " << offset
             << ", len: " << len << ", block write requests: " << writes;
 
-    ssize_t nr = blockDeviceClient_->Writev(writes);
+    ssize_t nr = 0;
+    if (journal_ != nullptr) {
+        nr = journal_->Append(ino, writes) ? len : -1;
+    } else {
+        nr = blockDeviceClient_->Writev(writes);
+    }
     // TODO(wuhanqing): enable check `nr != len`, currently, backend storage
     // will return larger value if write request is smaller than backend
     // storage's block size
@@ -159,7 +164,8 @@ CURVEFS_ERROR DefaultVolumeStorage::Read(uint64_t ino,
         VLOG(9) << "read ino: " << ino << ", offset: " << offset
             << ", len: " << len << ", block read requests: " << reads;
 
-        ssize_t nr = blockDeviceClient_->Readv(reads);
+        ssize_t nr = journal_ != nullptr ? journal_->Readv(reads)
+                                         : blockDeviceClient_->Readv(reads);
         // TODO(wuhanqing): enable check `(nr+total) != len`, currently, backend
         // storage will return larger value if write request is smaller than
         // backend storage's block size
@@ -198,6 +204,13 @@ CURVEFS_ERROR DefaultVolumeStorage::Flush(uint64_t ino) {
         return ret;
     }
 
+    // extents are marked written before journaled data reaches the volume,
+    // so flush the data before syncing the extents to metaserver
+    if (journal_ != nullptr && !journal_->Flush(ino)) {
+        LOG(ERROR) << "Flush write journal error, ino: " << ino;
+        return CURVEFS_ERROR::IO_ERROR;
+    }
+
     auto lk = inodeWrapper->GetUniqueLock();
     ret = inodeWrapper->Sync();
     LOG_IF(ERROR, ret != CURVEFS_ERROR::OK)
@@ -206,6 +219,10 @@ CURVEFS_ERROR DefaultVolumeStorage::Flush(uint64_t ino) {
 }
 
 bool DefaultVolumeStorage::Shutdown() {
+    if (journal_ != nullptr) {
+        return journal_->Shutdown();
+    }
+
     return true;
 }
 
@@ -29,6 +29,7 @@
 
 #include "curvefs/src/client/volume/metric.h"
 #include "curvefs/src/client/volume/volume_storage.h"
+#include "curvefs/src/client/volume/write_journal.h"
 #include "curvefs/src/volume/block_device_client.h"
 #include "curvefs/src/volume/space_manager.h"
 #include "curvefs/src/client/filesystem/error.h"
@@ -46,15 +47,18 @@ class InodeCacheManager;
 
 // `DefaultVolumeStorage` implements from `VolumeStorage`
 // for write operation, data is written directly to the backend storage,
-// meta-data is cached
+// meta-data is cached, if `journal` is given, data is written into the local
+// journal and flushed to the backend storage in background
 class DefaultVolumeStorage final : public VolumeStorage {
  public:
     DefaultVolumeStorage(SpaceManager* spaceManager,
                          BlockDeviceClient* blockDeviceClient,
-                         InodeCacheManager* inodeCacheManager)
+                         InodeCacheManager* inodeCacheManager,
+                         WriteJournal* journal = nullptr)
         : spaceManager_(spaceManager),
           blockDeviceClient_(blockDeviceClient),
           inodeCacheManager_(inodeCacheManager),
+          journal_(journal),
           metric_("default_volume_storage") {}
 
     DefaultVolumeStorage(const DefaultVolumeStorage&) = delete;
@@ -81,6 +85,7 @@ class DefaultVolumeStorage final : public VolumeStorage {
     SpaceManager* spaceManager_;
     BlockDeviceClient* blockDeviceClient_;
     InodeCacheManager* inodeCacheManager_;
+    WriteJournal* journal_;
     VolumeStorageMetric metric_;
 };
 
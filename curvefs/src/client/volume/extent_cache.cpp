@@ -64,6 +64,11 @@ std::ostream& operator<<(std::ostream& os, const ExtentCacheOption& opt) {
     return os;
 }
 
+// length from |offset| to the end of its slice
+inline uint64_t SliceRemain(uint64_t offset, uint64_t sliceSize) {
+    return sliceSize - (offset & (sliceSize - 1));
+}
+
 }  // namespace
 
 ExtentCacheOption ExtentCache::option_;
@@ -108,8 +113,8 @@ void ExtentCache::DivideForWrite(uint64_t offset,
     const char* datap = data;
 
     while (offset < end) {
-        const auto length = std::min(
-            end - offset, option_.sliceSize - (offset & ~option_.sliceSize));
+        const auto length =
+            std::min(end - offset, SliceRemain(offset, option_.sliceSize));
 
         auto slice = slices_.find(align_down(offset, option_.sliceSize));
         if (slice != slices_.end()) {
@@ -171,7 +176,7 @@ void ExtentCache::MarkWritten(uint64_t offset, uint64_t len) {
 
     while (cur < end) {
         const auto length =
-            std::min(end - cur, option_.sliceSize - (cur & ~option_.sliceSize));
+            std::min(end - cur, SliceRemain(cur, option_.sliceSize));
         auto slice = slices_.find(align_down(cur, option_.sliceSize));
         assert(slice != slices_.end());
         VLOG(9) << "mark written for offset: " << offset << ", len: " << len
@@ -217,8 +222,8 @@ void ExtentCache::DivideForRead(uint64_t offset,
     char* datap = data;
 
     while (offset < end) {
-        const auto length = std::min(
-            end - offset, option_.sliceSize - (offset & ~option_.sliceSize));
+        const auto length =
+            std::min(end - offset, SliceRemain(offset, option_.sliceSize));
 
         auto slice = slices_.find(align_down(offset, option_.sliceSize));
         if (slice != slices_.end()) {
@@ -258,6 +263,7 @@ void ExtentCache::Build(const VolumeExtentSliceList &extents) {
     slices_.clear();
     dirties_.clear();
 
+    slices_.reserve(extents.slices_size());
     for (const auto& s : extents.slices()) {
         slices_.emplace(s.offset(), ExtentSlice{s});
     }
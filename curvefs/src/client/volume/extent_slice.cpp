@@ -44,9 +44,22 @@ ExtentSlice::ExtentSlice(uint64_t offset) : offset_(offset) {}
 ExtentSlice::ExtentSlice(const VolumeExtentSlice& slice) {
     assert(slice.IsInitialized());
     offset_ = slice.offset();
+
+    // extents are usually sorted by offset, so insert them at the end in
+    // amortized constant time, and merge contiguous extents of same state to
+    // keep the map small for fragmented files
+    auto last = extents_.end();
     for (const auto& pext : slice.extents()) {
-        extents_.emplace(
-            pext.fsoffset(),
+        if (last != extents_.end() &&
+            last->second.UnWritten == !pext.isused() &&
+            last->first + last->second.len == pext.fsoffset() &&
+            last->second.pOffset + last->second.len == pext.volumeoffset()) {
+            last->second.len += pext.length();
+            continue;
+        }
+
+        last = extents_.emplace_hint(
+            extents_.end(), pext.fsoffset(),
             PExtent{pext.length(), pext.volumeoffset(), !pext.isused()});
     }
 }
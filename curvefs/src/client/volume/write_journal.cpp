@@ -0,0 +1,610 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-14
+ */
+
+#include "curvefs/src/client/volume/write_journal.h"
+
+#include <fcntl.h>
+#include <glog/logging.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+
+#include "src/common/crc32.h"
+
+namespace curvefs {
+namespace client {
+
+using ::curve::common::ReadLockGuard;
+using ::curve::common::WriteLockGuard;
+
+namespace {
+
+// max bytes of data written to volume in one round of flush
+constexpr uint64_t kFlushBatchBytes = 64ULL * 1024 * 1024;
+
+bool WriteFully(int fd, const char* buf, size_t length) {
+    while (length > 0) {
+        ssize_t n = ::write(fd, buf, length);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        buf += n;
+        length -= n;
+    }
+    return true;
+}
+
+bool ReadFully(int fd, off_t offset, char* buf, size_t length) {
+    while (length > 0) {
+        ssize_t n = ::pread(fd, buf, length, offset);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        offset += n;
+        length -= n;
+    }
+    return true;
+}
+
+uint32_t RecordCrc(const char* header, size_t headerLength,
+                   const char* body, size_t bodyLength) {
+    uint32_t crc = curve::common::CRC32(header, headerLength);
+    return curve::common::CRC32(crc, body, bodyLength);
+}
+
+}  // namespace
+
+WriteJournal::WriteJournal(const VolumeJournalOption& option,
+                           uint32_t fsId,
+                           const std::string& volumeName,
+                           BlockDeviceClient* blockDeviceClient)
+    : option_(option),
+      fsId_(fsId),
+      volumeName_(volumeName),
+      blockDeviceClient_(blockDeviceClient),
+      fd_(-1),
+      headerSize_(sizeof(FileHeader) + volumeName.size()),
+      seq_(0),
+      journalSize_(0),
+      pendingBytes_(0),
+      running_(false) {}
+
+WriteJournal::~WriteJournal() {
+    Shutdown();
+}
+
+bool WriteJournal::Init() {
+    fd_ = ::open(option_.path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC,
+                 0644);
+    if (fd_ < 0) {
+        LOG(ERROR) << "Open write journal failed, path: " << option_.path
+                   << ", error: " << strerror(errno);
+        return false;
+    }
+
+    if (!CheckOrWriteFileHeader()) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    if (!Replay() || !Flush()) {
+        LOG(ERROR) << "Replay write journal failed, path: " << option_.path;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    running_.store(true);
+    sleeper_.init();
+    flushThread_ = std::thread(&WriteJournal::FlushWorker, this);
+
+    LOG(INFO) << "Write journal inited, path: " << option_.path
+              << ", capacity: " << option_.capacity
+              << ", flush interval ms: " << option_.flushIntervalMs;
+    return true;
+}
+
+bool WriteJournal::Shutdown() {
+    if (fd_ < 0) {
+        return true;
+    }
+
+    if (running_.exchange(false)) {
+        sleeper_.interrupt();
+        flushThread_.join();
+    }
+
+    bool ret = Flush();
+    LOG_IF(ERROR, !ret) << "Flush write journal failed when shutdown, "
+                           "journaled data will be replayed at next mount";
+
+    ::close(fd_);
+    fd_ = -1;
+    return ret;
+}
+
+bool WriteJournal::CheckOrWriteFileHeader() {
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        LOG(ERROR) << "Stat write journal failed, path: " << option_.path
+                   << ", error: " << strerror(errno);
+        return false;
+    }
+
+    const uint64_t fileSize = st.st_size;
+    if (fileSize >= headerSize_) {
+        FileHeader header;
+        std::string volumeName(volumeName_.size(), '\0');
+        if (!ReadFully(fd_, 0, reinterpret_cast<char*>(&header),
+                       sizeof(header)) ||
+            header.magic != kFileMagic ||
+            header.volumeNameLength != volumeName_.size() ||
+            !ReadFully(fd_, sizeof(header), &volumeName[0],
+                       volumeName.size()) ||
+            header.fsId != fsId_ || volumeName != volumeName_) {
+            // replaying others' journal corrupts our volume, and dropping
+            // it loses their data, so leave it to the administrator
+            LOG(ERROR) << "Write journal doesn't belong to this filesystem, "
+                       << "path: " << option_.path << ", fsId: " << fsId_
+                       << ", volume: " << volumeName_;
+            return false;
+        }
+        return true;
+    }
+
+    // a new journal, or the header is partially written,
+    // there are no records in both cases
+    std::string header(headerSize_, '\0');
+    FileHeader* fileHeader = reinterpret_cast<FileHeader*>(&header[0]);
+    fileHeader->magic = kFileMagic;
+    fileHeader->fsId = fsId_;
+    fileHeader->volumeNameLength = volumeName_.size();
+    header.replace(sizeof(FileHeader), volumeName_.size(), volumeName_);
+    if (::ftruncate(fd_, 0) != 0 ||
+        !WriteFully(fd_, header.data(), header.size()) ||
+        ::fdatasync(fd_) != 0) {
+        LOG(ERROR) << "Write journal file header failed, path: "
+                   << option_.path << ", error: " << strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+bool WriteJournal::Replay() {
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        LOG(ERROR) << "Stat write journal failed, path: " << option_.path
+                   << ", error: " << strerror(errno);
+        return false;
+    }
+
+    const uint64_t fileSize = st.st_size;
+    journalSize_.store(fileSize - headerSize_, std::memory_order_relaxed);
+    off_t offset = headerSize_;
+    uint64_t records = 0;
+    RecordHeader header;
+    std::string body;
+
+    while (ReadFully(fd_, offset, reinterpret_cast<char*>(&header),
+                     sizeof(header))) {
+        const uint64_t remain = fileSize - offset - sizeof(header);
+        if (header.magic != kRecordMagic ||
+            header.dataLength > remain ||
+            header.count * sizeof(RecordPart) > remain - header.dataLength) {
+            break;
+        }
+
+        body.resize(header.count * sizeof(RecordPart) + header.dataLength);
+        const uint32_t crc = header.crc;
+        header.crc = 0;
+        if (!ReadFully(fd_, offset + sizeof(header), &body[0], body.size()) ||
+            RecordCrc(reinterpret_cast<const char*>(&header), sizeof(header),
+                      body.data(), body.size()) != crc) {
+            break;
+        }
+
+        // records are replayed in order, so newer data overwrites older data
+        const auto* parts = reinterpret_cast<const RecordPart*>(body.data());
+        const char* data = body.data() + header.count * sizeof(RecordPart);
+        uint64_t seq = ++seq_;
+        {
+            WriteLockGuard lk(pendingLock_);
+            if (header.type == kRecordDiscard) {
+                DiscardPendingLocked(header.ino);
+            }
+            for (uint32_t i = 0; i < header.count; ++i) {
+                InsertPendingLocked(parts[i].offset, data, parts[i].length,
+                                    header.ino, seq);
+                data += parts[i].length;
+            }
+        }
+
+        offset += sizeof(header) + body.size();
+        ++records;
+
+        if (GetPendingBytes() >= kFlushBatchBytes && !FlushPending()) {
+            return false;
+        }
+    }
+
+    // the journal is truncated after replayed data is flushed, so an
+    // incomplete record at the tail is dropped here
+    LOG(INFO) << "Replay write journal, records: " << records
+              << ", valid bytes: " << offset - headerSize_;
+    return FlushPending();
+}
+
+bool WriteJournal::Append(uint64_t ino, const std::vector<WritePart>& writes) {
+    if (GetJournalSize() >= option_.capacity) {
+        // block new writes until all journaled data is flushed
+        std::lock_guard<std::mutex> flushLk(flushMtx_);
+        std::lock_guard<std::mutex> lk(journalMtx_);
+        if (GetJournalSize() >= option_.capacity &&
+            (!FlushPending() || !ResetJournalLocked())) {
+            LOG(ERROR) << "Flush full write journal failed";
+            return false;
+        }
+    }
+
+    RecordHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kRecordMagic;
+    header.type = kRecordWrite;
+    header.ino = ino;
+    header.count = writes.size();
+    for (const auto& write : writes) {
+        header.dataLength += write.length;
+    }
+
+    std::string record;
+    record.reserve(sizeof(header) + writes.size() * sizeof(RecordPart) +
+                   header.dataLength);
+    record.append(sizeof(header), '\0');
+    for (const auto& write : writes) {
+        RecordPart part{static_cast<uint64_t>(write.offset), write.length};
+        record.append(reinterpret_cast<const char*>(&part), sizeof(part));
+    }
+    for (const auto& write : writes) {
+        record.append(write.data, write.length);
+    }
+    memcpy(&record[0], &header, sizeof(header));
+
+    std::lock_guard<std::mutex> lk(journalMtx_);
+    uint64_t seq;
+    if (!AppendRecordLocked(&record, &seq)) {
+        return false;
+    }
+
+    WriteLockGuard pendingLk(pendingLock_);
+    for (const auto& write : writes) {
+        InsertPendingLocked(write.offset, write.data, write.length, ino, seq);
+    }
+
+    return true;
+}
+
+bool WriteJournal::Discard(uint64_t ino) {
+    {
+        ReadLockGuard lk(pendingLock_);
+        if (inodePending_.count(ino) == 0) {
+            return true;
+        }
+    }
+
+    // the discard record is journaled, so the dropped data isn't replayed
+    RecordHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kRecordMagic;
+    header.type = kRecordDiscard;
+    header.ino = ino;
+    std::string record(reinterpret_cast<const char*>(&header),
+                       sizeof(header));
+
+    std::lock_guard<std::mutex> lk(journalMtx_);
+    uint64_t seq;
+    if (!AppendRecordLocked(&record, &seq)) {
+        return false;
+    }
+
+    WriteLockGuard pendingLk(pendingLock_);
+    DiscardPendingLocked(ino);
+    return true;
+}
+
+bool WriteJournal::AppendRecordLocked(std::string* record, uint64_t* seq) {
+    auto* header = reinterpret_cast<RecordHeader*>(&(*record)[0]);
+    header->crc = 0;
+    header->crc = RecordCrc(record->data(), sizeof(RecordHeader),
+                            record->data() + sizeof(RecordHeader),
+                            record->size() - sizeof(RecordHeader));
+
+    if (!WriteFully(fd_, record->data(), record->size()) ||
+        ::fdatasync(fd_) != 0) {
+        LOG(ERROR) << "Write journal failed, path: " << option_.path
+                   << ", error: " << strerror(errno);
+        // drop the partial record, otherwise records appended after it
+        // can't be replayed
+        int rc = ::ftruncate(fd_, headerSize_ + GetJournalSize());
+        LOG_IF(ERROR, rc != 0) << "Truncate write journal failed, error: "
+                               << strerror(errno);
+        return false;
+    }
+
+    journalSize_.fetch_add(record->size(), std::memory_order_relaxed);
+    *seq = ++seq_;
+    return true;
+}
+
+void WriteJournal::InsertPendingLocked(off_t offset,
+                                       const char* data,
+                                       size_t length,
+                                       uint64_t ino,
+                                       uint64_t seq) {
+    const off_t end = offset + length;
+
+    // trim the write that starts before |offset|
+    auto iter = pending_.lower_bound(offset);
+    if (iter != pending_.begin()) {
+        auto prev = std::prev(iter);
+        const off_t prevEnd = prev->first + prev->second.data.size();
+        if (prevEnd > offset) {
+            if (prevEnd > end) {
+                AddPendingLocked(
+                    end, PendingWrite{
+                             prev->second.data.substr(end - prev->first),
+                             prev->second.ino, prev->second.seq});
+            }
+            pendingBytes_.fetch_sub(prevEnd - offset,
+                                    std::memory_order_relaxed);
+            prev->second.data.resize(offset - prev->first);
+        }
+    }
+
+    // remove or trim the writes that start in [offset, end)
+    iter = pending_.lower_bound(offset);
+    while (iter != pending_.end() && iter->first < end) {
+        const off_t curEnd = iter->first + iter->second.data.size();
+        if (curEnd > end) {
+            PendingWrite tail{iter->second.data.substr(end - iter->first),
+                              iter->second.ino, iter->second.seq};
+            ErasePendingLocked(iter);
+            AddPendingLocked(end, std::move(tail));
+            break;
+        }
+
+        iter = ErasePendingLocked(iter);
+    }
+
+    AddPendingLocked(offset,
+                     PendingWrite{std::string(data, length), ino, seq});
+}
+
+void WriteJournal::DiscardPendingLocked(uint64_t ino) {
+    if (inodePending_.count(ino) == 0) {
+        return;
+    }
+
+    for (auto iter = pending_.begin(); iter != pending_.end();) {
+        if (iter->second.ino == ino) {
+            iter = ErasePendingLocked(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void WriteJournal::AddPendingLocked(off_t offset, PendingWrite write) {
+    pendingBytes_.fetch_add(write.data.size(), std::memory_order_relaxed);
+    ++inodePending_[write.ino];
+    pending_.emplace(offset, std::move(write));
+}
+
+std::map<off_t, WriteJournal::PendingWrite>::iterator
+WriteJournal::ErasePendingLocked(
+    std::map<off_t, PendingWrite>::iterator iter) {
+    pendingBytes_.fetch_sub(iter->second.data.size(),
+                            std::memory_order_relaxed);
+    auto inode = inodePending_.find(iter->second.ino);
+    if (--inode->second == 0) {
+        inodePending_.erase(inode);
+    }
+    return pending_.erase(iter);
+}
+
+ssize_t WriteJournal::Readv(const std::vector<ReadPart>& reads) {
+    // copy the journaled data before reading volume, so journaled data
+    // flushed during reading volume is still overlaid, and appends and
+    // flushes aren't blocked by the volume read
+    std::vector<Overlay> overlays;
+    {
+        ReadLockGuard lk(pendingLock_);
+        if (!pending_.empty()) {
+            for (const auto& read : reads) {
+                CopyPendingLocked(read, &overlays);
+            }
+        }
+    }
+
+    ssize_t nr = blockDeviceClient_->Readv(reads);
+    if (nr < 0) {
+        return nr;
+    }
+
+    for (const auto& overlay : overlays) {
+        memcpy(overlay.dest, overlay.data.data(), overlay.data.size());
+    }
+
+    return nr;
+}
+
+void WriteJournal::CopyPendingLocked(const ReadPart& read,
+                                     std::vector<Overlay>* overlays) const {
+    const off_t end = read.offset + read.length;
+    auto iter = pending_.upper_bound(read.offset);
+    if (iter != pending_.begin()) {
+        --iter;
+    }
+
+    for (; iter != pending_.end() && iter->first < end; ++iter) {
+        const off_t start = std::max<off_t>(iter->first, read.offset);
+        const off_t stop = std::min<off_t>(
+            iter->first + iter->second.data.size(), end);
+        if (start >= stop) {
+            continue;
+        }
+
+        overlays->push_back(Overlay{
+            read.data + (start - read.offset),
+            iter->second.data.substr(start - iter->first, stop - start)});
+    }
+}
+
+bool WriteJournal::Flush() {
+    std::lock_guard<std::mutex> flushLk(flushMtx_);
+    if (!FlushPending()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lk(journalMtx_);
+    return ResetJournalLocked();
+}
+
+bool WriteJournal::Flush(uint64_t ino) {
+    {
+        ReadLockGuard lk(pendingLock_);
+        if (inodePending_.count(ino) == 0) {
+            return true;
+        }
+    }
+
+    std::lock_guard<std::mutex> flushLk(flushMtx_);
+    return FlushPending(ino);
+}
+
+bool WriteJournal::FlushPending(uint64_t ino) {
+    struct FlushedWrite {
+        off_t offset;
+        size_t length;
+        uint64_t seq;
+    };
+
+    off_t cursor = 0;
+    while (true) {
+        // adjacent journaled writes are merged into one volume write
+        std::vector<FlushedWrite> flushed;
+        std::vector<std::string> buffers;
+        std::vector<off_t> offsets;
+        uint64_t bytes = 0;
+        {
+            ReadLockGuard lk(pendingLock_);
+            off_t lastEnd = -1;
+            for (auto iter = pending_.lower_bound(cursor);
+                 iter != pending_.end() && bytes < kFlushBatchBytes; ++iter) {
+                const auto& write = iter->second;
+                if (ino != kAllInodes && write.ino != ino) {
+                    continue;
+                }
+                if (iter->first != lastEnd) {
+                    buffers.emplace_back();
+                    offsets.push_back(iter->first);
+                }
+                buffers.back().append(write.data);
+                lastEnd = iter->first + write.data.size();
+                bytes += write.data.size();
+                flushed.push_back({iter->first, write.data.size(), write.seq});
+            }
+            if (!flushed.empty()) {
+                cursor = lastEnd;
+            }
+        }
+
+        if (flushed.empty()) {
+            return true;
+        }
+
+        std::vector<WritePart> writes;
+        writes.reserve(buffers.size());
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            writes.emplace_back(offsets[i], buffers[i].size(),
+                                buffers[i].data());
+        }
+
+        ssize_t nr = blockDeviceClient_->Writev(writes);
+        if (nr < 0) {
+            LOG(ERROR) << "Flush write journal to volume failed, bytes: "
+                       << bytes;
+            return false;
+        }
+
+        // a write modified during flushing is kept, it's flushed next round
+        WriteLockGuard lk(pendingLock_);
+        for (const auto& write : flushed) {
+            auto iter = pending_.find(write.offset);
+            if (iter != pending_.end() && iter->second.seq == write.seq &&
+                iter->second.data.size() == write.length) {
+                ErasePendingLocked(iter);
+            }
+        }
+    }
+}
+
+bool WriteJournal::ResetJournalLocked() {
+    {
+        ReadLockGuard lk(pendingLock_);
+        if (!pending_.empty()) {
+            return true;
+        }
+    }
+
+    if (GetJournalSize() == 0) {
+        return true;
+    }
+
+    if (::ftruncate(fd_, headerSize_) != 0 || ::fdatasync(fd_) != 0) {
+        LOG(ERROR) << "Truncate write journal failed, path: " << option_.path
+                   << ", error: " << strerror(errno);
+        return false;
+    }
+
+    journalSize_.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+void WriteJournal::FlushWorker() {
+    while (sleeper_.wait_for(
+        std::chrono::milliseconds(option_.flushIntervalMs))) {
+        LOG_IF(WARNING, !Flush()) << "Flush write journal failed, retry later";
+    }
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -0,0 +1,218 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-14
+ */
+
+#ifndef CURVEFS_SRC_CLIENT_VOLUME_WRITE_JOURNAL_H_
+#define CURVEFS_SRC_CLIENT_VOLUME_WRITE_JOURNAL_H_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "curvefs/src/client/common/config.h"
+#include "curvefs/src/volume/block_device_client.h"
+#include "curvefs/src/volume/common.h"
+#include "src/common/concurrent/rw_lock.h"
+#include "src/common/interruptible_sleeper.h"
+
+namespace curvefs {
+namespace client {
+
+using ::curvefs::client::common::VolumeJournalOption;
+using ::curvefs::volume::BlockDeviceClient;
+using ::curvefs::volume::ReadPart;
+using ::curvefs::volume::WritePart;
+
+// `WriteJournal` persists volume writes into a local journal file, so a write
+// can be acknowledged once its journal record is durable. Journaled data is
+// kept in memory until a background thread flushes it to the volume, where
+// adjacent writes are merged into large writes. Reads of the volume go through
+// the journal to see the data that is not flushed yet.
+//
+// Journal records that are not flushed when the client crashes are replayed
+// to the volume by `Init` at next mount, only if the journal belongs to the
+// same filesystem and volume.
+//
+// Journal file layout:
+//   | FileHeader | volume name | record * n |
+// Journal record layout:
+//   | RecordHeader | RecordPart * count | data of all parts |
+class WriteJournal {
+ public:
+    WriteJournal(const VolumeJournalOption& option,
+                 uint32_t fsId,
+                 const std::string& volumeName,
+                 BlockDeviceClient* blockDeviceClient);
+
+    ~WriteJournal();
+
+    WriteJournal(const WriteJournal&) = delete;
+    WriteJournal& operator=(const WriteJournal&) = delete;
+
+    // Open journal file, replay records left by last run and start the
+    // background flush thread
+    bool Init();
+
+    // Flush all journaled data and stop the background flush thread
+    bool Shutdown();
+
+    // Persist |writes| of inode |ino| into journal, they are readable after
+    // return
+    bool Append(uint64_t ino, const std::vector<WritePart>& writes);
+
+    // Read from volume and overlay the journaled data that is not flushed
+    ssize_t Readv(const std::vector<ReadPart>& reads);
+
+    // Flush all journaled data to volume and reset the journal file
+    bool Flush();
+
+    // Flush journaled data of inode |ino| to volume
+    bool Flush(uint64_t ino);
+
+    // Drop journaled data of inode |ino| that is not flushed, e.g. the inode
+    // is truncated to zero
+    bool Discard(uint64_t ino);
+
+    uint64_t GetPendingBytes() const {
+        return pendingBytes_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetJournalSize() const {
+        return journalSize_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t fsId;
+        uint32_t volumeNameLength;
+        uint32_t padding;
+    };
+
+    enum RecordType : uint32_t {
+        kRecordWrite = 0,
+        // drop the journaled data of the inode, it has no parts and data
+        kRecordDiscard = 1,
+    };
+
+    struct RecordHeader {
+        uint32_t magic;
+        uint32_t type;
+        uint64_t ino;
+        uint64_t dataLength;
+        uint32_t count;
+        uint32_t crc;  // crc of the record with this field as 0
+    };
+
+    struct RecordPart {
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    struct PendingWrite {
+        std::string data;
+        uint64_t ino;
+        uint64_t seq;
+    };
+
+    // journaled data copied out for overlaying a read
+    struct Overlay {
+        char* dest;
+        std::string data;
+    };
+
+    static constexpr uint32_t kFileMagic = 0x4a524e48;    // "JRNH"
+    static constexpr uint32_t kRecordMagic = 0x4a524e4c;  // "JRNL"
+    // flush journaled data of all inodes
+    static constexpr uint64_t kAllInodes = 0;
+
+    // Write file header to a new journal, or check the journal belongs to
+    // this filesystem and volume
+    bool CheckOrWriteFileHeader();
+
+    bool Replay();
+
+    // Append |record| to journal file and assign it a seq,
+    // journalMtx_ must be held
+    bool AppendRecordLocked(std::string* record, uint64_t* seq);
+
+    // Write journaled data of |ino| to volume, a write modified during
+    // flushing is kept in pending_
+    bool FlushPending(uint64_t ino = kAllInodes);
+
+    // Truncate journal file if all journaled data is flushed,
+    // journalMtx_ must be held
+    bool ResetJournalLocked();
+
+    void FlushWorker();
+
+    // Insert a journaled write into pending_, the overlapped part of
+    // older writes is trimmed
+    void InsertPendingLocked(off_t offset, const char* data, size_t length,
+                             uint64_t ino, uint64_t seq);
+
+    void DiscardPendingLocked(uint64_t ino);
+
+    void AddPendingLocked(off_t offset, PendingWrite write);
+
+    std::map<off_t, PendingWrite>::iterator ErasePendingLocked(
+        std::map<off_t, PendingWrite>::iterator iter);
+
+    void CopyPendingLocked(const ReadPart& read,
+                           std::vector<Overlay>* overlays) const;
+
+ private:
+    const VolumeJournalOption option_;
+    const uint32_t fsId_;
+    const std::string volumeName_;
+    BlockDeviceClient* blockDeviceClient_;
+
+    int fd_;
+    // size of file header and volume name, records start from here
+    const uint64_t headerSize_;
+
+    // protect journal file and seq_
+    std::mutex journalMtx_;
+    uint64_t seq_;
+    std::atomic<uint64_t> journalSize_;
+
+    // journaled data not flushed yet, ranges in it don't overlap
+    mutable curve::common::RWLock pendingLock_;
+    std::map<off_t, PendingWrite> pending_;
+    std::atomic<uint64_t> pendingBytes_;
+    // number of writes in pending_ of each inode
+    std::unordered_map<uint64_t, uint64_t> inodePending_;
+
+    // serialize flushes
+    std::mutex flushMtx_;
+
+    std::atomic<bool> running_;
+    std::thread flushThread_;
+    curve::common::InterruptibleSleeper sleeper_;
+};
+
+}  // namespace client
+}  // namespace curvefs
+
+#endif  // CURVEFS_SRC_CLIENT_VOLUME_WRITE_JOURNAL_H_
@@ -36,6 +36,7 @@
 #include <unordered_map>
 #include <utility>
 
+#include "curvefs/src/client/common/buffer_pool.h"
 #include "curvefs/src/client/common/common.h"
 #include "curvefs/src/client/inode_wrapper.h"
 #include "curvefs/src/client/kvclient/kvclient_manager.h"
@@ -50,6 +51,8 @@ namespace client {
 namespace warmup {
 
 using curve::common::WriteLockGuard;
+using curvefs::client::common::BufferPool;
+using curvefs::client::common::PooledBuffer;
 
 #define WARMUP_CHECKINTERVAL_US (1000 * 1000)
 
@@ -168,6 +171,8 @@ bool WarmupManagerS3Impl::CancelWarmupDependentQueue(fuse_ino_t key) {
 
 void WarmupManagerS3Impl::UnInit() {
     bgFetchStop_.store(true, std::memory_order_release);
+    // let warmup tasks blocked by throttle go
+    throttle_.Stop();
     if (initbgFetchThread_) {
         bgFetchThread_.join();
     }
@@ -195,6 +200,14 @@ void WarmupManagerS3Impl::UnInit() {
 
 void WarmupManagerS3Impl::Init(const FuseClientOption& option) {
     WarmupManager::Init(option);
+    if (option.warmupBpsLimitMB != 0 || option.warmupIopsLimit != 0) {
+        curve::common::ReadWriteThrottleParams params;
+        params.bpsTotal.limit = option.warmupBpsLimitMB * 1024 * 1024;
+        params.iopsTotal.limit = option.warmupIopsLimit;
+        throttle_.UpdateThrottleParams(params);
+        LOG(INFO) << "warmup throttle, bps limit: " << option.warmupBpsLimitMB
+                  << "MB, iops limit: " << option.warmupIopsLimit;
+    }
     bgFetchStop_.store(false, std::memory_order_release);
     bgFetchThread_ = Thread(&WarmupManagerS3Impl::BackGroundFetch, this);
     initbgFetchThread_ = true;
@@ -532,12 +545,15 @@ void WarmupManagerS3Impl::WarmUpAllObjs(
             (void)adapter;
             if (bgFetchStop_.load(std::memory_order_acquire)) {
                 VLOG(9) << "need stop warmup";
+                RemoveDownloadingObj(context->key, false);
+                BufferPool::GetInstance().Free(context->buf, context->len);
                 cond.Signal();
                 return;
             }
             if (context->retCode >= 0) {
                 VLOG(9) << "Get Object success: " << context->key;
                 PutObjectToCache(key, context);
+                RemoveDownloadingObj(context->key, true);
                 curve::client::CollectMetrics(&warmupS3Metric_.warmupS3Cached,
                                               context->len,
                                               butil::cpuwide_time_us() - start);
@@ -556,7 +572,8 @@ void WarmupManagerS3Impl::WarmUpAllObjs(
                 }
                 VLOG(9) << "Up to max retry times, "
                         << "download object failed, key: " << context->key;
-                delete[] context->buf;
+                RemoveDownloadingObj(context->key, false);
+                BufferPool::GetInstance().Free(context->buf, context->len);
                 return;
             }
 
@@ -564,6 +581,12 @@ void WarmupManagerS3Impl::WarmUpAllObjs(
                          << ", offset: " << context->offset;
             s3Adaptor_->GetS3Client()->DownloadAsync(context);
         };
+    // the download of an object by another warmup task is over
+    auto waitDone = [&]() {
+        if (pendingReq.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+            cond.Signal();
+        }
+    };
 
     pendingReq.fetch_add(prefetchObjs.size(), std::memory_order_seq_cst);
     if (pendingReq.load(std::memory_order_seq_cst)) {
@@ -585,9 +608,22 @@ void WarmupManagerS3Impl::WarmUpAllObjs(
                     pendingReq.fetch_sub(1);
                     continue;
                 }
+                if (!AddDownloadingObj(name, key, waitDone)) {
+                    // being downloaded by another warmup task, it's counted
+                    // as finished when that download finishes, and this
+                    // task is not over until then
+                    continue;
+                }
+            }
+            char* cacheS3 = BufferPool::GetInstance().Allocate(readLen);
+            if (cacheS3 == nullptr) {
+                LOG(ERROR) << "allocate buffer failed, key: " << name
+                           << ", len: " << readLen;
+                RemoveDownloadingObj(name, false);
+                pendingReq.fetch_sub(1);
+                continue;
             }
-            char* cacheS3 = new char[readLen];
-            memset(cacheS3, 0, readLen);
+            throttle_.Add(true, readLen);
             auto context = std::make_shared<GetObjectAsyncContext>(
                 name, cacheS3, 0, readLen, cb);
             context->retry = 0;
@@ -764,6 +800,8 @@ void WarmupManagerS3Impl::AddFetchS3objectsTask(fuse_ino_t key,
 
 void WarmupManagerS3Impl::PutObjectToCache(
     fuse_ino_t key, const std::shared_ptr<GetObjectAsyncContext>& context) {
+    // the buffer is returned to pool when all holders are released
+    auto buffer = std::make_shared<PooledBuffer>(context->buf, context->len);
     ReadLockGuard lock(inode2ProgressMutex_);
     auto iter = FindWarmupProgressByKeyLocked(key);
     if (iter == inode2Progress_.end()) {
@@ -781,16 +819,13 @@ void WarmupManagerS3Impl::PutObjectToCache(
                 LOG_EVERY_SECOND(INFO)
                     << "write read directly failed, key: " << context->key;
             }
-            delete[] context->buf;
             break;
         case curvefs::client::common::WarmupStorageType::
             kWarmupStorageTypeKvClient:
             if (kvClientManager_ != nullptr) {
                 kvClientManager_->Set(std::make_shared<SetKVCacheTask>(
                     context->key, context->buf, context->len,
-                    [context](const std::shared_ptr<SetKVCacheTask>&) {
-                        delete[] context->buf;
-                    }));
+                    [buffer](const std::shared_ptr<SetKVCacheTask>&) {}));
             }
             break;
         default:
@@ -798,6 +833,47 @@ void WarmupManagerS3Impl::PutObjectToCache(
     }
 }
 
+bool WarmupManagerS3Impl::AddDownloadingObj(const std::string& name,
+                                            fuse_ino_t key,
+                                            std::function<void()> done) {
+    std::lock_guard<std::mutex> lock(downloadingObjsMutex_);
+    auto ret = downloadingObjs_.emplace(name, std::vector<DownloadWaiter>());
+    if (!ret.second) {
+        ret.first->second.push_back(DownloadWaiter{key, std::move(done)});
+    }
+    return ret.second;
+}
+
+void WarmupManagerS3Impl::RemoveDownloadingObj(const std::string& name,
+                                               bool success) {
+    std::vector<DownloadWaiter> waiters;
+    {
+        std::lock_guard<std::mutex> lock(downloadingObjsMutex_);
+        auto iter = downloadingObjs_.find(name);
+        if (iter == downloadingObjs_.end()) {
+            return;
+        }
+        waiters.swap(iter->second);
+        downloadingObjs_.erase(iter);
+    }
+
+    if (success) {
+        ReadLockGuard lock(inode2ProgressMutex_);
+        for (const auto& waiter : waiters) {
+            auto iter = FindWarmupProgressByKeyLocked(waiter.key);
+            if (iter != inode2Progress_.end()) {
+                iter->second.FinishedPlusOne();
+            }
+        }
+    }
+
+    for (const auto& waiter : waiters) {
+        if (waiter.done) {
+            waiter.done();
+        }
+    }
+}
+
 bool WarmupManagerS3Impl::GetInodeSubPathParent(
     fuse_ino_t inode, const std::vector<std::string>& subPath, fuse_ino_t* ret,
     std::string* lastPath, uint32_t* symlink_depth) {
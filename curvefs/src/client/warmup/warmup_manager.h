@@ -51,6 +51,7 @@
 #include "curvefs/src/common/task_thread_pool.h"
 #include "src/common/concurrent/concurrent.h"
 #include "src/common/concurrent/rw_lock.h"
+#include "src/common/throttle.h"
 
 namespace curvefs {
 namespace client {
@@ -515,6 +516,25 @@ class WarmupManagerS3Impl : public WarmupManager {
     void PutObjectToCache(
         fuse_ino_t key, const std::shared_ptr<GetObjectAsyncContext>& context);
 
+    /**
+     * @brief Mark the object is being downloaded by warmup task[key]
+     *
+     * @param done called when the download by another warmup task is over,
+     *        if warmup task[key] has to wait for it
+     * @return false the object is being downloaded by another warmup task,
+     *         warmup task[key] waits for that download
+     */
+    bool AddDownloadingObj(const std::string& name, fuse_ino_t key,
+                           std::function<void()> done);
+
+    /**
+     * @brief The download of the object is over
+     *
+     * @param success whether the object is downloaded, if so, it's counted
+     *        as finished for the warmup tasks waiting for it
+     */
+    void RemoveDownloadingObj(const std::string& name, bool success);
+
  protected:
     std::deque<WarmupFilelist> warmupFilelistDeque_;
     mutable RWLock warmupFilelistDequeMutex_;
@@ -539,6 +559,21 @@ class WarmupManagerS3Impl : public WarmupManager {
         inode2FetchS3ObjectsPool_;
     mutable RWLock inode2FetchS3ObjectsPoolMutex_;
 
+    // warmup task waiting for an object downloaded by another warmup task
+    struct DownloadWaiter {
+        fuse_ino_t key;
+        std::function<void()> done;
+    };
+
+    // objects being downloaded by all warmup tasks,
+    // and the other warmup tasks waiting for them
+    std::unordered_map<std::string, std::vector<DownloadWaiter>>
+        downloadingObjs_;
+    std::mutex downloadingObjsMutex_;
+
+    // limit s3 bandwidth used by warmup, so it doesn't hurt user io
+    curve::common::Throttle throttle_;
+
     curvefs::client::metric::WarmupManagerS3Metric warmupS3Metric_;
 };
 
@@ -24,11 +24,12 @@
 #include "curvefs/src/metaserver/copyset/concurrent_apply_queue.h"
 
 #include <algorithm>
+#include <mutex>
 
 namespace curvefs {
 namespace metaserver {
 namespace copyset {
-bool ApplyQueue::Init(const ApplyOption &opt) {
+bool ApplyQueue::Init(const ApplyOption &opt, const std::string& name) {
     if (start_) {
         LOG(WARNING) << "concurrent module already start!";
         return true;
@@ -38,6 +39,10 @@ bool ApplyQueue::Init(const ApplyOption &opt) {
         return false;
     }
 
+    if (!name.empty()) {
+        metric_.Expose(name);
+    }
+
     start_ = true;
     cond_.Reset(opt.rconcurrentsize + opt.wconcurrentsize);
     InitThreadPool(ThreadPoolType::READ, rconcurrentsize_, rqueuedepth_);
@@ -68,6 +73,12 @@ bool ApplyQueue::CheckOptAndInit(const ApplyOption &opt) {
     rconcurrentsize_ = opt.rconcurrentsize;
     rqueuedepth_ = opt.rqueuedepth;
 
+    std::lock_guard<bthread::Mutex> lk(dispatchMtx_);
+    rdispatcher_.keys.clear();
+    rdispatcher_.pending.assign(rconcurrentsize_, 0);
+    wdispatcher_.keys.clear();
+    wdispatcher_.pending.assign(wconcurrentsize_, 0);
+
     return true;
 }
 
@@ -180,6 +191,61 @@ void ApplyQueue::FlushAll() {
     event.Wait();
 }
 
+int ApplyQueue::Dispatch(ThreadPoolType type, uint64_t key) {
+    std::lock_guard<bthread::Mutex> lk(dispatchMtx_);
+    Dispatcher* dispatcher = GetDispatcher(type);
+    auto iter = dispatcher->keys.find(key);
+    if (iter == dispatcher->keys.end()) {
+        auto& pending = dispatcher->pending;
+        int index = std::min_element(pending.begin(), pending.end()) -
+                    pending.begin();
+        iter = dispatcher->keys.emplace(key, KeyState{index, 0}).first;
+    }
+
+    iter->second.inflight++;
+    dispatcher->pending[iter->second.index]++;
+    if (type == ThreadPoolType::READ) {
+        metric_.rqueueDepth << 1;
+    } else {
+        metric_.wqueueDepth << 1;
+    }
+
+    return iter->second.index;
+}
+
+void ApplyQueue::OnTaskStart(ThreadPoolType type, uint64_t enqueueUs) {
+    uint64_t waitUs =
+        curve::common::TimeUtility::GetTimeofDayUs() - enqueueUs;
+    if (type == ThreadPoolType::READ) {
+        metric_.rwaitLatency << waitUs;
+    } else {
+        metric_.wwaitLatency << waitUs;
+    }
+}
+
+void ApplyQueue::OnTaskDone(ThreadPoolType type, uint64_t key, int index) {
+    std::lock_guard<bthread::Mutex> lk(dispatchMtx_);
+    Dispatcher* dispatcher = GetDispatcher(type);
+    auto iter = dispatcher->keys.find(key);
+    if (iter != dispatcher->keys.end() && --iter->second.inflight == 0) {
+        dispatcher->keys.erase(iter);
+    }
+
+    dispatcher->pending[index]--;
+    if (type == ThreadPoolType::READ) {
+        metric_.rqueueDepth << -1;
+    } else {
+        metric_.wqueueDepth << -1;
+    }
+}
+
+void ApplyQueue::Metric::Expose(const std::string& prefix) {
+    rqueueDepth.expose_as(prefix, "read_queue_depth");
+    wqueueDepth.expose_as(prefix, "write_queue_depth");
+    rwaitLatency.expose(prefix, "read_wait_latency");
+    wwaitLatency.expose(prefix, "write_wait_latency");
+}
+
 ThreadPoolType ApplyQueue::Schedule(OperatorType optype) {
     switch (optype) {
     case OperatorType::GetDentry:
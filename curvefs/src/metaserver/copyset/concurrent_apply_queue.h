@@ -25,16 +25,22 @@
 
 #include <bthread/condition_variable.h>
 #include <bthread/mutex.h>
+#include <bvar/bvar.h>
 #include <glog/logging.h>
 
 #include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
 #include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "include/curve_compiler_specific.h"
 #include "src/common/concurrent/count_down_event.h"
 #include "src/common/concurrent/task_queue.h"
+#include "src/common/timeutility.h"
 #include "curvefs/src/metaserver/copyset/operator_type.h"
 
 namespace curvefs {
@@ -82,29 +88,30 @@ class CURVE_CACHELINE_ALIGNMENT ApplyQueue {
      * @param[in] wqueuedepth: depth of write queue in ervery thread
      * @param[in] rconcurrentsizee: num of read threads
      * @param[in] wqueuedephth: depth of read queue in every thread
+     * @param[in] name: prefix of exposed metrics, empty means not expose
      */
-    bool Init(const ApplyOption &opt);
+    bool Init(const ApplyOption &opt, const std::string& name = "");
 
     /**
      * Push: apply task will be push to ApplyQueue
-     * @param[in] key: used to hash task to specified queue
+     * @param[in] key: tasks with same key are executed in order
      * @param[in] optype: operation type defined in proto
      * @param[in] f: task
      * @param[in] args: param to excute task
      */
     template <class F, class... Args>
     bool Push(uint64_t key, OperatorType optype, F&& f, Args&&... args) {
-        switch (Schedule(optype)) {
-            case ThreadPoolType::READ:
-                rapplyMap_[Hash(key, rconcurrentsize_)]->tq.Push(
-                        std::forward<F>(f), std::forward<Args>(args)...);
-                break;
-            case ThreadPoolType::WRITE:
-                wapplyMap_[Hash(key, wconcurrentsize_)]->tq.Push(
-                        std::forward<F>(f), std::forward<Args>(args)...);
-                break;
-        }
-
+        ThreadPoolType type = Schedule(optype);
+        int index = Dispatch(type, key);
+        auto task = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+        uint64_t enqueueUs = curve::common::TimeUtility::GetTimeofDayUs();
+        auto wrapper = [this, type, key, index, task, enqueueUs]() mutable {
+            OnTaskStart(type, enqueueUs);
+            task();
+            OnTaskDone(type, key, index);
+        };
+
+        GetTaskThread(type, index)->tq.Push(std::move(wrapper));
         return true;
     }
 
@@ -125,9 +132,16 @@ class CURVE_CACHELINE_ALIGNMENT ApplyQueue {
 
     void InitThreadPool(ThreadPoolType type, int concorrent, int depth);
 
-    static int Hash(uint64_t key, int concurrent) {
-        return key % concurrent;
-    }
+    // Dispatch a task of |key| to a thread of pool |type|.
+    // Tasks with the same key (partition) must be applied in order, so while
+    // a key still has inflight tasks, its new task follows them to the same
+    // thread; otherwise the least loaded thread is chosen, which avoids
+    // several busy partitions being stacked on one thread by hash collision.
+    int Dispatch(ThreadPoolType type, uint64_t key);
+
+    void OnTaskStart(ThreadPoolType type, uint64_t enqueueUs);
+
+    void OnTaskDone(ThreadPoolType type, uint64_t key, int index);
 
  private:
     struct TaskThread {
@@ -136,12 +150,46 @@ class CURVE_CACHELINE_ALIGNMENT ApplyQueue {
         explicit TaskThread(size_t capacity) : tq(capacity) {}
     };
 
+    TaskThread* GetTaskThread(ThreadPoolType type, int index) {
+        return type == ThreadPoolType::READ ? rapplyMap_[index]
+                                            : wapplyMap_[index];
+    }
+
+    struct KeyState {
+        int index;
+        uint64_t inflight;
+    };
+
+    struct Dispatcher {
+        // key -> thread index and number of its tasks not done yet
+        std::unordered_map<uint64_t, KeyState> keys;
+        // number of tasks dispatched to every thread but not done yet
+        std::vector<uint64_t> pending;
+    };
+
+    struct Metric {
+        bvar::Adder<int64_t> rqueueDepth;
+        bvar::Adder<int64_t> wqueueDepth;
+        bvar::LatencyRecorder rwaitLatency;
+        bvar::LatencyRecorder wwaitLatency;
+
+        void Expose(const std::string& prefix);
+    };
+
+    Dispatcher* GetDispatcher(ThreadPoolType type) {
+        return type == ThreadPoolType::READ ? &rdispatcher_ : &wdispatcher_;
+    }
+
     std::atomic<bool> start_;
     int rconcurrentsize_;
     int rqueuedepth_;
     int wconcurrentsize_;
     int wqueuedepth_;
     CountDownEvent cond_;
+    bthread::Mutex dispatchMtx_;
+    Dispatcher rdispatcher_;
+    Dispatcher wdispatcher_;
+    Metric metric_;
     CURVE_CACHELINE_ALIGNMENT std::unordered_map<int, TaskThread*> wapplyMap_;
     CURVE_CACHELINE_ALIGNMENT std::unordered_map<int, TaskThread*> rapplyMap_;
 };
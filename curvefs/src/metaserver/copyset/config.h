@@ -25,6 +25,8 @@
 
 #include <braft/raft.h>
 #include <braft/snapshot_throttle.h>
+#include <bthread/condition_variable.h>
+#include <bthread/mutex.h>
 #include <gflags/gflags.h>
 
 #include <cstdint>
@@ -34,12 +36,16 @@
 #include "curvefs/src/metaserver/copyset/concurrent_apply_queue.h"
 #include "curvefs/src/metaserver/copyset/trash.h"
 #include "curvefs/src/metaserver/storage/config.h"
+#include "src/common/concurrent/task_thread_pool.h"
 #include "src/fs/local_filesystem.h"
 
 namespace curvefs {
 namespace metaserver {
 namespace copyset {
 
+using ReadPool = curve::common::TaskThreadPool<bthread::Mutex,
+                                               bthread::ConditionVariable>;
+
 // Options for copyset node and relative modules
 struct CopysetNodeOptions {
     // copyset's data uri
@@ -82,6 +88,17 @@ struct CopysetNodeOptions {
     // apply queue options
     ApplyOption applyQueueOption;
 
+    // number of threads and queue depth of read pool, which is shared by all
+    // copysets and executes lease reads directly instead of pushing them into
+    // apply queue, so reads don't compete with writes for apply workers
+    // 0 threads means disable read pool
+    // Default: 0 threads, 4096 queue depth
+    uint32_t readPoolWorkerCount;
+    uint32_t readPoolQueueDepth;
+
+    // read pool created by copyset node manager
+    ReadPool* readPool;
+
     // filesystem adaptor
     curve::fs::LocalFileSystem* localFileSystem;
 
@@ -104,6 +121,9 @@ inline CopysetNodeOptions::CopysetNodeOptions()
       finishLoadMargin(2000),
       checkLoadMarginIntervalMs(1000),
       applyQueueOption(),
+      readPoolWorkerCount(0),
+      readPoolQueueDepth(4096),
+      readPool(nullptr),
       localFileSystem(nullptr),
       trashOptions(),
       raftNodeOptions() {}
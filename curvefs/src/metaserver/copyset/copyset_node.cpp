@@ -25,6 +25,7 @@
 #include <braft/protobuf_file.h>
 #include <braft/util.h>
 #include <brpc/channel.h>
+#include <bthread/bthread.h>
 #include <glog/logging.h>
 
 #include <functional>
@@ -88,6 +89,7 @@ CopysetNode::CopysetNode(PoolId poolId, CopysetId copysetId,
       appliedIndex_(0),
       epochFile_(),
       applyQueue_(nullptr),
+      inflightReads_(0),
       latestLoadSnapshotIndex_(0),
       confChangeMtx_(),
       ongoingConfChange_(),
@@ -128,7 +130,10 @@ bool CopysetNode::Init(const CopysetNodeOptions& options) {
 
     // init apply queue
     applyQueue_ = absl::make_unique<ApplyQueue>();
-    if (!applyQueue_->Init(options_.applyQueueOption)) {
+    std::string applyQueueName = "apply_queue_pool_" +
+                                 std::to_string(poolId_) + "_copyset_" +
+                                 std::to_string(copysetId_);
+    if (!applyQueue_->Init(options_.applyQueueOption, applyQueueName)) {
         LOG(ERROR) << "init concurrent apply queue failed";
         return false;
     }
@@ -186,6 +191,10 @@ void CopysetNode::Stop() {
         applyQueue_->Stop();
     }
 
+    while (inflightReads_.load(std::memory_order_acquire) != 0) {
+        bthread_usleep(1000);
+    }
+
     if (metaStore_) {
         LOG_IF(ERROR, metaStore_->Destroy() != true)
             << "Failed to clear metastore, copyset: " << name_;
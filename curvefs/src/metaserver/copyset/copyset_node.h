@@ -133,6 +133,14 @@ class CopysetNode : public braft::StateMachine {
 
     ApplyQueue* GetApplyQueue() const;
 
+    // return nullptr if read pool is disabled
+    ReadPool* GetReadPool() const;
+
+    // track reads of current copyset which are executing in read pool,
+    // because read pool is shared, they must be waited before stop
+    void IncInflightRead();
+    void DecInflightRead();
+
     OperatorMetric* GetMetric() const;
 
     const std::string& Name() const;
@@ -264,6 +272,8 @@ class CopysetNode : public braft::StateMachine {
 
     std::unique_ptr<ApplyQueue> applyQueue_;
 
+    std::atomic<uint64_t> inflightReads_;
+
     mutable Mutex confMtx_;
 
     int64_t latestLoadSnapshotIndex_;
@@ -328,6 +338,18 @@ inline ApplyQueue* CopysetNode::GetApplyQueue() const {
     return applyQueue_.get();
 }
 
+inline ReadPool* CopysetNode::GetReadPool() const {
+    return options_.readPool;
+}
+
+inline void CopysetNode::IncInflightRead() {
+    inflightReads_.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void CopysetNode::DecInflightRead() {
+    inflightReads_.fetch_sub(1, std::memory_order_release);
+}
+
 inline OperatorMetric* CopysetNode::GetMetric() const {
     return metric_.get();
 }
@@ -27,6 +27,7 @@
 #include <string>
 #include <utility>
 
+#include "absl/memory/memory.h"
 #include "curvefs/src/metaserver/copyset/copyset_reloader.h"
 #include "curvefs/src/metaserver/copyset/raft_cli_service2.h"
 #include "curvefs/src/metaserver/copyset/utils.h"
@@ -88,6 +89,10 @@ bool CopysetNodeManager::DeleteCopysetNodeInternal(PoolId poolId,
 
 bool CopysetNodeManager::Init(const CopysetNodeOptions& options) {
     options_ = options;
+    if (options_.readPoolWorkerCount > 0) {
+        readPool_ = absl::make_unique<ReadPool>();
+        options_.readPool = readPool_.get();
+    }
     return trash_.Init(options_.trashOptions, options_.localFileSystem);
 }
 
@@ -101,6 +106,13 @@ bool CopysetNodeManager::Start() {
         return false;
     }
 
+    if (readPool_ != nullptr &&
+        readPool_->Start(options_.readPoolWorkerCount,
+                         options_.readPoolQueueDepth) != 0) {
+        LOG(ERROR) << "Start read pool failed";
+        return false;
+    }
+
     CopysetReloader reloader(this);
     bool ret = reloader.Init(options_) && reloader.ReloadCopysets();
     if (ret) {
@@ -129,6 +141,10 @@ bool CopysetNodeManager::Stop() {
         }
     }
 
+    if (readPool_ != nullptr) {
+        readPool_->Stop();
+    }
+
     {
         WriteLockGuard lock(lock_);
         copysets_.clear();
@@ -102,6 +102,8 @@ class CopysetNodeManager {
 
     CopysetNodeOptions options_;
 
+    std::unique_ptr<ReadPool> readPool_;
+
     std::atomic<bool> running_;
 
     // whether copyset is loaded finished, manager will reject create copyset
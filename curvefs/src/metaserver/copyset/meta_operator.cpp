@@ -24,6 +24,7 @@
 
 #include <brpc/closure_guard.h>
 #include <brpc/controller.h>
+#include <gflags/gflags.h>
 
 #include <algorithm>
 #include <memory>
@@ -40,6 +41,13 @@
 static bvar::LatencyRecorder
     g_concurrent_fast_apply_wait_latency("concurrent_fast_apply_wait");
 
+DEFINE_uint32(list_dentry_stream_page_size, 1024,
+              "number of dentrys in one page when listing dentry by stream");
+
+DEFINE_bool(enable_follower_read, false,
+            "whether serve read request on follower if its applied index is "
+            "not less than the applied index carried by request");
+
 
 namespace curvefs {
 namespace metaserver {
@@ -60,6 +68,16 @@ void MetaOperator::Propose() {
 
     // check if current node is leader
     if (!IsLeaderTerm()) {
+        // follower read: current node has applied all logs the client has
+        // seen, so it won't return older data than the client already read
+        if (FLAGS_enable_follower_read && CanBypassPropose() &&
+            RequestAppliedIndex() != 0 &&
+            node_->GetAppliedIndex() >= RequestAppliedIndex()) {
+            FastApplyTask();
+            doneGuard.release();
+            return;
+        }
+
         RedirectRequest();
         return;
     }
@@ -123,14 +141,29 @@ void MetaOperator::FastApplyTask() {
     auto task =
         std::bind(&MetaOperator::OnApply, this, node_->GetAppliedIndex(),
                   new MetaOperatorClosure(this), TimeUtility::GetTimeofDayUs());
-    node_->GetApplyQueue()->Push(HashCode(), GetOperatorType(),
-                                 std::move(task));
+    auto* readPool = node_->GetReadPool();
+    if (readPool != nullptr) {
+        // readonly operator doesn't need to be ordered with other operators,
+        // so execute it in read pool directly to bypass apply queue
+        auto* node = node_;
+        node->IncInflightRead();
+        readPool->Enqueue([node, task]() {
+            task();
+            node->DecInflightRead();
+        });
+    } else {
+        node_->GetApplyQueue()->Push(HashCode(), GetOperatorType(),
+                                     std::move(task));
+    }
     timer.stop();
     g_concurrent_fast_apply_wait_latency << timer.u_elapsed();
 }
 
-#define OPERATOR_CAN_BY_PASS_PROPOSE(TYPE) \
-    bool TYPE##Operator::CanBypassPropose() const { return true; }
+#define OPERATOR_CAN_BY_PASS_PROPOSE(TYPE)                                  \
+    bool TYPE##Operator::CanBypassPropose() const { return true; }          \
+    uint64_t TYPE##Operator::RequestAppliedIndex() const {                  \
+        return static_cast<const TYPE##Request*>(request_)->appliedindex(); \
+    }
 
 // below operator are readonly, so can enable lease read
 OPERATOR_CAN_BY_PASS_PROPOSE(GetDentry);
@@ -170,7 +203,6 @@ OPERATOR_CAN_BY_PASS_PROPOSE(GetVolumeExtent);
     }
 
 OPERATOR_ON_APPLY(GetDentry);
-OPERATOR_ON_APPLY(ListDentry);
 OPERATOR_ON_APPLY(CreateDentry);
 OPERATOR_ON_APPLY(DeleteDentry);
 OPERATOR_ON_APPLY(GetInode);
@@ -290,6 +322,65 @@ void GetVolumeExtentOperator::OnApply(int64_t index,
     }
 }
 
+void ListDentryOperator::OnApply(int64_t index,
+                                 google::protobuf::Closure *done,
+                                 uint64_t startTimeUs) {
+    brpc::ClosureGuard doneGuard(done);
+    const auto *request = static_cast<const ListDentryRequest *>(request_);
+    auto *response = static_cast<ListDentryResponse *>(response_);
+    auto *metaStore = node_->GetMetaStore();
+
+    uint64_t timeUs = TimeUtility::GetTimeofDayUs();
+    node_->GetMetric()->WaitInQueueLatency(OperatorType::ListDentry,
+                                           timeUs - startTimeUs);
+    auto st = metaStore->ListDentry(request, response, index);
+    node_->GetMetric()->ExecuteLatency(OperatorType::ListDentry,
+                                       TimeUtility::GetTimeofDayUs() - timeUs);
+    node_->GetMetric()->OnOperatorComplete(
+        OperatorType::ListDentry, TimeUtility::GetTimeofDayUs() - startTimeUs,
+        st == MetaStatusCode::OK);
+
+    if (st != MetaStatusCode::OK) {
+        return;
+    }
+
+    node_->UpdateAppliedIndex(index);
+    response->set_appliedindex(
+        std::max<uint64_t>(index, node_->GetAppliedIndex()));
+    if (!request->streaming()) {
+        return;
+    }
+
+    // in streaming mode, swap dentrys and attributes out and
+    // send them by streaming
+    google::protobuf::RepeatedPtrField<Dentry> dentrys;
+    google::protobuf::RepeatedPtrField<InodeAttr> attrs;
+    response->mutable_dentrys()->Swap(&dentrys);
+    response->mutable_attrs()->Swap(&attrs);
+
+    // accept client's streaming request
+    auto *cntl = static_cast<brpc::Controller *>(cntl_);
+    auto streamingServer = metaStore->GetStreamServer();
+    auto connection = streamingServer->Accept(cntl);
+    if (connection == nullptr) {
+        LOG(ERROR) << "Accept streaming connection failed";
+        response->set_statuscode(MetaStatusCode::RPC_STREAM_ERROR);
+        return;
+    }
+
+    // run done
+    response->set_streaming(true);
+    done->Run();
+    doneGuard.release();
+
+    // send dentrys page by page
+    st = StreamingSendDentry(connection.get(), dentrys, attrs,
+                             FLAGS_list_dentry_stream_page_size);
+    if (st != MetaStatusCode::OK) {
+        LOG(ERROR) << "Send dentrys by stream failed";
+    }
+}
+
 #define OPERATOR_ON_APPLY_FROM_LOG(TYPE)                                       \
     void TYPE##Operator::OnApplyFromLog(int64_t index, uint64_t startTimeUs) { \
         std::unique_ptr<TYPE##Operator> selfGuard(this);                       \
@@ -134,6 +134,12 @@ class MetaOperator {
      */
     virtual bool CanBypassPropose() const { return false; }
 
+    /**
+     * @brief Applied index carried by a readonly request, which is the
+     *        minimum applied index a follower must reach to serve it
+     */
+    virtual uint64_t RequestAppliedIndex() const { return 0; }
+
  protected:
     CopysetNode* node_;
 
@@ -175,6 +181,8 @@ class GetDentryOperator : public MetaOperator {
     void OnFailed(MetaStatusCode code) override;
 
     bool CanBypassPropose() const override;
+
+    uint64_t RequestAppliedIndex() const override;
 };
 
 class ListDentryOperator : public MetaOperator {
@@ -196,6 +204,8 @@ class ListDentryOperator : public MetaOperator {
     void OnFailed(MetaStatusCode code) override;
 
     bool CanBypassPropose() const override;
+
+    uint64_t RequestAppliedIndex() const override;
 };
 
 class CreateDentryOperator : public MetaOperator {
@@ -255,6 +265,8 @@ class GetInodeOperator : public MetaOperator {
     void OnFailed(MetaStatusCode code) override;
 
     bool CanBypassPropose() const override;
+
+    uint64_t RequestAppliedIndex() const override;
 };
 
 class BatchGetInodeAttrOperator : public MetaOperator {
@@ -276,6 +288,8 @@ class BatchGetInodeAttrOperator : public MetaOperator {
     void OnFailed(MetaStatusCode code) override;
 
     bool CanBypassPropose() const override;
+
+    uint64_t RequestAppliedIndex() const override;
 };
 
 class BatchGetXAttrOperator : public MetaOperator {
@@ -297,6 +311,8 @@ class BatchGetXAttrOperator : public MetaOperator {
     void OnFailed(MetaStatusCode code) override;
 
     bool CanBypassPropose() const override;
+
+    uint64_t RequestAppliedIndex() const override;
 };
 
 class CreateInodeOperator : public MetaOperator {
@@ -508,6 +524,8 @@ class GetVolumeExtentOperator : public MetaOperator {
     void OnFailed(MetaStatusCode code) override;
 
     bool CanBypassPropose() const override;
+
+    uint64_t RequestAppliedIndex() const override;
 };
 
 class UpdateVolumeExtentOperator : public MetaOperator {
@@ -22,6 +22,7 @@
 
 #include "curvefs/src/metaserver/inode_storage.h"
 
+#include <gflags/gflags.h>
 #include <google/protobuf/empty.pb.h>
 
 #include <algorithm>
@@ -29,6 +30,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "curvefs/proto/common.pb.h"
@@ -40,6 +42,14 @@
 #include "src/common/concurrent/rw_lock.h"
 #include "src/common/string_util.h"
 
+DEFINE_uint32(s3chunkinfo_list_merge_threshold, 32,
+              "merge all s3chunkinfo lists of one chunk index into one list "
+              "when the number of lists reaches this threshold, "
+              "0 means never merge");
+DEFINE_uint32(s3chunkinfo_list_merge_max_size, 4096,
+              "the maximum number of s3chunkinfo in a merged list, "
+              "lists which already reach this size are never merged");
+
 namespace curvefs {
 namespace metaserver {
 
@@ -612,7 +622,8 @@ MetaStatusCode InodeStorage::AddS3ChunkInfoList(
 
 MetaStatusCode InodeStorage::DelS3ChunkInfoList(
     Transaction txn, uint32_t fsId, uint64_t inodeId, uint64_t chunkIndex,
-    const S3ChunkInfoList* list2del) {
+    const S3ChunkInfoList* list2del, uint64_t* size4del) {
+    *size4del = 0;
     if (nullptr == list2del || list2del->s3chunks_size() == 0) {
         return MetaStatusCode::OK;
     }
@@ -632,6 +643,8 @@ MetaStatusCode InodeStorage::DelS3ChunkInfoList(
 
     Key4S3ChunkInfoList key;
     std::vector<std::string> key2del;
+    std::vector<S3ChunkInfoList> lists2keep;
+    S3ChunkInfoList list;
     for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
         std::string skey = iterator->Key();
         if (!StringStartWith(skey, sprefix)) {
@@ -640,28 +653,199 @@ MetaStatusCode InodeStorage::DelS3ChunkInfoList(
             return MetaStatusCode::PARSE_FROM_STRING_FAILED;
         }
 
-        // current list range:    [  ]
-        // delete list range :  [      ]
-        if (delFirstChunkId <= key.firstChunkId &&
-            delLastChunkId >= key.lastChunkId) {
-            key2del.push_back(skey);
-            // current list range:       [  ]
-            // delete list range :  [  ]
-        } else if (delLastChunkId < key.firstChunkId) {
+        // current list range:       [  ]     or  [  ]
+        // delete list range :  [  ]                  [  ]
+        if (delLastChunkId < key.firstChunkId ||
+            delFirstChunkId > key.lastChunkId) {
             continue;
+            // current list range:    [  ]
+            // delete list range :  [      ]
+        } else if (delFirstChunkId <= key.firstChunkId &&
+                   delLastChunkId >= key.lastChunkId) {
+            key2del.push_back(skey);
+            *size4del += key.size;
+            // current list range:   [      ]  or  [      ]  or  [      ]
+            // delete list range :  [   ]            [  ]            [     ]
         } else {
-            LOG(ERROR) << "wrong delete list range (" << delFirstChunkId << ","
-                       << delLastChunkId << "), skey=" << skey;
+            // the list was merged with lists appended after s3compact took
+            // its snapshot, only drop the s3chunkinfo in delete range
+            if (!iterator->ParseFromValue(&list)) {
+                return MetaStatusCode::PARSE_FROM_STRING_FAILED;
+            }
+            S3ChunkInfoList remain;
+            for (const auto& info : list.s3chunks()) {
+                if (info.chunkid() < delFirstChunkId ||
+                    info.chunkid() > delLastChunkId) {
+                    *remain.add_s3chunks() = info;
+                }
+            }
+            key2del.push_back(skey);
+            *size4del += list.s3chunks_size() - remain.s3chunks_size();
+            if (remain.s3chunks_size() != 0) {
+                lists2keep.push_back(std::move(remain));
+            }
+        }
+    }
+
+    for (const auto& skey : key2del) {
+        if (!txn->SDel(table4S3ChunkInfo_, skey).ok()) {
+            LOG(ERROR) << "Delete key failed, skey=" << skey;
             return MetaStatusCode::STORAGE_INTERNAL_ERROR;
         }
     }
 
+    for (const auto& remain : lists2keep) {
+        auto rc = SetS3ChunkInfoList(txn, fsId, inodeId, chunkIndex, remain);
+        if (rc != MetaStatusCode::OK) {
+            return rc;
+        }
+    }
+    return MetaStatusCode::OK;
+}
+
+MetaStatusCode InodeStorage::SetS3ChunkInfoList(Transaction txn,
+                                                uint32_t fsId,
+                                                uint64_t inodeId,
+                                                uint64_t chunkIndex,
+                                                const S3ChunkInfoList& list) {
+    uint64_t firstChunkId = std::numeric_limits<uint64_t>::max();
+    uint64_t lastChunkId = 0;
+    for (const auto& info : list.s3chunks()) {
+        firstChunkId = std::min(firstChunkId, info.chunkid());
+        lastChunkId = std::max(lastChunkId, info.chunkid());
+    }
+
+    Key4S3ChunkInfoList key(fsId, inodeId, chunkIndex, firstChunkId,
+                            lastChunkId, list.s3chunks_size());
+    std::string skey = conv_.SerializeToString(key);
+    if (!txn->SSet(table4S3ChunkInfo_, skey, list).ok()) {
+        LOG(ERROR) << "Set s3chunkinfo list failed, skey=" << skey;
+        return MetaStatusCode::STORAGE_INTERNAL_ERROR;
+    }
+    return MetaStatusCode::OK;
+}
+
+MetaStatusCode InodeStorage::MergeS3ChunkInfoList(Transaction txn,
+                                                  uint32_t fsId,
+                                                  uint64_t inodeId,
+                                                  uint64_t chunkIndex,
+                                                  uint64_t* size4del) {
+    *size4del = 0;
+    uint32_t threshold = FLAGS_s3chunkinfo_list_merge_threshold;
+    uint64_t maxSize = FLAGS_s3chunkinfo_list_merge_max_size;
+    if (threshold == 0) {
+        return MetaStatusCode::OK;
+    }
+
+    Prefix4ChunkIndexS3ChunkInfoList prefix(fsId, inodeId, chunkIndex);
+    std::string sprefix = conv_.SerializeToString(prefix);
+    auto iterator = txn->SSeek(table4S3ChunkInfo_, sprefix);
+    if (iterator->Status() != 0) {
+        LOG(ERROR) << "Get iterator failed, prefix=" << sprefix;
+        return MetaStatusCode::STORAGE_INTERNAL_ERROR;
+    }
+
+    // lists are iterated in key order, which is also the order of writing,
+    // the later s3chunkinfo covers the former one when they are overlapped,
+    // so only adjacent lists can be merged. find the first run of adjacent
+    // lists whose total size fits in `maxSize` by the keys, and only
+    // decode the lists when the run reaches the threshold
+    std::vector<std::string> key2del;
+    uint64_t runSize = 0;
+    Key4S3ChunkInfoList key;
+    for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
+        std::string skey = iterator->Key();
+        if (!StringStartWith(skey, sprefix)) {
+            break;
+        } else if (!conv_.ParseFromString(skey, &key)) {
+            return MetaStatusCode::PARSE_FROM_STRING_FAILED;
+        }
+
+        if (runSize + key.size > maxSize) {
+            if (key2del.size() >= threshold) {
+                break;
+            }
+            key2del.clear();
+            runSize = 0;
+            if (key.size >= maxSize) {
+                continue;
+            }
+        }
+        key2del.push_back(skey);
+        runSize += key.size;
+    }
+
+    if (key2del.size() < 2 || key2del.size() < threshold) {
+        return MetaStatusCode::OK;
+    }
+
+    S3ChunkInfoList list;
+    S3ChunkInfoList all;
+    for (const auto& skey : key2del) {
+        if (!txn->SGet(table4S3ChunkInfo_, skey, &list).ok()) {
+            LOG(ERROR) << "Get s3chunkinfo list failed, skey=" << skey;
+            return MetaStatusCode::STORAGE_INTERNAL_ERROR;
+        }
+        all.mutable_s3chunks()->MergeFrom(list.s3chunks());
+    }
+
+    // only metadata is merged here, so we can only drop the s3chunkinfo
+    // which doesn't refer any object that not referred by others:
+    //  1) duplicate s3chunkinfo (e.g. retried append), keep the last one
+    //  2) zero s3chunkinfo which is fully covered by a later one
+    // objects of the overlapped s3chunkinfo are left to s3compact
+    using ChunkInfoTuple =
+        std::tuple<uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, bool>;
+    std::set<ChunkInfoTuple> seen;
+    std::vector<const S3ChunkInfo*> kept;
+    kept.reserve(all.s3chunks_size());
+    for (int i = all.s3chunks_size() - 1; i >= 0; i--) {
+        const S3ChunkInfo& info = all.s3chunks(i);
+        ChunkInfoTuple tuple(info.chunkid(), info.compaction(), info.offset(),
+                             info.len(), info.size(), info.zero());
+        if (!seen.insert(tuple).second) {
+            continue;
+        }
+
+        if (info.zero()) {
+            bool covered = false;
+            for (const auto* later : kept) {
+                if (later->offset() <= info.offset() &&
+                    later->offset() + later->len() >=
+                        info.offset() + info.len()) {
+                    covered = true;
+                    break;
+                }
+            }
+            if (covered) {
+                continue;
+            }
+        }
+        kept.push_back(&info);
+    }
+
+    S3ChunkInfoList merged;
+    for (auto iter = kept.rbegin(); iter != kept.rend(); ++iter) {
+        *merged.add_s3chunks() = **iter;
+    }
+
     for (const auto& skey : key2del) {
         if (!txn->SDel(table4S3ChunkInfo_, skey).ok()) {
             LOG(ERROR) << "Delete key failed, skey=" << skey;
             return MetaStatusCode::STORAGE_INTERNAL_ERROR;
         }
     }
+
+    auto rc = SetS3ChunkInfoList(txn, fsId, inodeId, chunkIndex, merged);
+    if (rc != MetaStatusCode::OK) {
+        return rc;
+    }
+
+    *size4del = all.s3chunks_size() - merged.s3chunks_size();
+    VLOG(6) << "Merge " << key2del.size() << " s3chunkinfo lists into one, "
+            << "fsId = " << fsId << ", inodeId = " << inodeId
+            << ", chunkIndex = " << chunkIndex
+            << ", dropped s3chunkinfo = " << *size4del;
     return MetaStatusCode::OK;
 }
 
@@ -678,18 +862,27 @@ MetaStatusCode InodeStorage::ModifyInodeS3ChunkInfoList(
     }
     WriteLockGuard lg(rwLock_);
     std::string step;
-    auto rc = DelS3ChunkInfoList(*txn, fsId, inodeId, chunkIndex, list2del);
+    uint64_t size4del = 0;
+    auto rc = DelS3ChunkInfoList(*txn, fsId, inodeId, chunkIndex, list2del,
+                                 &size4del);
     step = "del s3 chunkinfo list ";
     if (rc == MetaStatusCode::OK) {
         rc = AddS3ChunkInfoList(*txn, fsId, inodeId, chunkIndex, list2add);
         step = "add s3 chunkInfo list ";
     }
 
+    uint64_t size4merge = 0;
+    if (rc == MetaStatusCode::OK && nullptr != list2add &&
+        list2add->s3chunks_size() != 0) {
+        rc = MergeS3ChunkInfoList(*txn, fsId, inodeId, chunkIndex,
+                                  &size4merge);
+        step = "merge s3 chunkInfo list ";
+    }
+
     if (rc == MetaStatusCode::OK) {
         uint64_t size4add =
             (nullptr == list2add) ? 0 : list2add->s3chunks_size();
-        uint64_t size4del =
-            (nullptr == list2del) ? 0 : list2del->s3chunks_size();
+        size4del += size4merge;
         // TODO(huyao): I don't think this place is idempotent. If the timeout
         // is retried, the size will increase.
         rc = UpdateInodeS3MetaSize(*txn, fsId, inodeId, size4add, size4del);
@@ -194,14 +194,32 @@ class InodeStorage {
 
     uint64_t GetInodeS3MetaSize(uint32_t fsId, uint64_t inodeId);
 
+    // delete the s3chunkinfo in range of |list2del|, a list partially
+    // overlapped with the range is kept with the rest s3chunkinfo,
+    // `size4del` returns the number of s3chunkinfo been deleted
     MetaStatusCode DelS3ChunkInfoList(Transaction txn, uint32_t fsId,
                                       uint64_t inodeId, uint64_t chunkIndex,
-                                      const S3ChunkInfoList* list2del);
+                                      const S3ChunkInfoList* list2del,
+                                      uint64_t* size4del);
 
     MetaStatusCode AddS3ChunkInfoList(Transaction txn, uint32_t fsId,
                                       uint64_t inodeId, uint64_t chunkIndex,
                                       const S3ChunkInfoList* list2add);
 
+    // set |list| with a key ranged by its min and max chunk id
+    MetaStatusCode SetS3ChunkInfoList(Transaction txn, uint32_t fsId,
+                                      uint64_t inodeId, uint64_t chunkIndex,
+                                      const S3ChunkInfoList& list);
+
+    // merge adjacent s3chunkinfo lists of one chunk index into a single list
+    // once the number of them reaches `s3chunkinfo_list_merge_threshold`,
+    // a merged list holds at most `s3chunkinfo_list_merge_max_size`
+    // s3chunkinfo, `size4del` returns the number of redundant s3chunkinfo
+    // been dropped
+    MetaStatusCode MergeS3ChunkInfoList(Transaction txn, uint32_t fsId,
+                                        uint64_t inodeId, uint64_t chunkIndex,
+                                        uint64_t* size4del);
+
     MetaStatusCode Increase(Transaction txn, uint32_t fsId,
                             const IncreaseDeallocatableBlockGroup& increase,
                             DeallocatableBlockGroup* out);
@@ -703,6 +703,16 @@ void Metaserver::InitCopysetNodeOptions() {
                 &copysetNodeOptions_.applyQueueOption.rconcurrentsize));
     LOG_IF(FATAL, !conf_->GetIntValue("applyqueue.read_queue_depth",
                 &copysetNodeOptions_.applyQueueOption.rqueuedepth));
+    ret = conf_->GetUInt32Value("readpool.worker_count",
+                &copysetNodeOptions_.readPoolWorkerCount);
+    LOG_IF(WARNING, ret == false)
+        << "config no readpool.worker_count info, using default value "
+        << copysetNodeOptions_.readPoolWorkerCount;
+    ret = conf_->GetUInt32Value("readpool.queue_depth",
+                &copysetNodeOptions_.readPoolQueueDepth);
+    LOG_IF(WARNING, ret == false)
+        << "config no readpool.queue_depth info, using default value "
+        << copysetNodeOptions_.readPoolQueueDepth;
     LOG_IF(FATAL, !conf_->GetStringValue("copyset.trash.uri",
                 &copysetNodeOptions_.trashOptions.trashUri));
     LOG_IF(FATAL, !conf_->GetUInt32Value("copyset.trash.expired_aftersec",
@@ -469,10 +469,36 @@ MetaStatusCode MetaStoreImpl::ListDentry(const ListDentryRequest* request,
     response->set_statuscode(rc);
     if (rc == MetaStatusCode::OK && !dentrys.empty()) {
         *response->mutable_dentrys() = {dentrys.begin(), dentrys.end()};
+        if (request->returninodeattr()) {
+            PaddingInodeAttr(partition, fsId, dentrys, response);
+        }
     }
     return rc;
 }
 
+void MetaStoreImpl::PaddingInodeAttr(
+    const std::shared_ptr<Partition>& partition, uint32_t fsId,
+    const std::vector<Dentry>& dentrys, ListDentryResponse* response) {
+    // NOTE: attributes are padded in the order of dentrys, so the sender
+    // can split dentrys and attributes into the same pages
+    for (const auto& dentry : dentrys) {
+        if (!partition->IsInodeBelongs(fsId, dentry.inodeid())) {
+            continue;
+        }
+
+        InodeAttr attr;
+        auto rc = partition->GetInodeAttr(fsId, dentry.inodeid(), &attr);
+        if (rc != MetaStatusCode::OK) {
+            // client will fetch it by BatchGetInodeAttr
+            VLOG(3) << "Padding inode attribute failed, fsId = " << fsId
+                    << ", inodeId = " << dentry.inodeid()
+                    << ", retCode = " << MetaStatusCode_Name(rc);
+            continue;
+        }
+        *response->add_attrs() = std::move(attr);
+    }
+}
+
 MetaStatusCode MetaStoreImpl::PrepareRenameTx(
     const PrepareRenameTxRequest* request, PrepareRenameTxResponse* response,
     int64_t logIndex) {
@@ -328,6 +328,7 @@ class MetaStoreImpl : public MetaStore {
     FRIEND_TEST(MetastoreTest, persist_partition_fail);
     FRIEND_TEST(MetastoreTest, persist_dentry_fail);
     FRIEND_TEST(MetastoreTest, testBatchGetInodeAttr);
+    FRIEND_TEST(MetastoreTest, testListDentryWithInodeAttr);
     FRIEND_TEST(MetastoreTest, testBatchGetXAttr);
     FRIEND_TEST(MetastoreTest, GetOrModifyS3ChunkInfo);
     FRIEND_TEST(MetastoreTest, GetInodeWithPaddingS3Meta);
@@ -337,6 +338,11 @@ class MetaStoreImpl : public MetaStore {
     MetaStoreImpl(copyset::CopysetNode* node,
                   const StorageOptions& storageOptions);
 
+    // pad attribute of inodes which belong to |partition| into response
+    void PaddingInodeAttr(const std::shared_ptr<Partition>& partition,
+                          uint32_t fsId, const std::vector<Dentry>& dentrys,
+                          ListDentryResponse* response);
+
     void PrepareStreamBuffer(butil::IOBuf* buffer,
                              uint64_t chunkIndex,
                              const std::string& value);
@@ -27,6 +27,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -36,8 +37,10 @@
 #include "curvefs/src/common/s3util.h"
 #include "curvefs/src/metaserver/copyset/copyset_node_manager.h"
 #include "curvefs/src/metaserver/copyset/meta_operator.h"
+#include "src/common/concurrent/count_down_event.h"
 
 using curve::common::Configuration;
+using curve::common::CountDownEvent;
 using curve::common::InitS3AdaptorOptionExceptS3InfoOption;
 using curve::common::S3Adapter;
 using curve::common::S3AdapterOption;
@@ -48,6 +51,22 @@ namespace curvefs {
 namespace metaserver {
 
 
+uint64_t CompactInodeJob::CountFragments(const S3ChunkInfoList& list) {
+    if (opts_->smallFragmentSize == 0) {
+        return list.s3chunks_size();
+    }
+
+    // size-tiered: large fragments are cheap to read, rewriting them costs
+    // a lot of s3 traffic but gains little, so only small ones are counted
+    uint64_t count = 0;
+    for (const auto& info : list.s3chunks()) {
+        if (info.len() < opts_->smallFragmentSize) {
+            count++;
+        }
+    }
+    return count;
+}
+
 std::vector<uint64_t> CompactInodeJob::GetNeedCompact(
     const ::google::protobuf::Map<uint64_t, S3ChunkInfoList>& s3chunkinfoMap,
     uint64_t inodeLen, uint64_t chunkSize) {
@@ -62,8 +81,7 @@ std::vector<uint64_t> CompactInodeJob::GetNeedCompact(
             needCompact.push_back(item.first);
             continue;
         }
-        if (static_cast<uint64_t>(item.second.s3chunks_size()) >
-            opts_->fragmentThreshold) {
+        if (CountFragments(item.second) > opts_->fragmentThreshold) {
             needCompact.push_back(item.first);
         } else {
             const auto& l = item.second;
@@ -79,10 +97,17 @@ std::vector<uint64_t> CompactInodeJob::GetNeedCompact(
     return needCompact;
 }
 
+void CompactInodeJob::ThrottleS3(bool isRead, uint64_t length) {
+    if (opts_->throttle != nullptr) {
+        opts_->throttle->Add(isRead, length);
+    }
+}
+
 void CompactInodeJob::DeleteObjs(const std::vector<std::string>& objs,
                                         S3Adapter* s3adapter) {
     for (const auto& obj : objs) {
         VLOG(9) << "s3compact: delete " << obj;
+        ThrottleS3(false, 0);
         const Aws::String aws_key(obj.c_str(), obj.size());
         int ret =
             s3adapter->DeleteObject(aws_key);  // don't care success or not
@@ -280,7 +305,14 @@ int CompactInodeJob::ReadFullChunk(
         const Aws::String aws_key(objName.c_str(), objName.size());
         const auto maxRetry = opts_->s3ReadMaxRetry;
         const auto retryInterval = opts_->s3ReadRetryInterval;
+        // object size is unknown before read, the end of requested range
+        // is a lower bound of it
+        uint64_t readLen = 0;
+        for (const auto& req : reqs) {
+            readLen = std::max(readLen, req->off + req->len);
+        }
         while (retry <= maxRetry) {
+            ThrottleS3(true, readLen);
             // why we need retry
             // if you enable client's diskcache,
             // metadata may be newer than data in s3
@@ -359,6 +391,7 @@ int CompactInodeJob::WriteFullChunk(
             newOff + chunkLen - 1, offRoundDown + (index + 1) * blockSize - 1);
         VLOG(9) << "s3compact: put " << objName << ", [" << s3objBegin << "-"
                 << s3objEnd << "]";
+        ThrottleS3(false, s3objEnd - s3objBegin + 1);
         ret = ctx.s3adapter->PutObject(
             aws_key,
             fullChunk.substr(s3objBegin - newOff, s3objEnd - s3objBegin + 1));
@@ -533,6 +566,7 @@ void CompactInodeJob::DeleteObjsOfS3ChunkInfoList(
                 chunkinfo.chunkid(), index, chunkinfo.compaction(), ctx.fsId,
                 ctx.inodeId, ctx.objectPrefix);
             VLOG(6) << "s3compact: delete " << objName;
+            ThrottleS3(false, 0);
             const Aws::String aws_key(objName.c_str(), objName.size());
             int r = ctx.s3adapter->DeleteObject(
                 aws_key);  // don't care success or not
@@ -581,10 +615,41 @@ void CompactInodeJob::CompactChunks(const S3CompactTask& task) {
     ::google::protobuf::Map<uint64_t, S3ChunkInfoList> s3ChunkInfoRemove;
     VLOG(6) << "s3compact: begin to compact fsId:" << fsId
             << ", inodeId:" << inodeId;
-    for (const auto& index : needCompact) {
-        // s3chunklist order: from small chunkid to big chunkid
-        CompactChunk(compactCtx, index, inode, &objsAddedMap, &s3ChunkInfoAdd,
-                     &s3ChunkInfoRemove);
+    if (opts_->chunkPool == nullptr || needCompact.size() <= 1) {
+        for (const auto& index : needCompact) {
+            // s3chunklist order: from small chunkid to big chunkid
+            CompactChunk(compactCtx, index, inode, &objsAddedMap,
+                         &s3ChunkInfoAdd, &s3ChunkInfoRemove);
+        }
+    } else {
+        // chunks are independent of each other, so compact them concurrently
+        // and overlap one chunk's download with another one's upload
+        std::mutex mtx;
+        CountDownEvent event(static_cast<int>(needCompact.size()));
+        for (const auto& index : needCompact) {
+            opts_->chunkPool->Enqueue([&, index]() {
+                std::unordered_map<uint64_t, std::vector<std::string>> objs;
+                ::google::protobuf::Map<uint64_t, S3ChunkInfoList> toAdd;
+                ::google::protobuf::Map<uint64_t, S3ChunkInfoList> toRemove;
+                CompactChunk(compactCtx, index, inode, &objs, &toAdd,
+                             &toRemove);
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    for (auto& item : objs) {
+                        objsAddedMap.emplace(item.first,
+                                             std::move(item.second));
+                    }
+                    for (auto& item : toAdd) {
+                        s3ChunkInfoAdd[item.first].Swap(&item.second);
+                    }
+                    for (auto& item : toRemove) {
+                        s3ChunkInfoRemove[item.first].Swap(&item.second);
+                    }
+                }
+                event.Signal();
+            });
+        }
+        event.Wait();
     }
     if (s3ChunkInfoAdd.empty() && s3ChunkInfoRemove.empty()) {
         VLOG(6) << "s3compact: do nothing to metadata";
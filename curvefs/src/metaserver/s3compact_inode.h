@@ -165,6 +165,7 @@ class CompactInodeJob {
         }
     };
 
+    uint64_t CountFragments(const S3ChunkInfoList& list);
     std::vector<uint64_t> GetNeedCompact(
         const ::google::protobuf::Map<uint64_t, S3ChunkInfoList>&
             s3chunkinfoMap,
@@ -173,6 +174,8 @@ class CompactInodeJob {
     S3Adapter* SetupS3Adapter(uint64_t fsid, uint64_t* s3adapterIndex,
                               uint64_t* blockSize, uint64_t* chunkSize,
                               uint32_t* objectPrefix);
+    // consume the s3 budget of compaction, block if it's exhausted
+    void ThrottleS3(bool isRead, uint64_t length);
     void DeleteObjs(const std::vector<std::string>& objsAdded,
                     S3Adapter* s3adapter);
     std::list<struct Node> BuildValidList(
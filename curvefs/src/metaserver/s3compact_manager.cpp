@@ -34,9 +34,11 @@
 using curve::common::Configuration;
 using curve::common::InitS3AdaptorOptionExceptS3InfoOption;
 using curve::common::ReadLockGuard;
+using curve::common::ReadWriteThrottleParams;
 using curve::common::S3Adapter;
 using curve::common::S3AdapterOption;
 using curve::common::TaskThreadPool;
+using curve::common::Throttle;
 using curve::common::WriteLockGuard;
 
 namespace curvefs {
@@ -109,6 +111,10 @@ void S3CompactWorkQueueOption::Init(std::shared_ptr<Configuration> conf) {
     conf->GetValueFatalIfFail("s3compactwq.thread_num", &threadNum);
     conf->GetValueFatalIfFail("s3compactwq.fragment_threshold",
                               &fragmentThreshold);
+    if (!conf->GetUInt64Value("s3compactwq.small_fragment_size",
+                              &smallFragmentSize)) {
+        smallFragmentSize = 0;
+    }
     conf->GetValueFatalIfFail("s3compactwq.max_chunks_per_compact",
                               &maxChunksPerCompact);
     conf->GetValueFatalIfFail("s3compactwq.enqueue_sleep_ms", &enqueueSleepMS);
@@ -116,6 +122,18 @@ void S3CompactWorkQueueOption::Init(std::shared_ptr<Configuration> conf) {
     conf->GetValueFatalIfFail("s3compactwq.s3_read_max_retry", &s3ReadMaxRetry);
     conf->GetValueFatalIfFail("s3compactwq.s3_read_retry_interval",
                               &s3ReadRetryInterval);
+    if (!conf->GetUInt64Value("s3compactwq.chunk_concurrency",
+                              &chunkConcurrency)) {
+        chunkConcurrency = 1;
+    }
+    if (!conf->GetUInt64Value("s3compactwq.throttle.iops_limit",
+                              &iopsLimit)) {
+        iopsLimit = 0;
+    }
+    if (!conf->GetUInt64Value("s3compactwq.throttle.bps_limit_mb",
+                              &bpsLimitMB)) {
+        bpsLimitMB = 0;
+    }
 }
 
 void S3CompactManager::Init(std::shared_ptr<Configuration> conf) {
@@ -140,10 +158,27 @@ void S3CompactManager::Init(std::shared_ptr<Configuration> conf) {
         workerOptions_.s3infoCache = s3infoCache_.get();
         workerOptions_.maxChunksPerCompact = opts_.maxChunksPerCompact;
         workerOptions_.fragmentThreshold = opts_.fragmentThreshold;
+        workerOptions_.smallFragmentSize = opts_.smallFragmentSize;
         workerOptions_.s3ReadMaxRetry = opts_.s3ReadMaxRetry;
         workerOptions_.s3ReadRetryInterval = opts_.s3ReadRetryInterval;
         workerOptions_.sleepMS = opts_.enqueueSleepMS;
 
+        if (opts_.chunkConcurrency > 1) {
+            chunkPool_ = absl::make_unique<TaskThreadPool<>>();
+            workerOptions_.chunkPool = chunkPool_.get();
+        }
+        if (opts_.iopsLimit != 0 || opts_.bpsLimitMB != 0) {
+            ReadWriteThrottleParams params;
+            params.iopsTotal.limit = opts_.iopsLimit;
+            params.bpsTotal.limit = opts_.bpsLimitMB * 1024 * 1024;
+            throttle_ = absl::make_unique<Throttle>();
+            throttle_->UpdateThrottleParams(params);
+            workerOptions_.throttle = throttle_.get();
+        }
+        LOG(INFO) << "s3compact: chunk concurrency: " << opts_.chunkConcurrency
+                  << ", iops limit: " << opts_.iopsLimit
+                  << ", bps limit: " << opts_.bpsLimitMB << "MB";
+
         inited_ = true;
     } else {
         LOG(INFO) << "s3compact: not enabled";
@@ -188,6 +223,9 @@ int S3CompactManager::Run() {
     }
 
     if (!workerContext_.running.exchange(true)) {
+        if (chunkPool_ != nullptr) {
+            chunkPool_->Start(opts_.chunkConcurrency);
+        }
         for (uint64_t i = 0; i < opts_.threadNum; ++i) {
             workers_.push_back(absl::make_unique<S3CompactWorker>(
                 this, &workerContext_, &workerOptions_));
@@ -204,10 +242,18 @@ void S3CompactManager::Stop() {
     }
 
     workerContext_.cond.notify_all();
+    // let requests blocked by throttle go
+    if (throttle_ != nullptr) {
+        throttle_->Stop();
+    }
     for (auto& worker : workers_) {
         worker->Stop();
     }
 
+    if (chunkPool_ != nullptr) {
+        chunkPool_->Stop();
+    }
+
     s3adapterManager_->Deinit();
 }
 
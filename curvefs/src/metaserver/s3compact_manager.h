@@ -72,6 +72,7 @@ struct S3CompactWorkQueueOption {
     bool enable;
     uint64_t threadNum;
     uint64_t fragmentThreshold;
+    uint64_t smallFragmentSize;
     uint64_t maxChunksPerCompact;
     uint64_t enqueueSleepMS;
     std::vector<std::string> mdsAddrs;
@@ -80,6 +81,9 @@ struct S3CompactWorkQueueOption {
     uint64_t s3infocacheSize;
     uint64_t s3ReadMaxRetry;
     uint64_t s3ReadRetryInterval;
+    uint64_t chunkConcurrency;
+    uint64_t iopsLimit;
+    uint64_t bpsLimitMB;
 
     void Init(std::shared_ptr<Configuration> conf);
 };
@@ -89,6 +93,8 @@ class S3CompactManager {
     S3CompactWorkQueueOption opts_;
     std::unique_ptr<S3InfoCache> s3infoCache_;
     std::unique_ptr<S3AdapterManager> s3adapterManager_;
+    std::unique_ptr<curve::common::TaskThreadPool<>> chunkPool_;
+    std::unique_ptr<curve::common::Throttle> throttle_;
 
     S3CompactWorkerContext workerContext_;
     S3CompactWorkerOptions workerOptions_;
@@ -32,7 +32,9 @@
 
 #include "absl/types/optional.h"
 #include "curvefs/src/metaserver/s3compact.h"
+#include "src/common/concurrent/task_thread_pool.h"
 #include "src/common/interruptible_sleeper.h"
+#include "src/common/throttle.h"
 
 namespace curvefs {
 namespace metaserver {
@@ -63,11 +65,22 @@ struct S3CompactWorkerOptions {
 
     uint64_t maxChunksPerCompact;
     uint64_t fragmentThreshold;
+    // only fragments smaller than this size are counted for
+    // `fragmentThreshold`, 0 means all fragments are counted
+    uint64_t smallFragmentSize;
     uint64_t s3ReadMaxRetry;
     uint64_t s3ReadRetryInterval;
 
     // sleep interval in ms between compacting two inodes
     uint64_t sleepMS;
+
+    // chunks of one inode are compacted concurrently in this pool,
+    // nullptr means compact them one by one in the worker thread
+    curve::common::TaskThreadPool<>* chunkPool = nullptr;
+
+    // s3 iops and bandwidth budget shared by all compaction of this
+    // metaserver, nullptr means unlimited
+    curve::common::Throttle* throttle = nullptr;
 };
 
 // S3CompactWorker compacts one partition at once
@@ -204,13 +204,11 @@ DUMPFILE_ERROR DumpFile::Read(char* buffer, off_t offset, size_t length) {
 template <typename Int>
 DUMPFILE_ERROR DumpFile::SaveInt(Int num, off_t* offset, uint32_t* checkSum) {
     size_t length = sizeof(Int);
-    std::unique_ptr<char[]> writeBuffer(new (std::nothrow) char[length]);
-
-    memcpy(writeBuffer.get(), reinterpret_cast<char*>(&num), length);
-    auto retCode = Write(writeBuffer.get(), *offset, length);
+    const char* writeBuffer = reinterpret_cast<const char*>(&num);
+    auto retCode = Write(writeBuffer, *offset, length);
     if (retCode == DUMPFILE_ERROR::OK) {
         *offset = (*offset) + length;
-        *checkSum = CRC32(*checkSum, writeBuffer.get(), length);
+        *checkSum = CRC32(*checkSum, writeBuffer, length);
     }
 
     return retCode;
@@ -243,13 +241,11 @@ DUMPFILE_ERROR DumpFile::SaveEntry(const std::string& entry,
 template <typename Int>
 DUMPFILE_ERROR DumpFile::LoadInt(Int* num, off_t* offset, uint32_t* checkSum) {
     size_t length = sizeof(Int);
-    std::unique_ptr<char[]> readBuffer(new (std::nothrow) char[length]);
-
-    auto retCode = Read(readBuffer.get(), *offset, length);
+    char* readBuffer = reinterpret_cast<char*>(num);
+    auto retCode = Read(readBuffer, *offset, length);
     if (retCode == DUMPFILE_ERROR::OK) {
-        *num = *reinterpret_cast<Int*>(readBuffer.get());
         *offset = (*offset) + length;
-        *checkSum = CRC32(*checkSum, readBuffer.get(), length);
+        *checkSum = CRC32(*checkSum, readBuffer, length);
     }
 
     return retCode;
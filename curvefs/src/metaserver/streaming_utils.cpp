@@ -58,5 +58,68 @@ MetaStatusCode StreamingSendVolumeExtent(StreamConnection* connection,
     return MetaStatusCode::OK;
 }
 
+namespace {
+
+MetaStatusCode StreamingSendPage(StreamConnection* connection,
+                                 const ListDentryPage& page) {
+    butil::IOBuf data;
+    butil::IOBufAsZeroCopyOutputStream wrapper(&data);
+    if (!page.SerializeToZeroCopyStream(&wrapper)) {
+        LOG(ERROR) << "Serialize dentry page failed, dentry size: "
+                   << page.dentrys_size();
+        return MetaStatusCode::PARAM_ERROR;
+    }
+
+    if (!connection->Write(data)) {
+        LOG(ERROR) << "Stream write failed, dentry size: "
+                   << page.dentrys_size();
+        return MetaStatusCode::RPC_STREAM_ERROR;
+    }
+
+    return MetaStatusCode::OK;
+}
+
+}  // namespace
+
+MetaStatusCode StreamingSendDentry(
+    StreamConnection* connection,
+    const google::protobuf::RepeatedPtrField<Dentry>& dentrys,
+    const google::protobuf::RepeatedPtrField<InodeAttr>& attrs,
+    uint32_t pageSize) {
+    VLOG(9) << "StreamingSendDentry, dentry size: " << dentrys.size()
+            << ", attribute size: " << attrs.size();
+    ListDentryPage page;
+    int attrIndex = 0;
+    for (const auto& dentry : dentrys) {
+        *page.add_dentrys() = dentry;
+        while (attrIndex < attrs.size() &&
+               attrs.Get(attrIndex).inodeid() == dentry.inodeid()) {
+            *page.add_attrs() = attrs.Get(attrIndex++);
+        }
+
+        if (static_cast<uint32_t>(page.dentrys_size()) >= pageSize) {
+            auto rc = StreamingSendPage(connection, page);
+            if (rc != MetaStatusCode::OK) {
+                return rc;
+            }
+            page.Clear();
+        }
+    }
+
+    if (page.dentrys_size() > 0) {
+        auto rc = StreamingSendPage(connection, page);
+        if (rc != MetaStatusCode::OK) {
+            return rc;
+        }
+    }
+
+    if (!connection->WriteDone()) {
+        LOG(ERROR) << "Stream write done failed in server side";
+        return MetaStatusCode::RPC_STREAM_ERROR;
+    }
+
+    return MetaStatusCode::OK;
+}
+
 }  // namespace metaserver
 }  // namespace curvefs
@@ -34,6 +34,14 @@ using ::curvefs::common::StreamConnection;
 MetaStatusCode StreamingSendVolumeExtent(StreamConnection* connection,
                                          const VolumeExtentSliceList& extents);
 
+// send dentrys and their attributes page by page, |attrs| must be padded
+// in the order of |dentrys|
+MetaStatusCode StreamingSendDentry(
+    StreamConnection* connection,
+    const google::protobuf::RepeatedPtrField<Dentry>& dentrys,
+    const google::protobuf::RepeatedPtrField<InodeAttr>& attrs,
+    uint32_t pageSize);
+
 }  // namespace metaserver
 }  // namespace curvefs
 
@@ -21,7 +21,11 @@
  */
 
 #include <glog/logging.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <utility>
+#include <vector>
 #include "absl/memory/memory.h"
 #include "curvefs/proto/space.pb.h"
 #include "curvefs/src/volume/block_group_manager.h"
@@ -38,6 +42,13 @@ using ::curvefs::common::BitmapLocation;
 using ::curvefs::mds::space::BlockGroup;
 using ::curvefs::mds::space::SpaceErrCode_Name;
 
+namespace {
+
+// upper bound of threads loading block group bitmaps concurrently
+constexpr size_t kMaxBitmapLoaders = 8;
+
+}  // namespace
+
 BlockGroupManagerImpl::BlockGroupManagerImpl(
     SpaceManager* spaceManager,
     const std::shared_ptr<MdsClient>& mdsClient,
@@ -66,26 +77,64 @@ bool BlockGroupManagerImpl::AllocateBlockGroup(
         return false;
     }
 
-    WriteLockGuard lk(groupsLock_);
-    for (auto& group : groups) {
-        VLOG(9) << "load group: " << group.ShortDebugString();
-        AllocatorAndBitmapUpdater res;
-        res.blockGroupOffset = group.offset();
-        BlockGroupBitmapLoader loader(blockDeviceClient_.get(),
-                                      option_.blockSize, allocatorOption_,
-                                      group);
-        auto ret = loader.Load(&res);
-        if (!ret) {
-            LOG(ERROR) << "Create allocator for block group failed";
-            return false;
-        } else {
-            out->push_back(std::move(res));
+    // bitmaps of block groups are read from block device, load them in
+    // parallel so the first allocations after mount don't wait for them one
+    // by one. the number of loader threads is bounded, each of them takes the
+    // next unloaded group until all groups are done
+    std::vector<AllocatorAndBitmapUpdater> loaded(groups.size());
+    std::vector<int> succeeded(groups.size(), 0);
+    std::atomic<size_t> next(0);
+    auto load = [&]() {
+        for (size_t i = next.fetch_add(1); i < groups.size();
+             i = next.fetch_add(1)) {
+            VLOG(9) << "load group: " << groups[i].ShortDebugString();
+            loaded[i].blockGroupOffset = groups[i].offset();
+            BlockGroupBitmapLoader loader(blockDeviceClient_.get(),
+                                          option_.blockSize, allocatorOption_,
+                                          groups[i]);
+            succeeded[i] = loader.Load(&loaded[i]);
         }
+    };
 
-        groups_.emplace_back(std::move(group));
+    size_t threadNum = std::min<size_t>(groups.size(), kMaxBitmapLoaders);
+    std::vector<std::thread> loaders;
+    for (size_t i = 1; i < threadNum; ++i) {
+        loaders.emplace_back(load);
+    }
+    load();
+    for (auto& t : loaders) {
+        t.join();
     }
 
-    return true;
+    // serve the groups loaded successfully, and give the others back to mds
+    // right away, so every owned group has an allocator
+    std::vector<BlockGroup> failed;
+    {
+        WriteLockGuard lk(groupsLock_);
+        for (size_t i = 0; i < groups.size(); ++i) {
+            if (succeeded[i]) {
+                out->push_back(std::move(loaded[i]));
+                groups_.emplace_back(std::move(groups[i]));
+            } else {
+                LOG(ERROR)
+                    << "Create allocator for block group failed, offset: "
+                    << groups[i].offset();
+                failed.emplace_back(std::move(groups[i]));
+            }
+        }
+    }
+
+    // failed groups were never added to groups_, release them without
+    // holding the lock
+    if (!failed.empty()) {
+        err = mdsClient_->ReleaseVolumeBlockGroup(option_.fsId, option_.owner,
+                                                  failed);
+        LOG_IF(WARNING, err != SpaceErrCode::SpaceOk)
+            << "Release unloaded block groups failed, err: "
+            << SpaceErrCode_Name(err);
+    }
+
+    return !out->empty();
 }
 
 bool BlockGroupManagerImpl::AcquireBlockGroup(uint64_t blockGroupOffset,
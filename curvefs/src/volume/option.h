@@ -57,6 +57,10 @@ struct SpaceManagerOption {
 
     double threshold{1.0};
     uint64_t releaseInterSec{300};
+
+    // allocate more block groups in background when available space is
+    // less than this value, 0 means disabled
+    uint64_t prefetchThreshold{0};
 };
 
 }  // namespace volume
@@ -26,6 +26,7 @@
 #include <bvar/bvar.h>
 
 #include <atomic>
+#include <limits>
 #include <unordered_set>
 #include <utility>
 
@@ -40,18 +41,35 @@ using ::curve::common::align_down;
 using ::curve::common::ReadLockGuard;
 using ::curve::common::WriteLockGuard;
 
+namespace {
+
+std::atomic<uint64_t> spaceManagerId{0};
+
+// block group that current thread allocated from last time, a thread may
+// allocate from several space managers, so it's tagged with the owner's id
+struct LastBlockGroup {
+    uint64_t owner = 0;
+    uint64_t offset = std::numeric_limits<uint64_t>::max();
+};
+
+thread_local LastBlockGroup tlsLastBlockGroup;
+
+}  // namespace
+
 SpaceManagerImpl::SpaceManagerImpl(
     const SpaceManagerOption &option,
     const std::shared_ptr<MdsClient> &mdsClient,
     const std::shared_ptr<BlockDeviceClient> &blockDev)
-    : totalBytes_(0), availableBytes_(0),
+    : id_(spaceManagerId.fetch_add(1, std::memory_order_relaxed) + 1),
+      totalBytes_(0), availableBytes_(0),
       blockSize_(option.blockGroupManagerOption.blockSize),
       blockGroupSize_(option.blockGroupManagerOption.blockGroupSize),
       blockGroupManager_(new BlockGroupManagerImpl(
           this, mdsClient, blockDev, option.blockGroupManagerOption,
           option.allocatorOption)),
       allocating_(false), threshold_(option.threshold),
-      releaseInterSec_(option.releaseInterSec) {}
+      releaseInterSec_(option.releaseInterSec),
+      prefetchThreshold_(option.prefetchThreshold) {}
 
 bool SpaceManagerImpl::Alloc(uint32_t size,
                              const AllocateHint& hint,
@@ -98,6 +116,7 @@ bool SpaceManagerImpl::Alloc(uint32_t size,
 
     VLOG(9) << "Alloc success, " << *extents;
 
+    PrefetchBlockGroups();
     return true;
 }
 
@@ -150,6 +169,16 @@ SpaceManagerImpl::FindAllocator(const AllocateHint& hint) {
         }
     }
 
+    // without hint, a thread keeps allocating from the same block group until
+    // it's used up, so concurrent writers are spread over block groups instead
+    // of contending on one allocator, and space of each writer is contiguous
+    if (tlsLastBlockGroup.owner == id_) {
+        auto last = allocators_.find(tlsLastBlockGroup.offset);
+        if (last != allocators_.end() && last->second->AvailableSize() > 0) {
+            return last;
+        }
+    }
+
     static thread_local unsigned int seed = time(nullptr);
     auto it = allocators_.begin();
     std::advance(it, rand_r(&seed) % allocators_.size());
@@ -173,6 +202,8 @@ int64_t SpaceManagerImpl::AllocInternal(int64_t size,
     do {
         left -= it->second->Alloc(left, hint, exts);
         if (left <= 0) {
+            tlsLastBlockGroup.owner = id_;
+            tlsLastBlockGroup.offset = it->first;
             break;
         }
 
@@ -285,9 +316,44 @@ void SpaceManagerImpl::ReleaseFullBlockGroups() {
     }
 }
 
+void SpaceManagerImpl::PrefetchBlockGroups() {
+    if (prefetchThreshold_ == 0 ||
+        availableBytes_.load(std::memory_order_relaxed) >=
+            prefetchThreshold_ ||
+        prefetching_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lk(prefetchMtx_, std::try_to_lock);
+    if (!lk.owns_lock() || prefetchStopped_ ||
+        prefetching_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // last prefetch is done
+    if (prefetchT_.joinable()) {
+        prefetchT_.join();
+    }
+
+    prefetching_.store(true, std::memory_order_release);
+    prefetchT_ = std::thread([this]() {
+        LOG_IF(WARNING, !AllocateBlockGroup(prefetchThreshold_))
+            << "Prefetch block groups failed";
+        prefetching_.store(false, std::memory_order_release);
+    });
+}
+
 bool SpaceManagerImpl::Shutdown() {
     bool ret = false;
 
+    {
+        std::lock_guard<std::mutex> lk(prefetchMtx_);
+        prefetchStopped_ = true;
+        if (prefetchT_.joinable()) {
+            prefetchT_.join();
+        }
+    }
+
     {
         WriteLockGuard allocLk(allocatorsLock_);
         WriteLockGuard updaterLk(updatersLock_);
@@ -314,8 +380,25 @@ bool SpaceManagerImpl::Shutdown() {
     return ret;
 }
 
-bool SpaceManagerImpl::AllocateBlockGroup(uint64_t hint) {
+void SpaceManagerImpl::BeginAllocating() {
     std::unique_lock<std::mutex> lk(mtx_);
+    cond_.wait(lk, [this]() { return !allocating_; });
+    allocating_ = true;
+}
+
+void SpaceManagerImpl::EndAllocating() {
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        allocating_ = false;
+    }
+    cond_.notify_all();
+}
+
+bool SpaceManagerImpl::AllocateBlockGroup(uint64_t hint) {
+    // only one thread talks to mds and block device at a time, others wait
+    // for it without holding mtx_ and then recheck available space
+    BeginAllocating();
+    auto endAllocating = absl::MakeCleanup([this]() { EndAllocating(); });
     if (availableBytes_.load(std::memory_order_relaxed) >= hint) {
         return true;
     }
@@ -347,9 +430,13 @@ bool SpaceManagerImpl::AllocateBlockGroup(uint64_t hint) {
 }
 
 bool SpaceManagerImpl::AcquireBlockGroup(uint64_t blockGroupOffset) {
-    std::unique_lock<std::mutex> lk(mtx_);
-    if (bitmapUpdaters_.find(blockGroupOffset) != bitmapUpdaters_.end()) {
-        return true;
+    BeginAllocating();
+    auto endAllocating = absl::MakeCleanup([this]() { EndAllocating(); });
+    {
+        ReadLockGuard lk(updatersLock_);
+        if (bitmapUpdaters_.find(blockGroupOffset) != bitmapUpdaters_.end()) {
+            return true;
+        }
     }
 
     AllocatorAndBitmapUpdater out;
@@ -104,12 +104,26 @@ class SpaceManagerImpl final : public SpaceManager {
 
     void ReleaseFullBlockGroups();
 
+    /**
+     * @brief Allocate block groups in background if available space is
+     *        less than prefetch threshold
+     */
+    void PrefetchBlockGroups();
+
  private:
+    // Wait until no other thread is allocating or acquiring block groups,
+    // mds and block device are accessed without holding mtx_
+    void BeginAllocating();
+    void EndAllocating();
+
     bool AllocateBlockGroup(uint64_t hint);
 
     bool AcquireBlockGroup(uint64_t blockGroupOffset);
 
  private:
+    // unique among space managers of this process
+    const uint64_t id_;
+
     curve::common::RWLock allocatorsLock_;
     std::map<uint64_t, std::unique_ptr<Allocator>> allocators_;
 
@@ -137,6 +151,13 @@ class SpaceManagerImpl final : public SpaceManager {
     bool running_{false};
     std::thread releaseT_;
 
+    // prefetchT_ allocates block groups before available space is used up
+    uint64_t prefetchThreshold_;
+    std::atomic<bool> prefetching_{false};
+    std::mutex prefetchMtx_;
+    bool prefetchStopped_{false};
+    std::thread prefetchT_;
+
 
  private:
     struct Metric {
@@ -27,6 +27,8 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "curvefs/src/client/kvclient/kvclient_manager.h"
@@ -141,5 +143,52 @@ TEST_F(MemCachedTest, MultiThreadTask) {
         }
     }
 }
+
+TEST_F(MemCachedTest, MGetTask) {
+    std::vector<std::pair<std::string, std::string>> kvstr = {
+        {"mget1", "1231"},
+        {"mget2", "4561"},
+        {"mget3", "7891"},
+    };
+
+    CountDownEvent setEvent(kvstr.size());
+    for (const auto& kv : kvstr) {
+        auto task = std::make_shared<SetKVCacheTask>(
+            kv.first, kv.second.c_str(), kv.second.length(),
+            [&setEvent](const std::shared_ptr<SetKVCacheTask>&) {
+                setEvent.Signal();
+            });
+        manager_.Set(task);
+    }
+    setEvent.Wait();
+
+    // get existed keys, a part of value, and a not existed key in one batch
+    std::vector<std::vector<char>> bufs(5, std::vector<char>(4));
+    std::vector<KVGetItem> items = {
+        KVGetItem("mget1", bufs[0].data(), 0, 4),
+        KVGetItem("mget2", bufs[1].data(), 0, 4),
+        KVGetItem("mget3", bufs[2].data(), 1, 3),
+        KVGetItem("mget4", bufs[3].data(), 0, 4),
+        KVGetItem("mget1", bufs[4].data(), 2, 2),
+    };
+    CountDownEvent getEvent(1);
+    auto task = std::make_shared<MGetKVCacheTask>(
+        items, [&getEvent](const std::shared_ptr<MGetKVCacheTask>&) {
+            getEvent.Signal();
+        });
+    manager_.MGet(task);
+    getEvent.Wait();
+
+    ASSERT_EQ(5u, task->items.size());
+    ASSERT_TRUE(task->items[0].res);
+    ASSERT_EQ(0, memcmp(bufs[0].data(), "1231", 4));
+    ASSERT_TRUE(task->items[1].res);
+    ASSERT_EQ(0, memcmp(bufs[1].data(), "4561", 4));
+    ASSERT_TRUE(task->items[2].res);
+    ASSERT_EQ(0, memcmp(bufs[2].data(), "891", 3));
+    ASSERT_FALSE(task->items[3].res);
+    ASSERT_TRUE(task->items[4].res);
+    ASSERT_EQ(0, memcmp(bufs[4].data(), "31", 2));
+}
 }  // namespace client
 }  // namespace curvefs
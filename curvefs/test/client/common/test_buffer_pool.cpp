@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-12
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <future>
+#include <thread>
+
+#include "curvefs/src/client/common/buffer_pool.h"
+
+namespace curvefs {
+namespace client {
+namespace common {
+
+TEST(BufferPoolTest, ClassSize) {
+    ASSERT_EQ(4096u, BufferPool::ClassSize(1));
+    ASSERT_EQ(4096u, BufferPool::ClassSize(4096));
+    ASSERT_EQ(8192u, BufferPool::ClassSize(4097));
+    ASSERT_EQ(4u * 1024 * 1024, BufferPool::ClassSize(3 * 1024 * 1024));
+    ASSERT_EQ(BufferPool::kMaxClassSize,
+              BufferPool::ClassSize(BufferPool::kMaxClassSize));
+    ASSERT_EQ(0u, BufferPool::ClassSize(BufferPool::kMaxClassSize + 1));
+}
+
+TEST(BufferPoolTest, AllocateAndFree) {
+    BufferPool& pool = BufferPool::GetInstance();
+    int64_t live = pool.GetLiveBytes();
+
+    // CASE 1: buffer is aligned and accounted by its size class
+    char* buf = pool.Allocate(5000);
+    ASSERT_NE(nullptr, buf);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(buf) %
+                     BufferPool::kBufferAlignment);
+    ASSERT_EQ(live + 8192, pool.GetLiveBytes());
+
+    // CASE 2: freed buffer is reused by same size class
+    pool.Free(buf, 5000);
+    ASSERT_EQ(live, pool.GetLiveBytes());
+    char* reused = pool.Allocate(6000);
+    ASSERT_EQ(buf, reused);
+    pool.Free(reused, 6000);
+
+    // CASE 3: large buffer is not pooled
+    size_t large = BufferPool::kMaxClassSize + 1;
+    int64_t cached = pool.GetCachedBytes();
+    buf = pool.Allocate(large);
+    ASSERT_NE(nullptr, buf);
+    ASSERT_EQ(live + static_cast<int64_t>(large), pool.GetLiveBytes());
+    pool.Free(buf, large);
+    ASSERT_EQ(live, pool.GetLiveBytes());
+    ASSERT_EQ(cached, pool.GetCachedBytes());
+}
+
+TEST(BufferPoolTest, ThreadExit) {
+    BufferPool& pool = BufferPool::GetInstance();
+    int64_t cached = pool.GetCachedBytes();
+
+    // buffers cached by exited thread are returned to global cache
+    char* buf = nullptr;
+    std::thread t([&buf]() {
+        PooledBuffer buffer(64 * 1024);
+        buf = buffer.Data();
+    });
+    t.join();
+    ASSERT_EQ(cached + 64 * 1024, pool.GetCachedBytes());
+
+    PooledBuffer buffer(64 * 1024);
+    ASSERT_EQ(buf, buffer.Data());
+}
+
+TEST(BufferPoolTest, CrossThreadFree) {
+    BufferPool& pool = BufferPool::GetInstance();
+
+    // buffer freed by a thread which never allocates goes to global cache,
+    // so it can be reused by allocating thread while freeing thread lives
+    char* buf = pool.Allocate(256 * 1024);
+    ASSERT_NE(nullptr, buf);
+    std::promise<void> freed;
+    std::promise<void> reused;
+    std::thread t([&]() {
+        pool.Free(buf, 256 * 1024);
+        freed.set_value();
+        reused.get_future().wait();
+    });
+    freed.get_future().wait();
+
+    char* again = pool.Allocate(256 * 1024);
+    reused.set_value();
+    t.join();
+    ASSERT_EQ(buf, again);
+    pool.Free(again, 256 * 1024);
+}
+
+}  // namespace common
+}  // namespace client
+}  // namespace curvefs
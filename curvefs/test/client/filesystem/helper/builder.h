@@ -148,7 +148,7 @@ class RPCClientBuilder {
     using Callback = std::function<void(RPCOption* option)>;
 
     static RPCOption DefaultOption() {
-        return RPCOption{ listDentryLimit: 65535 };
+        return RPCOption{ listDentryLimit: 65535, listDentryPlus: false };
     }
 
  public:
@@ -105,6 +105,12 @@ do {                                                     \
         .WillOnce(Invoke(CALLBACK));                     \
 } while (0)
 
+#define EXPECT_CALL_INVOKE_ListDentryPlus(MANAGER, CALLBACK) \
+do {                                                         \
+    EXPECT_CALL(MANAGER, ListDentryPlus(_, _, _, _))         \
+        .WillOnce(Invoke(CALLBACK));                         \
+} while (0)
+
 #define EXPECT_CALL_INVOKE_GetInodeAttr(MANAGER, CALLBACK) \
 do {                                                       \
     EXPECT_CALL(MANAGER, GetInodeAttr(_, _))               \
@@ -147,6 +147,66 @@ TEST_F(RPCClientTest, ReadDir_Basic) {
     }
 }
 
+TEST_F(RPCClientTest, ReadDir_ListDentryPlus) {
+    auto builder = RPCClientBuilder();
+    auto rpc = builder.SetOption([&](RPCOption* option) {
+        option->listDentryPlus = true;
+    }).Build();
+
+    // CASE 1: attribute of inode 1 returned inline, only fetch inode 2
+    {
+        EXPECT_CALL_INVOKE_ListDentryPlus(*builder.GetDentryManager(),
+            [&](uint64_t parent,
+                std::list<Dentry>* dentries,
+                std::map<uint64_t, InodeAttr>* attrs,
+                uint32_t limit) -> CURVEFS_ERROR {
+                dentries->push_back(MkDentry(1, "f1"));
+                dentries->push_back(MkDentry(2, "f2"));
+                attrs->emplace(1, MkAttr(1, AttrOption().mtime(123, 1)));
+                return CURVEFS_ERROR::OK;
+            });
+        EXPECT_CALL_INVOKE_BatchGetInodeAttrAsync(*builder.GetInodeManager(),
+            [&](uint64_t parentId,
+                std::set<uint64_t>* inos,
+                std::map<uint64_t, InodeAttr>* attrs) -> CURVEFS_ERROR {
+                for (const auto& ino : *inos) {
+                    if (attrs->find(ino) == attrs->end()) {
+                        auto attr = MkAttr(ino, AttrOption().mtime(456, ino));
+                        attrs->emplace(ino, attr);
+                    }
+                }
+                return CURVEFS_ERROR::OK;
+            });
+
+        DirEntry dirEntry;
+        auto entries = std::make_shared<DirEntryList>();
+        auto rc = rpc->ReadDir(100, &entries);
+        ASSERT_EQ(rc, CURVEFS_ERROR::OK);
+        ASSERT_EQ(entries->Size(), 2);
+        ASSERT_TRUE(entries->Get(1, &dirEntry));
+        ASSERT_EQ(dirEntry.name, "f1");
+        ASSERT_EQ(dirEntry.attr.mtime(), 123);
+        ASSERT_TRUE(entries->Get(2, &dirEntry));
+        ASSERT_EQ(dirEntry.name, "f2");
+        ASSERT_EQ(dirEntry.attr.mtime(), 456);
+    }
+
+    // CASE 2: list dentry failed
+    {
+        EXPECT_CALL_INVOKE_ListDentryPlus(*builder.GetDentryManager(),
+            [&](uint64_t parent,
+                std::list<Dentry>* dentries,
+                std::map<uint64_t, InodeAttr>* attrs,
+                uint32_t limit) -> CURVEFS_ERROR {
+                return CURVEFS_ERROR::INTERNAL;
+            });
+
+        auto entries = std::make_shared<DirEntryList>();
+        auto rc = rpc->ReadDir(100, &entries);
+        ASSERT_EQ(rc, CURVEFS_ERROR::INTERNAL);
+    }
+}
+
 TEST_F(RPCClientTest, Open_Basic) {
     auto builder = RPCClientBuilder();
     auto rpc = builder.Build();
@@ -27,6 +27,7 @@
 #include <gmock/gmock.h>
 
 #include <list>
+#include <map>
 #include <string>
 #include <vector>
 #include <memory>
@@ -62,6 +63,11 @@ class MockMetaServerClient : public MetaServerClient {
             const std::string &last, uint32_t count, bool onlyDir,
             std::list<Dentry> *dentryList));
 
+    MOCK_METHOD6(ListDentryPlus, MetaStatusCode(uint32_t fsId,
+            uint64_t inodeid, const std::string &last, uint32_t count,
+            std::list<Dentry> *dentryList,
+            std::map<uint64_t, InodeAttr> *attrs));
+
     MOCK_METHOD1(CreateDentry, MetaStatusCode(const Dentry &dentry));
 
     MOCK_METHOD4(DeleteDentry, MetaStatusCode(
@@ -25,6 +25,10 @@
 #include <google/protobuf/util/message_differencer.h>
 #include <unistd.h>
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "curvefs/test/client/mock_metaserver_client.h"
 #include "curvefs/src/client/dentry_cache_manager.h"
 
@@ -238,6 +242,48 @@ TEST_F(TestDentryCacheManager, ListDentryFailed) {
     ASSERT_EQ(0, out.size());
 }
 
+TEST_F(TestDentryCacheManager, ListDentryPlusByPage) {
+    uint64_t parent = 99;
+    uint32_t limit = 2;
+
+    auto listPage = [](const std::vector<std::string>& names) {
+        return [names](uint32_t, uint64_t, const std::string&, uint32_t,
+                       std::list<Dentry>* dentryList,
+                       std::map<uint64_t, InodeAttr>* attrs) {
+            for (const auto& name : names) {
+                Dentry dentry;
+                dentry.set_name(name);
+                dentry.set_inodeid(100 + name[0]);
+                dentryList->push_back(dentry);
+                InodeAttr attr;
+                attr.set_inodeid(dentry.inodeid());
+                attrs->emplace(attr.inodeid(), attr);
+            }
+            return MetaStatusCode::OK;
+        };
+    };
+
+    // the next page starts from the last dentry of previous page
+    EXPECT_CALL(*metaClient_, ListDentryPlus(fsId_, parent, "", limit, _, _))
+        .WillOnce(Invoke(listPage({"a", "b"})));
+    EXPECT_CALL(*metaClient_, ListDentryPlus(fsId_, parent, "b", limit, _, _))
+        .WillOnce(Invoke(listPage({"c"})));
+
+    std::list<Dentry> out;
+    std::map<uint64_t, InodeAttr> attrs;
+    CURVEFS_ERROR ret =
+        dCacheManager_->ListDentryPlus(parent, &out, &attrs, limit);
+    ASSERT_EQ(CURVEFS_ERROR::OK, ret);
+    ASSERT_EQ(3, out.size());
+    ASSERT_EQ("c", out.back().name());
+    ASSERT_EQ(3, attrs.size());
+
+    EXPECT_CALL(*metaClient_, ListDentryPlus(fsId_, parent, "", limit, _, _))
+        .WillOnce(Return(MetaStatusCode::UNKNOWN_ERROR));
+    ret = dCacheManager_->ListDentryPlus(parent, &out, &attrs, limit);
+    ASSERT_EQ(CURVEFS_ERROR::UNKNOWN, ret);
+}
+
 TEST_F(TestDentryCacheManager, GetTimeOutDentry) {
     curvefs::client::common::FLAGS_enableCto = false;
     uint64_t parent = 99;
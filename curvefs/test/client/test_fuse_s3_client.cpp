@@ -24,7 +24,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <list>
 #include <memory>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 
@@ -47,6 +51,7 @@
 #include "curvefs/test/client/mock_metaserver_client.h"
 #include "curvefs/test/client/rpcclient/mock_mds_client.h"
 #include "fuse3/fuse_lowlevel.h"
+#include "src/common/concurrent/count_down_event.h"
 
 struct fuse_req {
     struct fuse_ctx* ctx;
@@ -129,6 +134,40 @@ class WarmupManagerS3Test : public warmup::WarmupManagerS3Impl {
         return warmup::WarmupManagerS3Impl::FetchDentry(key, ino, file,
                                                         symlink_depth);
     }
+
+    bool AddDownloadingObj(const std::string& name, fuse_ino_t key) {
+        return warmup::WarmupManagerS3Impl::AddDownloadingObj(name, key,
+                                                              nullptr);
+    }
+
+    size_t DownloadWaiterNum(const std::string& name) {
+        std::lock_guard<std::mutex> lock(downloadingObjsMutex_);
+        auto iter = downloadingObjs_.find(name);
+        return iter == downloadingObjs_.end() ? 0 : iter->second.size();
+    }
+
+    void RemoveDownloadingObj(const std::string& name, bool success) {
+        return warmup::WarmupManagerS3Impl::RemoveDownloadingObj(name,
+                                                                 success);
+    }
+
+    void WarmUpAllObjs(
+        fuse_ino_t key,
+        const std::list<std::pair<std::string, uint64_t>>& prefetchObjs) {
+        return warmup::WarmupManagerS3Impl::WarmUpAllObjs(key, prefetchObjs);
+    }
+
+    bool AddWarmupProcess(fuse_ino_t key, const std::string& path,
+                          common::WarmupStorageType type) {
+        curve::common::WriteLockGuard lock(inode2ProgressMutex_);
+        return warmup::WarmupManagerS3Impl::AddWarmupProcessLocked(key, path,
+                                                                   type);
+    }
+
+    // without Init, downloads are not treated as stopped
+    void EnableFetch() {
+        bgFetchStop_.store(false, std::memory_order_release);
+    }
 };
 
 class TestFuseS3Client : public ::testing::Test {
@@ -991,6 +1030,71 @@ TEST_F(TestFuseS3Client, warmUp_GetInodeSubPathParent_empty) {
               false);
 }
 
+TEST_F(TestFuseS3Client, warmUp_DownloadingObjDedup) {
+    // same object is downloaded only once by all warmup tasks
+    ASSERT_TRUE(warmupManager_->AddDownloadingObj("1_16777216_2_0_0", 1));
+    ASSERT_FALSE(warmupManager_->AddDownloadingObj("1_16777216_2_0_0", 2));
+    ASSERT_TRUE(warmupManager_->AddDownloadingObj("1_16777216_3_0_0", 1));
+
+    // can be downloaded again after finished
+    warmupManager_->RemoveDownloadingObj("1_16777216_2_0_0", true);
+    ASSERT_TRUE(warmupManager_->AddDownloadingObj("1_16777216_2_0_0", 2));
+}
+
+TEST_F(TestFuseS3Client, warmUp_DownloadingObjRace) {
+    // a standalone manager, so background scan won't clean the progress
+    auto manager = std::make_shared<WarmupManagerS3Test>(
+        metaClient_, inodeManager_, dentryManager_, nullptr, nullptr,
+        nullptr, nullptr, s3ClientAdaptor_);
+    manager->EnableFetch();
+    auto type = curvefs::client::common::WarmupStorageType::
+        kWarmupStorageTypeKvClient;
+    ASSERT_TRUE(manager->AddWarmupProcess(1, "/a", type));
+    ASSERT_TRUE(manager->AddWarmupProcess(2, "/b", type));
+
+    auto s3Client = std::make_shared<MockS3Client>();
+    EXPECT_CALL(*s3ClientAdaptor_, GetS3Client())
+        .WillRepeatedly(Return(s3Client));
+    std::shared_ptr<GetObjectAsyncContext> downloading;
+    curve::common::CountDownEvent started(1);
+    EXPECT_CALL(*s3Client, DownloadAsync(_))
+        .WillOnce(Invoke(
+            [&](const std::shared_ptr<GetObjectAsyncContext>& context) {
+                downloading = context;
+                started.Signal();
+            }));
+
+    // two warmup tasks race for the same object, only one downloads it
+    std::list<std::pair<std::string, uint64_t>> objs{
+        {"1_16777216_2_0_0", 4096}};
+    std::thread owner([&]() { manager->WarmUpAllObjs(1, objs); });
+    started.Wait();
+    std::atomic<bool> waiterReturned(false);
+    std::thread waiter([&]() {
+        manager->WarmUpAllObjs(2, objs);
+        waiterReturned = true;
+    });
+    while (manager->DownloadWaiterNum("1_16777216_2_0_0") == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // neither finished nor returned until the owning download finishes
+    warmup::WarmupProgress progress;
+    ASSERT_TRUE(manager->QueryWarmupProgress(2, &progress));
+    ASSERT_EQ(0, progress.GetFinished());
+    ASSERT_FALSE(waiterReturned);
+
+    downloading->retCode = 0;
+    downloading->cb(nullptr, downloading);
+    owner.join();
+    waiter.join();
+
+    ASSERT_TRUE(manager->QueryWarmupProgress(1, &progress));
+    ASSERT_EQ(1, progress.GetFinished());
+    ASSERT_TRUE(manager->QueryWarmupProgress(2, &progress));
+    ASSERT_EQ(1, progress.GetFinished());
+}
+
 TEST_F(TestFuseS3Client, warmUp_GetInodeSubPathParent_1depth) {
     /*
 .(1) parent
@@ -277,6 +277,43 @@ struct FakeUpdateInodeWithOutNlinkAsync {
 
 }  // namespace
 
+TEST_F(TestInodeWrapper, TestFlushDataBeforeSync) {
+    ExtentCache::SetOption({});
+
+    inodeWrapper_->SetType(FsFileType::TYPE_FILE);
+    inodeWrapper_->ClearDirty();
+    auto* extentCache = inodeWrapper_->GetMutableExtentCache();
+    PExtent pext;
+    pext.len = 4096;
+    pext.pOffset = 0;
+    pext.UnWritten = false;
+    extentCache->Merge(0, pext);
+
+    // data is not on the volume yet, extents must stay unsynced
+    bool flushed = false;
+    inodeWrapper_->SetDataFlusher([&flushed](uint64_t) { return flushed; });
+    EXPECT_CALL(*metaClient_, AsyncUpdateVolumeExtent(_, _, _, _))
+        .Times(0);
+    ASSERT_EQ(CURVEFS_ERROR::IO_ERROR, inodeWrapper_->Sync());
+    ASSERT_TRUE(extentCache->HasDirtyExtents());
+
+    FakeCallback done;
+    inodeWrapper_->Async(&done);
+    done.Wait();
+    ASSERT_EQ(MetaStatusCode::UNKNOWN_ERROR, done.GetStatusCode());
+    ASSERT_TRUE(extentCache->HasDirtyExtents());
+
+    flushed = true;
+    EXPECT_CALL(*metaClient_, AsyncUpdateVolumeExtent(_, _, _, _))
+        .WillOnce(Invoke([](uint32_t, uint64_t, const VolumeExtentSliceList&,
+                            MetaServerClientDone* done) {
+            done->SetMetaStatusCode(MetaStatusCode::OK);
+            done->Run();
+        }));
+    ASSERT_EQ(CURVEFS_ERROR::OK, inodeWrapper_->Sync());
+    ASSERT_FALSE(extentCache->HasDirtyExtents());
+}
+
 TEST_F(TestInodeWrapper, TestAsyncInode) {
     for (auto type : {FsFileType::TYPE_DIRECTORY, FsFileType::TYPE_FILE,
                       FsFileType::TYPE_S3, FsFileType::TYPE_SYM_LINK}) {
@@ -406,5 +406,41 @@ TEST(ExtentCacheMergeTest, MergeCase5_PhysicalOffsetContinuousButNotWritten) {
     ASSERT_TRUE(range[24 * kMiB].UnWritten);
 }
 
+// contiguous extents of same state are merged when building from meta
+TEST(ExtentCacheMergeTest, BuildMergeContiguousExtents) {
+    VolumeExtentSliceList list;
+    auto* slice = list.add_slices();
+    slice->set_offset(0);
+
+    auto addExtent = [slice](uint64_t fsOffset, uint64_t volumeOffset,
+                             uint64_t length, bool used) {
+        auto* ext = slice->add_extents();
+        ext->set_fsoffset(fsOffset);
+        ext->set_volumeoffset(volumeOffset);
+        ext->set_length(length);
+        ext->set_isused(used);
+    };
+
+    addExtent(0 * kMiB, 16 * kMiB, 4 * kMiB, true);
+    addExtent(4 * kMiB, 20 * kMiB, 4 * kMiB, true);
+    // written state is different
+    addExtent(8 * kMiB, 24 * kMiB, 4 * kMiB, false);
+    addExtent(12 * kMiB, 28 * kMiB, 4 * kMiB, false);
+    // physical offset is not continuous
+    addExtent(16 * kMiB, 64 * kMiB, 4 * kMiB, false);
+
+    ExtentCache cache;
+    cache.Build(list);
+
+    auto extents = cache.GetExtentsForTesting();
+    ASSERT_TRUE(extents.count(0));
+
+    auto& range = extents[0];
+    ASSERT_EQ(3, range.size());
+    ASSERT_EQ(PExtent(8 * kMiB, 16 * kMiB, false), range[0 * kMiB]);
+    ASSERT_EQ(PExtent(8 * kMiB, 24 * kMiB, true), range[8 * kMiB]);
+    ASSERT_EQ(PExtent(4 * kMiB, 64 * kMiB, true), range[16 * kMiB]);
+}
+
 }  // namespace client
 }  // namespace curvefs
@@ -454,5 +454,42 @@ TEST(ExtentCacheReadDivideTest, DivideCase8_UnWritten) {
     ASSERT_EQ(data.get() + 4 * kKiB, holes[1].data);
 }
 
+// read across two slices which are not the first two slices of a file
+TEST(ExtentCacheReadDivideTest, DivideAcrossSlices) {
+    ExtentCacheOption option;
+    option.sliceSize = 1 * kGiB;
+    ExtentCache::SetOption(option);
+
+    ExtentCache cache;
+
+    PExtent pext;
+    pext.len = 4 * kKiB;
+    pext.UnWritten = false;
+    pext.pOffset = 4 * kMiB;
+    cache.Merge(3 * kGiB - 4 * kKiB, pext);
+
+    pext.pOffset = 8 * kMiB;
+    cache.Merge(3 * kGiB, pext);
+
+    off_t offset = 3 * kGiB - 4 * kKiB;
+    size_t length = 8 * kKiB;
+    std::unique_ptr<char[]> data(new char[length]);
+
+    std::vector<ReadPart> reads;
+    std::vector<ReadPart> holes;
+    cache.DivideForRead(offset, length, data.get(), &reads, &holes);
+
+    ASSERT_EQ(2, reads.size());
+    ASSERT_EQ(0, holes.size());
+
+    ASSERT_EQ(4 * kMiB, reads[0].offset);
+    ASSERT_EQ(4 * kKiB, reads[0].length);
+    ASSERT_EQ(data.get(), reads[0].data);
+
+    ASSERT_EQ(8 * kMiB, reads[1].offset);
+    ASSERT_EQ(4 * kKiB, reads[1].length);
+    ASSERT_EQ(data.get() + 4 * kKiB, reads[1].data);
+}
+
 }  // namespace client
 }  // namespace curvefs
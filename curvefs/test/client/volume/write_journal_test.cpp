@@ -0,0 +1,264 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-14
+ */
+
+#include "curvefs/src/client/volume/write_journal.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "curvefs/test/volume/mock/mock_block_device_client.h"
+
+namespace curvefs {
+namespace client {
+
+using ::curvefs::volume::MockBlockDeviceClient;
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Invoke;
+
+const uint32_t kFsId = 1;
+const char kVolumeName[] = "volume";
+const uint64_t kIno = 100;
+
+// a volume in memory
+class FakeVolume {
+ public:
+    explicit FakeVolume(size_t size) : data_(size, '\0'), writes_(0) {}
+
+    ssize_t Readv(const std::vector<ReadPart>& reads) {
+        ssize_t nr = 0;
+        for (const auto& read : reads) {
+            memcpy(read.data, &data_[read.offset], read.length);
+            nr += read.length;
+        }
+        return nr;
+    }
+
+    ssize_t Writev(const std::vector<WritePart>& writes) {
+        ssize_t nr = 0;
+        for (const auto& write : writes) {
+            memcpy(&data_[write.offset], write.data, write.length);
+            nr += write.length;
+            ++writes_;
+        }
+        return nr;
+    }
+
+    std::string data_;
+    int writes_;
+};
+
+class WriteJournalTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        option_.path = "./write_journal_test.journal";
+        option_.capacity = 1024 * 1024;
+        // flush explicitly in tests
+        option_.flushIntervalMs = 3600 * 1000;
+        ::unlink(option_.path.c_str());
+
+        ExpectVolume(&blockDev_, &volume_);
+    }
+
+    void TearDown() override {
+        ::unlink(option_.path.c_str());
+    }
+
+    static void ExpectVolume(MockBlockDeviceClient* blockDev,
+                             FakeVolume* volume) {
+        EXPECT_CALL(*blockDev, Readv(_))
+            .Times(AnyNumber())
+            .WillRepeatedly(Invoke(volume, &FakeVolume::Readv));
+        EXPECT_CALL(*blockDev, Writev(_))
+            .Times(AnyNumber())
+            .WillRepeatedly(Invoke(volume, &FakeVolume::Writev));
+    }
+
+ protected:
+    VolumeJournalOption option_;
+    MockBlockDeviceClient blockDev_;
+    FakeVolume volume_{4096};
+};
+
+TEST_F(WriteJournalTest, ReadJournaledDataAndFlush) {
+    WriteJournal journal(option_, kFsId, kVolumeName, &blockDev_);
+    ASSERT_TRUE(journal.Init());
+
+    std::string a(100, 'a');
+    std::string b(50, 'b');
+    std::string c(10, 'c');
+    ASSERT_TRUE(journal.Append(kIno, {WritePart(0, a.size(), a.data())}));
+    ASSERT_TRUE(journal.Append(kIno, {WritePart(100, b.size(), b.data()),
+                                WritePart(20, c.size(), c.data())}));
+    ASSERT_EQ(150u, journal.GetPendingBytes());
+    ASSERT_EQ(0, volume_.writes_);
+
+    std::string expected = a + b;
+    expected.replace(20, c.size(), c);
+
+    std::string buf(150, 'x');
+    ASSERT_EQ(150, journal.Readv({ReadPart(0, buf.size(), &buf[0])}));
+    ASSERT_EQ(expected, buf);
+
+    // adjacent writes are merged into one volume write
+    ASSERT_TRUE(journal.Flush());
+    ASSERT_EQ(1, volume_.writes_);
+    ASSERT_EQ(0u, journal.GetPendingBytes());
+    ASSERT_EQ(0u, journal.GetJournalSize());
+    ASSERT_EQ(expected, volume_.data_.substr(0, 150));
+}
+
+TEST_F(WriteJournalTest, ReplayAfterCrash) {
+    std::string a(100, 'a');
+    std::string b(30, 'b');
+    {
+        WriteJournal journal(option_, kFsId, kVolumeName, &blockDev_);
+        ASSERT_TRUE(journal.Init());
+        ASSERT_TRUE(journal.Append(kIno, {WritePart(0, a.size(), a.data())}));
+        ASSERT_TRUE(journal.Append(kIno, {WritePart(50, b.size(), b.data())}));
+
+        // simulate a crash by keeping a copy of the journal file
+        std::string cmd = "cp " + option_.path + " " + option_.path + ".bak";
+        ASSERT_EQ(0, ::system(cmd.c_str()));
+        ASSERT_TRUE(journal.Shutdown());
+    }
+
+    // append an incomplete record
+    std::string cmd = "mv " + option_.path + ".bak " + option_.path +
+                      " && printf incomplete >> " + option_.path;
+    ASSERT_EQ(0, ::system(cmd.c_str()));
+
+    MockBlockDeviceClient blockDev;
+    FakeVolume volume(4096);
+    ExpectVolume(&blockDev, &volume);
+
+    WriteJournal journal(option_, kFsId, kVolumeName, &blockDev);
+    ASSERT_TRUE(journal.Init());
+    ASSERT_EQ(0u, journal.GetJournalSize());
+
+    std::string expected = a;
+    expected.replace(50, b.size(), b);
+    ASSERT_EQ(expected, volume.data_.substr(0, 100));
+}
+
+TEST_F(WriteJournalTest, FlushWhenJournalIsFull) {
+    option_.capacity = 128;
+    WriteJournal journal(option_, kFsId, kVolumeName, &blockDev_);
+    ASSERT_TRUE(journal.Init());
+
+    std::string a(150, 'a');
+    ASSERT_TRUE(journal.Append(kIno, {WritePart(0, a.size(), a.data())}));
+    ASSERT_EQ(0, volume_.writes_);
+
+    ASSERT_TRUE(journal.Append(kIno, {WritePart(1024, a.size(), a.data())}));
+    ASSERT_EQ(1, volume_.writes_);
+    ASSERT_EQ(a, volume_.data_.substr(0, 150));
+    ASSERT_EQ(150u, journal.GetPendingBytes());
+
+    ASSERT_TRUE(journal.Shutdown());
+    ASSERT_EQ(a, volume_.data_.substr(1024, 150));
+}
+
+TEST_F(WriteJournalTest, RefuseJournalOfOtherFilesystem) {
+    std::string a(100, 'a');
+    {
+        WriteJournal journal(option_, kFsId, kVolumeName, &blockDev_);
+        ASSERT_TRUE(journal.Init());
+        ASSERT_TRUE(journal.Append(kIno, {WritePart(0, a.size(), a.data())}));
+
+        // simulate a crash by keeping a copy of the journal file
+        std::string cmd = "cp " + option_.path + " " + option_.path + ".bak";
+        ASSERT_EQ(0, ::system(cmd.c_str()));
+        ASSERT_TRUE(journal.Shutdown());
+    }
+    std::string cmd = "mv " + option_.path + ".bak " + option_.path;
+    ASSERT_EQ(0, ::system(cmd.c_str()));
+
+    MockBlockDeviceClient blockDev;
+    FakeVolume volume(4096);
+    ExpectVolume(&blockDev, &volume);
+
+    {
+        WriteJournal journal(option_, kFsId + 1, kVolumeName, &blockDev);
+        ASSERT_FALSE(journal.Init());
+    }
+    {
+        WriteJournal journal(option_, kFsId, "other", &blockDev);
+        ASSERT_FALSE(journal.Init());
+    }
+    ASSERT_EQ(0, volume.writes_);
+
+    WriteJournal journal(option_, kFsId, kVolumeName, &blockDev);
+    ASSERT_TRUE(journal.Init());
+    ASSERT_EQ(a, volume.data_.substr(0, 100));
+}
+
+TEST_F(WriteJournalTest, FlushAndDiscardInode) {
+    std::string a(100, 'a');
+    std::string b(50, 'b');
+    {
+        WriteJournal journal(option_, kFsId, kVolumeName, &blockDev_);
+        ASSERT_TRUE(journal.Init());
+        ASSERT_TRUE(journal.Append(kIno, {WritePart(0, a.size(), a.data())}));
+        ASSERT_TRUE(
+            journal.Append(kIno + 1, {WritePart(200, b.size(), b.data())}));
+
+        // only data of the inode is flushed
+        ASSERT_TRUE(journal.Flush(kIno + 1));
+        ASSERT_EQ(1, volume_.writes_);
+        ASSERT_EQ(b, volume_.data_.substr(200, 50));
+        ASSERT_EQ(100u, journal.GetPendingBytes());
+
+        // discarded data is neither read nor flushed
+        ASSERT_TRUE(journal.Discard(kIno));
+        ASSERT_EQ(0u, journal.GetPendingBytes());
+        std::string buf(100, 'x');
+        ASSERT_EQ(100, journal.Readv({ReadPart(0, buf.size(), &buf[0])}));
+        ASSERT_EQ(std::string(100, '\0'), buf);
+
+        // data appended after discard is kept
+        ASSERT_TRUE(journal.Append(kIno, {WritePart(0, b.size(), b.data())}));
+
+        // simulate a crash by keeping a copy of the journal file
+        std::string cmd = "cp " + option_.path + " " + option_.path + ".bak";
+        ASSERT_EQ(0, ::system(cmd.c_str()));
+        ASSERT_TRUE(journal.Shutdown());
+    }
+    std::string cmd = "mv " + option_.path + ".bak " + option_.path;
+    ASSERT_EQ(0, ::system(cmd.c_str()));
+
+    // discarded data isn't replayed
+    MockBlockDeviceClient blockDev;
+    FakeVolume volume(4096);
+    ExpectVolume(&blockDev, &volume);
+    WriteJournal journal(option_, kFsId, kVolumeName, &blockDev);
+    ASSERT_TRUE(journal.Init());
+    ASSERT_EQ(b + std::string(50, '\0'), volume.data_.substr(0, 100));
+    ASSERT_EQ(b, volume.data_.substr(200, 50));
+}
+
+}  // namespace client
+}  // namespace curvefs
@@ -221,3 +221,50 @@ TEST(ApplyQueue, ConcurrentTest) {
     concurrentapply.Stop();
 }
 
+
+TEST(ApplyQueue, DispatchTest) {
+    std::vector<OperatorType> readTypeList;
+    std::vector<OperatorType> writeTypeList;
+    InitReadWriteTypeList(&readTypeList, &writeTypeList);
+    auto write_type = get_random_type(writeTypeList);
+
+    ApplyQueue concurrentapply;
+    ApplyOption opt(2, 100, 1, 1);
+    ASSERT_TRUE(concurrentapply.Init(opt, "apply_queue_dispatch_test"));
+
+    // 1. task of key 0 blocks one thread, task of key 2 will not be
+    //    stacked behind it although both keys hash to the same thread
+    std::atomic<bool> blocked(true);
+    auto btask = [&blocked]() {
+        while (blocked.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+    std::atomic<bool> done(false);
+    auto dtask = [&done]() {
+        done.store(true);
+    };
+
+    ASSERT_TRUE(concurrentapply.Push(0, write_type, btask));
+    ASSERT_TRUE(concurrentapply.Push(2, write_type, dtask));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_TRUE(done.load());
+
+    // 2. tasks of key 0 are still executed in order
+    std::vector<int> order;
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(concurrentapply.Push(0, write_type, [&order, i]() {
+            order.push_back(i);
+        }));
+    }
+    ASSERT_TRUE(order.empty());
+
+    blocked.store(false);
+    concurrentapply.Flush();
+    ASSERT_EQ(10u, order.size());
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(i, order[i]);
+    }
+
+    concurrentapply.Stop();
+}
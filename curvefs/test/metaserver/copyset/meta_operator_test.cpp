@@ -23,6 +23,7 @@
 #include "curvefs/src/metaserver/copyset/meta_operator.h"
 
 #include <brpc/server.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
 #include <condition_variable>
@@ -37,6 +38,8 @@
 #include "src/common/timeutility.h"
 #include "test/fs/mock_local_filesystem.h"
 
+DECLARE_bool(enable_follower_read);
+
 namespace curvefs {
 namespace metaserver {
 namespace copyset {
@@ -472,6 +475,125 @@ TEST_F(MetaOperatorTest, PropostTest_RequestCanBypassProcess) {
     node.Stop();
 }
 
+TEST_F(MetaOperatorTest, PropostTest_RequestBypassByReadPool) {
+    curve::fs::MockLocalFileSystem localFs;
+
+    PoolId poolId = 100;
+    CopysetId copysetId = 100;
+    braft::Configuration conf;
+
+    ReadPool readPool;
+    ASSERT_EQ(0, readPool.Start(2));
+
+    CopysetNode node(poolId, copysetId, conf, &mockNodeManager_);
+    CopysetNodeOptions options;
+    options.dataUri = "local:///mnt/data";
+    options.localFileSystem = &localFs;
+    options.storageOptions.type = "memory";
+    options.readPool = &readPool;
+
+    EXPECT_CALL(localFs, Mkdir(_)).WillOnce(Return(0));
+
+    EXPECT_TRUE(node.Init(options));
+    auto* mockMetaStore = new mock::MockMetaStore();
+    node.SetMetaStore(mockMetaStore);
+    auto* mockRaftNode = new MockRaftNode();
+    node.SetRaftNode(mockRaftNode);
+
+    ON_CALL(*mockMetaStore, Clear()).WillByDefault(Return(true));
+    EXPECT_CALL(*mockRaftNode, apply(_)).Times(0);
+    EXPECT_CALL(*mockRaftNode, shutdown(_)).Times(AtLeast(1));
+    EXPECT_CALL(*mockRaftNode, join()).Times(AtLeast(1));
+    EXPECT_CALL(*mockMetaStore, GetInode(_, _, _))
+        .WillOnce(Return(MetaStatusCode::OK));
+
+    braft::LeaderLeaseStatus status;
+    status.state = braft::LEASE_VALID;
+    status.term = 1;
+    EXPECT_CALL(*mockRaftNode, get_leader_lease_status(_))
+        .WillOnce(SetArgPointee<0>(status));
+
+    node.on_leader_start(1);
+    node.UpdateAppliedIndex(101);
+
+    GetInodeRequest request;
+    GetInodeResponse response;
+    FakeClosure done;
+    auto op = absl::make_unique<GetInodeOperator>(&node, nullptr, &request,
+                                                  &response, &done);
+    op->Propose();
+    op.release();
+
+    done.WaitRunned();
+    EXPECT_TRUE(response.has_appliedindex());
+    EXPECT_EQ(101, response.appliedindex());
+
+    node.Stop();
+    readPool.Stop();
+}
+
+TEST_F(MetaOperatorTest, PropostTest_FollowerRead) {
+    curve::fs::MockLocalFileSystem localFs;
+
+    PoolId poolId = 100;
+    CopysetId copysetId = 100;
+    braft::Configuration conf;
+
+    CopysetNode node(poolId, copysetId, conf, &mockNodeManager_);
+    CopysetNodeOptions options;
+    options.dataUri = "local:///mnt/data";
+    options.localFileSystem = &localFs;
+    options.storageOptions.type = "memory";
+
+    EXPECT_CALL(localFs, Mkdir(_)).WillOnce(Return(0));
+
+    EXPECT_TRUE(node.Init(options));
+    auto* mockMetaStore = new mock::MockMetaStore();
+    node.SetMetaStore(mockMetaStore);
+    auto* mockRaftNode = new MockRaftNode();
+    node.SetRaftNode(mockRaftNode);
+
+    ON_CALL(*mockMetaStore, Clear()).WillByDefault(Return(true));
+    EXPECT_CALL(*mockRaftNode, apply(_)).Times(0);
+    EXPECT_CALL(*mockRaftNode, shutdown(_)).Times(AtLeast(1));
+    EXPECT_CALL(*mockRaftNode, join()).Times(AtLeast(1));
+    EXPECT_CALL(*mockMetaStore, GetDentry(_, _, _))
+        .WillOnce(Return(MetaStatusCode::OK));
+
+    // current node is follower
+    node.UpdateAppliedIndex(101);
+    FLAGS_enable_follower_read = true;
+
+    // CASE 1: follower hasn't applied the index carried by request
+    {
+        GetDentryRequest request;
+        request.set_appliedindex(102);
+        GetDentryResponse response;
+        auto op = absl::make_unique<GetDentryOperator>(
+            &node, nullptr, &request, &response, nullptr);
+        op->Propose();
+        EXPECT_EQ(MetaStatusCode::REDIRECTED, response.statuscode());
+    }
+
+    // CASE 2: read on follower
+    {
+        GetDentryRequest request;
+        request.set_appliedindex(100);
+        GetDentryResponse response;
+        auto op = absl::make_unique<GetDentryOperator>(
+            &node, nullptr, &request, &response, nullptr);
+        op->Propose();
+        op.release();
+
+        node.FlushApplyQueue();
+        EXPECT_TRUE(response.has_appliedindex());
+        EXPECT_EQ(101, response.appliedindex());
+    }
+
+    FLAGS_enable_follower_read = false;
+    node.Stop();
+}
+
 TEST_F(MetaOperatorTest, PropostTest_IsNotLeaseLeader) {
     PoolId poolId = 100;
     CopysetId copysetId = 100;
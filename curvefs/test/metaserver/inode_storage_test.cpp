@@ -20,6 +20,7 @@
  * @Author: chenwei
  */
 
+#include <gflags/gflags.h>
 #include <gmock/gmock.h>
 #include <google/protobuf/util/message_differencer.h>
 #include <google/protobuf/empty.pb.h>
@@ -60,6 +61,9 @@ using ::curvefs::metaserver::storage::RandomStoragePath;
 using ::curvefs::metaserver::storage::RocksDBStorage;
 using ::curvefs::metaserver::storage::StorageOptions;
 
+DECLARE_uint32(s3chunkinfo_list_merge_threshold);
+DECLARE_uint32(s3chunkinfo_list_merge_max_size);
+
 namespace curvefs {
 namespace metaserver {
 
@@ -705,6 +709,253 @@ TEST_F(InodeStorageTest, PaddingInodeS3ChunkInfo) {
     }
 }
 
+TEST_F(InodeStorageTest, MergeS3ChunkInfoList) {
+    uint32_t fsId = 1;
+    uint64_t inodeId = 1;
+    InodeStorage storage(kvStorage_, nameGenerator_, 0);
+    ASSERT_TRUE(storage.Init());
+    uint32_t threshold = FLAGS_s3chunkinfo_list_merge_threshold;
+    FLAGS_s3chunkinfo_list_merge_threshold = 4;
+
+    Inode inode = GenInode(fsId, inodeId);
+    ASSERT_EQ(storage.Insert(inode, logIndex_++), MetaStatusCode::OK);
+
+    // step1: append s3chunkinfo, not reach merge threshold
+    std::vector<uint64_t> chunkIndexs{1, 1, 2, 1};
+    std::vector<S3ChunkInfoList> lists2add{
+        GenS3ChunkInfoList(100, 109), GenS3ChunkInfoList(110, 119),
+        GenS3ChunkInfoList(200, 209), GenS3ChunkInfoList(115, 119),
+    };
+    for (size_t i = 0; i < chunkIndexs.size(); i++) {
+        MetaStatusCode rc = storage.ModifyInodeS3ChunkInfoList(
+            fsId, inodeId, chunkIndexs[i], &lists2add[i], nullptr, logIndex_++);
+        ASSERT_EQ(rc, MetaStatusCode::OK);
+    }
+    CHECK_INODE_S3CHUNKINFOLIST(&storage, fsId, inodeId,
+                                std::vector<uint64_t>{1, 1, 1, 2},
+                                std::vector<S3ChunkInfoList>{
+                                    GenS3ChunkInfoList(100, 109),
+                                    GenS3ChunkInfoList(110, 119),
+                                    GenS3ChunkInfoList(115, 119),
+                                    GenS3ChunkInfoList(200, 209),
+                                });
+
+    // step2: reach merge threshold, duplicate s3chunkinfo been dropped
+    S3ChunkInfoList list2add = GenS3ChunkInfoList(120, 129);
+    ASSERT_EQ(storage.ModifyInodeS3ChunkInfoList(fsId, inodeId, 1, &list2add,
+                                                 nullptr, logIndex_++),
+              MetaStatusCode::OK);
+    CHECK_INODE_S3CHUNKINFOLIST(&storage, fsId, inodeId,
+                                std::vector<uint64_t>{1, 2},
+                                std::vector<S3ChunkInfoList>{
+                                    GenS3ChunkInfoList(100, 129),
+                                    GenS3ChunkInfoList(200, 209),
+                                });
+
+    // step3: check s3 meta size
+    Inode out;
+    ASSERT_EQ(storage.PaddingInodeS3ChunkInfo(
+                  fsId, inodeId, out.mutable_s3chunkinfomap(), 40),
+              MetaStatusCode::OK);
+    out.clear_s3chunkinfomap();
+    ASSERT_EQ(storage.PaddingInodeS3ChunkInfo(
+                  fsId, inodeId, out.mutable_s3chunkinfomap(), 39),
+              MetaStatusCode::INODE_S3_META_TOO_LARGE);
+
+    // step4: compaction delete the merged list
+    S3ChunkInfoList list2del = GenS3ChunkInfoList(100, 129);
+    list2add = GenS3ChunkInfoList(129, 129);
+    ASSERT_EQ(storage.ModifyInodeS3ChunkInfoList(fsId, inodeId, 1, &list2add,
+                                                 &list2del, logIndex_++),
+              MetaStatusCode::OK);
+    CHECK_INODE_S3CHUNKINFOLIST(&storage, fsId, inodeId,
+                                std::vector<uint64_t>{1, 2},
+                                std::vector<S3ChunkInfoList>{
+                                    GenS3ChunkInfoList(129, 129),
+                                    GenS3ChunkInfoList(200, 209),
+                                });
+
+    // step5: s3compact took a snapshot of (129, 139), then lists appended
+    //        after the snapshot been merged with it
+    std::vector<S3ChunkInfoList> lists{
+        GenS3ChunkInfoList(130, 139),
+        GenS3ChunkInfoList(140, 149),
+        GenS3ChunkInfoList(150, 159),
+    };
+    for (auto& list : lists) {
+        ASSERT_EQ(storage.ModifyInodeS3ChunkInfoList(
+                      fsId, inodeId, 1, &list, nullptr, logIndex_++),
+                  MetaStatusCode::OK);
+    }
+    CHECK_INODE_S3CHUNKINFOLIST(&storage, fsId, inodeId,
+                                std::vector<uint64_t>{1, 2},
+                                std::vector<S3ChunkInfoList>{
+                                    GenS3ChunkInfoList(129, 159),
+                                    GenS3ChunkInfoList(200, 209),
+                                });
+
+    // step6: compaction delete the snapshot range,
+    //        s3chunkinfo appended after the snapshot are kept
+    list2del = GenS3ChunkInfoList(129, 139);
+    list2add = GenS3ChunkInfoList(160, 160);
+    ASSERT_EQ(storage.ModifyInodeS3ChunkInfoList(fsId, inodeId, 1, &list2add,
+                                                 &list2del, logIndex_++),
+              MetaStatusCode::OK);
+    CHECK_INODE_S3CHUNKINFOLIST(&storage, fsId, inodeId,
+                                std::vector<uint64_t>{1, 1, 2},
+                                std::vector<S3ChunkInfoList>{
+                                    GenS3ChunkInfoList(140, 159),
+                                    GenS3ChunkInfoList(160, 160),
+                                    GenS3ChunkInfoList(200, 209),
+                                });
+    out.clear_s3chunkinfomap();
+    ASSERT_EQ(storage.PaddingInodeS3ChunkInfo(
+                  fsId, inodeId, out.mutable_s3chunkinfomap(), 31),
+              MetaStatusCode::OK);
+    out.clear_s3chunkinfomap();
+    ASSERT_EQ(storage.PaddingInodeS3ChunkInfo(
+                  fsId, inodeId, out.mutable_s3chunkinfomap(), 30),
+              MetaStatusCode::INODE_S3_META_TOO_LARGE);
+
+    FLAGS_s3chunkinfo_list_merge_threshold = threshold;
+}
+
+TEST_F(InodeStorageTest, DelS3ChunkInfoListOverlapListTail) {
+    uint32_t fsId = 1;
+    uint64_t inodeId = 1;
+    InodeStorage storage(kvStorage_, nameGenerator_, 0);
+    ASSERT_TRUE(storage.Init());
+    uint32_t threshold = FLAGS_s3chunkinfo_list_merge_threshold;
+    FLAGS_s3chunkinfo_list_merge_threshold = 0;
+
+    Inode inode = GenInode(fsId, inodeId);
+    ASSERT_EQ(storage.Insert(inode, logIndex_++), MetaStatusCode::OK);
+    std::vector<S3ChunkInfoList> lists2add{
+        GenS3ChunkInfoList(1, 5),
+        GenS3ChunkInfoList(10, 19),
+    };
+    for (auto& list : lists2add) {
+        ASSERT_EQ(storage.ModifyInodeS3ChunkInfoList(
+                      fsId, inodeId, 1, &list, nullptr, logIndex_++),
+                  MetaStatusCode::OK);
+    }
+
+    // current list range:  [      ]
+    // delete list range :      [      ]
+    S3ChunkInfoList list2del = GenS3ChunkInfoList(15, 25);
+    ASSERT_EQ(storage.ModifyInodeS3ChunkInfoList(fsId, inodeId, 1, nullptr,
+                                                 &list2del, logIndex_++),
+              MetaStatusCode::OK);
+    CHECK_INODE_S3CHUNKINFOLIST(&storage, fsId, inodeId,
+                                std::vector<uint64_t>{1, 1},
+                                std::vector<S3ChunkInfoList>{
+                                    GenS3ChunkInfoList(1, 5),
+                                    GenS3ChunkInfoList(10, 14),
+                                });
+
+    Inode out;
+    ASSERT_EQ(storage.PaddingInodeS3ChunkInfo(
+                  fsId, inodeId, out.mutable_s3chunkinfomap(), 10),
+              MetaStatusCode::OK);
+    out.clear_s3chunkinfomap();
+    ASSERT_EQ(storage.PaddingInodeS3ChunkInfo(
+                  fsId, inodeId, out.mutable_s3chunkinfomap(), 9),
+              MetaStatusCode::INODE_S3_META_TOO_LARGE);
+
+    FLAGS_s3chunkinfo_list_merge_threshold = threshold;
+}
+
+TEST_F(InodeStorageTest, DelS3ChunkInfoListOverlapListHead) {
+    uint32_t fsId = 1;
+    uint64_t inodeId = 1;
+    InodeStorage storage(kvStorage_, nameGenerator_, 0);
+    ASSERT_TRUE(storage.Init());
+    uint32_t threshold = FLAGS_s3chunkinfo_list_merge_threshold;
+    FLAGS_s3chunkinfo_list_merge_threshold = 0;
+
+    Inode inode = GenInode(fsId, inodeId);
+    ASSERT_EQ(storage.Insert(inode, logIndex_++), MetaStatusCode::OK);
+    std::vector<S3ChunkInfoList> lists2add{
+        GenS3ChunkInfoList(10, 19),
+        GenS3ChunkInfoList(30, 35),
+    };
+    for (auto& list : lists2add) {
+        ASSERT_EQ(storage.ModifyInodeS3ChunkInfoList(
+                      fsId, inodeId, 1, &list, nullptr, logIndex_++),
+                  MetaStatusCode::OK);
+    }
+
+    // current list range:      [      ]
+    // delete list range :  [      ]
+    S3ChunkInfoList list2del = GenS3ChunkInfoList(5, 14);
+    ASSERT_EQ(storage.ModifyInodeS3ChunkInfoList(fsId, inodeId, 1, nullptr,
+                                                 &list2del, logIndex_++),
+              MetaStatusCode::OK);
+    CHECK_INODE_S3CHUNKINFOLIST(&storage, fsId, inodeId,
+                                std::vector<uint64_t>{1, 1},
+                                std::vector<S3ChunkInfoList>{
+                                    GenS3ChunkInfoList(15, 19),
+                                    GenS3ChunkInfoList(30, 35),
+                                });
+
+    Inode out;
+    ASSERT_EQ(storage.PaddingInodeS3ChunkInfo(
+                  fsId, inodeId, out.mutable_s3chunkinfomap(), 11),
+              MetaStatusCode::OK);
+    out.clear_s3chunkinfomap();
+    ASSERT_EQ(storage.PaddingInodeS3ChunkInfo(
+                  fsId, inodeId, out.mutable_s3chunkinfomap(), 10),
+              MetaStatusCode::INODE_S3_META_TOO_LARGE);
+
+    FLAGS_s3chunkinfo_list_merge_threshold = threshold;
+}
+
+TEST_F(InodeStorageTest, MergeS3ChunkInfoListWithMaxSize) {
+    uint32_t fsId = 1;
+    uint64_t inodeId = 1;
+    InodeStorage storage(kvStorage_, nameGenerator_, 0);
+    ASSERT_TRUE(storage.Init());
+    uint32_t threshold = FLAGS_s3chunkinfo_list_merge_threshold;
+    uint32_t maxSize = FLAGS_s3chunkinfo_list_merge_max_size;
+    FLAGS_s3chunkinfo_list_merge_threshold = 2;
+    FLAGS_s3chunkinfo_list_merge_max_size = 16;
+
+    Inode inode = GenInode(fsId, inodeId);
+    ASSERT_EQ(storage.Insert(inode, logIndex_++), MetaStatusCode::OK);
+
+    // step1: merged list will exceed max size, not merged
+    std::vector<S3ChunkInfoList> lists2add{
+        GenS3ChunkInfoList(1, 10),
+        GenS3ChunkInfoList(11, 20),
+    };
+    for (auto& list : lists2add) {
+        ASSERT_EQ(storage.ModifyInodeS3ChunkInfoList(
+                      fsId, inodeId, 1, &list, nullptr, logIndex_++),
+                  MetaStatusCode::OK);
+    }
+    CHECK_INODE_S3CHUNKINFOLIST(&storage, fsId, inodeId,
+                                std::vector<uint64_t>{1, 1},
+                                std::vector<S3ChunkInfoList>{
+                                    GenS3ChunkInfoList(1, 10),
+                                    GenS3ChunkInfoList(11, 20),
+                                });
+
+    // step2: only merge the adjacent lists fit in max size
+    S3ChunkInfoList list2add = GenS3ChunkInfoList(21, 22);
+    ASSERT_EQ(storage.ModifyInodeS3ChunkInfoList(fsId, inodeId, 1, &list2add,
+                                                 nullptr, logIndex_++),
+              MetaStatusCode::OK);
+    CHECK_INODE_S3CHUNKINFOLIST(&storage, fsId, inodeId,
+                                std::vector<uint64_t>{1, 1},
+                                std::vector<S3ChunkInfoList>{
+                                    GenS3ChunkInfoList(1, 10),
+                                    GenS3ChunkInfoList(11, 22),
+                                });
+
+    FLAGS_s3chunkinfo_list_merge_threshold = threshold;
+    FLAGS_s3chunkinfo_list_merge_max_size = maxSize;
+}
+
 TEST_F(InodeStorageTest, GetAllS3ChunkInfoList) {
     InodeStorage storage(kvStorage_, nameGenerator_, 0);
     ASSERT_TRUE(storage.Init());
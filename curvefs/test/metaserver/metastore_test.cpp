@@ -1438,6 +1438,121 @@ TEST_F(MetastoreTest, testBatchGetInodeAttr) {
     }
 }
 
+TEST_F(MetastoreTest, testListDentryWithInodeAttr) {
+    MetaStoreImpl metastore(copyset_.get(), options_);
+    ASSERT_TRUE(metastore.InitStorage());
+
+    uint32_t poolId = 2;
+    uint32_t copysetId = 3;
+    uint32_t partitionId = 1;
+    uint32_t fsId = 1;
+
+    // create partition1
+    CreatePartitionRequest createPartitionRequest;
+    CreatePartitionResponse createPartitionResponse;
+    PartitionInfo partitionInfo1;
+    partitionInfo1.set_fsid(fsId);
+    partitionInfo1.set_poolid(poolId);
+    partitionInfo1.set_copysetid(copysetId);
+    partitionInfo1.set_partitionid(partitionId);
+    partitionInfo1.set_start(100);
+    partitionInfo1.set_end(1000);
+    createPartitionRequest.mutable_partition()->CopyFrom(partitionInfo1);
+    MetaStatusCode ret = metastore.CreatePartition(
+        &createPartitionRequest, &createPartitionResponse, logIndex_++);
+    ASSERT_EQ(ret, MetaStatusCode::OK);
+
+    // create parent and child inode
+    CreateInodeRequest createRequest;
+    CreateInodeResponse createResponse;
+    createRequest.set_poolid(poolId);
+    createRequest.set_copysetid(copysetId);
+    createRequest.set_partitionid(partitionId);
+    createRequest.set_fsid(fsId);
+    createRequest.set_length(0);
+    createRequest.set_uid(100);
+    createRequest.set_gid(200);
+    createRequest.set_mode(777);
+    createRequest.set_type(FsFileType::TYPE_DIRECTORY);
+    ret = metastore.CreateInode(&createRequest, &createResponse, logIndex_++);
+    ASSERT_EQ(ret, MetaStatusCode::OK);
+    uint64_t parentId = createResponse.inode().inodeid();
+
+    createRequest.set_length(4096);
+    createRequest.set_type(FsFileType::TYPE_FILE);
+    createRequest.set_parent(parentId);
+    ret = metastore.CreateInode(&createRequest, &createResponse, logIndex_++);
+    ASSERT_EQ(ret, MetaStatusCode::OK);
+    uint64_t childId = createResponse.inode().inodeid();
+
+    // create dentrys, one of them points to inode in other partition
+    CreateDentryRequest createDentryRequest;
+    CreateDentryResponse createDentryResponse;
+    createDentryRequest.set_poolid(poolId);
+    createDentryRequest.set_copysetid(copysetId);
+    createDentryRequest.set_partitionid(partitionId);
+    Dentry dentry;
+    dentry.set_fsid(fsId);
+    dentry.set_parentinodeid(parentId);
+    dentry.set_txid(0);
+    dentry.set_type(FsFileType::TYPE_FILE);
+
+    dentry.set_name("local");
+    dentry.set_inodeid(childId);
+    createDentryRequest.mutable_dentry()->CopyFrom(dentry);
+    ret = metastore.CreateDentry(&createDentryRequest, &createDentryResponse,
+                                 logIndex_++);
+    ASSERT_EQ(ret, MetaStatusCode::OK);
+
+    dentry.set_name("remote");
+    dentry.set_inodeid(5000);
+    createDentryRequest.mutable_dentry()->CopyFrom(dentry);
+    ret = metastore.CreateDentry(&createDentryRequest, &createDentryResponse,
+                                 logIndex_++);
+    ASSERT_EQ(ret, MetaStatusCode::OK);
+
+    ListDentryRequest listRequest;
+    ListDentryResponse listResponse;
+    listRequest.set_poolid(poolId);
+    listRequest.set_copysetid(copysetId);
+    listRequest.set_partitionid(partitionId);
+    listRequest.set_fsid(fsId);
+    listRequest.set_dirinodeid(parentId);
+    listRequest.set_txid(0);
+
+    // without inode attribute
+    ret = metastore.ListDentry(&listRequest, &listResponse, logIndex_++);
+    ASSERT_EQ(ret, MetaStatusCode::OK);
+    ASSERT_EQ(listResponse.dentrys_size(), 2);
+    ASSERT_EQ(listResponse.attrs_size(), 0);
+
+    // with inode attribute, only inode in this partition is returned
+    listResponse.Clear();
+    listRequest.set_returninodeattr(true);
+    ret = metastore.ListDentry(&listRequest, &listResponse, logIndex_++);
+    ASSERT_EQ(ret, MetaStatusCode::OK);
+    ASSERT_EQ(listResponse.dentrys_size(), 2);
+    ASSERT_EQ(listResponse.attrs_size(), 1);
+    ASSERT_EQ(listResponse.attrs(0).inodeid(), childId);
+    ASSERT_EQ(listResponse.attrs(0).length(), 4096);
+
+    // streaming mode also lists at most count dentrys
+    listResponse.Clear();
+    listRequest.set_count(1);
+    listRequest.set_streaming(true);
+    ret = metastore.ListDentry(&listRequest, &listResponse, logIndex_++);
+    ASSERT_EQ(ret, MetaStatusCode::OK);
+    ASSERT_EQ(listResponse.dentrys_size(), 1);
+    ASSERT_EQ(listResponse.dentrys(0).name(), "local");
+
+    listResponse.Clear();
+    listRequest.set_last("local");
+    ret = metastore.ListDentry(&listRequest, &listResponse, logIndex_++);
+    ASSERT_EQ(ret, MetaStatusCode::OK);
+    ASSERT_EQ(listResponse.dentrys_size(), 1);
+    ASSERT_EQ(listResponse.dentrys(0).name(), "remote");
+}
+
 TEST_F(MetastoreTest, testBatchGetXAttr) {
     MetaStoreImpl metastore(copyset_.get(), options_);
     ASSERT_TRUE(metastore.InitStorage());
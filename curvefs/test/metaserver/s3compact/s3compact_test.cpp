@@ -66,6 +66,7 @@ class S3CompactTest : public ::testing::Test {
         opts_.enable = true;
         opts_.threadNum = 1;
         opts_.fragmentThreshold = 20;
+        opts_.smallFragmentSize = 0;
         opts_.maxChunksPerCompact = 10;
         opts_.s3ReadMaxRetry = 2;
         opts_.s3ReadRetryInterval = 1;
@@ -98,6 +99,9 @@ class S3CompactTest : public ::testing::Test {
         workerOptions_.s3adapterManager = s3adapterManager_.get();
         workerOptions_.s3infoCache = s3infoCache_.get();
         workerOptions_.fragmentThreshold = opts_.fragmentThreshold;
+        workerOptions_.smallFragmentSize = opts_.smallFragmentSize;
+        workerOptions_.chunkPool = nullptr;
+        workerOptions_.throttle = nullptr;
         workerOptions_.maxChunksPerCompact = opts_.maxChunksPerCompact;
         workerOptions_.s3ReadMaxRetry = opts_.s3ReadMaxRetry;
         workerOptions_.s3ReadRetryInterval = opts_.s3ReadRetryInterval;
@@ -268,6 +272,39 @@ TEST_F(S3CompactTest, test_GetNeedCompact) {
               opts_.maxChunksPerCompact);
 }
 
+TEST_F(S3CompactTest, test_GetNeedCompactWithSmallFragmentSize) {
+    workerOptions_.smallFragmentSize = 4;
+    ::google::protobuf::Map<uint64_t, S3ChunkInfoList> s3chunkinfoMap;
+
+    // many large fragments, no need to compact
+    S3ChunkInfoList l0;
+    for (int i = 0; i < 30; i++) {
+        auto ref = l0.add_s3chunks();
+        ref->set_chunkid(i);
+        ref->set_offset(i);
+        ref->set_len(4);
+    }
+    s3chunkinfoMap.insert({0, l0});
+    ASSERT_EQ(impl_->GetNeedCompact(s3chunkinfoMap, 64, 64).size(), 0);
+
+    // small fragments reach threshold
+    S3ChunkInfoList l1;
+    for (int i = 0; i < 30; i++) {
+        auto ref = l1.add_s3chunks();
+        ref->set_chunkid(i);
+        ref->set_offset(i + 64);
+        ref->set_len(i % 2 == 0 ? 1 : 4);
+    }
+    s3chunkinfoMap.insert({1, l1});
+    ASSERT_EQ(impl_->GetNeedCompact(s3chunkinfoMap, 64 * 2, 64).size(), 0);
+    workerOptions_.fragmentThreshold = 10;
+    ASSERT_EQ(impl_->GetNeedCompact(s3chunkinfoMap, 64 * 2, 64).size(), 1);
+
+    // count all fragments
+    workerOptions_.smallFragmentSize = 0;
+    ASSERT_EQ(impl_->GetNeedCompact(s3chunkinfoMap, 64 * 2, 64).size(), 2);
+}
+
 TEST_F(S3CompactTest, test_DeleteObjs) {
     std::vector<std::string> objs;
     objs.emplace_back("obj1");
@@ -696,5 +733,116 @@ TEST_F(S3CompactTest, test_CompactChunks) {
     mockImpl_->CompactChunks(t);
 }
 
+TEST_F(S3CompactTest, test_CompactChunksConcurrently) {
+    uint64_t blockSize = 4;
+    uint64_t chunkSize = 64;
+    TaskThreadPool<> chunkPool;
+    ASSERT_EQ(chunkPool.Start(4), 0);
+    workerOptions_.chunkPool = &chunkPool;
+
+    Inode tmp;
+    auto mock_updateinode =
+        [&](CopysetNode* copysetNode, const PartitionInfo& pinfo,
+            uint64_t inode,
+            ::google::protobuf::Map<uint64_t, S3ChunkInfoList> s3ChunkInfoAdd,
+            ::google::protobuf::Map<uint64_t, S3ChunkInfoList>
+                s3ChunkInfoRemove) {
+            *tmp.mutable_s3chunkinfomap() = s3ChunkInfoAdd;
+            return MetaStatusCode::OK;
+        };
+    EXPECT_CALL(*mockImpl_, UpdateInode_rvr(_, _, _, _, _))
+        .WillRepeatedly(testing::Invoke(mock_updateinode));
+    EXPECT_CALL(*s3adapter_, PutObject(_, _)).WillRepeatedly(Return(0));
+    EXPECT_CALL(*s3adapter_, DeleteObject(_)).WillRepeatedly(Return(0));
+    auto mock_getobj = [&](const Aws::String& key, std::string* data) {
+        data->clear();
+        data->append(blockSize, '\0');
+        return 0;
+    };
+    EXPECT_CALL(*s3adapter_, GetObject(_, _))
+        .WillRepeatedly(testing::Invoke(mock_getobj));
+    auto* mockCopysetNodeWrapper = mockCopysetNodeWrapper_.get();
+    EXPECT_CALL(*mockCopysetNodeWrapper, IsLeaderTerm())
+        .WillRepeatedly(Return(true));
+    EXPECT_CALL(*mockCopysetNodeWrapper, IsValid())
+        .WillRepeatedly(Return(true));
+    auto pairResult = std::make_pair(0, s3adapter_.get());
+    EXPECT_CALL(*s3adapterManager_, GetS3Adapter())
+        .WillRepeatedly(Return(pairResult));
+    EXPECT_CALL(*s3adapterManager_, ReleaseS3Adapter(_))
+        .WillRepeatedly(Return());
+    auto mock_gets3info_success = [&](uint64_t fsid, S3Info* s3info) {
+        s3info->set_ak("5");
+        s3info->set_sk("5");
+        s3info->set_endpoint("5");
+        s3info->set_bucketname("5");
+        s3info->set_blocksize(blockSize);
+        s3info->set_chunksize(chunkSize);
+        s3info->set_objectprefix(0);
+        return 0;
+    };
+    EXPECT_CALL(*s3infoCache_, GetS3Info(_, _))
+        .WillRepeatedly(testing::Invoke(mock_gets3info_success));
+    std::string v = "5";
+    EXPECT_CALL(*s3adapter_, GetS3Ak()).WillRepeatedly(Return(v));
+    EXPECT_CALL(*s3adapter_, GetS3Sk()).WillRepeatedly(Return(v));
+    EXPECT_CALL(*s3adapter_, GetS3Endpoint()).WillRepeatedly(Return(v));
+    EXPECT_CALL(*s3adapter_, GetBucketName()).WillRepeatedly(Return(v));
+
+    struct CompactInodeJob::S3CompactTask t {
+        inodeManager_, Key4Inode(1, 1),
+            PartitionInfo(), std::move(mockCopysetNodeWrapper_)
+    };
+
+    Inode inode1;
+    inode1.set_fsid(1);
+    inode1.set_inodeid(1);
+    inode1.set_length(chunkSize * 3);
+    inode1.set_nlink(1);
+    inode1.set_ctime(0);
+    inode1.set_ctime_ns(0);
+    inode1.set_mtime(0);
+    inode1.set_mtime_ns(0);
+    inode1.set_atime(0);
+    inode1.set_atime_ns(0);
+    inode1.set_uid(0);
+    inode1.set_gid(0);
+    inode1.set_mode(0);
+    inode1.set_type(FsFileType::TYPE_FILE);
+    ASSERT_EQ(inodeStorage_->Insert(inode1, logIndex_++), MetaStatusCode::OK);
+
+    // 3 chunks, all of them have too many fragments
+    for (uint64_t index = 0; index < 3; index++) {
+        S3ChunkInfoList l;
+        for (uint64_t i = 0; i < 32; i++) {
+            auto ref = l.add_s3chunks();
+            ref->set_chunkid(index * 32 + i);
+            ref->set_compaction(0);
+            ref->set_offset(index * chunkSize + i * 2);
+            ref->set_len(2);
+            ref->set_size(2);
+            ref->set_zero(false);
+        }
+        ASSERT_EQ(inodeStorage_->ModifyInodeS3ChunkInfoList(
+                      inode1.fsid(), inode1.inodeid(), index, &l, nullptr,
+                      logIndex_++),
+                  MetaStatusCode::OK);
+    }
+
+    mockImpl_->CompactChunks(t);
+    ASSERT_EQ(tmp.s3chunkinfomap().size(), 3);
+    for (uint64_t index = 0; index < 3; index++) {
+        const auto& l = tmp.s3chunkinfomap().at(index);
+        ASSERT_EQ(l.s3chunks_size(), 1);
+        ASSERT_EQ(l.s3chunks(0).chunkid(), index * 32 + 31);
+        ASSERT_EQ(l.s3chunks(0).compaction(), 1);
+        ASSERT_EQ(l.s3chunks(0).offset(), index * chunkSize);
+        ASSERT_EQ(l.s3chunks(0).len(), chunkSize);
+    }
+
+    chunkPool.Stop();
+    workerOptions_.chunkPool = nullptr;
+}
+
 }  // namespace metaserver
 }  // namespace curvefs
@@ -218,5 +218,48 @@ TEST_F(SpaceManagerImplTest, TestMultiThreadAlloc) {
     ASSERT_TRUE(spaceManager_->Shutdown());
 }
 
+TEST_F(SpaceManagerImplTest, TestPrefetchBlockGroup) {
+    opt_.prefetchThreshold = kBlockGroupSize;
+    spaceManager_.reset(new SpaceManagerImpl(opt_, mdsClient_, devClient_));
+
+    mds::space::BlockGroup group;
+    group.set_offset(0);
+    group.set_size(kBlockGroupSize);
+    group.set_available(kBlockGroupSize);
+    group.set_bitmaplocation(curvefs::common::BitmapLocation::AtStart);
+
+    mds::space::BlockGroup group2(group);
+    group2.set_offset(kBlockGroupSize);
+
+    std::atomic<bool> prefetched(false);
+    EXPECT_CALL(*mdsClient_, AllocateVolumeBlockGroup(_, _, _, _))
+        .WillOnce(Invoke(MockAllocateBlockGroup{group}))
+        .WillOnce(Invoke(
+            [&](uint32_t fsId, uint32_t count, const std::string& owner,
+                std::vector<curvefs::mds::space::BlockGroup>* groups) {
+                prefetched.store(true);
+                return MockAllocateBlockGroup{group2}(fsId, count, owner,
+                                                      groups);
+            }));
+
+    EXPECT_CALL(*devClient_, Write(_, _, _))
+        .Times(AtLeast(1))
+        .WillRepeatedly(Invoke(MockWrite));
+
+    // available space is less than threshold after allocation, so the next
+    // block group is allocated in background
+    std::vector<Extent> ext;
+    ASSERT_TRUE(spaceManager_->Alloc(kBlockSize, {}, &ext));
+
+    for (int i = 0; i < 100 && !prefetched.load(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(prefetched.load());
+
+    EXPECT_CALL(*mdsClient_, ReleaseVolumeBlockGroup(_, _, _))
+        .WillOnce(Return(SpaceErrCode::SpaceOk));
+    ASSERT_TRUE(spaceManager_->Shutdown());
+}
+
 }  // namespace volume
 }  // namespace curvefs
@@ -23,6 +23,7 @@
 #include "src/chunkserver/chunk_service.h"
 
 #include <glog/logging.h>
+#include <gflags/gflags.h>
 #include <brpc/closure_guard.h>
 #include <brpc/controller.h>
 
@@ -39,6 +40,9 @@
 
 #include "include/curve_compiler_specific.h"
 
+DEFINE_uint32(maxBatchChunkOpSize, 1024,
+              "max number of chunks in one batch chunk request");
+
 namespace curve {
 namespace chunkserver {
 
@@ -470,10 +474,126 @@ void ChunkServiceImpl::GetChunkInfo(RpcController *controller,
         return;
     }
 
+    GetChunkInfoFromDataStore(nodePtr, request->chunkid(), response);
+}
+
+void ChunkServiceImpl::BatchChunkOp(RpcController *controller,
+                                    const ChunkRequest *request,
+                                    ChunkResponse *response,
+                                    Closure *done) {
+    ChunkServiceClosure* closure =
+        new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
+                                               request,
+                                               response,
+                                               done);
+    CHECK(nullptr != closure) << "new chunk service closure failed";
+
+    brpc::ClosureGuard doneGuard(closure);
+
+    if (inflightThrottle_->IsOverLoad()) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
+        LOG_EVERY_N(WARNING, 100)
+            << "BatchChunkOp: "
+            << "too many inflight requests to process in chunkserver";
+        return;
+    }
+
+    // 判断request参数是否合法
+    if (!CheckBatchChunkRequest(request)) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST);
+        LOG(ERROR) << "batch chunk op failed, invalid request: "
+                   << request->logicpoolid() << "," << request->copysetid()
+                   << ", sub request num: " << request->subrequests_size();
+        return;
+    }
+
+    // 判断copyset是否存在
+    auto nodePtr = copysetNodeManager_->GetCopysetNode(request->logicpoolid(),
+                                                       request->copysetid());
+    if (nullptr == nodePtr) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_COPYSET_NOTEXIST);
+        LOG(WARNING) << "batch chunk op failed, copyset node is not found:"
+                     << request->logicpoolid() << "," << request->copysetid();
+        return;
+    }
+
+    std::shared_ptr<BatchChunkOpRequest>
+        req = std::make_shared<BatchChunkOpRequest>(nodePtr,
+                                                    controller,
+                                                    request,
+                                                    response,
+                                                    doneGuard.release());
+    req->Process();
+}
+
+void ChunkServiceImpl::BatchGetChunkInfo(
+    RpcController *controller,
+    const BatchGetChunkInfoRequest *request,
+    BatchGetChunkInfoResponse *response,
+    Closure *done) {
+    (void)controller;
+    ChunkServiceClosure* closure =
+        new (std::nothrow) ChunkServiceClosure(inflightThrottle_,
+                                               nullptr,
+                                               nullptr,
+                                               done);
+    CHECK(nullptr != closure) << "new chunk service closure failed";
+
+    brpc::ClosureGuard doneGuard(closure);
+
+    if (inflightThrottle_->IsOverLoad()) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_OVERLOAD);
+        LOG_EVERY_N(WARNING, 100)
+            << "BatchGetChunkInfo: "
+            << "too many inflight requests to process in chunkserver";
+        return;
+    }
+
+    if (request->chunkid_size() == 0 ||
+        static_cast<uint32_t>(request->chunkid_size()) >
+            FLAGS_maxBatchChunkOpSize) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST);
+        LOG(ERROR) << "BatchGetChunkInfo failed, invalid chunk num: "
+                   << request->chunkid_size();
+        return;
+    }
+
+    // 判断copyset是否存在
+    auto nodePtr =
+        copysetNodeManager_->GetCopysetNode(request->logicpoolid(),
+                                            request->copysetid());
+    if (nullptr == nodePtr) {
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_COPYSET_NOTEXIST);
+        LOG(WARNING) << "BatchGetChunkInfo failed, copyset node is not found: "
+                     << request->logicpoolid() << "," << request->copysetid();
+        return;
+    }
+
+    // 检查任期和自己是不是Leader
+    if (!nodePtr->IsLeaderTerm()) {
+        PeerId leader = nodePtr->GetLeaderId();
+        if (!leader.is_empty()) {
+            response->set_redirect(leader.to_string());
+        }
+        response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED);
+        return;
+    }
+
+    for (int i = 0; i < request->chunkid_size(); ++i) {
+        GetChunkInfoFromDataStore(nodePtr, request->chunkid(i),
+                                  response->add_chunkinfos());
+    }
+    response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+}
+
+void ChunkServiceImpl::GetChunkInfoFromDataStore(
+    const std::shared_ptr<CopysetNode> &nodePtr,
+    ChunkID chunkId,
+    GetChunkInfoResponse *response) const {
     CSErrorCode ret;
     CSChunkInfo chunkInfo;
 
-    ret = nodePtr->GetDataStore()->GetChunkInfo(request->chunkid(), &chunkInfo);
+    ret = nodePtr->GetDataStore()->GetChunkInfo(chunkId, &chunkInfo);
 
     if (CSErrorCode::Success == ret) {
         // 1.成功，此时chunk文件肯定存在
@@ -487,9 +607,9 @@ void ChunkServiceImpl::GetChunkInfo(RpcController *controller,
     } else {
         // 3.其他错误
         LOG(ERROR) << "get chunk info failed, "
-                   << " logic pool id: " << request->logicpoolid()
-                   << " copyset id: " << request->copysetid()
-                   << " chunk id: " << request->chunkid() << ", "
+                   << " logic pool id: " << nodePtr->GetLogicPoolId()
+                   << " copyset id: " << nodePtr->GetCopysetId()
+                   << " chunk id: " << chunkId << ", "
                    << " errno: " << errno << ", "
                    << " error message: " << strerror(errno)
                    << " data store return: " << ret;
@@ -577,6 +697,31 @@ void ChunkServiceImpl::UpdateEpoch(RpcController *controller,
     }
 }
 
+bool ChunkServiceImpl::CheckBatchChunkRequest(
+    const ChunkRequest *request) const {
+    if (request->optype() != CHUNK_OP_TYPE::CHUNK_OP_BATCH ||
+        request->subrequests_size() == 0 ||
+        static_cast<uint32_t>(request->subrequests_size()) >
+            FLAGS_maxBatchChunkOpSize) {
+        return false;
+    }
+
+    // 子请求必须属于同一个copyset，且请求类型支持批量处理
+    for (const auto &subRequest : request->subrequests()) {
+        if (subRequest.logicpoolid() != request->logicpoolid() ||
+            subRequest.copysetid() != request->copysetid() ||
+            !BatchChunkOpRequest::IsSupportedSubRequest(subRequest)) {
+            return false;
+        }
+        // 请求创建的chunk大小和copyset配置的大小不一致
+        if (subRequest.optype() == CHUNK_OP_TYPE::CHUNK_OP_CREATE_CLONE &&
+            subRequest.size() != maxChunkSize_) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool ChunkServiceImpl::CheckRequestOffsetAndLength(uint32_t offset,
                                                    uint32_t len) const {
     // 检查offset+len是否越界
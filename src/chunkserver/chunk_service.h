@@ -37,6 +37,7 @@ namespace chunkserver {
 using ::google::protobuf::RpcController;
 using ::google::protobuf::Closure;
 
+class CopysetNode;
 class CopysetNodeManager;
 
 class ChunkServiceImpl : public ChunkService {
@@ -98,7 +99,34 @@ class ChunkServiceImpl : public ChunkService {
                     UpdateEpochResponse *response,
                     Closure *done);
 
+    void BatchChunkOp(RpcController *controller,
+                      const ChunkRequest *request,
+                      ChunkResponse *response,
+                      Closure *done);
+
+    void BatchGetChunkInfo(RpcController *controller,
+                           const BatchGetChunkInfoRequest *request,
+                           BatchGetChunkInfoResponse *response,
+                           Closure *done);
+
  private:
+    /**
+     * 从datastore中获取chunk的版本信息
+     * @param nodePtr[in]: chunk所在的复制组
+     * @param chunkId[in]: chunk id
+     * @param response[out]: chunk的版本号和处理结果
+     */
+    void GetChunkInfoFromDataStore(const std::shared_ptr<CopysetNode> &nodePtr,
+                                   ChunkID chunkId,
+                                   GetChunkInfoResponse *response) const;
+
+    /**
+     * 检查批量请求的子请求是否合法
+     * @param request[in]: 批量请求
+     * @return true，说明合法，否则返回false
+     */
+    bool CheckBatchChunkRequest(const ChunkRequest *request) const;
+
     /**
      * 验证op request的offset和length是否越界和对齐
      * @param offset[in]: op request' offset
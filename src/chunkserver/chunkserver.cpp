@@ -190,8 +190,20 @@ int ChunkServer::Run(int argc, char** argv) {
     LOG_IF(FATAL, !conf.GetUInt32Value("clone.slice_size", &sliceSize));
     bool enablePaste = false;
     LOG_IF(FATAL, !conf.GetBoolValue("clone.enable_paste", &enablePaste));
-    cloneOptions.core =
-        std::make_shared<CloneCore>(sliceSize, enablePaste, copyer);
+    bool enablePrefetch = false;
+    LOG_IF(WARNING, !conf.GetBoolValue("clone.enable_prefetch",
+        &enablePrefetch))
+        << "clone.enable_prefetch not found, use default: " << enablePrefetch;
+    std::shared_ptr<ClonePrefetcher> prefetcher = nullptr;
+    if (enablePrefetch) {
+        ClonePrefetchOptions prefetchOptions;
+        InitClonePrefetchOptions(&conf, &prefetchOptions);
+        prefetcher = std::make_shared<ClonePrefetcher>();
+        LOG_IF(FATAL, prefetcher->Init(prefetchOptions, copyer) != 0)
+            << "Failed to initialize clone prefetcher.";
+    }
+    cloneOptions.core = std::make_shared<CloneCore>(
+        sliceSize, enablePaste, copyer, prefetcher);
     LOG_IF(FATAL, cloneManager_.Init(cloneOptions) != 0)
         << "Failed to initialize clone manager.";
 
@@ -437,6 +449,10 @@ int ChunkServer::Run(int argc, char** argv) {
         << "Failed to start trash.";
     LOG_IF(FATAL, cloneManager_.Run() != 0)
         << "Failed to start clone manager.";
+    if (prefetcher != nullptr) {
+        LOG_IF(FATAL, prefetcher->Run() != 0)
+            << "Failed to start clone prefetcher.";
+    }
     LOG_IF(FATAL, heartbeat_.Run() != 0)
         << "Failed to start heartbeat manager.";
     LOG_IF(FATAL, copysetNodeManager_->Run() != 0)
@@ -465,6 +481,11 @@ int ChunkServer::Run(int argc, char** argv) {
 
     LOG_IF(ERROR, heartbeat_.Fini() != 0)
         << "Failed to shutdown heartbeat manager.";
+    // 预取任务会向copyset提交paste请求，需要在copyset停止前退出
+    if (prefetcher != nullptr) {
+        LOG_IF(ERROR, prefetcher->Fini() != 0)
+            << "Failed to shutdown clone prefetcher.";
+    }
     LOG_IF(ERROR, copysetNodeManager_->Fini() != 0)
         << "Failed to shutdown CopysetNodeManager.";
     LOG_IF(ERROR, cloneManager_.Fini() != 0)
@@ -752,6 +773,26 @@ void ChunkServer::InitCloneOptions(
         &cloneOptions->queueCapacity));
 }
 
+void ChunkServer::InitClonePrefetchOptions(
+    common::Configuration *conf, ClonePrefetchOptions *prefetchOptions) {
+    LOG_IF(WARNING, !conf->GetUInt32Value("clone.prefetch_size",
+        &prefetchOptions->prefetchSize))
+        << "clone.prefetch_size not found, use default: "
+        << prefetchOptions->prefetchSize;
+    LOG_IF(WARNING, !conf->GetUInt32Value("clone.prefetch_thread_num",
+        &prefetchOptions->threadNum))
+        << "clone.prefetch_thread_num not found, use default: "
+        << prefetchOptions->threadNum;
+    LOG_IF(WARNING, !conf->GetUInt32Value("clone.prefetch_queue_depth",
+        &prefetchOptions->queueCapacity))
+        << "clone.prefetch_queue_depth not found, use default: "
+        << prefetchOptions->queueCapacity;
+    LOG_IF(WARNING, !conf->GetUInt64Value("clone.prefetch_bps",
+        &prefetchOptions->bandwidthBps))
+        << "clone.prefetch_bps not found, use default: "
+        << prefetchOptions->bandwidthBps;
+}
+
 void ChunkServer::InitScanOptions(
     common::Configuration *conf, ScanManagerOptions *scanOptions) {
     LOG_IF(FATAL, !conf->GetUInt32Value("copyset.scan_interval_sec",
@@ -781,6 +822,10 @@ void ChunkServer::InitHeartbeatOptions(
         &heartbeatOptions->intervalSec));
     LOG_IF(FATAL, !conf->GetUInt32Value("mds.heartbeat_timeout",
         &heartbeatOptions->timeout));
+    LOG_IF(WARNING, !conf->GetUInt32Value("mds.heartbeat_full_report_interval",
+        &heartbeatOptions->fullReportInterval))
+        << "mds.heartbeat_full_report_interval not found, use default: "
+        << heartbeatOptions->fullReportInterval;
 }
 
 void ChunkServer::InitRegisterOptions(
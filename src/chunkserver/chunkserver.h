@@ -76,6 +76,9 @@ class ChunkServer {
     void InitCloneOptions(common::Configuration *conf,
         CloneOptions *cloneOptions);
 
+    void InitClonePrefetchOptions(common::Configuration *conf,
+        ClonePrefetchOptions *prefetchOptions);
+
     void InitScanOptions(common::Configuration *conf,
         ScanManagerOptions *scanOptions);
 
@@ -180,7 +180,15 @@ int CloneCore::CloneReadByLocalInfo(
                                                shared_from_this(),
                                                downloadCtx,
                                                doneGuard.release());
-        copyer_->DownloadAsync(downloadClosure);
+        // 用户读到了未拷贝的区域，在后台把chunk剩余的数据也拷贝过来
+        // 需要在下载前提交，下载完成后request可能已经被释放
+        if (prefetcher_ != nullptr &&
+            CHUNK_OP_TYPE::CHUNK_OP_READ == request->optype()) {
+            prefetcher_->Prefetch(readRequest->node_,
+                                  *request,
+                                  chunkInfo.location);
+        }
+        DownloadOrJoinInflight(downloadClosure);
         return 0;
     }
 
@@ -215,10 +223,19 @@ void CloneCore::CloneReadByRequestInfo(std::shared_ptr<ReadChunkRequest>
                                     shared_from_this(),
                                     downloadCtx,
                                     doneGuard.release());
-    copyer_->DownloadAsync(downloadClosure);
+    DownloadOrJoinInflight(downloadClosure);
     return;
 }
 
+void CloneCore::DownloadOrJoinInflight(DownloadClosure* downloadClosure) {
+    // 相同的源数据正在被预取时等待预取的结果，避免重复从源端下载
+    if (prefetcher_ != nullptr &&
+        prefetcher_->JoinInflight(downloadClosure)) {
+        return;
+    }
+    copyer_->DownloadAsync(downloadClosure);
+}
+
 int CloneCore::HandleReadRequest(
     std::shared_ptr<ReadChunkRequest> readRequest,
     Closure* done) {
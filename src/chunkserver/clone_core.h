@@ -33,6 +33,7 @@
 #include "include/chunkserver/chunkserver_common.h"
 #include "src/common/timeutility.h"
 #include "src/chunkserver/clone_copyer.h"
+#include "src/chunkserver/clone_prefetcher.h"
 #include "src/chunkserver/datastore/define.h"
 
 namespace curve {
@@ -115,10 +116,12 @@ class CloneCore : public std::enable_shared_from_this<CloneCore> {
     friend class DownloadClosure;
  public:
     CloneCore(uint32_t sliceSize, bool enablePaste,
-              std::shared_ptr<OriginCopyer> copyer)
+              std::shared_ptr<OriginCopyer> copyer,
+              std::shared_ptr<ClonePrefetcher> prefetcher = nullptr)
         : sliceSize_(sliceSize)
         , enablePaste_(enablePaste)
-        , copyer_(copyer) {}
+        , copyer_(copyer)
+        , prefetcher_(prefetcher) {}
     virtual ~CloneCore() {}
 
     /**
@@ -149,6 +152,12 @@ class CloneCore : public std::enable_shared_from_this<CloneCore> {
     void CloneReadByRequestInfo(std::shared_ptr<ReadChunkRequest> readRequest,
         Closure* done);
 
+    /**
+     * 从源端下载数据，如果相同的源数据正在被预取则等待预取的结果
+     * @param[in] downloadClosure: 下载请求，完成后执行
+     */
+    void DownloadOrJoinInflight(DownloadClosure* downloadClosure);
+
     /**
      * 从本地chunk中读取请求的区域，然后设置response
      * @param readRequest: 用户的ReadRequest
@@ -197,6 +206,8 @@ class CloneCore : public std::enable_shared_from_this<CloneCore> {
     bool enablePaste_;
     // 负责从源端下载数据
     std::shared_ptr<OriginCopyer> copyer_;
+    // 负责在后台预取clone chunk剩余的数据，为空表示不预取
+    std::shared_ptr<ClonePrefetcher> prefetcher_;
 };
 
 }  // namespace chunkserver
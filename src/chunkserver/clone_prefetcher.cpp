@@ -0,0 +1,384 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-28
+ */
+
+#include "src/chunkserver/clone_prefetcher.h"
+
+#include <glog/logging.h>
+
+#include <cstring>
+#include <vector>
+
+#include "src/common/bitmap.h"
+#include "src/common/concurrent/count_down_event.h"
+#include "src/chunkserver/clone_core.h"
+#include "src/chunkserver/copyset_node.h"
+#include "src/chunkserver/op_request.h"
+#include "src/chunkserver/chunk_service_closure.h"
+#include "src/chunkserver/datastore/chunkserver_datastore.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::common::Bitmap;
+using curve::common::BitRange;
+using curve::common::CountDownEvent;
+using curve::common::ReadWriteThrottleParams;
+using curve::common::ThrottleParams;
+
+namespace {
+
+void PrefetchBufferDeleter(void* ptr) {
+    delete[] static_cast<char*>(ptr);
+}
+
+// 同步等待源端数据下载完成
+class PrefetchDownloadClosure : public DownloadClosure {
+ public:
+    explicit PrefetchDownloadClosure(AsyncDownloadContext* downloadCtx)
+        : DownloadClosure(nullptr, nullptr, downloadCtx, nullptr)
+        , event_(1) {}
+
+    void Run() override {
+        event_.Signal();
+    }
+
+    void Wait() {
+        event_.Wait();
+    }
+
+    bool IsFailed() const {
+        return isFailed_;
+    }
+
+ private:
+    CountDownEvent event_;
+};
+
+// 同步等待paste请求apply完成
+class PrefetchPasteClosure : public Closure {
+ public:
+    PrefetchPasteClosure() : event_(1) {}
+
+    void Run() override {
+        event_.Signal();
+    }
+
+    void Wait() {
+        event_.Wait();
+    }
+
+ private:
+    CountDownEvent event_;
+};
+
+}  // namespace
+
+ClonePrefetcher::ClonePrefetcher()
+    : copyer_(nullptr)
+    , tp_(nullptr)
+    , isRunning_(false) {}
+
+ClonePrefetcher::~ClonePrefetcher() {
+    if (isRunning_.load(std::memory_order_acquire))
+        Fini();
+}
+
+int ClonePrefetcher::Init(const ClonePrefetchOptions& options,
+                          std::shared_ptr<OriginCopyer> copyer) {
+    if (options.prefetchSize == 0 || options.threadNum == 0 ||
+        options.queueCapacity == 0 || copyer == nullptr) {
+        LOG(ERROR) << "Invalid clone prefetch options."
+                   << " prefetch size: " << options.prefetchSize
+                   << ", thread num: " << options.threadNum
+                   << ", queue capacity: " << options.queueCapacity;
+        return -1;
+    }
+    options_ = options;
+    copyer_ = copyer;
+
+    ReadWriteThrottleParams params;
+    params.bpsRead = ThrottleParams(options_.bandwidthBps, 0, 0);
+    throttle_.UpdateThrottleParams(params);
+    return 0;
+}
+
+int ClonePrefetcher::Run() {
+    if (isRunning_.load(std::memory_order_acquire))
+        return 0;
+    tp_ = std::make_shared<TaskThreadPool<>>();
+    int ret = tp_->Start(options_.threadNum, options_.queueCapacity);
+    if (ret < 0) {
+        LOG(ERROR) << "clone prefetcher start error."
+                   << "threadNum: " << options_.threadNum
+                   << ", queueCapacity: " << options_.queueCapacity;
+        return -1;
+    }
+    isRunning_.store(true, std::memory_order_release);
+    LOG(INFO) << "Start clone prefetcher success.";
+    return 0;
+}
+
+int ClonePrefetcher::Fini() {
+    if (!isRunning_.load(std::memory_order_acquire))
+        return 0;
+
+    LOG(INFO) << "Begin to stop clone prefetcher.";
+    isRunning_.store(false, std::memory_order_release);
+    // 放行阻塞在限流上的预取任务
+    throttle_.Stop();
+    tp_->Stop();
+    std::lock_guard<std::mutex> lock(mtx_);
+    chunks_.clear();
+    LOG(INFO) << "Stop clone prefetcher success.";
+    return 0;
+}
+
+bool ClonePrefetcher::Prefetch(std::shared_ptr<CopysetNode> node,
+                               const ChunkRequest& request,
+                               const std::string& location) {
+    if (!isRunning_.load(std::memory_order_acquire))
+        return false;
+
+    ChunkKey key(request.logicpoolid(),
+                 request.copysetid(),
+                 request.chunkid());
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        // 同一个chunk只保留一个预取任务，避免对源端重复下载
+        if (chunks_.count(key) != 0) {
+            return false;
+        }
+        // 线程池队列满时Enqueue会阻塞调用者，这里直接丢弃
+        if (chunks_.size() >= options_.threadNum + options_.queueCapacity) {
+            return false;
+        }
+        chunks_.insert(key);
+    }
+
+    tp_->Enqueue([this, node, key, location] () {
+        FillChunk(node, key, location);
+        std::lock_guard<std::mutex> lock(mtx_);
+        chunks_.erase(key);
+    });
+    return true;
+}
+
+bool ClonePrefetcher::JoinInflight(DownloadClosure* done) {
+    AsyncDownloadContext* ctx = done->GetDownloadContext();
+    std::lock_guard<std::mutex> lock(inflightMtx_);
+    // 找到同一个location中起始offset不大于请求offset的最后一个区域
+    auto iter = inflight_.upper_bound(PieceKey(ctx->location, ctx->offset));
+    if (iter == inflight_.begin()) {
+        return false;
+    }
+    --iter;
+    const PieceKey& key = iter->first;
+    if (key.first != ctx->location ||
+        key.second + static_cast<off_t>(iter->second.size) <
+        ctx->offset + static_cast<off_t>(ctx->size)) {
+        return false;
+    }
+    iter->second.waiters.push_back(done);
+    return true;
+}
+
+void ClonePrefetcher::FinishInflight(const PieceKey& key,
+                                     const char* buf,
+                                     bool failed) {
+    std::vector<DownloadClosure*> waiters;
+    {
+        std::lock_guard<std::mutex> lock(inflightMtx_);
+        auto iter = inflight_.find(key);
+        if (iter == inflight_.end()) {
+            return;
+        }
+        waiters.swap(iter->second.waiters);
+        inflight_.erase(iter);
+    }
+
+    for (DownloadClosure* waiter : waiters) {
+        AsyncDownloadContext* ctx = waiter->GetDownloadContext();
+        if (failed) {
+            waiter->SetFailed();
+        } else {
+            memcpy(ctx->buf, buf + (ctx->offset - key.second), ctx->size);
+        }
+        waiter->Run();
+    }
+}
+
+void ClonePrefetcher::FillChunk(std::shared_ptr<CopysetNode> node,
+                                const ChunkKey& key,
+                                const std::string& location) {
+    std::shared_ptr<CSDataStore> dataStore = node->GetDataStore();
+    ChunkID id = std::get<2>(key);
+    const uint32_t prefetchSize = options_.prefetchSize;
+    off_t offset = 0;
+    while (isRunning_.load(std::memory_order_acquire)) {
+        // 只有leader才能propose paste请求
+        if (!node->IsLeaderTerm()) {
+            return;
+        }
+
+        // 每段拷贝前重新获取bitmap，期间用户的写或读也会填充chunk
+        CSChunkInfo chunkInfo;
+        CSErrorCode errorCode = dataStore->GetChunkInfo(id, &chunkInfo);
+        if (errorCode != CSErrorCode::Success || !chunkInfo.isClone) {
+            return;
+        }
+        if (prefetchSize % chunkInfo.blockSize != 0 ||
+            chunkInfo.chunkSize % prefetchSize != 0) {
+            LOG(ERROR) << "prefetch size is not aligned with chunk: "
+                       << " chunkid: " << id
+                       << " prefetch size: " << prefetchSize
+                       << " chunk size: " << chunkInfo.chunkSize
+                       << " block size: " << chunkInfo.blockSize;
+            return;
+        }
+
+        // 找到从offset开始第一个未拷贝过的分段
+        uint32_t blocksPerPiece = prefetchSize / chunkInfo.blockSize;
+        uint32_t lastIndex = chunkInfo.chunkSize / chunkInfo.blockSize - 1;
+        uint32_t beginIndex = offset / chunkInfo.blockSize;
+        uint32_t clearIndex =
+            chunkInfo.bitmap->NextClearBit(beginIndex, lastIndex);
+        if (clearIndex == Bitmap::NO_POS) {
+            return;
+        }
+        offset = clearIndex / blocksPerPiece * prefetchSize;
+
+        // 只下载分段中未拷贝过的区域，已拷贝过的block不再从源端读取
+        uint32_t pieceBegin = offset / chunkInfo.blockSize;
+        uint32_t pieceEnd = pieceBegin + blocksPerPiece - 1;
+        std::vector<BitRange> clearRanges;
+        std::vector<BitRange> setRanges;
+        chunkInfo.bitmap->Divide(pieceBegin, pieceEnd,
+                                 &clearRanges, &setRanges);
+        for (const auto& range : clearRanges) {
+            off_t rangeOffset =
+                static_cast<off_t>(range.beginIndex) * chunkInfo.blockSize;
+            size_t rangeSize = static_cast<size_t>(
+                range.endIndex - range.beginIndex + 1) * chunkInfo.blockSize;
+            throttle_.Add(true, rangeSize);
+            if (!isRunning_.load(std::memory_order_acquire)) {
+                return;
+            }
+            if (!FillPiece(node, key, location, rangeOffset, rangeSize)) {
+                return;
+            }
+        }
+        offset += prefetchSize;
+        if (offset >= chunkInfo.chunkSize) {
+            return;
+        }
+    }
+}
+
+bool ClonePrefetcher::FillPiece(std::shared_ptr<CopysetNode> node,
+                                const ChunkKey& key,
+                                const std::string& location,
+                                off_t offset,
+                                size_t size) {
+    // 1.从源端下载该区域
+    AsyncDownloadContext* downloadCtx = new AsyncDownloadContext;
+    std::unique_ptr<AsyncDownloadContext> contextGuard(downloadCtx);
+    downloadCtx->location = location;
+    downloadCtx->offset = offset;
+    downloadCtx->size = size;
+    downloadCtx->buf = new char[size];
+    butil::IOBuf cloneData;
+    cloneData.append_user_data(downloadCtx->buf, size, PrefetchBufferDeleter);
+
+    PrefetchDownloadClosure downloadClosure(downloadCtx);
+    if (JoinInflight(&downloadClosure)) {
+        // 其他chunk正在预取相同的源数据，等待其下载完成即可
+        downloadClosure.Wait();
+    } else {
+        // 记录正在下载的区域，相同源数据的读取和预取可以等待它完成
+        PieceKey pieceKey(location, offset);
+        bool registered = false;
+        {
+            std::lock_guard<std::mutex> lock(inflightMtx_);
+            registered =
+                inflight_.emplace(pieceKey, InflightPiece{size, {}}).second;
+        }
+        copyer_->DownloadAsync(&downloadClosure);
+        downloadClosure.Wait();
+        if (registered) {
+            FinishInflight(pieceKey,
+                           downloadCtx->buf,
+                           downloadClosure.IsFailed());
+        }
+    }
+    if (downloadClosure.IsFailed()) {
+        LOG(ERROR) << "prefetch origin data failed: "
+                   << " logic pool id: " << std::get<0>(key)
+                   << " copyset id: " << std::get<1>(key)
+                   << " chunkid: " << std::get<2>(key)
+                   << " AsyncDownloadContext: " << *downloadCtx;
+        return false;
+    }
+
+    // 2.paste到本地chunk，已被写过的区域不会被覆盖
+    ChunkRequest* pasteRequest = new ChunkRequest();
+    pasteRequest->set_optype(CHUNK_OP_TYPE::CHUNK_OP_PASTE);
+    pasteRequest->set_logicpoolid(std::get<0>(key));
+    pasteRequest->set_copysetid(std::get<1>(key));
+    pasteRequest->set_chunkid(std::get<2>(key));
+    pasteRequest->set_offset(offset);
+    pasteRequest->set_size(size);
+    ChunkResponse* pasteResponse = new ChunkResponse();
+
+    ChunkResponse result;
+    PrefetchPasteClosure pasteDone;
+    CloneClosure* closure = new CloneClosure();
+    closure->SetRequest(pasteRequest);
+    closure->SetResponse(pasteResponse);
+    closure->SetUserResponse(&result);
+    closure->SetClosure(&pasteDone);
+    ChunkServiceClosure* pasteClosure =
+        new (std::nothrow) ChunkServiceClosure(nullptr,
+                                               pasteRequest,
+                                               pasteResponse,
+                                               closure);
+    auto req = std::make_shared<PasteChunkInternalRequest>(node,
+                                                           pasteRequest,
+                                                           pasteResponse,
+                                                           &cloneData,
+                                                           pasteClosure);
+    req->Process();
+    pasteDone.Wait();
+    if (result.status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+        LOG(WARNING) << "prefetch paste failed: "
+                     << " logic pool id: " << std::get<0>(key)
+                     << " copyset id: " << std::get<1>(key)
+                     << " chunkid: " << std::get<2>(key)
+                     << " offset: " << offset
+                     << " size: " << size
+                     << " status: "
+                     << CHUNK_OP_STATUS_Name(result.status());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace chunkserver
+}  // namespace curve
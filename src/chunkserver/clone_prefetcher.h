@@ -0,0 +1,169 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-28
+ */
+
+#ifndef SRC_CHUNKSERVER_CLONE_PREFETCHER_H_
+#define SRC_CHUNKSERVER_CLONE_PREFETCHER_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "proto/chunk.pb.h"
+#include "include/chunkserver/chunkserver_common.h"
+#include "src/common/concurrent/task_thread_pool.h"
+#include "src/common/throttle.h"
+#include "src/chunkserver/clone_copyer.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::common::TaskThreadPool;
+using curve::common::Throttle;
+
+class CopysetNode;
+class DownloadClosure;
+
+struct ClonePrefetchOptions {
+    // 每次从源端预取的数据大小，需要是block size的整数倍并能整除chunk size
+    uint32_t prefetchSize;
+    // 预取线程数，即同时进行预取的chunk个数上限
+    uint32_t threadNum;
+    // 等待预取的chunk个数上限，超过后新的预取请求会被丢弃
+    uint32_t queueCapacity;
+    // 所有预取任务从源端下载的总带宽上限，单位bytes/s，0表示不限制
+    uint64_t bandwidthBps;
+    ClonePrefetchOptions() : prefetchSize(4 * 1024 * 1024)
+                           , threadNum(4)
+                           , queueCapacity(1000)
+                           , bandwidthBps(100 * 1024 * 1024) {}
+};
+
+/**
+ * clone chunk第一次被读到未拷贝的区域后，在后台把chunk剩余未拷贝的区域
+ * 按prefetchSize对齐分段，逐段从源端下载并paste到本地chunk，
+ * 使clone chunk尽快转为本地读。
+ * 预取会按(源chunk位置, offset)记录正在从源端下载的区域，用户读或其他
+ * chunk的预取命中这些区域时等待下载完成后直接使用其数据，不再重复下载
+ */
+class ClonePrefetcher {
+ public:
+    ClonePrefetcher();
+    virtual ~ClonePrefetcher();
+
+    /**
+     * 初始化
+     * @param options: 预取相关的配置
+     * @param copyer: 负责从源端下载数据
+     * @return: 成功返回0，失败返回-1
+     */
+    virtual int Init(const ClonePrefetchOptions& options,
+                     std::shared_ptr<OriginCopyer> copyer);
+
+    /**
+     * 启动预取线程
+     * @return: 成功返回0，失败返回-1
+     */
+    virtual int Run();
+
+    /**
+     * 停止预取线程，未完成的预取任务会在当前分段结束后退出
+     * @return: 成功返回0，失败返回-1
+     */
+    virtual int Fini();
+
+    /**
+     * 提交一个chunk的预取任务，同一个chunk同时只会有一个预取任务
+     * @param node: chunk所在的copyset
+     * @param request: 触发预取的用户请求
+     * @param location: 源chunk的位置信息
+     * @return: 任务被接受返回true，已在预取中、队列已满或未启动返回false
+     */
+    virtual bool Prefetch(std::shared_ptr<CopysetNode> node,
+                          const ChunkRequest& request,
+                          const std::string& location);
+
+    /**
+     * 如果done要下载的区域包含在某个正在从源端下载的预取区域中，
+     * 则等待该区域下载完成，把数据拷贝到done的下载上下文后执行done
+     * @param done: 下载请求，其上下文中的buf用来接收数据
+     * @return: 已加入等待返回true，调用者不能再使用done；
+     *          没有可等待的区域返回false，调用者需要自己下载
+     */
+    virtual bool JoinInflight(DownloadClosure* done);
+
+ private:
+    // (logicPoolId, copysetId, chunkId)
+    using ChunkKey = std::tuple<LogicPoolID, CopysetID, ChunkID>;
+    // (location, offset)
+    using PieceKey = std::pair<std::string, off_t>;
+
+    // 正在从源端下载的区域
+    struct InflightPiece {
+        size_t size;
+        // 等待该区域下载完成的请求
+        std::vector<DownloadClosure*> waiters;
+    };
+
+    // 依次预取chunk中所有分段未拷贝过的区域，直到全部拷贝完或出错
+    void FillChunk(std::shared_ptr<CopysetNode> node,
+                   const ChunkKey& key,
+                   const std::string& location);
+
+    // 下载[offset, offset + size)区域的源数据并paste到本地chunk
+    bool FillPiece(std::shared_ptr<CopysetNode> node,
+                   const ChunkKey& key,
+                   const std::string& location,
+                   off_t offset,
+                   size_t size);
+
+    // 区域下载结束，把结果交给所有等待的请求
+    void FinishInflight(const PieceKey& key, const char* buf, bool failed);
+
+ private:
+    ClonePrefetchOptions options_;
+    // 负责从源端下载数据
+    std::shared_ptr<OriginCopyer> copyer_;
+    // 执行预取任务的线程池
+    std::shared_ptr<TaskThreadPool<>> tp_;
+    // 限制预取的下载带宽
+    Throttle throttle_;
+    // 保护chunks_的互斥锁
+    std::mutex mtx_;
+    // 正在预取或等待预取的chunk
+    std::set<ChunkKey> chunks_;
+    // 保护inflight_的互斥锁
+    std::mutex inflightMtx_;
+    // 正在从源端下载的区域，相同源数据的下载可以等待它完成
+    std::map<PieceKey, InflightPiece> inflight_;
+    // 当前是否处于工作状态
+    std::atomic<bool> isRunning_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_CLONE_PREFETCHER_H_
@@ -303,6 +303,16 @@ void CopysetNode::on_apply(::braft::Iterator &iter) {
             CHECK(nullptr != chunkClosure)
                 << "ChunkClosure dynamic cast failed";
             std::shared_ptr<ChunkOpRequest>& opRequest = chunkClosure->request_;
+            if (CHUNK_OP_TYPE::CHUNK_OP_BATCH == opRequest->OpType()) {
+                /**
+                 * 批量请求涉及多个chunk，无法按chunk id放入某一个队列，
+                 * 等之前的请求都apply完成之后在当前线程中apply，
+                 * 保证和前后请求的顺序
+                 */
+                concurrentapply_->Flush();
+                opRequest->OnApply(iter.index(), doneGuard.release());
+                continue;
+            }
             concurrentapply_->Push(opRequest->ChunkId(), ChunkOpRequest::Schedule(opRequest->OpType()),  // NOLINT
                                    &ChunkOpRequest::OnApply, opRequest,
                                    iter.index(), doneGuard.release());
@@ -319,6 +329,12 @@ void CopysetNode::on_apply(::braft::Iterator &iter) {
             butil::IOBuf data;
             auto opReq = ChunkOpRequest::Decode(log, &request, &data,
                                                 iter.index(), GetLeaderId());
+            if (nullptr != opReq &&
+                CHUNK_OP_TYPE::CHUNK_OP_BATCH == request.optype()) {
+                concurrentapply_->Flush();
+                opReq->OnApplyFromLog(dataStore_, request, data);
+                continue;
+            }
             auto chunkId = request.chunkid();
             concurrentapply_->Push(chunkId, ChunkOpRequest::Schedule(request.optype()),  // NOLINT
                                    &ChunkOpRequest::OnApplyFromLog, opReq,
@@ -937,6 +953,13 @@ int CopysetNode::GetHash(std::string *hash) {
     // 计算所有chunk文件crc需要保证计算的顺序是一样的
     std::sort(files.begin(), files.end());
 
+    // 分段读取文件计算crc，复用同一个buffer，避免按文件大小分配内存
+    static const int kHashReadSize = 1024 * 1024;
+    std::unique_ptr<char[]> buff(new (std::nothrow) char[kHashReadSize]);
+    if (nullptr == buff) {
+        return -1;
+    }
+
     for (std::string file : files) {
         std::string filename = chunkDataApath_;
         filename += "/";
@@ -953,20 +976,15 @@ int CopysetNode::GetHash(std::string *hash) {
         }
 
         len = fileInfo.st_size;
-        char *buff = new (std::nothrow) char[len];
-        if (nullptr == buff) {
-            return -1;
-        }
+        for (int off = 0; off < len; off += kHashReadSize) {
+            int size = std::min(kHashReadSize, len - off);
+            ret = fs_->Read(fd, buff.get(), off, size);
+            if (ret != size) {
+                return -1;
+            }
 
-        ret = fs_->Read(fd, buff, 0, len);
-        if (ret != len) {
-            delete[] buff;
-            return -1;
+            crc32c = curve::common::CRC32(crc32c, buff.get(), size);
         }
-
-        crc32c = curve::common::CRC32(crc32c, buff, len);
-
-        delete[] buff;
     }
 
     *hash = std::to_string(crc32c);
@@ -96,6 +96,9 @@ int Heartbeat::Init(const HeartbeatOptions &options) {
 
     // init scanManager
     scanMan_ = options.scanManager;
+
+    // 启动后第一次心跳全量上报
+    reportTracker_.Init(options_.fullReportInterval);
     return 0;
 }
 
@@ -301,19 +304,28 @@ int Heartbeat::BuildRequest(HeartbeatRequest* req) {
     req->set_copysetcount(copysets.size());
     int leaders = 0;
 
+    req->set_isdelta(!reportTracker_.BeginReport());
     for (CopysetNodePtr copyset : copysets) {
-        curve::mds::heartbeat::CopySetInfo* info = req->add_copysetinfos();
+        curve::mds::heartbeat::CopySetInfo info;
+        GroupNid id = ToGroupNid(copyset->GetLogicPoolId(),
+                                 copyset->GetCopysetId());
 
-        ret = BuildCopysetInfo(info, copyset);
+        ret = BuildCopysetInfo(&info, copyset);
         if (ret != 0) {
             LOG(ERROR) << "Failed to build heartbeat information of copyset "
                        << ToGroupIdStr(copyset->GetLogicPoolId(),
                                      copyset->GetCopysetId());
+            // 不记录上报状态, 下次心跳重新上报
+            req->add_copysetinfos()->Swap(&info);
             continue;
         }
         if (copyset->IsLeaderTerm()) {
             ++leaders;
         }
+
+        if (reportTracker_.AddCopyset(id, info)) {
+            req->add_copysetinfos()->Swap(&info);
+        }
     }
     req->set_leadercount(leaders);
     req->set_version(curve::common::CurveVersion());
@@ -326,7 +338,9 @@ void Heartbeat::DumpHeartbeatRequest(const HeartbeatRequest& request) {
              << request.chunkserverid()
              << ", IP: " << request.ip() << ", port: " << request.port()
              << ", copyset count: " << request.copysetcount()
-             << ", leader count: " << request.leadercount();
+             << ", leader count: " << request.leadercount()
+             << ", reported copyset count: " << request.copysetinfos_size()
+             << ", delta: " << request.isdelta();
     for (int i = 0; i < request.copysetinfos_size(); i ++) {
         const curve::mds::heartbeat::CopySetInfo& info =
             request.copysetinfos(i);
@@ -405,6 +419,8 @@ int Heartbeat::SendHeartbeat(const HeartbeatRequest& request,
                          << " is shutdown or going to quit,"
                          << cntl.ErrorText();
             inServiceIndex_ = (inServiceIndex_ + 1) % mdsEps_.size();
+            // 新的mds可能没有该chunkserver的copyset信息
+            reportTracker_.ForceFullReport();
             LOG(INFO) << "next heartbeat switch to "
                       << mdsEps_[inServiceIndex_];
         } else {
@@ -607,6 +623,7 @@ void Heartbeat::HeartbeatWorker() {
             ::sleep(errorIntervalSec);
             continue;
         }
+        reportTracker_.Commit(req, resp);
 
         LOG(INFO) << "executing heartbeat info";
         ret = ExecTask(resp);
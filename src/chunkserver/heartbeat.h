@@ -36,6 +36,7 @@
 
 #include "include/chunkserver/chunkserver_common.h"
 #include "src/chunkserver/copyset_node_manager.h"
+#include "src/chunkserver/heartbeat_helper.h"
 #include "src/common/wait_interval.h"
 #include "src/common/concurrent/concurrent.h"
 #include "src/chunkserver/scan_manager.h"
@@ -67,6 +68,9 @@ struct HeartbeatOptions {
     uint32_t                port;
     uint32_t                intervalSec;
     uint32_t                timeout;
+    // 每隔多少次心跳全量上报一次copyset信息, 其余心跳只上报有变化的copyset,
+    // 0或1表示每次心跳都全量上报
+    uint32_t                fullReportInterval = 0;
     CopysetNodeManager*     copysetNodeManager;
     ScanManager*            scanManager;
 
@@ -187,6 +191,9 @@ class Heartbeat {
     uint64_t startUpTime_;
 
     ScanManager *scanMan_;
+
+    // 记录已上报的copyset状态, 只在心跳线程中访问
+    CopysetReportTracker reportTracker_;
 };
 
 }  // namespace chunkserver
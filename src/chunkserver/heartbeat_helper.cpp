@@ -24,6 +24,7 @@
 #include <brpc/channel.h>
 #include <brpc/controller.h>
 #include <string>
+#include <utility>
 #include "src/chunkserver/heartbeat_helper.h"
 #include "include/chunkserver/chunkserver_common.h"
 #include "proto/chunkserver.pb.h"
@@ -140,6 +141,86 @@ bool HeartbeatHelper::ChunkServerLoadCopySetFin(const std::string peerId) {
     return rep.copysetloadfin();
 }
 
+
+ReportedCopysetState::ReportedCopysetState(const CopySetInfo &info)
+    : epoch(info.epoch()),
+      leader(info.leaderpeer().address()),
+      scaning(info.scaning()),
+      lastScanSec(info.lastscansec()) {
+    for (int i = 0; i < info.peers_size(); i++) {
+        peers.push_back(info.peers(i).address());
+    }
+}
+
+bool ReportedCopysetState::operator==(
+    const ReportedCopysetState &other) const {
+    return epoch == other.epoch && leader == other.leader &&
+           peers == other.peers && scaning == other.scaning &&
+           lastScanSec == other.lastScanSec;
+}
+
+void CopysetReportTracker::Init(uint32_t fullReportInterval) {
+    fullReportInterval_ = fullReportInterval;
+    reported_.clear();
+    building_.clear();
+    needFullReport_ = true;
+    fullReport_ = true;
+    deltaReports_ = 0;
+}
+
+bool CopysetReportTracker::BeginReport() {
+    fullReport_ = needFullReport_ || fullReportInterval_ <= 1 ||
+                  deltaReports_ + 1 >= fullReportInterval_;
+    building_.clear();
+    return fullReport_;
+}
+
+bool CopysetReportTracker::AddCopyset(GroupNid id, const CopySetInfo &info) {
+    ReportedCopysetState state(info);
+    bool report = fullReport_ || NeedReportCopyset(id, info, state);
+    building_.emplace(id, std::move(state));
+    return report;
+}
+
+bool CopysetReportTracker::NeedReportCopyset(
+    GroupNid id, const CopySetInfo &info,
+    const ReportedCopysetState &state) const {
+    // mds根据正在进行的配置变更和scan结果推进operator, 需要一直上报
+    if (info.has_configchangeinfo() || info.scanmap_size() > 0) {
+        return true;
+    }
+
+    auto iter = reported_.find(id);
+    return iter == reported_.end() || !(iter->second == state);
+}
+
+void CopysetReportTracker::Commit(
+    const ChunkServerHeartbeatRequest &request,
+    const ChunkServerHeartbeatResponse &response) {
+    if (response.statuscode() != curve::mds::heartbeat::hbOK &&
+        response.statuscode() !=
+            curve::mds::heartbeat::hbRequestNoCopyset) {
+        // mds没有完整处理本次上报的copyset
+        needFullReport_ = true;
+        return;
+    }
+
+    // mds下发了配置的copyset下次继续上报, 直到mds不再下发
+    for (int i = 0; i < response.needupdatecopysets_size(); i++) {
+        const CopySetConf &conf = response.needupdatecopysets(i);
+        building_.erase(ToGroupNid(conf.logicalpoolid(), conf.copysetid()));
+    }
+    reported_.swap(building_);
+    building_.clear();
+
+    if (request.isdelta()) {
+        ++deltaReports_;
+    } else {
+        deltaReports_ = 0;
+    }
+    needFullReport_ = response.needfullreport();
+}
+
 }  // namespace chunkserver
 }  // namespace curve
 
@@ -24,6 +24,7 @@
 #define SRC_CHUNKSERVER_HEARTBEAT_HELPER_H_
 
 #include <braft/node_manager.h>
+#include <map>
 #include <vector>
 #include <memory>
 #include <string>
@@ -33,6 +34,9 @@
 namespace curve {
 namespace chunkserver {
 using ::curve::mds::heartbeat::CopySetConf;
+using ::curve::mds::heartbeat::CopySetInfo;
+using ::curve::mds::heartbeat::ChunkServerHeartbeatRequest;
+using ::curve::mds::heartbeat::ChunkServerHeartbeatResponse;
 using ::curve::common::Peer;
 using CopysetNodePtr = std::shared_ptr<CopysetNode>;
 
@@ -91,6 +95,97 @@ class HeartbeatHelper {
      */
     static bool ChunkServerLoadCopySetFin(const std::string ipPort);
 };
+
+/**
+ * 上报给MDS的copyset状态, 用于增量心跳判断copyset是否有变化
+ */
+struct ReportedCopysetState {
+    uint64_t epoch;
+    std::string leader;
+    std::vector<std::string> peers;
+    bool scaning;
+    uint64_t lastScanSec;
+
+    explicit ReportedCopysetState(const CopySetInfo &info);
+
+    bool operator==(const ReportedCopysetState &other) const;
+};
+
+/**
+ * 记录MDS已收到的copyset状态, 决定每次心跳是全量上报还是只上报有变化的copyset
+ */
+class CopysetReportTracker {
+ public:
+    CopysetReportTracker()
+        : fullReportInterval_(0), needFullReport_(true),
+          fullReport_(true), deltaReports_(0) {}
+
+    /**
+     * 初始化, 之后的第一次心跳全量上报
+     *
+     * @param[in] fullReportInterval 每隔多少次心跳全量上报一次, 0或1表示每次
+     *            心跳都全量上报
+     */
+    void Init(uint32_t fullReportInterval);
+
+    /**
+     * 开始构建一次心跳
+     *
+     * @return true-本次心跳全量上报 false-本次心跳只上报有变化的copyset
+     */
+    bool BeginReport();
+
+    /**
+     * 记录copyset在本次心跳中的状态
+     *
+     * @param[in] id copyset的GroupNid
+     * @param[in] info copyset本次的心跳信息
+     *
+     * @return true-本次心跳需要上报该copyset false-可以不上报
+     */
+    bool AddCopyset(GroupNid id, const CopySetInfo &info);
+
+    /**
+     * 心跳发送成功后记录本次上报的copyset状态, 发送失败时不调用,
+     * 下次心跳会重新上报相对上次成功上报有变化的copyset
+     *
+     * @param[in] request 本次心跳请求
+     * @param[in] response mds的心跳回应
+     */
+    void Commit(const ChunkServerHeartbeatRequest &request,
+                const ChunkServerHeartbeatResponse &response);
+
+    /**
+     * 下次心跳全量上报, 例如切换了mds
+     */
+    void ForceFullReport() {
+        needFullReport_ = true;
+    }
+
+ private:
+    // 增量心跳中是否需要上报该copyset: 状态相对上次上报有变化,
+    // 或者正在进行配置变更, 或者有未处理的scan结果
+    bool NeedReportCopyset(GroupNid id, const CopySetInfo &info,
+                           const ReportedCopysetState &state) const;
+
+ private:
+    uint32_t fullReportInterval_;
+
+    // MDS已收到的各copyset状态
+    std::map<GroupNid, ReportedCopysetState> reported_;
+
+    // 本次心跳构建的各copyset状态, 发送成功后替换reported_
+    std::map<GroupNid, ReportedCopysetState> building_;
+
+    // 下次心跳是否必须全量上报
+    bool needFullReport_;
+
+    // 正在构建的心跳是否全量上报
+    bool fullReport_;
+
+    // 上次全量上报之后已发送的增量心跳次数
+    uint32_t deltaReports_;
+};
 }  // namespace chunkserver
 }  // namespace curve
 #endif  // SRC_CHUNKSERVER_HEARTBEAT_HELPER_H_
@@ -171,6 +171,8 @@ std::shared_ptr<ChunkOpRequest> ChunkOpRequest::Decode(butil::IOBuf log,
             return std::make_shared<CreateCloneChunkRequest>();
         case CHUNK_OP_TYPE::CHUNK_OP_SCAN:
             return std::make_shared<ScanChunkRequest>(index, leaderId);
+        case CHUNK_OP_TYPE::CHUNK_OP_BATCH:
+            return std::make_shared<BatchChunkOpRequest>();
         default:LOG(ERROR) << "Unknown chunk op";
             return nullptr;
     }
@@ -704,6 +706,99 @@ void CreateCloneChunkRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datast
     }
 }
 
+bool BatchChunkOpRequest::IsSupportedSubRequest(
+    const ChunkRequest &subRequest) {
+    switch (subRequest.optype()) {
+        case CHUNK_OP_TYPE::CHUNK_OP_DELETE:
+        case CHUNK_OP_TYPE::CHUNK_OP_CREATE_CLONE:
+            return true;
+        case CHUNK_OP_TYPE::CHUNK_OP_DELETE_SNAP:
+            return subRequest.has_correctedsn();
+        default:
+            return false;
+    }
+}
+
+CHUNK_OP_STATUS BatchChunkOpRequest::ApplySubRequest(
+    const std::shared_ptr<CSDataStore> &datastore,
+    const ChunkRequest &subRequest) {
+    CSErrorCode ret;
+    switch (subRequest.optype()) {
+        case CHUNK_OP_TYPE::CHUNK_OP_DELETE:
+            ret = datastore->DeleteChunk(subRequest.chunkid(),
+                                         subRequest.sn());
+            break;
+        case CHUNK_OP_TYPE::CHUNK_OP_DELETE_SNAP:
+            ret = datastore->DeleteSnapshotChunkOrCorrectSn(
+                subRequest.chunkid(), subRequest.correctedsn());
+            break;
+        case CHUNK_OP_TYPE::CHUNK_OP_CREATE_CLONE:
+            ret = datastore->CreateCloneChunk(subRequest.chunkid(),
+                                              subRequest.sn(),
+                                              subRequest.correctedsn(),
+                                              subRequest.size(),
+                                              subRequest.location());
+            break;
+        default:
+            LOG(ERROR) << "unsupported batch sub request: "
+                       << subRequest.ShortDebugString();
+            return CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST;
+    }
+
+    // 错误处理和单个chunk的请求保持一致
+    switch (ret) {
+        case CSErrorCode::Success:
+            return CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS;
+        case CSErrorCode::BackwardRequestError:
+            LOG(WARNING) << "batch sub request failed: "
+                         << " data store return: " << ret
+                         << ", request: " << subRequest.ShortDebugString();
+            return CHUNK_OP_STATUS::CHUNK_OP_STATUS_BACKWARD;
+        case CSErrorCode::ChunkConflictError:
+            LOG(WARNING) << "batch sub request failed: "
+                         << " data store return: " << ret
+                         << ", request: " << subRequest.ShortDebugString();
+            return CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_EXIST;
+        case CSErrorCode::InternalError:
+        case CSErrorCode::CrcCheckError:
+        case CSErrorCode::FileFormatError:
+            LOG(FATAL) << "batch sub request failed: "
+                       << " data store return: " << ret
+                       << ", request: " << subRequest.ShortDebugString();
+            return CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN;
+        default:
+            LOG(ERROR) << "batch sub request failed: "
+                       << " data store return: " << ret
+                       << ", request: " << subRequest.ShortDebugString();
+            return CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN;
+    }
+}
+
+void BatchChunkOpRequest::OnApply(uint64_t index,
+                                  ::google::protobuf::Closure *done) {
+    brpc::ClosureGuard doneGuard(done);
+
+    // 子请求的结果放在subResponses中，整个batch已经apply，返回成功
+    for (int i = 0; i < request_->subrequests_size(); ++i) {
+        ChunkResponse *subResponse = response_->add_subresponses();
+        subResponse->set_status(
+            ApplySubRequest(datastore_, request_->subrequests(i)));
+    }
+    response_->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+    node_->UpdateAppliedIndex(index);
+    response_->set_appliedindex(MaxAppliedIndex(node_, index));
+}
+
+void BatchChunkOpRequest::OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,  //NOLINT
+                                         const ChunkRequest &request,
+                                         const butil::IOBuf &data) {
+    (void)data;
+    // NOTE: 处理过程中优先使用参数传入的datastore/request
+    for (int i = 0; i < request.subrequests_size(); ++i) {
+        ApplySubRequest(datastore, request.subrequests(i));
+    }
+}
+
 void PasteChunkInternalRequest::Process() {
     brpc::ClosureGuard doneGuard(done_);
 
@@ -334,6 +334,48 @@ class CreateCloneChunkRequest : public ChunkOpRequest {
                         const butil::IOBuf &data) override;
 };
 
+/**
+ * 同一copyset内多个chunk的批量操作，所有子请求作为一条raft日志提交，
+ * apply时按顺序依次执行，每个子请求的结果放在response的subResponses中
+ */
+class BatchChunkOpRequest : public ChunkOpRequest {
+ public:
+    BatchChunkOpRequest() :
+        ChunkOpRequest() {}
+    BatchChunkOpRequest(std::shared_ptr<CopysetNode> nodePtr,
+                        RpcController *cntl,
+                        const ChunkRequest *request,
+                        ChunkResponse *response,
+                        ::google::protobuf::Closure *done) :
+        ChunkOpRequest(nodePtr,
+                       cntl,
+                       request,
+                       response,
+                       done) {}
+    virtual ~BatchChunkOpRequest() = default;
+
+    void OnApply(uint64_t index, ::google::protobuf::Closure *done) override;
+    void OnApplyFromLog(std::shared_ptr<CSDataStore> datastore,
+                        const ChunkRequest &request,
+                        const butil::IOBuf &data) override;
+
+    /**
+     * 检查子请求是否可以批量处理
+     * @param subRequest: 子请求
+     * @return true表示支持批量处理
+     */
+    static bool IsSupportedSubRequest(const ChunkRequest &subRequest);
+
+ private:
+    /**
+     * 在datastore上执行一个子请求
+     * @return 子请求的处理结果
+     */
+    static CHUNK_OP_STATUS ApplySubRequest(
+        const std::shared_ptr<CSDataStore> &datastore,
+        const ChunkRequest &subRequest);
+};
+
 class PasteChunkInternalRequest : public ChunkOpRequest {
  public:
     PasteChunkInternalRequest() :
@@ -45,6 +45,7 @@
 #include <braft/fsync.h>
 #include "src/chunkserver/raftlog/curve_segment.h"
 #include "src/chunkserver/raftlog/define.h"
+#include "src/common/crc32.h"
 
 namespace curve {
 namespace chunkserver {
@@ -247,7 +248,7 @@ inline bool verify_checksum(int checksum_type,
     case CHECKSUM_MURMURHASH32:
         return (value == braft::murmurhash32(data, len));
     case CHECKSUM_CRC32:
-        return (value == braft::crc32(data, len));
+        return (value == curve::common::CRC32(data, len));
     default:
         LOG(ERROR) << "Unknown checksum_type=" << checksum_type;
         return false;
@@ -260,7 +261,7 @@ inline bool verify_checksum(int checksum_type,
     case CHECKSUM_MURMURHASH32:
         return (value == braft::murmurhash32(data));
     case CHECKSUM_CRC32:
-        return (value == braft::crc32(data));
+        return (value == curve::common::CRC32(data));
     default:
         LOG(ERROR) << "Unknown checksum_type=" << checksum_type;
         return false;
@@ -272,7 +273,7 @@ inline uint32_t get_checksum(int checksum_type, const char* data, size_t len) {
     case CHECKSUM_MURMURHASH32:
         return braft::murmurhash32(data, len);
     case CHECKSUM_CRC32:
-        return braft::crc32(data, len);
+        return curve::common::CRC32(data, len);
     default:
         CHECK(false) << "Unknown checksum_type=" << checksum_type;
         abort();
@@ -285,7 +286,7 @@ inline uint32_t get_checksum(int checksum_type, const butil::IOBuf& data) {
     case CHECKSUM_MURMURHASH32:
         return braft::murmurhash32(data);
     case CHECKSUM_CRC32:
-        return braft::crc32(data);
+        return curve::common::CRC32(data);
     default:
         CHECK(false) << "Unknown checksum_type=" << checksum_type;
         abort();
@@ -67,6 +67,12 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no global.fileIOSplitMaxSizeKB info";           // NOLINT
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetUInt32Value("global.preallocateSegmentNum",
+          &fileServiceOption_.ioOpt.ioSplitOpt.preallocateSegmentNum);
+    LOG_IF(WARNING, ret == false)
+        << "config no global.preallocateSegmentNum info, using default value "
+        << fileServiceOption_.ioOpt.ioSplitOpt.preallocateSegmentNum;
+
     ret = conf_.GetUInt32Value("chunkserver.opMaxRetry",
           &fileServiceOption_.ioOpt.ioSenderOpt.failRequestOpt.chunkserverOPMaxRetry);    // NOLINT
     LOG_IF(ERROR, ret == false) << "config no chunkserver.opMaxRetry info";
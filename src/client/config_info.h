@@ -215,6 +215,8 @@ struct MetaCacheOption {
  */
 struct IOSplitOption {
     uint64_t fileIOSplitMaxSizeKB = 64;
+    // 顺序写分配segment时，同时向mds预分配的后续segment数量，0表示不预分配
+    uint32_t preallocateSegmentNum = 0;
 };
 
 /**
@@ -45,6 +45,26 @@ using curve::mds::StatusCode;
 using curve::common::ChunkServerLocation;
 using curve::mds::topology::CopySetServerInfo;
 
+namespace {
+
+void PageFileSegment2SegmentInfo(const PageFileSegment &pfs,
+                                 SegmentInfo *segInfo) {
+    segInfo->chunksize = pfs.chunksize();
+    segInfo->segmentsize = pfs.segmentsize();
+    segInfo->startoffset = pfs.startoffset();
+    LogicPoolID logicpoolid = pfs.logicalpoolid();
+    segInfo->lpcpIDInfo.lpid = pfs.logicalpoolid();
+
+    for (int i = 0; i < pfs.chunks_size(); i++) {
+        ChunkID chunkid = pfs.chunks(i).chunkid();
+        CopysetID copysetid = pfs.chunks(i).copysetid();
+        segInfo->lpcpIDInfo.cpidVec.push_back(copysetid);
+        segInfo->chunkvec.emplace_back(chunkid, logicpoolid, copysetid);
+    }
+}
+
+}  // namespace
+
 // rpc发送和mds地址切换状态机
 int RPCExcutorRetryPolicy::DoRPCTask(RPCFunc rpctask, uint64_t maxRetryTimeMS) {
     // 记录上一次正在服务的mds index
@@ -1035,10 +1055,11 @@ LIBCURVE_ERROR MDSClient::SetCloneFileStatus(const std::string &filename,
         rpcExcutor_.DoRPCTask(task, metaServerOpt_.mdsMaxRetryMS));
 }
 
-LIBCURVE_ERROR MDSClient::GetOrAllocateSegment(bool allocate, uint64_t offset,
-                                               const FInfo_t *fi,
-                                               const FileEpoch_t *fEpoch,
-                                               SegmentInfo *segInfo) {
+LIBCURVE_ERROR MDSClient::GetOrAllocateSegment(
+    bool allocate, uint64_t offset, const FInfo_t *fi,
+    const FileEpoch_t *fEpoch, SegmentInfo *segInfo,
+    uint32_t preallocateSegmentNum,
+    std::vector<SegmentInfo> *preallocatedSegInfos) {
     auto task = RPCTaskDefine {
         (void)addrindex;
         (void)rpctimeoutMS;
@@ -1046,7 +1067,8 @@ LIBCURVE_ERROR MDSClient::GetOrAllocateSegment(bool allocate, uint64_t offset,
         mdsClientMetric_.getOrAllocateSegment.qps.count << 1;
         LatencyGuard lg(&mdsClientMetric_.getOrAllocateSegment.latency);
         MDSClientBase::GetOrAllocateSegment(allocate, offset, fi, fEpoch,
-                                            &response, cntl, channel);
+                                            preallocateSegmentNum, &response,
+                                            cntl, channel);
         if (cntl->Failed()) {
             mdsClientMetric_.getOrAllocateSegment.eps.count << 1;
             LOG(WARNING) << "allocate segment failed, error code = "
@@ -1077,25 +1099,25 @@ LIBCURVE_ERROR MDSClient::GetOrAllocateSegment(bool allocate, uint64_t offset,
             break;
         }
 
-        PageFileSegment pfs = response.pagefilesegment();
-        segInfo->chunksize = pfs.chunksize();
-        segInfo->segmentsize = pfs.segmentsize();
-        segInfo->startoffset = pfs.startoffset();
-        LogicPoolID logicpoolid = pfs.logicalpoolid();
-        segInfo->lpcpIDInfo.lpid = pfs.logicalpoolid();
-
-        int chunksNum = pfs.chunks_size();
-        if (allocate && chunksNum <= 0) {
+        const PageFileSegment& pfs = response.pagefilesegment();
+        if (allocate && pfs.chunks_size() <= 0) {
             LOG(WARNING) << "MDS allocate segment, but no chunkinfo!";
             // Now, we will retry until allocate segment success
             return -LIBCURVE_ERROR::RETRY_UNTIL_SUCCESS;
         }
 
-        for (int i = 0; i < chunksNum; i++) {
-            ChunkID chunkid = pfs.chunks(i).chunkid();
-            CopysetID copysetid = pfs.chunks(i).copysetid();
-            segInfo->lpcpIDInfo.cpidVec.push_back(copysetid);
-            segInfo->chunkvec.emplace_back(chunkid, logicpoolid, copysetid);
+        PageFileSegment2SegmentInfo(pfs, segInfo);
+
+        if (preallocatedSegInfos != nullptr) {
+            preallocatedSegInfos->clear();
+            for (const auto& seg : response.preallocatedsegments()) {
+                if (seg.chunks_size() <= 0) {
+                    continue;
+                }
+                preallocatedSegInfos->emplace_back();
+                PageFileSegment2SegmentInfo(seg,
+                                            &preallocatedSegInfos->back());
+            }
         }
         return LIBCURVE_ERROR::OK;
     };
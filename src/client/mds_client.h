@@ -209,7 +209,7 @@ class MDSClient : public MDSClientBase,
      * @param: cpinfoVec保存获取到的server信息
      * @return: 成功返回LIBCURVE_ERROR::OK,否则返回LIBCURVE_ERROR::FAILED
      */
-    LIBCURVE_ERROR
+    virtual LIBCURVE_ERROR
     GetServerList(const LogicPoolID &logicPoolId,
                   const std::vector<CopysetID> &csid,
                   std::vector<CopysetInfo<ChunkServerID>> *cpinfoVec);
@@ -230,15 +230,19 @@ class MDSClient : public MDSClientBase,
      * @param: fi file info
      * @param: fEpoch  file epoch info
      * @param[out]: segInfo segment info returned
+     * @param: preallocateSegmentNum  number of following segments to
+     *         allocate together if the segment is allocated
+     * @param[out]: preallocatedSegInfos  following segments allocated
      * @return:
      * return LIBCURVE_ERROR::OK for success,
      * return LIBCURVE_ERROR::AUTHFAIL for auth fail,
      * otherwise return LIBCURVE_ERROR::FAILED
      */
-    LIBCURVE_ERROR GetOrAllocateSegment(bool allocate, uint64_t offset,
-                                        const FInfo_t *fi,
-                                        const FileEpoch_t *fEpoch,
-                                        SegmentInfo *segInfo);
+    virtual LIBCURVE_ERROR GetOrAllocateSegment(
+        bool allocate, uint64_t offset, const FInfo_t *fi,
+        const FileEpoch_t *fEpoch, SegmentInfo *segInfo,
+        uint32_t preallocateSegmentNum = 0,
+        std::vector<SegmentInfo> *preallocatedSegInfos = nullptr);
 
     /**
      * @brief Send DeAllocateSegment request to current working MDS
@@ -383,6 +383,7 @@ void MDSClientBase::GetOrAllocateSegment(bool allocate,
                                          uint64_t offset,
                                          const FInfo_t* fi,
                                          const FileEpoch_t *fEpoch,
+                                         uint32_t preallocateSegmentNum,
                                          GetOrAllocateSegmentResponse* response,
                                          brpc::Controller* cntl,
                                          brpc::Channel* channel) {
@@ -397,11 +398,15 @@ void MDSClientBase::GetOrAllocateSegment(bool allocate,
     if (allocate && fEpoch != nullptr && fEpoch->epoch != 0) {
         request.set_epoch(fEpoch->epoch);
     }
+    if (allocate && preallocateSegmentNum > 0) {
+        request.set_preallocatesegmentnum(preallocateSegmentNum);
+    }
     FillUserInfo(&request, fi->userinfo);
 
     LOG(INFO) << "GetOrAllocateSegment: filename = " << fi->fullPathName
               << ", allocate = " << allocate << ", owner = " << fi->owner
               << ", offset = " << offset << ", segment offset = " << seg_offset
+              << ", preallocate = " << preallocateSegmentNum
               << ", log id = " << cntl->log_id();
 
     curve::mds::CurveFSService_Stub stub(channel);
@@ -348,6 +348,7 @@ class MDSClientBase {
                               uint64_t offset,
                               const FInfo_t* fi,
                               const FileEpoch_t *fEpoch,
+                              uint32_t preallocateSegmentNum,
                               GetOrAllocateSegmentResponse* response,
                               brpc::Controller* cntl,
                               brpc::Channel* channel);
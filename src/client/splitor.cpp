@@ -25,6 +25,9 @@
 #include <glog/logging.h>
 
 #include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -217,9 +220,17 @@ bool Splitor::GetOrAllocateSegment(bool allocateIfNotExist,
                                    const FInfo* fileInfo,
                                    const FileEpoch_t *fEpoch,
                                    ChunkIndex chunkidx) {
+    uint32_t preallocateNum = 0;
+    if (allocateIfNotExist && iosplitopt_.preallocateSegmentNum > 0 &&
+        IsSequentialAllocate(offset, metaCache, fileInfo)) {
+        preallocateNum = iosplitopt_.preallocateSegmentNum;
+    }
+
     SegmentInfo segmentInfo;
+    std::vector<SegmentInfo> preallocated;
     LIBCURVE_ERROR errCode = mdsClient->GetOrAllocateSegment(
-        allocateIfNotExist, offset, fileInfo, fEpoch, &segmentInfo);
+        allocateIfNotExist, offset, fileInfo, fEpoch, &segmentInfo,
+        preallocateNum, &preallocated);
 
     if (errCode != LIBCURVE_ERROR::OK) {
         if (errCode == LIBCURVE_ERROR::NOT_ALLOCATE) {
@@ -241,44 +252,70 @@ bool Splitor::GetOrAllocateSegment(bool allocateIfNotExist,
         }
     }
 
-    const auto chunksize = fileInfo->chunksize;
-    uint32_t count = 0;
-    for (const auto& chunkIdInfo : segmentInfo.chunkvec) {
-        uint64_t chunkIdx =
-            (segmentInfo.startoffset + count * chunksize) / chunksize;
-        metaCache->UpdateChunkInfoByIndex(chunkIdx, chunkIdInfo);
-        ++count;
+    // the preallocated segments are cached together with the requested one
+    std::vector<SegmentInfo> segments;
+    segments.reserve(preallocated.size() + 1);
+    segments.push_back(std::move(segmentInfo));
+    std::move(preallocated.begin(), preallocated.end(),
+              std::back_inserter(segments));
+
+    return UpdateSegmentInfo(segments, mdsClient, metaCache, fileInfo);
+}
+
+bool Splitor::UpdateSegmentInfo(const std::vector<SegmentInfo>& segments,
+                                MDSClient* mdsClient,
+                                MetaCache* metaCache,
+                                const FInfo* fileInfo) {
+    // fetch copysets of all segments at once, segments of a file are
+    // usually in one logical pool
+    std::map<LogicPoolID, std::set<CopysetID>> copysets;
+    for (const auto& segmentInfo : segments) {
+        copysets[segmentInfo.lpcpIDInfo.lpid].insert(
+            segmentInfo.lpcpIDInfo.cpidVec.begin(),
+            segmentInfo.lpcpIDInfo.cpidVec.end());
     }
 
-    std::vector<CopysetInfo<ChunkServerID>> copysetInfos;
-    errCode = mdsClient->GetServerList(segmentInfo.lpcpIDInfo.lpid,
-                                       segmentInfo.lpcpIDInfo.cpidVec,
-                                       &copysetInfos);
+    for (const auto& pool : copysets) {
+        std::vector<CopysetID> copysetIds(pool.second.begin(),
+                                          pool.second.end());
+        std::vector<CopysetInfo<ChunkServerID>> copysetInfos;
+        LIBCURVE_ERROR errCode = mdsClient->GetServerList(
+            pool.first, copysetIds, &copysetInfos);
+
+        if (errCode == LIBCURVE_ERROR::FAILED) {
+            std::string failedCopysets;
+            for (const auto& id : copysetIds) {
+                failedCopysets.append(std::to_string(id)).append(",");
+            }
+
+            LOG(ERROR) << "GetServerList failed, logicpool id: "
+                       << pool.first << ", copysets: " << failedCopysets;
 
-    if (errCode == LIBCURVE_ERROR::FAILED) {
-        std::string failedCopysets;
-        for (const auto& id : segmentInfo.lpcpIDInfo.cpidVec) {
-            failedCopysets.append(std::to_string(id)).append(",");
+            return false;
         }
 
-        LOG(ERROR) << "GetServerList failed, logicpool id: "
-                   << segmentInfo.lpcpIDInfo.lpid
-                   << ", copysets: " << failedCopysets;
+        for (const auto& copysetInfo : copysetInfos) {
+            for (const auto& peerInfo : copysetInfo.csinfos_) {
+                metaCache->AddCopysetIDInfo(
+                    peerInfo.peerID,
+                    CopysetIDInfo(pool.first, copysetInfo.cpid_));
+            }
+        }
 
-        return false;
+        metaCache->AddCopysetsInfo(pool.first, std::move(copysetInfos));
     }
 
-    for (const auto& copysetInfo : copysetInfos) {
-        for (const auto& peerInfo : copysetInfo.csinfos_) {
-            metaCache->AddCopysetIDInfo(
-                peerInfo.peerID,
-                CopysetIDInfo(segmentInfo.lpcpIDInfo.lpid, copysetInfo.cpid_));
+    const auto chunksize = fileInfo->chunksize;
+    for (const auto& segmentInfo : segments) {
+        uint32_t count = 0;
+        for (const auto& chunkIdInfo : segmentInfo.chunkvec) {
+            uint64_t chunkIdx =
+                (segmentInfo.startoffset + count * chunksize) / chunksize;
+            metaCache->UpdateChunkInfoByIndex(chunkIdx, chunkIdInfo);
+            ++count;
         }
     }
 
-    metaCache->AddCopysetsInfo(segmentInfo.lpcpIDInfo.lpid,
-                               std::move(copysetInfos));
-
     return true;
 }
 
@@ -417,6 +454,23 @@ RequestSourceInfo Splitor::CalcRequestSourceInfo(IOTracker* ioTracker,
     return {};
 }
 
+bool Splitor::IsSequentialAllocate(uint64_t offset,
+                                   MetaCache* metaCache,
+                                   const FInfo* fileInfo) {
+    uint64_t segmentOffset =
+        offset / fileInfo->segmentsize * fileInfo->segmentsize;
+    if (segmentOffset == 0) {
+        return false;
+    }
+
+    // last chunk of the previous segment
+    ChunkIndex chunkidx = segmentOffset / fileInfo->chunksize - 1;
+    ChunkIDInfo chunkIdInfo;
+    return metaCache->GetChunkInfoByIndex(chunkidx, &chunkIdInfo) ==
+               MetaCacheErrorType::OK &&
+           chunkIdInfo.chunkExist;
+}
+
 bool Splitor::NeedGetOrAllocateSegment(MetaCacheErrorType error, OpType opType,
                                        const ChunkIDInfo& chunkInfo,
                                        const MetaCache* metaCache) {
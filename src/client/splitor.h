@@ -103,6 +103,26 @@ class Splitor {
                                          const ChunkIDInfo& chunkInfo,
                                          const MetaCache* metaCache);
 
+    /**
+     * 从mds获取或分配offset所在的segment，并更新到metacache，
+     * 顺序写时同时缓存mds预分配的后续segment
+     */
+    static bool GetOrAllocateSegment(bool allocateIfNotExist,
+                                     uint64_t offset,
+                                     MDSClient* mdsClient,
+                                     MetaCache* metaCache,
+                                     const FInfo* fileInfo,
+                                     const FileEpoch_t *fEpoch,
+                                     ChunkIndex chunkidx);
+
+    /**
+     * 分配segment时，如果前一个segment已经分配，认为是顺序写，
+     * 需要向mds预分配后续的segment
+     */
+    static bool IsSequentialAllocate(uint64_t offset,
+                                     MetaCache* metaCache,
+                                     const FInfo* fileInfo);
+
  private:
     /**
      * IO2ChunkRequests内部会调用这个函数，进行真正的拆分操作
@@ -127,13 +147,14 @@ class Splitor {
                            const FileEpoch_t* fEpoch,
                            ChunkIndex chunkidx);
 
-    static bool GetOrAllocateSegment(bool allocateIfNotExist,
-                                     uint64_t offset,
-                                     MDSClient* mdsClient,
-                                     MetaCache* metaCache,
-                                     const FInfo* fileInfo,
-                                     const FileEpoch_t *fEpoch,
-                                     ChunkIndex chunkidx);
+    /**
+     * 将segment的chunk信息以及所在copyset的server信息更新到metacache，
+     * 所有segment的copyset通过一次GetServerList获取
+     */
+    static bool UpdateSegmentInfo(const std::vector<SegmentInfo>& segments,
+                                  MDSClient* mdsClient,
+                                  MetaCache* metaCache,
+                                  const FInfo* fileInfo);
 
     static int SplitForNormal(IOTracker* iotracker, MetaCache* metaCache,
                               std::vector<RequestContext*>* targetlist,
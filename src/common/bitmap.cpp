@@ -20,6 +20,7 @@
  * Author: yangyaokai
  */
 
+#include <endian.h>
 #include <glog/logging.h>
 #include <memory.h>
 #include <utility>
@@ -168,54 +169,61 @@ bool Bitmap::Test(uint32_t index) const {
 }
 
 uint32_t Bitmap::NextSetBit(uint32_t index) const {
-    for (; index < bits_; ++index) {
-        if (Test(index))
-            break;
-    }
-    if (index >= bits_)
-        index = NO_POS;
-    return index;
+    return FindNextBit(index, bits_, true);
 }
 
 uint32_t Bitmap::NextSetBit(uint32_t startIndex, uint32_t endIndex) const {
-    uint32_t index = startIndex;
     // bitmap中最后一个bit的index值
     uint32_t lastIndex = bits_ - 1;
     // endIndex值不能超过lastIndex
     if (endIndex > lastIndex)
         endIndex = lastIndex;
-    for (; index <= endIndex; ++index) {
-        if (Test(index))
-            break;
-    }
-    if (index > endIndex)
-        index = NO_POS;
-    return index;
+    return FindNextBit(startIndex, endIndex + 1, true);
 }
 
 uint32_t Bitmap::NextClearBit(uint32_t index) const {
-    for (; index < bits_; ++index) {
-        if (!Test(index))
-            break;
-    }
-    if (index >= bits_)
-        index = NO_POS;
-    return index;
+    return FindNextBit(index, bits_, false);
 }
 
 uint32_t Bitmap::NextClearBit(uint32_t startIndex, uint32_t endIndex) const {
-    uint32_t index = startIndex;
     uint32_t lastIndex = bits_ - 1;
     // endIndex值不能超过lastIndex
     if (endIndex > lastIndex)
         endIndex = lastIndex;
-    for (; index <= endIndex; ++index) {
-        if (!Test(index))
-            break;
+    return FindNextBit(startIndex, endIndex + 1, false);
+}
+
+uint32_t Bitmap::FindNextBit(uint32_t index, uint32_t end, bool set) const {
+    if (end > bits_)
+        end = bits_;
+
+    // 查找clear bit时先取反，转换为查找set bit
+    const uint64_t flip = set ? 0 : ~0ULL;
+    while (index < end) {
+        // 64位对齐后按字扫描，跳过全0(或全1)的字
+        if ((index & 63) == 0 && end - index >= 64) {
+            uint64_t word;
+            memcpy(&word, bitmap_ + indexOfUnit(index), sizeof(word));
+            word = le64toh(word) ^ flip;
+            if (word != 0)
+                return index + __builtin_ctzll(word);
+            index += 64;
+            continue;
+        }
+        // 按字节扫描到下一个64位边界
+        if ((index & 7) == 0 && end - index >= 8) {
+            uint8_t byte = static_cast<uint8_t>(bitmap_[indexOfUnit(index)]) ^
+                           static_cast<uint8_t>(flip);
+            if (byte != 0)
+                return index + __builtin_ctz(byte);
+            index += 8;
+            continue;
+        }
+        if (Test(index) == set)
+            return index;
+        ++index;
     }
-    if (index > endIndex)
-        index = NO_POS;
-    return index;
+    return NO_POS;
 }
 
 void Bitmap::Divide(uint32_t startIndex,
@@ -198,6 +198,11 @@ class Bitmap {
         char mask = 0x01 << indexInUnit;
         return mask;
     }
+    /**
+     * 查找[index, end)范围内第一个值为set的bit，按64位字批量扫描
+     * @return: 找到返回bit的位置，否则返回NO_POS
+     */
+    uint32_t FindNextBit(uint32_t index, uint32_t end, bool set) const;
 
  public:
     // 表示不存在的位置，值为0xffffffff
@@ -27,6 +27,7 @@
 #include <sys/types.h>
 
 #include <butil/crc32c.h>
+#include <butil/iobuf.h>
 
 namespace curve {
 namespace common {
@@ -54,6 +55,26 @@ inline uint32_t CRC32(uint32_t crc, const char *pData, size_t iLen) {
     return butil::crc32c::Extend(crc, pData, iLen);
 }
 
+/**
+ * 计算IOBuf的CRC32校验码(CRC32C)，逐个block计算，不需要先拷贝成连续内存.
+ * 结果与对IOBuf中的全部数据计算CRC32相同
+ * @param crc 起始的crc校验码
+ * @param buf 待计算的数据
+ * @return 32位的数据CRC32校验码
+ */
+inline uint32_t CRC32(uint32_t crc, const butil::IOBuf& buf) {
+    const size_t n = buf.backing_block_num();
+    for (size_t i = 0; i < n; ++i) {
+        butil::StringPiece block = buf.backing_block(i);
+        crc = butil::crc32c::Extend(crc, block.data(), block.size());
+    }
+    return crc;
+}
+
+inline uint32_t CRC32(const butil::IOBuf& buf) {
+    return CRC32(0, buf);
+}
+
 }  // namespace common
 }  // namespace curve
 
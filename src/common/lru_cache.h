@@ -31,6 +31,7 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include "src/common/concurrent/concurrent.h"
 #include "src/common/timeutility.h"
 
@@ -579,6 +580,70 @@ void TimedLRUCache<K, V, KeyTraits, ValueTraits>::Remove(const K &key) {
     lruImp_.Remove(key);
 }
 
+// ShardedLRUCache
+// Keys are spread over several LRUCache by hash, so concurrent accesses to
+// different keys don't contend on a single lock. Each shard holds at most
+// maxCount / shardNum items, and all shards share the same metrics.
+template <typename K,  typename V,
+    typename KeyTraits = CacheTraits<K>,
+    typename ValueTraits = CacheTraits<V>>
+class ShardedLRUCache : public LRUCacheInterface<K, V> {
+ public:
+    ShardedLRUCache(uint64_t maxCount, uint32_t shardNum,
+        std::shared_ptr<CacheMetrics> cacheMetrics = nullptr)
+      : cacheMetrics_(cacheMetrics) {
+        shardNum = std::max(shardNum, 1u);
+        uint64_t shardCount = 0;
+        if (maxCount != 0) {
+            shardCount = std::max<uint64_t>(
+                (maxCount + shardNum - 1) / shardNum, 1);
+        }
+        for (uint32_t i = 0; i < shardNum; ++i) {
+            shards_.emplace_back(
+                new LRUCache<K, V, KeyTraits, ValueTraits>(
+                    shardCount, cacheMetrics));
+        }
+    }
+
+    void Put(const K &key, const V &value) override {
+        GetShard(key)->Put(key, value);
+    }
+
+    bool Put(const K &key, const V &value, V *eliminated) override {
+        return GetShard(key)->Put(key, value, eliminated);
+    }
+
+    bool Get(const K &key, V *value) override {
+        return GetShard(key)->Get(key, value);
+    }
+
+    void Remove(const K &key) override {
+        GetShard(key)->Remove(key);
+    }
+
+    uint64_t Size() override {
+        uint64_t size = 0;
+        for (auto &shard : shards_) {
+            size += shard->Size();
+        }
+        return size;
+    }
+
+    std::shared_ptr<CacheMetrics> GetCacheMetrics() const {
+        return cacheMetrics_;
+    }
+
+ private:
+    LRUCache<K, V, KeyTraits, ValueTraits>* GetShard(const K &key) {
+        return shards_[std::hash<K>()(key) % shards_.size()].get();
+    }
+
+ private:
+    std::shared_ptr<CacheMetrics> cacheMetrics_;
+    std::vector<std::unique_ptr<LRUCache<K, V, KeyTraits, ValueTraits>>>
+        shards_;
+};
+
 template <typename K>
 class SglLRUCacheInterface {
  public:
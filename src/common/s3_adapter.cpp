@@ -23,10 +23,16 @@
 #include "src/common/s3_adapter.h"
 
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <bthread/unstable.h>
+#include <butil/time.h>
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <memory>
 #include <sstream>
+#include <streambuf>
 #include <string>
 #include <utility>
 
@@ -60,6 +66,65 @@ class PreallocatedIOStream : public Aws::IOStream {
     }
 };
 
+// Write response body into the caller's buffer only if the request with
+// |index| is the first one writing it, otherwise drop the data. Hedged
+// requests share the caller's buffer this way without an extra copy.
+class ClaimedStreamBuf : public std::streambuf {
+ public:
+    ClaimedStreamBuf(std::shared_ptr<void> owner, std::atomic<int>* writer,
+                     int index, char* buf, size_t size)
+        : owner_(std::move(owner)), writer_(writer), index_(index), buf_(buf),
+          size_(size), pos_(0) {}
+
+ protected:
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        int expected = -1;
+        if (!writer_->compare_exchange_strong(expected, index_) &&
+            expected != index_) {
+            return n;
+        }
+
+        size_t len = std::min<size_t>(n, size_ - pos_);
+        memcpy(buf_ + pos_, s, len);
+        pos_ += len;
+        return n;
+    }
+
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) {
+            return traits_type::not_eof(ch);
+        }
+        char c = traits_type::to_char_type(ch);
+        xsputn(&c, 1);
+        return ch;
+    }
+
+ private:
+    // keeps |writer_| alive
+    std::shared_ptr<void> owner_;
+    std::atomic<int>* writer_;
+    const int index_;
+    char* buf_;
+    const size_t size_;
+    size_t pos_;
+};
+
+class ClaimedIOStream : public Aws::IOStream {
+ public:
+    ClaimedIOStream(std::shared_ptr<void> owner, std::atomic<int>* writer,
+                    int index, char* buf, size_t size)
+        : Aws::IOStream(new ClaimedStreamBuf(std::move(owner), writer, index,
+                                             buf, size)) {}
+
+    ~ClaimedIOStream() {
+        // corresponding new in constructor
+        delete rdbuf();
+    }
+};
+
+// distinguish metrics of s3 adapters for the same bucket
+std::atomic<uint64_t> s3AdapterId{0};
+
 Aws::String GetObjectRequestRange(uint64_t offset, uint64_t len) {
     auto range =
         "bytes=" + std::to_string(offset) + "-" + std::to_string(offset + len);
@@ -112,7 +177,42 @@ void InitS3AdaptorOptionExceptS3InfoOption(Configuration* conf,
         LOG(WARNING) << "Not found s3.maxAsyncRequestInflightBytes in conf";
         s3Opt->maxAsyncRequestInflightBytes = 0;
     }
-}
+
+    LOG_IF(WARNING, !conf->GetDoubleValue("s3.getHedgePercentile",
+                                          &s3Opt->getHedgePercentile))
+        << "Not found s3.getHedgePercentile in conf, get requests are not "
+           "hedged";
+    LOG_IF(WARNING, !conf->GetUInt64Value("s3.getHedgeMinDelayMs",
+                                          &s3Opt->getHedgeMinDelayMs))
+        << "Not found s3.getHedgeMinDelayMs in conf, use default value "
+        << s3Opt->getHedgeMinDelayMs;
+    LOG_IF(WARNING, !conf->GetUInt64Value("s3.getHedgeMinSamples",
+                                          &s3Opt->getHedgeMinSamples))
+        << "Not found s3.getHedgeMinSamples in conf, use default value "
+        << s3Opt->getHedgeMinSamples;
+}
+
+// A get request which may be sent twice. The slower request can't be
+// cancelled, so the request which first receives data owns the caller's
+// buffer, and the data of the other one is dropped.
+struct S3Adapter::HedgedGetContext {
+    HedgedGetContext(S3Adapter* adapter,
+                     std::shared_ptr<GetObjectAsyncContext> context)
+        : adapter(adapter), context(std::move(context)) {}
+
+    S3Adapter* adapter;
+    // the request from caller
+    std::shared_ptr<GetObjectAsyncContext> context;
+    // index of the request writing into caller's buffer, -1 if none
+    std::atomic<int> writer{-1};
+
+    std::mutex mtx;
+    bool done = false;
+    int inflight = 0;
+    // argument of the pending hedge timer, nullptr if it's fired or deleted
+    std::shared_ptr<HedgedGetContext>* timerArg = nullptr;
+    bthread_timer_t timerId;
+};
 
 void S3Adapter::Init(const std::string& path) {
     LOG(INFO) << "Loading s3 configurations";
@@ -182,6 +282,23 @@ void S3Adapter::Init(const S3AdapterOption &option) {
         option.maxAsyncRequestInflightBytes == 0
             ? UINT64_MAX
             : option.maxAsyncRequestInflightBytes));
+
+    getHedgePercentile_ = option.getHedgePercentile;
+    getHedgeMinDelayMs_ = option.getHedgeMinDelayMs;
+    getHedgeMinSamples_ = option.getHedgeMinSamples;
+    LOG_IF(INFO, getHedgePercentile_ > 0)
+        << "S3Adapter hedge get requests after p" << getHedgePercentile_ * 100
+        << " latency, min delay " << getHedgeMinDelayMs_ << "ms, min samples "
+        << getHedgeMinSamples_;
+
+    std::string prefix = "s3_adapter";
+    if (!option.bucketName.empty()) {
+        prefix += "_" + option.bucketName;
+    }
+    prefix += "_" + std::to_string(s3AdapterId.fetch_add(1));
+    getObjectLatency_.expose(prefix, "get_object");
+    putObjectLatency_.expose(prefix, "put_object");
+    hedgedGetCount_.expose_as(prefix, "hedged_get_count");
 }
 
 void S3Adapter::Deinit() {
@@ -292,7 +409,10 @@ int S3Adapter::PutObject(const Aws::String &key, const char *buffer,
         throttle_->Add(false, bufferSize);
     }
 
+    butil::Timer timer(butil::Timer::STARTED);
     auto response = s3Client_->PutObject(request);
+    timer.stop();
+    putObjectLatency_ << timer.u_elapsed();
     if (response.IsSuccess()) {
         return 0;
     } else {
@@ -350,8 +470,9 @@ void S3Adapter::PutObjectAsync(std::shared_ptr<PutObjectAsyncContext> context) {
             ctx->cb(ctx);
         };
 
+    const int64_t startUs = butil::cpuwide_time_us();
     Aws::S3::PutObjectResponseReceivedHandler handler =
-        [context](
+        [this, startUs](
             const Aws::S3::S3Client * /*client*/,
             const Aws::S3::Model::PutObjectRequest & /*request*/,
             const Aws::S3::Model::PutObjectOutcome &response,
@@ -362,6 +483,7 @@ void S3Adapter::PutObjectAsync(std::shared_ptr<PutObjectAsyncContext> context) {
                     std::dynamic_pointer_cast<const PutObjectAsyncContext>(
                         awsCtx));
 
+            putObjectLatency_ << butil::cpuwide_time_us() - startUs;
             LOG_IF(ERROR, !response.IsSuccess())
                 << "PutObjectAsync error: "
                 << response.GetError().GetExceptionName()
@@ -420,7 +542,10 @@ int S3Adapter::GetObject(const std::string &key,
     if (throttle_) {
         throttle_->Add(true, len);
     }
+    butil::Timer timer(butil::Timer::STARTED);
     auto response = s3Client_->GetObject(request);
+    timer.stop();
+    getObjectLatency_ << timer.u_elapsed();
     if (response.IsSuccess()) {
         return 0;
     } else {
@@ -432,16 +557,6 @@ int S3Adapter::GetObject(const std::string &key,
 }
 
 void S3Adapter::GetObjectAsync(std::shared_ptr<GetObjectAsyncContext> context) {
-    Aws::S3::Model::GetObjectRequest request;
-    request.SetBucket(bucketName_);
-    request.SetKey(Aws::String{context->key.c_str(), context->key.size()});
-    request.SetRange(GetObjectRequestRange(context->offset, context->len));
-
-    request.SetResponseStreamFactory([context]() {
-        return Aws::New<PreallocatedIOStream>(AWS_ALLOCATE_TAG, context->buf,
-                                              context->len);
-    });
-
     auto originCallback = context->cb;
     auto wrapperCallback =
         [this, originCallback](
@@ -452,17 +567,49 @@ void S3Adapter::GetObjectAsync(std::shared_ptr<GetObjectAsyncContext> context) {
             ctx->cb(this, ctx);
         };
 
+    if (throttle_) {
+        throttle_->Add(true, context->len);
+    }
+
+    inflightBytesThrottle_->OnStart(context->len);
+    context->cb = std::move(wrapperCallback);
+    if (ShouldHedgeGet()) {
+        HedgedGetObjectAsync(std::move(context));
+    } else {
+        DoGetObjectAsync(std::move(context));
+    }
+}
+
+void S3Adapter::DoGetObjectAsync(
+    std::shared_ptr<GetObjectAsyncContext> context,
+    Aws::IOStreamFactory streamFactory) {
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(bucketName_);
+    request.SetKey(Aws::String{context->key.c_str(), context->key.size()});
+    request.SetRange(GetObjectRequestRange(context->offset, context->len));
+
+    if (!streamFactory) {
+        streamFactory = [context]() {
+            return Aws::New<PreallocatedIOStream>(
+                AWS_ALLOCATE_TAG, context->buf, context->len);
+        };
+    }
+    request.SetResponseStreamFactory(streamFactory);
+
+    const int64_t startUs = butil::cpuwide_time_us();
     Aws::S3::GetObjectResponseReceivedHandler handler =
-        [this](const Aws::S3::S3Client * /*client*/,
-               const Aws::S3::Model::GetObjectRequest & /*request*/,
-               const Aws::S3::Model::GetObjectOutcome &response,
-               const std::shared_ptr<const Aws::Client::AsyncCallerContext>
-                   &awsCtx) {
+        [this, startUs](
+            const Aws::S3::S3Client * /*client*/,
+            const Aws::S3::Model::GetObjectRequest & /*request*/,
+            const Aws::S3::Model::GetObjectOutcome &response,
+            const std::shared_ptr<const Aws::Client::AsyncCallerContext>
+                &awsCtx) {
             std::shared_ptr<GetObjectAsyncContext> ctx =
                 std::const_pointer_cast<GetObjectAsyncContext>(
                     std::dynamic_pointer_cast<const GetObjectAsyncContext>(
                         awsCtx));
 
+            getObjectLatency_ << butil::cpuwide_time_us() - startUs;
             LOG_IF(ERROR, !response.IsSuccess())
                 << "GetObjectAsync error: "
                 << response.GetError().GetExceptionName()
@@ -472,13 +619,121 @@ void S3Adapter::GetObjectAsync(std::shared_ptr<GetObjectAsyncContext> context) {
             ctx->cb(this, ctx);
         };
 
-    if (throttle_) {
-        throttle_->Add(true, context->len);
+    s3Client_->GetObjectAsync(request, handler, context);
+}
+
+void S3Adapter::HedgedGetObjectAsync(
+    std::shared_ptr<GetObjectAsyncContext> context) {
+    auto hedge = std::make_shared<HedgedGetContext>(this, std::move(context));
+    {
+        // add the timer before sending the request, so the request always
+        // sees the timer when it finishes
+        std::lock_guard<std::mutex> lock(hedge->mtx);
+        hedge->inflight = 1;
+        auto* arg = new std::shared_ptr<HedgedGetContext>(hedge);
+        int ret = bthread_timer_add(
+            &hedge->timerId, butil::milliseconds_from_now(GetHedgeDelayMs()),
+            &S3Adapter::OnHedgeTimer, arg);
+        if (ret == 0) {
+            hedge->timerArg = arg;
+        } else {
+            LOG(WARNING) << "bthread_timer_add failed, ret = " << ret
+                         << ", get request is not hedged, key: "
+                         << hedge->context->key;
+            delete arg;
+        }
     }
 
-    inflightBytesThrottle_->OnStart(context->len);
-    context->cb = std::move(wrapperCallback);
-    s3Client_->GetObjectAsync(request, handler, context);
+    IssueHedgedGet(hedge, 0);
+}
+
+void S3Adapter::IssueHedgedGet(const std::shared_ptr<HedgedGetContext>& hedge,
+                               int index) {
+    const auto& origin = hedge->context;
+    auto ctx = std::make_shared<GetObjectAsyncContext>(
+        origin->key, origin->buf, origin->offset, origin->len,
+        [hedge, index](const S3Adapter* /*adapter*/,
+                       const std::shared_ptr<GetObjectAsyncContext>& ctx) {
+            hedge->adapter->OnHedgedGetDone(hedge, index, ctx);
+        });
+    DoGetObjectAsync(std::move(ctx), [hedge, index]() {
+        const auto& origin = hedge->context;
+        return Aws::New<ClaimedIOStream>(AWS_ALLOCATE_TAG, hedge,
+                                         &hedge->writer, index, origin->buf,
+                                         origin->len);
+    });
+}
+
+void S3Adapter::OnHedgedGetDone(
+    const std::shared_ptr<HedgedGetContext>& hedge,
+    int index,
+    const std::shared_ptr<GetObjectAsyncContext>& ctx) {
+    std::shared_ptr<HedgedGetContext>* timerArg = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(hedge->mtx);
+        --hedge->inflight;
+        if (hedge->done) {
+            return;
+        }
+
+        if (ctx->retCode >= 0) {
+            // an empty response writes nothing, claim the buffer here so the
+            // other request can't write it after the caller is called back
+            int expected = -1;
+            if (!hedge->writer.compare_exchange_strong(expected, index) &&
+                expected != index) {
+                // data of this request is dropped, wait for the other one
+                return;
+            }
+        } else if (hedge->inflight > 0 &&
+                   hedge->writer.load(std::memory_order_acquire) != index) {
+            // the other request may still succeed
+            return;
+        }
+
+        hedge->done = true;
+        std::swap(timerArg, hedge->timerArg);
+    }
+
+    // the timer callback is freed here only if it hasn't been run
+    if (timerArg != nullptr && bthread_timer_del(hedge->timerId) == 0) {
+        delete timerArg;
+    }
+
+    auto& origin = hedge->context;
+    origin->retCode = ctx->retCode;
+    origin->actualLen = ctx->actualLen;
+    origin->cb(this, origin);
+}
+
+void S3Adapter::OnHedgeTimer(void* arg) {
+    std::unique_ptr<std::shared_ptr<HedgedGetContext>> hedge(
+        static_cast<std::shared_ptr<HedgedGetContext>*>(arg));
+    {
+        std::lock_guard<std::mutex> lock((*hedge)->mtx);
+        (*hedge)->timerArg = nullptr;
+        if ((*hedge)->done) {
+            return;
+        }
+        ++(*hedge)->inflight;
+    }
+
+    S3Adapter* adapter = (*hedge)->adapter;
+    adapter->hedgedGetCount_ << 1;
+    adapter->IssueHedgedGet(*hedge, 1);
+}
+
+bool S3Adapter::ShouldHedgeGet() {
+    // latency percentile of a few requests is meaningless
+    return getHedgePercentile_ > 0 &&
+           getObjectLatency_.count() >=
+               static_cast<int64_t>(getHedgeMinSamples_);
+}
+
+uint64_t S3Adapter::GetHedgeDelayMs() {
+    int64_t latencyUs =
+        getObjectLatency_.latency_percentile(getHedgePercentile_);
+    return std::max<uint64_t>(getHedgeMinDelayMs_, latencyUs / 1000);
 }
 
 bool S3Adapter::ObjectExist(const Aws::String &key) {
@@ -49,6 +49,7 @@
 #include <aws/s3/model/ObjectIdentifier.h>                //NOLINT
 #include <aws/s3/model/PutObjectRequest.h>                //NOLINT
 #include <aws/s3/model/UploadPartRequest.h>               //NOLINT
+#include <bvar/bvar.h>
 
 #include <condition_variable>
 #include <cstdint>
@@ -92,6 +93,14 @@ struct S3AdapterOption {
     uint64_t bpsReadMB;
     uint64_t bpsWriteMB;
     bool useVirtualAddressing;
+    // hedge an async get request by sending the same request again if it
+    // isn't finished after this latency percentile (e.g. 0.99) of previous
+    // get requests, |0| means not hedging
+    double getHedgePercentile = 0;
+    // lower bound of the hedge delay
+    uint64_t getHedgeMinDelayMs = 10;
+    // not hedging until this number of get requests has been recorded
+    uint64_t getHedgeMinSamples = 1000;
 };
 
 struct S3InfoOption {
@@ -355,6 +364,31 @@ class S3Adapter {
     Aws::Client::ClientConfiguration *GetConfig() { return clientCfg_; }
 
  private:
+    struct HedgedGetContext;
+
+    // send a get request without throttling, |context->cb| is called with
+    // the result, response body is written by the stream from
+    // |streamFactory|, or into |context->buf| if it's empty
+    void DoGetObjectAsync(std::shared_ptr<GetObjectAsyncContext> context,
+                          Aws::IOStreamFactory streamFactory = {});
+
+    // send the get request, and send it again if the first one is slow,
+    // the result of the request which first receives data is returned
+    void HedgedGetObjectAsync(std::shared_ptr<GetObjectAsyncContext> context);
+
+    void IssueHedgedGet(const std::shared_ptr<HedgedGetContext>& hedge,
+                        int index);
+
+    void OnHedgedGetDone(const std::shared_ptr<HedgedGetContext>& hedge,
+                         int index,
+                         const std::shared_ptr<GetObjectAsyncContext>& ctx);
+
+    static void OnHedgeTimer(void* arg);
+
+    bool ShouldHedgeGet();
+
+    uint64_t GetHedgeDelayMs();
+
     class AsyncRequestInflightBytesThrottle {
      public:
         explicit AsyncRequestInflightBytesThrottle(uint64_t maxInflightBytes)
@@ -388,6 +422,16 @@ class S3Adapter {
     Throttle *throttle_;
 
     std::unique_ptr<AsyncRequestInflightBytesThrottle> inflightBytesThrottle_;
+
+    double getHedgePercentile_ = 0;
+    uint64_t getHedgeMinDelayMs_ = 0;
+    uint64_t getHedgeMinSamples_ = 0;
+
+    // latency of get/put object requests sent to s3
+    bvar::LatencyRecorder getObjectLatency_;
+    bvar::LatencyRecorder putObjectLatency_;
+    // number of get requests that are hedged
+    bvar::Adder<uint64_t> hedgedGetCount_;
 };
 
 class FakeS3Adapter : public S3Adapter {
@@ -0,0 +1,282 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-20
+ */
+
+#include "src/kvstorageclient/batch_kvstorage_client.h"
+
+#include <glog/logging.h>
+
+#include <chrono>
+#include <unordered_set>
+
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace kvstorage {
+
+using ::curve::common::TimeUtility;
+
+BatchKVStorageClient::BatchKVStorageClient(
+    std::shared_ptr<KVStorageClient> client,
+    const BatchKVStorageClientOption &option,
+    const std::string &metricPrefix)
+    : client_(client),
+      option_(option),
+      pendingOps_(0),
+      committing_(false),
+      metric_(metricPrefix) {}
+
+int BatchKVStorageClient::Put(const std::string &key,
+                              const std::string &value) {
+    return PutRewithRevision(key, value, nullptr);
+}
+
+int BatchKVStorageClient::PutRewithRevision(const std::string &key,
+                                            const std::string &value,
+                                            int64_t *revision) {
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    std::vector<Operation> ops{
+        Operation{OpType::OpPut, const_cast<char *>(key.c_str()),
+                  const_cast<char *>(value.c_str()),
+                  static_cast<int>(key.size()),
+                  static_cast<int>(value.size())}};
+    int errCode = Write(ops, revision);
+    metric_.put << TimeUtility::GetTimeofDayUs() - start;
+    return errCode;
+}
+
+int BatchKVStorageClient::Get(const std::string &key, std::string *out) {
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    int errCode = client_->Get(key, out);
+    metric_.get << TimeUtility::GetTimeofDayUs() - start;
+    return errCode;
+}
+
+int BatchKVStorageClient::List(const std::string &startKey,
+                               const std::string &endKey,
+                               std::vector<std::string> *values) {
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    int errCode = client_->List(startKey, endKey, values);
+    metric_.list << TimeUtility::GetTimeofDayUs() - start;
+    return errCode;
+}
+
+int BatchKVStorageClient::List(
+    const std::string &startKey, const std::string &endKey,
+    std::vector<std::pair<std::string, std::string>> *out) {
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    int errCode = client_->List(startKey, endKey, out);
+    metric_.list << TimeUtility::GetTimeofDayUs() - start;
+    return errCode;
+}
+
+int BatchKVStorageClient::Delete(const std::string &key) {
+    return DeleteRewithRevision(key, nullptr);
+}
+
+int BatchKVStorageClient::DeleteRewithRevision(const std::string &key,
+                                               int64_t *revision) {
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    std::vector<Operation> ops{
+        Operation{OpType::OpDelete, const_cast<char *>(key.c_str()),
+                  nullptr, static_cast<int>(key.size()), 0}};
+    int errCode = Write(ops, revision);
+    metric_.del << TimeUtility::GetTimeofDayUs() - start;
+    return errCode;
+}
+
+int BatchKVStorageClient::TxnN(const std::vector<Operation> &ops) {
+    return TxnNWithRevision(ops, nullptr);
+}
+
+int BatchKVStorageClient::TxnNWithRevision(const std::vector<Operation> &ops,
+                                           int64_t *revision) {
+    if (ops.empty()) {
+        LOG(ERROR) << "do not support empty Txn";
+        return EtcdErrCode::EtcdInvalidArgument;
+    }
+
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    int errCode = Write(ops, revision);
+    metric_.txn << TimeUtility::GetTimeofDayUs() - start;
+    return errCode;
+}
+
+int BatchKVStorageClient::CompareAndSwap(const std::string &key,
+                                         const std::string &preV,
+                                         const std::string &target) {
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    int errCode = client_->CompareAndSwap(key, preV, target);
+    metric_.cas << TimeUtility::GetTimeofDayUs() - start;
+    return errCode;
+}
+
+int BatchKVStorageClient::Write(const std::vector<Operation> &ops,
+                                int64_t *revision) {
+    WriteRequest req(&ops);
+
+    std::unique_lock<std::mutex> lk(mtx_);
+    pending_.push_back(&req);
+    pendingOps_ += ops.size();
+    if (pendingOps_ >= option_.maxBatchOps) {
+        // wake up the leader waiting for the batch window
+        cond_.notify_all();
+    }
+
+    while (!req.done) {
+        if (committing_) {
+            cond_.wait(lk);
+            continue;
+        }
+
+        // become the leader
+        committing_ = true;
+        if (option_.batchWindowUs > 0 &&
+            pendingOps_ < option_.maxBatchOps) {
+            cond_.wait_for(lk,
+                std::chrono::microseconds(option_.batchWindowUs),
+                [this] { return pendingOps_ >= option_.maxBatchOps; });
+        }
+
+        std::vector<WriteRequest *> batch = TakeBatchLocked();
+        lk.unlock();
+        CommitBatch(batch);
+        lk.lock();
+
+        for (auto r : batch) {
+            r->done = true;
+        }
+        committing_ = false;
+        cond_.notify_all();
+    }
+
+    if (req.errCode == EtcdErrCode::EtcdOK && revision != nullptr) {
+        *revision = req.revision;
+    }
+    return req.errCode;
+}
+
+std::vector<BatchKVStorageClient::WriteRequest *>
+BatchKVStorageClient::TakeBatchLocked() {
+    std::vector<WriteRequest *> batch;
+    std::unordered_set<std::string> keys;
+    uint64_t batchOps = 0;
+
+    while (!pending_.empty()) {
+        WriteRequest *req = pending_.front();
+        const std::vector<Operation> &ops = *req->ops;
+        if (!batch.empty()) {
+            if (batchOps + ops.size() > option_.maxBatchOps) {
+                break;
+            }
+
+            // etcd rejects a transaction which modifies a key twice,
+            // and writes to the same key must keep their order
+            bool conflict = false;
+            for (const auto &op : ops) {
+                if (keys.count(std::string(op.key, op.keyLen)) != 0) {
+                    conflict = true;
+                    break;
+                }
+            }
+            if (conflict) {
+                break;
+            }
+        }
+
+        for (const auto &op : ops) {
+            keys.emplace(op.key, op.keyLen);
+        }
+        batch.push_back(req);
+        batchOps += ops.size();
+        pending_.pop_front();
+        pendingOps_ -= ops.size();
+    }
+
+    return batch;
+}
+
+void BatchKVStorageClient::CommitBatch(
+    const std::vector<WriteRequest *> &batch) {
+    if (batch.size() == 1) {
+        CommitOne(batch[0]);
+        return;
+    }
+
+    std::vector<Operation> ops;
+    for (auto req : batch) {
+        ops.insert(ops.end(), req->ops->begin(), req->ops->end());
+    }
+
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    int64_t revision = 0;
+    int errCode = client_->TxnNWithRevision(ops, &revision);
+    metric_.batchTxn << TimeUtility::GetTimeofDayUs() - start;
+    metric_.batchOps << ops.size();
+
+    if (errCode == EtcdErrCode::EtcdOK || IsTransientError(errCode)) {
+        for (auto req : batch) {
+            req->errCode = errCode;
+            req->revision = revision;
+        }
+        return;
+    }
+
+    LOG(WARNING) << "commit " << batch.size() << " writes with " << ops.size()
+                 << " ops in one txn err: " << errCode
+                 << ", commit them one by one";
+    metric_.batchFallback << 1;
+    for (auto req : batch) {
+        CommitOne(req);
+    }
+}
+
+void BatchKVStorageClient::CommitOne(WriteRequest *req) {
+    const std::vector<Operation> &ops = *req->ops;
+    uint64_t start = TimeUtility::GetTimeofDayUs();
+    if (ops.size() == 1 && ops[0].opType == OpType::OpPut) {
+        req->errCode = client_->PutRewithRevision(
+            std::string(ops[0].key, ops[0].keyLen),
+            std::string(ops[0].value, ops[0].valueLen), &req->revision);
+    } else if (ops.size() == 1 && ops[0].opType == OpType::OpDelete) {
+        req->errCode = client_->DeleteRewithRevision(
+            std::string(ops[0].key, ops[0].keyLen), &req->revision);
+    } else {
+        req->errCode = client_->TxnNWithRevision(ops, &req->revision);
+    }
+    metric_.batchTxn << TimeUtility::GetTimeofDayUs() - start;
+    metric_.batchOps << ops.size();
+}
+
+bool BatchKVStorageClient::IsTransientError(int errCode) {
+    // the others would fail in the same way if they were committed one by one
+    switch (errCode) {
+        case EtcdErrCode::EtcdCanceled:
+        case EtcdErrCode::EtcdDeadlineExceeded:
+        case EtcdErrCode::EtcdResourceExhausted:
+        case EtcdErrCode::EtcdUnavailable:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace kvstorage
+}  // namespace curve
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-20
+ */
+
+#ifndef SRC_KVSTORAGECLIENT_BATCH_KVSTORAGE_CLIENT_H_
+#define SRC_KVSTORAGECLIENT_BATCH_KVSTORAGE_CLIENT_H_
+
+#include <bvar/bvar.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/kvstorageclient/etcd_client.h"
+
+namespace curve {
+namespace kvstorage {
+
+struct BatchKVStorageClientOption {
+    // max number of operations merged into one transaction,
+    // 1 means every write is sent to etcd by itself
+    uint32_t maxBatchOps = 64;
+    // how long the first write of a batch waits for others to join,
+    // 0 means only writes arrived during the last commit are merged
+    uint32_t batchWindowUs = 0;
+};
+
+struct KVStorageClientMetric {
+    explicit KVStorageClientMetric(const std::string &prefix)
+      : put(prefix, "put"),
+        get(prefix, "get"),
+        list(prefix, "list"),
+        del(prefix, "delete"),
+        txn(prefix, "txn"),
+        cas(prefix, "cas"),
+        batchTxn(prefix, "batch_txn"),
+        batchOps(prefix, "batch_ops"),
+        batchFallback(prefix, "batch_fallback") {}
+
+    bvar::LatencyRecorder put;
+    bvar::LatencyRecorder get;
+    bvar::LatencyRecorder list;
+    bvar::LatencyRecorder del;
+    bvar::LatencyRecorder txn;
+    bvar::LatencyRecorder cas;
+    // latency of committing one batch
+    bvar::LatencyRecorder batchTxn;
+    // number of operations committed in one batch
+    bvar::IntRecorder batchOps;
+    // number of merged transactions that failed and were split
+    bvar::Adder<uint64_t> batchFallback;
+};
+
+// BatchKVStorageClient merges concurrent independent writes
+// (Put/Delete/TxnN) into one multi-op etcd transaction, i.e. group commit.
+//
+// The first writer which finds no commit in progress becomes the leader,
+// it takes the pending writes whose keys don't conflict, commits them in one
+// transaction and wakes the writers of the batch up, while writes arrived
+// during the commit wait for the next batch. Every caller still blocks until
+// its own writes are committed, so the semantics of KVStorageClient don't
+// change. If the merged transaction is rejected, the writes of the batch are
+// committed one by one so a bad write doesn't fail the others.
+//
+// Reads and CompareAndSwap go to the underlying client directly.
+class BatchKVStorageClient : public KVStorageClient {
+ public:
+    BatchKVStorageClient(std::shared_ptr<KVStorageClient> client,
+                         const BatchKVStorageClientOption &option,
+                         const std::string &metricPrefix = "etcd_client");
+
+    int Put(const std::string &key, const std::string &value) override;
+
+    int PutRewithRevision(const std::string &key, const std::string &value,
+        int64_t *revision) override;
+
+    int Get(const std::string &key, std::string *out) override;
+
+    int List(const std::string &startKey,
+        const std::string &endKey, std::vector<std::string> *values) override;
+
+    int List(const std::string& startKey, const std::string& endKey,
+             std::vector<std::pair<std::string, std::string> >* out) override;
+
+    int Delete(const std::string &key) override;
+
+    int DeleteRewithRevision(
+        const std::string &key, int64_t *revision) override;
+
+    int TxnN(const std::vector<Operation> &ops) override;
+
+    int TxnNWithRevision(const std::vector<Operation> &ops,
+        int64_t *revision) override;
+
+    int CompareAndSwap(const std::string &key, const std::string &preV,
+        const std::string &target) override;
+
+    const KVStorageClientMetric& GetMetric() const {
+        return metric_;
+    }
+
+ private:
+    struct WriteRequest {
+        explicit WriteRequest(const std::vector<Operation> *ops)
+          : ops(ops), errCode(EtcdErrCode::EtcdOK), revision(0),
+            done(false) {}
+
+        // kept by the caller until the request is done
+        const std::vector<Operation> *ops;
+        int errCode;
+        int64_t revision;
+        bool done;
+    };
+
+    // Queue the request and wait until it is committed
+    int Write(const std::vector<Operation> &ops, int64_t *revision);
+
+    // Take the writes of next batch from the head of pending_,
+    // stop at the first write whose keys conflict with the batch
+    std::vector<WriteRequest *> TakeBatchLocked();
+
+    void CommitBatch(const std::vector<WriteRequest *> &batch);
+
+    // Commit a single request with the underlying client
+    void CommitOne(WriteRequest *req);
+
+    static bool IsTransientError(int errCode);
+
+ private:
+    std::shared_ptr<KVStorageClient> client_;
+    const BatchKVStorageClientOption option_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+    std::deque<WriteRequest *> pending_;
+    uint64_t pendingOps_;
+    // whether a leader is committing a batch
+    bool committing_;
+
+    KVStorageClientMetric metric_;
+};
+
+}  // namespace kvstorage
+}  // namespace curve
+
+#endif  // SRC_KVSTORAGECLIENT_BATCH_KVSTORAGE_CLIENT_H_
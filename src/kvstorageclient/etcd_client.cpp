@@ -190,18 +190,27 @@ int EtcdClientImp::DeleteRewithRevision(
 }
 
 int EtcdClientImp::TxnN(const std::vector<Operation> &ops) {
+    int64_t revision;
+    return TxnNWithRevision(ops, &revision);
+}
+
+int EtcdClientImp::TxnNWithRevision(const std::vector<Operation> &ops,
+    int64_t *revision) {
+    if (ops.empty()) {
+        LOG(ERROR) << "do not support empty Txn";
+        return EtcdErrCode::EtcdInvalidArgument;
+    }
+
     bool needRetry = false;
     int retry = 0;
     int errCode;
     do {
-        if (ops.size() == 2) {
-            errCode = EtcdClientTxn2(timeout_, ops[0], ops[1]);
-        } else if (ops.size() == 3) {
-            errCode = EtcdClientTxn3(timeout_, ops[0], ops[1], ops[2]);
-        } else {
-            LOG(ERROR) << "do not support Txn " << ops.size();
-            return EtcdErrCode::EtcdInvalidArgument;
+        EtcdClientTxnN_return res = EtcdClientTxnN(timeout_,
+            const_cast<Operation *>(ops.data()), ops.size());
+        if (res.r0 == EtcdErrCode::EtcdOK) {
+            *revision = res.r1;
         }
+        errCode = res.r0;
         needRetry = NeedRetry(errCode);
     } while (needRetry && ++retry <= retryTimes_);
     return errCode;
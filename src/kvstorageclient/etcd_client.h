@@ -112,7 +112,8 @@ class KVStorageClient {
         const std::string &key, int64_t *revision) = 0;
 
     /*
-    * @brief TxnN Operate transactions in the order of ops[0] ops[1] ..., currently 2 and 3 operations are supported //NOLINT
+    * @brief TxnN Operate any number of operations in one transaction in the
+    *        order of ops[0] ops[1] ...
     *
     * @param[in] ops Operation set
     *
@@ -120,6 +121,18 @@ class KVStorageClient {
     */
     virtual int TxnN(const std::vector<Operation> &ops) = 0;
 
+    /*
+    * @brief TxnNWithRevision Operate any number of operations in one
+    *        transaction in the order of ops[0] ops[1] ...
+    *
+    * @param[in] ops Operation set
+    * @param[out] revision Version number of the transaction
+    *
+    * @return error code
+    */
+    virtual int TxnNWithRevision(const std::vector<Operation> &ops,
+        int64_t *revision) = 0;
+
     /**
      * @brief CompareAndSwap Transaction, to achieve CAS
      *
@@ -174,6 +187,9 @@ class EtcdClientImp : public KVStorageClient {
 
     int TxnN(const std::vector<Operation> &ops) override;
 
+    int TxnNWithRevision(const std::vector<Operation> &ops,
+        int64_t *revision) override;
+
     int CompareAndSwap(const std::string &key, const std::string &preV,
         const std::string &target) override;
 
@@ -228,6 +228,143 @@ int ChunkServerClient::DeleteChunk(ChunkServerIdType leaderId,
     return kMdsSuccess;
 }
 
+int ChunkServerClient::BatchDeleteChunkSnapshotOrCorrectSn(
+    ChunkServerIdType leaderId,
+    LogicalPoolID logicalPoolId,
+    CopysetID copysetId,
+    const std::vector<ChunkID> &chunkIds,
+    uint64_t correctedSn) {
+    ChunkRequest request;
+    request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_BATCH);
+    request.set_logicpoolid(logicalPoolId);
+    request.set_copysetid(copysetId);
+    request.set_chunkid(chunkIds.empty() ? 0 : chunkIds[0]);
+    for (auto chunkId : chunkIds) {
+        ChunkRequest *subRequest = request.add_subrequests();
+        subRequest->set_optype(CHUNK_OP_TYPE::CHUNK_OP_DELETE_SNAP);
+        subRequest->set_logicpoolid(logicalPoolId);
+        subRequest->set_copysetid(copysetId);
+        subRequest->set_chunkid(chunkId);
+        subRequest->set_correctedsn(correctedSn);
+    }
+    return SendBatchChunkOp(leaderId, request);
+}
+
+int ChunkServerClient::BatchDeleteChunk(ChunkServerIdType leaderId,
+    LogicalPoolID logicalPoolId,
+    CopysetID copysetId,
+    const std::vector<ChunkID> &chunkIds,
+    uint64_t sn) {
+    ChunkRequest request;
+    request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_BATCH);
+    request.set_logicpoolid(logicalPoolId);
+    request.set_copysetid(copysetId);
+    request.set_chunkid(chunkIds.empty() ? 0 : chunkIds[0]);
+    for (auto chunkId : chunkIds) {
+        ChunkRequest *subRequest = request.add_subrequests();
+        subRequest->set_optype(CHUNK_OP_TYPE::CHUNK_OP_DELETE);
+        subRequest->set_logicpoolid(logicalPoolId);
+        subRequest->set_copysetid(copysetId);
+        subRequest->set_chunkid(chunkId);
+        subRequest->set_sn(sn);
+    }
+    return SendBatchChunkOp(leaderId, request);
+}
+
+int ChunkServerClient::SendBatchChunkOp(ChunkServerIdType leaderId,
+                                        const ChunkRequest &request) {
+    ChannelPtr channelPtr;
+    int res = GetOrInitChannel(leaderId, &channelPtr);
+    if (res != kMdsSuccess) {
+        return res;
+    }
+    ChunkService_Stub stub(channelPtr.get());
+
+    brpc::Controller cntl;
+    ChunkResponse response;
+    uint32_t retry = 0;
+    do {
+        cntl.Reset();
+        cntl.set_timeout_ms(rpcTimeoutMs_);
+        stub.BatchChunkOp(&cntl,
+            &request,
+            &response,
+            nullptr);
+        LOG(INFO) << "Send BatchChunkOp[log_id=" << cntl.log_id()
+                  << "] from " << cntl.local_side()
+                  << " to " << cntl.remote_side()
+                  << ", logicalPoolId = " << request.logicpoolid()
+                  << ", copysetId = " << request.copysetid()
+                  << ", chunk num = " << request.subrequests_size();
+        if (cntl.Failed()) {
+            LOG(WARNING) << "Send BatchChunkOp error, "
+                       << "cntl.errorText = "
+                       << cntl.ErrorText()
+                       << ", retry, time = "
+                       << retry;
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(rpcRetryIntervalMs_));
+        }
+        retry++;
+    } while (cntl.Failed() && retry < rpcRetryTimes_);
+
+    if (cntl.Failed()) {
+        LOG(ERROR) << "Send BatchChunkOp error, retry fail,"
+                   << "cntl.errorText = "
+                   << cntl.ErrorText() << std::endl;
+        return kRpcFail;
+    }
+
+    switch (response.status()) {
+        case CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS:
+            break;
+        case CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED:
+            LOG(INFO) << "Received BatchChunkOp, not leader, redirect."
+                      << " [log_id=" << cntl.log_id()
+                      << "] from " << cntl.remote_side()
+                      << " to " << cntl.local_side();
+            return kCsClientNotLeader;
+        default:
+            LOG(ERROR) << "Received BatchChunkOp error, [log_id="
+                       << cntl.log_id()
+                       << "] from " << cntl.remote_side()
+                       << " to " << cntl.local_side()
+                       << ", status = " << response.status();
+            return kCsClientReturnFail;
+    }
+
+    if (response.subresponses_size() != request.subrequests_size()) {
+        LOG(ERROR) << "Received BatchChunkOp error, [log_id="
+                   << cntl.log_id()
+                   << "] from " << cntl.remote_side()
+                   << ", response num = " << response.subresponses_size()
+                   << ", request num = " << request.subrequests_size();
+        return kCsClientReturnFail;
+    }
+
+    // the chunks are applied in one log entry, it's ok to retry the whole
+    // batch since deleting the chunk or its snapshot is idempotent
+    for (int i = 0; i < response.subresponses_size(); ++i) {
+        auto status = response.subresponses(i).status();
+        if (status != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS &&
+            status != CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_NOTEXIST) {
+            LOG(ERROR) << "Received BatchChunkOp error, [log_id="
+                       << cntl.log_id()
+                       << "] from " << cntl.remote_side()
+                       << ", status = " << status
+                       << ", [ChunkRequest] "
+                       << request.subrequests(i).ShortDebugString();
+            return kCsClientReturnFail;
+        }
+    }
+
+    LOG(INFO) << "Received BatchChunkOp[log_id=" << cntl.log_id()
+              << "] from " << cntl.remote_side()
+              << " to " << cntl.local_side()
+              << ", appliedIndex = " << response.appliedindex();
+    return kMdsSuccess;
+}
+
 int ChunkServerClient::GetLeader(ChunkServerIdType csId,
     LogicalPoolID logicalPoolId,
     CopysetID copysetId,
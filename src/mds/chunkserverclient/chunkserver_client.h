@@ -28,6 +28,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "src/mds/common/mds_define.h"
 #include "src/mds/topology/topology.h"
@@ -94,6 +95,44 @@ class ChunkServerClient {
         ChunkID chunkId,
         uint64_t sn);
 
+    /**
+     * @brief batch version of DeleteChunkSnapshotOrCorrectSn, the chunks
+     *        are handled in one request and one raft log entry
+     *
+     * @param leaderId
+     * @param logicalPoolId
+     * @param copysetId
+     * @param chunkIds chunks in the copyset
+     * @param correctedSn CorrectedSn to be corrected when the snapshot chunk
+     *                    does not exist
+     *
+     * @return error code, kMdsSuccess only if all chunks succeeded
+     */
+    virtual int BatchDeleteChunkSnapshotOrCorrectSn(
+        ChunkServerIdType leaderId,
+        LogicalPoolID logicalPoolId,
+        CopysetID copysetId,
+        const std::vector<ChunkID> &chunkIds,
+        uint64_t correctedSn);
+
+    /**
+     * @brief batch version of DeleteChunk, the chunks are handled in one
+     *        request and one raft log entry
+     *
+     * @param leaderId
+     * @param logicalPoolId
+     * @param copysetId
+     * @param chunkIds chunks in the copyset
+     * @param sn file version number
+     *
+     * @return error code, kMdsSuccess only if all chunks succeeded
+     */
+    virtual int BatchDeleteChunk(ChunkServerIdType leaderId,
+        LogicalPoolID logicalPoolId,
+        CopysetID copysetId,
+        const std::vector<ChunkID> &chunkIds,
+        uint64_t sn);
+
     /**
      * @brief get the leader
      * @detail
@@ -126,6 +165,18 @@ class ChunkServerClient {
     int GetOrInitChannel(ChunkServerIdType csId,
                          ChannelPtr* channelPtr);
 
+    /**
+     * @brief send a batch request to the leader and check the result of
+     *        every chunk
+     *
+     * @param leaderId
+     * @param request batch request whose opType is CHUNK_OP_BATCH
+     *
+     * @return error code
+     */
+    int SendBatchChunkOp(ChunkServerIdType leaderId,
+                         const ::curve::chunkserver::ChunkRequest &request);
+
     std::shared_ptr<Topology> topology_;
     uint32_t rpcTimeoutMs_;
     uint32_t rpcRetryTimes_;
@@ -38,64 +38,50 @@ int CopysetClient::DeleteChunkSnapshotOrCorrectSn(LogicalPoolID logicalPoolId,
     CopysetID copysetId,
     ChunkID chunkId,
     uint64_t correctedSn) {
-    int ret = kMdsFail;
-    CopySetInfo copyset;
-    if (true != topo_->GetCopySet(
-        CopySetKey(logicalPoolId, copysetId),
-        &copyset)) {
-        LOG(ERROR) << "GetCopySet fail.";
-        return kMdsFail;
-    }
-
-    ChunkServerIdType leaderId =
-        copyset.GetLeader();
-
-    if (leaderId != UNINTIALIZE_ID) {
-        ret = chunkserverClient_->DeleteChunkSnapshotOrCorrectSn(
-            leaderId, logicalPoolId, copysetId, chunkId, correctedSn);
-        if (kMdsSuccess == ret) {
-            return ret;
-        }
-    }
-
-    uint32_t retry = 0;
-    while ((retry < updateLeaderRetryTimes_) &&
-           ((UNINTIALIZE_ID == leaderId) ||
-            (kCsClientCSOffline == ret) ||
-            (kRpcFail == ret) ||
-            (kCsClientNotLeader == ret))) {
-        std::this_thread::sleep_for(
-                std::chrono::milliseconds(updateLeaderRetryIntervalMs_));
-        ret = UpdateLeader(&copyset);
-        if (ret < 0) {
-            LOG(ERROR) << "UpdateLeader fail."
-                       << " logicalPoolId = " << logicalPoolId
-                       << ", copysetId = " << copysetId;
-            break;
-        }
-
-        leaderId = copyset.GetLeader();
-        LOG(INFO) << "UpdateLeader success, new leaderId = " << leaderId;
-
-        if (leaderId != UNINTIALIZE_ID) {
-            ret = chunkserverClient_->DeleteChunkSnapshotOrCorrectSn(
+    return SendToLeader(logicalPoolId, copysetId,
+        [&](ChunkServerIdType leaderId) {
+            return chunkserverClient_->DeleteChunkSnapshotOrCorrectSn(
                 leaderId, logicalPoolId, copysetId, chunkId, correctedSn);
-            if (kMdsSuccess == ret) {
-                break;
-            }
-        } else {
-            LOG(ERROR) << "UpdateLeader success, but leaderId is uninit.";
-            return kMdsFail;
-        }
-        retry++;
-    }
-    return ret;
+        });
 }
 
 int CopysetClient::DeleteChunk(LogicalPoolID logicalPoolId,
                                     CopysetID copysetId,
                                     ChunkID chunkId,
                                     uint64_t sn) {
+    return SendToLeader(logicalPoolId, copysetId,
+        [&](ChunkServerIdType leaderId) {
+            return chunkserverClient_->DeleteChunk(
+                leaderId, logicalPoolId, copysetId, chunkId, sn);
+        });
+}
+
+int CopysetClient::BatchDeleteChunkSnapshotOrCorrectSn(
+    LogicalPoolID logicalPoolId,
+    CopysetID copysetId,
+    const std::vector<ChunkID> &chunkIds,
+    uint64_t correctedSn) {
+    return SendToLeader(logicalPoolId, copysetId,
+        [&](ChunkServerIdType leaderId) {
+            return chunkserverClient_->BatchDeleteChunkSnapshotOrCorrectSn(
+                leaderId, logicalPoolId, copysetId, chunkIds, correctedSn);
+        });
+}
+
+int CopysetClient::BatchDeleteChunk(LogicalPoolID logicalPoolId,
+    CopysetID copysetId,
+    const std::vector<ChunkID> &chunkIds,
+    uint64_t sn) {
+    return SendToLeader(logicalPoolId, copysetId,
+        [&](ChunkServerIdType leaderId) {
+            return chunkserverClient_->BatchDeleteChunk(
+                leaderId, logicalPoolId, copysetId, chunkIds, sn);
+        });
+}
+
+int CopysetClient::SendToLeader(LogicalPoolID logicalPoolId,
+    CopysetID copysetId,
+    const LeaderOperation &op) {
     int ret = kMdsFail;
     CopySetInfo copyset;
     if (true != topo_->GetCopySet(
@@ -109,15 +95,13 @@ int CopysetClient::DeleteChunk(LogicalPoolID logicalPoolId,
         copyset.GetLeader();
 
     if (leaderId != UNINTIALIZE_ID) {
-        ret = chunkserverClient_->DeleteChunk(
-            leaderId, logicalPoolId, copysetId, chunkId, sn);
+        ret = op(leaderId);
         if (kMdsSuccess == ret) {
             return ret;
         }
     }
 
-    // delete Chunk needs to retry when kCsClientCSOffline
-    // or kRpcFail or kCsClientNotLeader returned
+    // retry when kCsClientCSOffline or kRpcFail or kCsClientNotLeader returned
     uint32_t retry = 0;
     while ((retry < updateLeaderRetryTimes_) &&
            ((UNINTIALIZE_ID == leaderId) ||
@@ -138,8 +122,7 @@ int CopysetClient::DeleteChunk(LogicalPoolID logicalPoolId,
         LOG(INFO) << "UpdateLeader success, new leaderId = " << leaderId;
 
         if (leaderId != UNINTIALIZE_ID) {
-            ret = chunkserverClient_->DeleteChunk(
-                leaderId, logicalPoolId, copysetId, chunkId, sn);
+            ret = op(leaderId);
             if (kMdsSuccess == ret) {
                 break;
             }
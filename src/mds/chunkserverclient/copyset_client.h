@@ -23,7 +23,9 @@
 #ifndef SRC_MDS_CHUNKSERVERCLIENT_COPYSET_CLIENT_H_
 #define SRC_MDS_CHUNKSERVERCLIENT_COPYSET_CLIENT_H_
 
+#include <functional>
 #include <memory>
+#include <vector>
 #include "src/mds/common/mds_define.h"
 #include "src/mds/topology/topology.h"
 
@@ -92,6 +94,39 @@ class CopysetClient {
         ChunkID chunkId,
         uint64_t sn);
 
+    /**
+     * @brief batch version of DeleteChunkSnapshotOrCorrectSn, the chunks
+     *        must belong to the copyset
+     *
+     * @param logicPoolId
+     * @param copysetId
+     * @param chunkIds
+     * @param correctedSn the version number that needs to be corrected when
+     *                    there is no snapshot file for the chunk
+     *
+     * @return error code
+     */
+    int BatchDeleteChunkSnapshotOrCorrectSn(LogicalPoolID logicalPoolId,
+        CopysetID copysetId,
+        const std::vector<ChunkID> &chunkIds,
+        uint64_t correctedSn);
+
+    /**
+     * @brief batch version of DeleteChunk, the chunks must belong to
+     *        the copyset
+     *
+     * @param logicPoolId
+     * @param copysetId
+     * @param chunkIds
+     * @param sn file version number
+     *
+     * @return error code
+     */
+    int BatchDeleteChunk(LogicalPoolID logicalPoolId,
+        CopysetID copysetId,
+        const std::vector<ChunkID> &chunkIds,
+        uint64_t sn);
+
     /**
      * @brief update leader
      *
@@ -102,6 +137,18 @@ class CopysetClient {
     int UpdateLeader(CopySetInfo *copyset);
 
  private:
+    using LeaderOperation = std::function<int(ChunkServerIdType leaderId)>;
+
+    /**
+     * @brief send the operation to the leader of the copyset, retry with
+     *        the updated leader if the leader is unknown or changed
+     *
+     * @return error code
+     */
+    int SendToLeader(LogicalPoolID logicalPoolId,
+        CopysetID copysetId,
+        const LeaderOperation &op);
+
     std::shared_ptr<Topology> topo_;
     std::shared_ptr<ChunkServerClient> chunkserverClient_;
 
@@ -36,6 +36,11 @@ namespace curve {
 namespace mds {
 namespace heartbeat {
 void ChunkserverHealthyChecker::CheckHeartBeatInterval() {
+    CheckHeartBeatInterval(nullptr);
+}
+
+void ChunkserverHealthyChecker::CheckHeartBeatInterval(
+    std::map<ChunkServerIdType, OnlineState> *changed) {
     ::curve::common::WriteLockGuard lk(hbinfoLock_);
     auto iter = heartbeatInfos_.begin();
     while (iter != heartbeatInfos_.end()) {
@@ -47,6 +52,9 @@ void ChunkserverHealthyChecker::CheckHeartBeatInterval() {
         if (needUpdate) {
             UpdateChunkServerOnlineState(iter->first, newState);
             iter->second.state = newState;
+            if (changed != nullptr) {
+                (*changed)[iter->first] = newState;
+            }
         }
         // If a chunkserver is offline and contain no copyset, it will be set
         // to retired status
@@ -124,6 +124,15 @@ class ChunkserverHealthyChecker {
      */
     void CheckHeartBeatInterval();
 
+    /**
+     * @brief same as CheckHeartBeatInterval() above, and output the
+     *        chunkservers whose online state changed
+     *
+     * @param[out] changed chunkservers and their new online state
+     */
+    void CheckHeartBeatInterval(
+        std::map<ChunkServerIdType, OnlineState> *changed);
+
     // for test
     bool GetHeartBeatInfo(ChunkServerIdType id, HeartbeatInfo *info);
 
@@ -46,7 +46,8 @@ HeartbeatManager::HeartbeatManager(HeartbeatOption option,
     std::shared_ptr<TopologyStat> topologyStat,
     std::shared_ptr<Coordinator> coordinator)
     : topology_(topology),
-      topologyStat_(topologyStat) {
+      topologyStat_(topologyStat),
+      coordinator_(coordinator) {
     healthyChecker_ =
         std::make_shared<ChunkserverHealthyChecker>(option, topology);
 
@@ -92,7 +93,11 @@ void HeartbeatManager::Stop() {
 void HeartbeatManager::ChunkServerHealthyChecker() {
     while (sleeper_.wait_for(
         std::chrono::milliseconds(chunkserverHealthyCheckerRunInter_))) {
-        healthyChecker_->CheckHeartBeatInterval();
+        std::map<ChunkServerIdType, OnlineState> changed;
+        healthyChecker_->CheckHeartBeatInterval(&changed);
+        for (const auto &cs : changed) {
+            coordinator_->ChunkServerOnlineStateChanged(cs.first, cs.second);
+        }
     }
 }
 
@@ -119,7 +124,7 @@ void HeartbeatManager::UpdateChunkServerDiskStatus(
     }
 }
 
-void HeartbeatManager::UpdateChunkServerStatistics(
+bool HeartbeatManager::UpdateChunkServerStatistics(
     const ChunkServerHeartbeatRequest &request) {
     ChunkServerStat stat;
     stat.leaderCount = request.leadercount();
@@ -185,7 +190,26 @@ void HeartbeatManager::UpdateChunkServerStatistics(
         LOG(WARNING) << "hearbeat manager receive request "
                      << "do not have ChunkServerStatisticInfo";
     }
+
+    bool hasLastStat = true;
+    if (request.isdelta()) {
+        ChunkServerStat lastStat;
+        hasLastStat = topologyStat_->GetChunkServerStat(
+            request.chunkserverid(), &lastStat);
+        std::set<CopySetKey> reported;
+        for (const auto &cstat : stat.copysetStats) {
+            reported.emplace(cstat.logicalPoolId, cstat.copysetId);
+        }
+        for (const auto &cstat : lastStat.copysetStats) {
+            if (reported.count(
+                    CopySetKey(cstat.logicalPoolId, cstat.copysetId)) == 0) {
+                stat.copysetStats.push_back(cstat);
+                stat.copysetStats.back().carried = true;
+            }
+        }
+    }
     topologyStat_->UpdateChunkServerStat(request.chunkserverid(), stat);
+    return hasLastStat;
 }
 
 void HeartbeatManager::ChunkServerHeartbeat(
@@ -212,16 +236,23 @@ void HeartbeatManager::ChunkServerHeartbeat(
 
     UpdateChunkServerDiskStatus(request);
 
-    UpdateChunkServerStatistics(request);
+    if (!UpdateChunkServerStatistics(request)) {
+        LOG(INFO) << "heartbeatManager receive delta heartbeat from "
+                  << "chunkserver " << request.chunkserverid()
+                  << ", but has no full report of it";
+        response->set_needfullreport(true);
+    }
 
     UpdateChunkServerVersion(request);
 
     // no copyset info in the request
-    if (request.copysetinfos_size() == 0) {
+    if (!request.isdelta() && request.copysetinfos_size() == 0) {
         response->set_statuscode(HeartbeatStatusCode::hbRequestNoCopyset);
     }
     // dealing with copysets included in the heartbeat request
+    std::set<CopySetKey> reported;
     for (auto &value : request.copysetinfos()) {
+        reported.emplace(value.logicalpoolid(), value.copysetid());
         // discard copysets of invalid logical pool
         ::curve::mds::topology::LogicalPool lPool;
         if (topology_->GetLogicalPool(value.logicalpoolid(), &lPool)) {
@@ -255,7 +286,42 @@ void HeartbeatManager::ChunkServerHeartbeat(
         // if a copyset is the leader, update (e.g. epoch) topology according
         // to its info
         if (request.chunkserverid() == reportCopySetInfo.GetLeader()) {
-            topoUpdater_->UpdateTopo(reportCopySetInfo);
+            if (topoUpdater_->UpdateTopo(reportCopySetInfo)) {
+                coordinator_->CopySetTopoChanged(
+                    reportCopySetInfo.GetCopySetKey());
+            }
+        }
+    }
+
+    if (request.isdelta()) {
+        DispatchUnreportedOperators(
+            request.chunkserverid(), reported, response);
+    }
+}
+
+void HeartbeatManager::DispatchUnreportedOperators(ChunkServerIdType csId,
+    const std::set<CopySetKey> &reported,
+    ChunkServerHeartbeatResponse *response) {
+    for (const auto &key : coordinator_->GetOperatorCopySets()) {
+        if (reported.count(key) != 0) {
+            continue;
+        }
+
+        ::curve::mds::topology::CopySetInfo recordCopySetInfo;
+        if (!topology_->GetCopySet(key, &recordCopySetInfo) ||
+            recordCopySetInfo.GetLeader() != csId) {
+            continue;
+        }
+
+        // the copyset is not reported because it doesn't change since the
+        // last report of its leader, which has been updated to topology.
+        // no config change is in progress on it, so there is no candidate
+        recordCopySetInfo.ClearCandidate();
+        CopySetConf conf;
+        if (copysetConfGenerator_->GenCopysetConf(
+                csId, recordCopySetInfo, ConfigChangeInfo(), &conf)) {
+            CopySetConf *res = response->add_needupdatecopysets();
+            *res = conf;
         }
     }
 }
@@ -28,6 +28,7 @@
 #include <atomic>
 #include <string>
 #include <memory>
+#include <set>
 
 #include "src/mds/topology/topology.h"
 #include "src/mds/common/mds_define.h"
@@ -43,6 +44,7 @@
 using ::curve::mds::topology::CopySetInfo;
 using ::curve::mds::topology::PoolIdType;
 using ::curve::mds::topology::CopySetIdType;
+using ::curve::mds::topology::CopySetKey;
 using ::curve::mds::topology::Topology;
 using ::curve::mds::topology::TopologyStat;
 using ::curve::mds::schedule::Coordinator;
@@ -120,11 +122,15 @@ class HeartbeatManager {
         const ChunkServerHeartbeatRequest &request);
 
     /**
-     * @brief Update statistical data of chunkserver
+     * @brief Update statistical data of chunkserver. For a delta heartbeat
+     *        the copysets not reported keep the stats of last heartbeat
      *
      * @param request Heartbeat request
+     *
+     * @return false if it's a delta heartbeat but there's no stats of the
+     *         chunkserver, e.g. mds just restarted
      */
-    void UpdateChunkServerStatistics(
+    bool UpdateChunkServerStatistics(
         const ChunkServerHeartbeatRequest &request);
 
     /**
@@ -134,6 +140,19 @@ class HeartbeatManager {
      */
     void UpdateChunkServerVersion(const ChunkServerHeartbeatRequest &request);
 
+    /**
+     * @brief A delta heartbeat only reports the changed copysets, dispatch
+     *        the pending operators of the unchanged copysets led by the
+     *        chunkserver according to the records in topology
+     *
+     * @param[in] csId Chunkserver which sent the heartbeat
+     * @param[in] reported Copysets reported in the heartbeat
+     * @param[out] response Response of heartbeat request
+     */
+    void DispatchUnreportedOperators(ChunkServerIdType csId,
+        const std::set<CopySetKey> &reported,
+        ChunkServerHeartbeatResponse *response);
+
     /**
      * @brief Background thread for heartbeat timeout inspection
      */
@@ -26,7 +26,7 @@
 namespace curve {
 namespace mds {
 namespace heartbeat {
-void TopoUpdater::UpdateTopo(const CopySetInfo &reportCopySetInfo) {
+bool TopoUpdater::UpdateTopo(const CopySetInfo &reportCopySetInfo) {
     CopySetInfo recordCopySetInfo;
 
     if (!topo_->GetCopySet(
@@ -36,7 +36,7 @@ void TopoUpdater::UpdateTopo(const CopySetInfo &reportCopySetInfo) {
             << reportCopySetInfo.GetLogicalPoolId()
             << "," << reportCopySetInfo.GetId()
             << ") information, but can not get info from topology";
-        return;
+        return false;
     }
     // here we compare epoch number reported by heartbeat and stored in mds
     // record, and there're three possible cases:
@@ -94,7 +94,7 @@ void TopoUpdater::UpdateTopo(const CopySetInfo &reportCopySetInfo) {
                 << recordCopySetInfo.GetCopySetMembersStr()
                 << ", but epoch is same: "
                 << recordCopySetInfo.GetEpoch();
-            return;
+            return false;
         }
 
         // no configuration changes in heartbeat report (no candidate)
@@ -163,7 +163,7 @@ void TopoUpdater::UpdateTopo(const CopySetInfo &reportCopySetInfo) {
         }
 
 
-        return;
+        return false;
     }
 
     // update changes to database and RAM
@@ -179,9 +179,14 @@ void TopoUpdater::UpdateTopo(const CopySetInfo &reportCopySetInfo) {
                        << reportCopySetInfo.GetLogicalPoolId()
                        << "," << reportCopySetInfo.GetId()
                        << ") got error code: " << updateCode;
-            return;
+            return false;
         }
+
+        // the epoch increases after the members change
+        return reportCopySetInfo.GetEpoch() > recordCopySetInfo.GetEpoch() ||
+            reportCopySetInfo.GetLeader() != recordCopySetInfo.GetLeader();
     }
+    return false;
 }
 }  // namespace heartbeat
 }  // namespace mds
@@ -43,8 +43,9 @@ class TopoUpdater {
     *                   for updating copyset epoch, copy relationship and 
     *                   statistical data according to reportCopySetInfo 
     * @param[in] reportCopySetInfo copyset info reported by chunkserver
+    * @return true if the leader or the members of the copyset are updated
     */
-    void UpdateTopo(const CopySetInfo &reportCopySetInfo);
+    bool UpdateTopo(const CopySetInfo &reportCopySetInfo);
 
  private:
     std::shared_ptr<Topology> topo_;
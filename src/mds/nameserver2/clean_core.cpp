@@ -22,8 +22,54 @@
 
 #include "src/mds/nameserver2/clean_core.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include "src/common/concurrent/count_down_event.h"
+
+using ::curve::common::CountDownEvent;
+using ::curve::common::ReadWriteThrottleParams;
+
 namespace curve {
 namespace mds {
+CleanCore::CleanCore(std::shared_ptr<NameServerStorage> storage,
+                     std::shared_ptr<CopysetClient> copysetClient,
+                     std::shared_ptr<AllocStatistic> allocStatistic,
+                     const CleanCoreOption &option)
+    : storage_(storage),
+      copysetClient_(copysetClient),
+      allocStatistic_(allocStatistic),
+      option_(option) {
+    ReadWriteThrottleParams params;
+    params.iopsTotal = ::curve::common::ThrottleParams(
+        option_.deleteChunkLimitPerSec, 0, 0);
+    deleteThrottle_.UpdateThrottleParams(params);
+}
+
+bool CleanCore::Start() {
+    if (option_.deleteChunkConcurrency <= 1 || deleteWorkers_ != nullptr) {
+        return true;
+    }
+
+    deleteWorkers_.reset(new TaskThreadPool<>());
+    if (deleteWorkers_->Start(option_.deleteChunkConcurrency) != 0) {
+        LOG(ERROR) << "start delete chunk workers fail, concurrency = "
+                   << option_.deleteChunkConcurrency;
+        deleteWorkers_.reset();
+        return false;
+    }
+    return true;
+}
+
+void CleanCore::Stop() {
+    if (deleteWorkers_ != nullptr) {
+        deleteWorkers_->Stop();
+        deleteWorkers_.reset();
+    }
+}
+
 StatusCode CleanCore::CleanSnapShotFile(const FileInfo & fileInfo,
                                         TaskProgress* progress) {
     if (fileInfo.segmentsize() == 0) {
@@ -35,9 +81,8 @@ StatusCode CleanCore::CleanSnapShotFile(const FileInfo & fileInfo,
     for (uint32_t i = 0; i < segmentNum; i++) {
         // load  segment
         PageFileSegment segment;
-        StoreStatus storeRet = storage_->GetSegment(fileInfo.parentid(),
-                                                    i * segmentSize,
-                                                    &segment);
+        StoreStatus storeRet = storage_->GetSegmentWithoutFillCache(
+            fileInfo.parentid(), i * segmentSize, &segment);
         if (storeRet == StoreStatus::KeyNotExist) {
             continue;
         } else if (storeRet !=  StoreStatus::OK) {
@@ -51,28 +96,30 @@ StatusCode CleanCore::CleanSnapShotFile(const FileInfo & fileInfo,
         }
 
         // delete chunks in chunkserver
-        LogicalPoolID logicalPoolID = segment.logicalpoolid();
-        uint32_t chunkNum = segment.chunks_size();
-        for (uint32_t j = 0; j != chunkNum; j++) {
-            // 删除快照时如果chunk不存在快照，则需要修改chunk的correctedSn
-            // 防止删除快照后，后续的写触发chunk的快照
-            // correctSn为创建快照后文件的版本号，也就是快照版本号+1
-            SeqNum correctSn = fileInfo.seqnum() + 1;
-            int ret = copysetClient_->DeleteChunkSnapshotOrCorrectSn(
-                logicalPoolID,
-                segment.chunks()[j].copysetid(),
-                segment.chunks()[j].chunkid(),
-                correctSn);
-            if (ret != 0) {
-                LOG(ERROR) << "CleanSnapShotFile Error: "
-                    << "DeleteChunkSnapshotOrCorrectSn Error"
-                    << ", ret = " << ret
-                    << ", inodeid = " << fileInfo.id()
-                    << ", filename = " << fileInfo.filename()
-                    << ", correctSn = " << correctSn;
-                progress->SetStatus(TaskStatus::FAILED);
-                return StatusCode::kSnapshotFileDeleteError;
-            }
+        // 删除快照时如果chunk不存在快照，则需要修改chunk的correctedSn
+        // 防止删除快照后，后续的写触发chunk的快照
+        // correctSn为创建快照后文件的版本号，也就是快照版本号+1
+        SeqNum correctSn = fileInfo.seqnum() + 1;
+        int ret = ForEachChunkInSegment(segment,
+            [this, correctSn](LogicalPoolID logicalPoolId,
+                              CopysetID copysetId,
+                              const std::vector<ChunkID>& chunkIds) {
+                if (chunkIds.size() == 1) {
+                    return copysetClient_->DeleteChunkSnapshotOrCorrectSn(
+                        logicalPoolId, copysetId, chunkIds[0], correctSn);
+                }
+                return copysetClient_->BatchDeleteChunkSnapshotOrCorrectSn(
+                    logicalPoolId, copysetId, chunkIds, correctSn);
+            });
+        if (ret != 0) {
+            LOG(ERROR) << "CleanSnapShotFile Error: "
+                << "DeleteChunkSnapshotOrCorrectSn Error"
+                << ", ret = " << ret
+                << ", inodeid = " << fileInfo.id()
+                << ", filename = " << fileInfo.filename()
+                << ", correctSn = " << correctSn;
+            progress->SetStatus(TaskStatus::FAILED);
+            return StatusCode::kSnapshotFileDeleteError;
         }
         progress->SetProgress(100 * (i+1) / segmentNum);
     }
@@ -107,8 +154,8 @@ StatusCode CleanCore::CleanFile(const FileInfo & commonFile,
     for (int i = 0; i != segmentNum; i++) {
         // load  segment
         PageFileSegment segment;
-        StoreStatus storeRet = storage_->GetSegment(commonFile.id(),
-                                    i * segmentSize, &segment);
+        StoreStatus storeRet = storage_->GetSegmentWithoutFillCache(
+            commonFile.id(), i * segmentSize, &segment);
         if (storeRet == StoreStatus::KeyNotExist) {
             continue;
         } else if (storeRet !=  StoreStatus::OK) {
@@ -220,25 +267,80 @@ StatusCode CleanCore::CleanDiscardSegment(
 
 int CleanCore::DeleteChunksInSegment(const PageFileSegment& segment,
                                      const SeqNum& seq) {
+    return ForEachChunkInSegment(segment,
+        [this, seq](LogicalPoolID logicalPoolId, CopysetID copysetId,
+                    const std::vector<ChunkID>& chunkIds) {
+            if (chunkIds.size() == 1) {
+                return copysetClient_->DeleteChunk(
+                    logicalPoolId, copysetId, chunkIds[0], seq);
+            }
+            return copysetClient_->BatchDeleteChunk(
+                logicalPoolId, copysetId, chunkIds, seq);
+        });
+}
+
+int CleanCore::ForEachChunkInSegment(const PageFileSegment& segment,
+                                     const ChunkOperation& op) {
     const LogicalPoolID logicalPoolId = segment.logicalpoolid();
+
+    // chunks in the same copyset are handled by the same leader, so they are
+    // sent batch by batch, while different copysets are handled concurrently
+    std::map<CopysetID, std::vector<ChunkID>> copysetChunks;
     for (int i = 0; i < segment.chunks_size(); ++i) {
-        int ret = copysetClient_->DeleteChunk(
-            logicalPoolId,
-            segment.chunks()[i].copysetid(),
-            segment.chunks()[i].chunkid(),
-            seq);
+        copysetChunks[segment.chunks(i).copysetid()].push_back(
+            segment.chunks(i).chunkid());
+    }
 
-        if (ret != 0) {
-            LOG(ERROR) << "DeleteChunk failed, ret = " << ret
-                       << ", logicalpoolid = " << logicalPoolId
-                       << ", copysetid = " << segment.chunks()[i].copysetid()
-                       << ", chunkid = " << segment.chunks()[i].chunkid()
-                       << ", seq = " << seq;
-            return ret;
+    const size_t batchSize = std::max(option_.deleteChunkBatchSize, 1u);
+    std::atomic<int> result(0);
+    auto handleCopyset = [&](CopysetID copysetId,
+                             const std::vector<ChunkID>& chunkIds) {
+        for (size_t begin = 0; begin < chunkIds.size(); begin += batchSize) {
+            // stop as soon as any chunk failed, the task will be retried
+            if (result.load() != 0) {
+                return;
+            }
+
+            size_t end = std::min(begin + batchSize, chunkIds.size());
+            std::vector<ChunkID> batch(chunkIds.begin() + begin,
+                                       chunkIds.begin() + end);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                deleteThrottle_.Add(false, 0);
+            }
+            int ret = op(logicalPoolId, copysetId, batch);
+            if (ret != 0) {
+                LOG(ERROR) << "operate chunk failed, ret = " << ret
+                           << ", logicalpoolid = " << logicalPoolId
+                           << ", copysetid = " << copysetId
+                           << ", chunkid = " << batch.front()
+                           << ", chunk num = " << batch.size();
+                int expected = 0;
+                result.compare_exchange_strong(expected, ret);
+                return;
+            }
         }
+    };
+
+    if (deleteWorkers_ == nullptr || copysetChunks.size() <= 1) {
+        for (auto& item : copysetChunks) {
+            handleCopyset(item.first, item.second);
+        }
+        return result.load();
+    }
+
+    CountDownEvent event(copysetChunks.size());
+    for (auto& item : copysetChunks) {
+        const CopysetID copysetId = item.first;
+        const std::vector<ChunkID>* chunkIds = &item.second;
+        deleteWorkers_->Enqueue([&handleCopyset, &event, copysetId,
+                                 chunkIds]() {
+            handleCopyset(copysetId, *chunkIds);
+            event.Signal();
+        });
     }
+    event.Wait();
 
-    return 0;
+    return result.load();
 }
 
 }  // namespace mds
@@ -23,8 +23,12 @@
 #ifndef SRC_MDS_NAMESERVER2_CLEAN_CORE_H_
 #define SRC_MDS_NAMESERVER2_CLEAN_CORE_H_
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
+#include "src/common/concurrent/task_thread_pool.h"
+#include "src/common/throttle.h"
 #include "src/mds/nameserver2/namespace_storage.h"
 #include "src/mds/common/mds_define.h"
 #include "src/mds/nameserver2/task_progress.h"
@@ -34,18 +38,40 @@
 
 using ::curve::mds::chunkserverclient::CopysetClient;
 using ::curve::mds::topology::Topology;
+using ::curve::common::TaskThreadPool;
+using ::curve::common::Throttle;
 
 namespace curve {
 namespace mds {
 
+struct CleanCoreOption {
+    // 并发删除chunk的线程数, 一个segment中的chunk按copyset分组后并发删除,
+    // 所有清理任务共享这些线程, 1表示串行删除
+    uint32_t deleteChunkConcurrency = 1;
+    // 删除chunk的速率上限(个/s), 所有清理任务共享, 0表示不限制
+    uint64_t deleteChunkLimitPerSec = 0;
+    // 同一copyset的chunk每次批量删除的个数, 作为一条raft日志提交,
+    // 1表示逐个删除, 大于1需要chunkserver支持BatchChunkOp
+    uint32_t deleteChunkBatchSize = 1;
+};
+
 class CleanCore {
  public:
     CleanCore(std::shared_ptr<NameServerStorage> storage,
         std::shared_ptr<CopysetClient> copysetClient,
-        std::shared_ptr<AllocStatistic> allocStatistic)
-        : storage_(storage),
-          copysetClient_(copysetClient),
-          allocStatistic_(allocStatistic) {}
+        std::shared_ptr<AllocStatistic> allocStatistic,
+        const CleanCoreOption &option = CleanCoreOption());
+
+    /**
+     * @brief 启动并发删除chunk的线程池
+     * @return 成功返回true, 否则返回false
+     */
+    bool Start();
+
+    /**
+     * @brief 停止并发删除chunk的线程池, 需要在所有清理任务结束后调用
+     */
+    void Stop();
 
     /**
      * @brief 删除快照文件，更新task状态
@@ -74,12 +100,30 @@ class CleanCore {
                                    TaskProgress* progress);
 
  private:
+    // 对同一copyset的一批chunk执行操作
+    using ChunkOperation = std::function<int(LogicalPoolID, CopysetID,
+                                             const std::vector<ChunkID>&)>;
+
     int DeleteChunksInSegment(const PageFileSegment& segment,
                               const SeqNum& seq);
 
+    /**
+     * @brief 对segment中的所有chunk执行op, chunk按copyset分组,
+     *        同一copyset的chunk按deleteChunkBatchSize分批执行,
+     *        不同copyset的chunk并发执行, 受删除速率上限的限制
+     * @return 全部成功返回0, 否则返回其中一个失败的错误码
+     */
+    int ForEachChunkInSegment(const PageFileSegment& segment,
+                              const ChunkOperation& op);
+
     std::shared_ptr<NameServerStorage> storage_;
     std::shared_ptr<CopysetClient> copysetClient_;
     std::shared_ptr<AllocStatistic> allocStatistic_;
+
+    CleanCoreOption option_;
+    // 并发删除chunk的线程池, 未启动时串行删除
+    std::unique_ptr<TaskThreadPool<>> deleteWorkers_;
+    Throttle deleteThrottle_;
 };
 
 }  // namespace mds
@@ -34,11 +34,17 @@ CleanManager::CleanManager(std::shared_ptr<CleanCore> core,
                     : storage_(storage), cleanCore_(core), taskMgr_(taskMgr) {}
 
 bool CleanManager::Start(void) {
+    if (!cleanCore_->Start()) {
+        return false;
+    }
     return taskMgr_->Start();
 }
 
 bool CleanManager::Stop(void) {
-    return taskMgr_->Stop();
+    // the running tasks use the workers of clean core
+    bool ret = taskMgr_->Stop();
+    cleanCore_->Stop();
+    return ret;
 }
 
 void CleanManager::InitDLockOptions(std::shared_ptr<DLockOpts> dlockOpts) {
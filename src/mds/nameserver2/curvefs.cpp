@@ -23,11 +23,13 @@
 #include "src/mds/nameserver2/curvefs.h"
 #include <glog/logging.h>
 #include <google/protobuf/util/message_differencer.h>
+#include <algorithm>
 #include <memory>
 #include <chrono>    //NOLINT
 #include <set>
 #include <utility>
 #include <map>
+#include <vector>
 #include "src/common/string_util.h"
 #include "src/common/encode.h"
 #include "src/common/timeutility.h"
@@ -142,6 +144,7 @@ bool CurveFS::Init(std::shared_ptr<NameServerStorage> storage,
     defaultSegmentSize_ = curveFSOptions.defaultSegmentSize;
     minFileLength_ = curveFSOptions.minFileLength;
     maxFileLength_ = curveFSOptions.maxFileLength;
+    maxPreallocateSegmentNum_ = curveFSOptions.maxPreallocateSegmentNum;
     topology_ = topology;
     snapshotCloneClient_ = snapshotCloneClient;
     poolsetRules_ = curveFSOptions.poolsetRules;
@@ -1257,7 +1260,8 @@ StatusCode CurveFS::ChangeOwner(const std::string &filename,
 
 StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
         offset_t offset, bool allocateIfNoExist,
-        PageFileSegment *segment) {
+        PageFileSegment *segment, uint32_t preallocateSegmentNum,
+        std::vector<PageFileSegment> *preallocatedSegments) {
     assert(segment != nullptr);
 
     FileInfo  fileInfo;
@@ -1292,32 +1296,77 @@ StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
             return  StatusCode::kSegmentNotAllocated;
         } else {
             // TODO(hzsunjianliang): check the user and define the logical pool
-            auto ifok = chunkSegAllocator_->AllocateChunkSegment(
+            auto allocate = [&](offset_t off, PageFileSegment *seg) {
+                return chunkSegAllocator_->AllocateChunkSegment(
                     fileInfo.filetype(), fileInfo.segmentsize(),
                     fileInfo.chunksize(),
                     fileInfo.has_poolset() ? fileInfo.poolset()
                                            : kDefaultPoolsetName,
-                    offset, segment);
-            if (ifok == false) {
+                    off, seg);
+            };
+
+            std::vector<PageFileSegment> segments(1);
+            if (allocate(offset, &segments[0]) == false) {
                 LOG(ERROR) << "AllocateChunkSegment error";
                 return StatusCode::kSegmentAllocateError;
             }
+
+            // allocate the following segments for sequential writes, so
+            // they are persisted in one transaction with this one
+            uint32_t preallocateNum =
+                std::min(preallocateSegmentNum, maxPreallocateSegmentNum_);
+            for (uint32_t i = 1; i <= preallocateNum; ++i) {
+                offset_t off = offset + i * fileInfo.segmentsize();
+                if (off + fileInfo.segmentsize() > fileInfo.length()) {
+                    break;
+                }
+                PageFileSegment existed;
+                if (storage_->GetSegment(fileInfo.id(), off, &existed)
+                    != StoreStatus::KeyNotExist) {
+                    break;
+                }
+                segments.emplace_back();
+                if (allocate(off, &segments.back()) == false) {
+                    segments.pop_back();
+                    break;
+                }
+            }
+
             int64_t revision;
-            if (storage_->PutSegment(fileInfo.id(), offset, segment, &revision)
-                != StoreStatus::OK) {
+            StoreStatus putRet;
+            if (segments.size() == 1) {
+                putRet = storage_->PutSegment(fileInfo.id(), offset,
+                                              &segments[0], &revision);
+            } else {
+                putRet = storage_->PutSegments(fileInfo.id(), segments,
+                                               &revision);
+            }
+            if (putRet != StoreStatus::OK) {
                 LOG(ERROR) << "PutSegment fail, fileInfo.id() = "
                            << fileInfo.id()
                            << ", offset = "
-                           << offset;
+                           << offset
+                           << ", segment num = " << segments.size();
                 return StatusCode::kStorageError;
             }
-            allocStatistic_->AllocSpace(segment->logicalpoolid(),
-                    segment->segmentsize(),
-                    revision);
+            for (const auto &seg : segments) {
+                allocStatistic_->AllocSpace(seg.logicalpoolid(),
+                        seg.segmentsize(),
+                        revision);
+            }
+
+            segment->Swap(&segments[0]);
+            if (preallocatedSegments != nullptr) {
+                for (size_t i = 1; i < segments.size(); ++i) {
+                    preallocatedSegments->emplace_back(std::move(segments[i]));
+                }
+            }
 
             LOG(INFO) << "alloc segment success, fileInfo.id() = "
                       << fileInfo.id()
-                      << ", offset = " << offset;
+                      << ", offset = " << offset
+                      << ", preallocated segment num = "
+                      << segments.size() - 1;
             return StatusCode::kOK;
         }
     }  else {
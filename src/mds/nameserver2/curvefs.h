@@ -75,6 +75,8 @@ struct CurveFSOption {
     FileRecordOptions fileRecordOptions;
     ThrottleOption throttleOption;
     std::map<std::string, std::string> poolsetRules;
+    // max number of segments allocated ahead in one GetOrAllocateSegment
+    uint32_t maxPreallocateSegmentNum = 8;
 };
 
 struct AllocatedSize {
@@ -293,12 +295,19 @@ class CurveFS {
      *  @param allocateIfNoExist: If the segment does not exist,
      *                            whether or not creating a new one
      *  @param segment: Return the queried segment information
+     *  @param preallocateSegmentNum: If the segment is allocated, also
+     *                            allocate at most this number of following
+     *                            segments which are not allocated yet, all
+     *                            of them are persisted in one transaction
+     *  @param preallocatedSegments: Return the segments allocated ahead
      *  @return StatusCode::kOK if succeeded
      */
     StatusCode GetOrAllocateSegment(
         const std::string & filename,
         offset_t offset,
-        bool allocateIfNoExist, PageFileSegment *segment);
+        bool allocateIfNoExist, PageFileSegment *segment,
+        uint32_t preallocateSegmentNum = 0,
+        std::vector<PageFileSegment> *preallocatedSegments = nullptr);
 
     /**
      * @brief deallocate file segment start at offset
@@ -835,6 +844,7 @@ class CurveFS {
     uint64_t defaultSegmentSize_;
     uint64_t minFileLength_;
     uint64_t maxFileLength_;
+    uint32_t maxPreallocateSegmentNum_;
     std::chrono::steady_clock::time_point startTime_;
 
     std::map<std::string, std::string> poolsetRules_;
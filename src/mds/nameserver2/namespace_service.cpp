@@ -467,10 +467,13 @@ void NameSpaceService::GetOrAllocateSegment(
         }
     }
 
+    std::vector<PageFileSegment> preallocatedSegments;
     retCode = kCurveFS.GetOrAllocateSegment(request->filename(),
                 request->offset(),
                 request->allocateifnotexist(),
-                response->mutable_pagefilesegment());
+                response->mutable_pagefilesegment(),
+                request->preallocatesegmentnum(),
+                &preallocatedSegments);
 
     if (retCode != StatusCode::kOK)  {
         response->set_statuscode(retCode);
@@ -496,10 +499,14 @@ void NameSpaceService::GetOrAllocateSegment(
         response->clear_pagefilesegment();
     } else {
         response->set_statuscode(StatusCode::kOK);
+        for (auto& segment : preallocatedSegments) {
+            response->add_preallocatedsegments()->Swap(&segment);
+        }
         LOG(INFO) << "logid = " << cntl->log_id()
                   << ", GetOrAllocateSegment ok, filename = "
                   << request->filename() << ", offset = " << request->offset()
                   << ", allocateTag = " << request->allocateifnotexist()
+                  << ", preallocated = " << preallocatedSegments.size()
                   << ", cost " << expiredTime.ExpiredMs() << " ms";
     }
     return;
@@ -62,7 +62,7 @@ StoreStatus NameServerStorageImp::PutFile(const FileInfo &fileInfo) {
                    << "] err: " << errCode;
     } else {
         // update to cache
-        cache_->Put(storeKey, encodeFileInfo);
+        cache_->Put(storeKey, std::make_shared<FileInfo>(fileInfo));
     }
 
     return getErrorCode(errCode);
@@ -78,19 +78,21 @@ StoreStatus NameServerStorageImp::GetFile(InodeID parentid,
         return StoreStatus::InternalError;
     }
 
-    int errCode = EtcdErrCode::EtcdOK;
-    std::string out;
-    if (!cache_->Get(storeKey, &out)) {
-        errCode = client_->Get(storeKey, &out);
-
-        if (errCode == EtcdErrCode::EtcdOK) {
-            cache_->Put(storeKey, out);
-        }
+    CachedObject cached;
+    if (cache_->Get(storeKey, &cached)) {
+        *fileInfo = static_cast<const FileInfo &>(*cached);
+        return StoreStatus::OK;
     }
 
+    std::string out;
+    int errCode = client_->Get(storeKey, &out);
     if (errCode == EtcdErrCode::EtcdOK) {
-        bool decodeOK = NameSpaceStorageCodec::DecodeFileInfo(out, fileInfo);
+        auto parsed = std::make_shared<FileInfo>();
+        bool decodeOK =
+            NameSpaceStorageCodec::DecodeFileInfo(out, parsed.get());
         if (decodeOK) {
+            *fileInfo = *parsed;
+            cache_->Put(storeKey, parsed);
             return StoreStatus::OK;
         } else {
             LOG(ERROR) << "decode info error. parentid: " << parentid
@@ -198,7 +200,7 @@ StoreStatus NameServerStorageImp::RenameFile(const FileInfo &oldFInfo,
                    << newFInfo.filename() << "] err: " << errCode;
     } else {
         // update to cache at last
-        cache_->Put(newStoreKey, encodeNewFileInfo);
+        cache_->Put(newStoreKey, std::make_shared<FileInfo>(newFInfo));
     }
     return getErrorCode(errCode);
 }
@@ -281,8 +283,9 @@ StoreStatus NameServerStorageImp::ReplaceFileAndRecycleOldFile(
                    << newFInfo.filename() << "] err: " << errCode;
     } else {
         // update to cache
-        cache_->Put(recycleStoreKey, encodeRecycleFInfo);
-        cache_->Put(newStoreKey, encodeNewFInfo);
+        cache_->Put(recycleStoreKey,
+                    std::make_shared<FileInfo>(recycleFInfo));
+        cache_->Put(newStoreKey, std::make_shared<FileInfo>(newFInfo));
     }
     return getErrorCode(errCode);
 }
@@ -336,7 +339,8 @@ NameServerStorageImp::MoveFileToRecycle(const FileInfo &originFileInfo,
                    << "] err: " << errCode;
     } else {
         // update to cache
-        cache_->Put(recycleFileInfoKey, encodeRecycleFInfo);
+        cache_->Put(recycleFileInfoKey,
+                    std::make_shared<FileInfo>(recycleFileInfo));
     }
     return getErrorCode(errCode);
 }
@@ -453,24 +457,88 @@ StoreStatus NameServerStorageImp::PutSegment(InodeID id, uint64_t off,
         LOG(ERROR) << "put segment of logicalPoolId:"
                    << segment->logicalpoolid() << "err:" << errCode;
     } else {
-        cache_->Put(storeKey, encodeSegment);
+        cache_->Put(storeKey, std::make_shared<PageFileSegment>(*segment));
+    }
+    return getErrorCode(errCode);
+}
+
+StoreStatus NameServerStorageImp::PutSegments(
+    InodeID id, const std::vector<PageFileSegment> &segments,
+    int64_t *revision) {
+    if (segments.size() == 1) {
+        return PutSegment(id, segments[0].startoffset(), &segments[0],
+                          revision);
+    }
+
+    std::vector<std::string> storeKeys;
+    std::vector<std::string> encodeSegments;
+    storeKeys.reserve(segments.size());
+    encodeSegments.reserve(segments.size());
+    for (const auto &segment : segments) {
+        std::string encodeSegment;
+        if (!NameSpaceStorageCodec::EncodeSegment(segment, &encodeSegment)) {
+            return StoreStatus::InternalError;
+        }
+        storeKeys.emplace_back(NameSpaceStorageCodec::EncodeSegmentStoreKey(
+            id, segment.startoffset()));
+        encodeSegments.emplace_back(std::move(encodeSegment));
+    }
+
+    std::vector<Operation> ops;
+    ops.reserve(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        ops.push_back(Operation{OpType::OpPut,
+            const_cast<char *>(storeKeys[i].c_str()),
+            const_cast<char *>(encodeSegments[i].c_str()),
+            static_cast<int>(storeKeys[i].size()),
+            static_cast<int>(encodeSegments[i].size())});
+    }
+
+    int errCode = client_->TxnNWithRevision(ops, revision);
+    if (errCode != EtcdErrCode::EtcdOK) {
+        LOG(ERROR) << "put " << segments.size() << " segments of inode " << id
+                   << " err:" << errCode;
+    } else {
+        for (size_t i = 0; i < segments.size(); ++i) {
+            cache_->Put(storeKeys[i],
+                        std::make_shared<PageFileSegment>(segments[i]));
+        }
     }
     return getErrorCode(errCode);
 }
 
 StoreStatus NameServerStorageImp::GetSegment(InodeID id, uint64_t off,
                                              PageFileSegment *segment) {
+    return GetSegmentInternal(id, off, segment, true);
+}
+
+StoreStatus NameServerStorageImp::GetSegmentWithoutFillCache(
+    InodeID id, uint64_t off, PageFileSegment *segment) {
+    return GetSegmentInternal(id, off, segment, false);
+}
+
+StoreStatus NameServerStorageImp::GetSegmentInternal(InodeID id, uint64_t off,
+                                                     PageFileSegment *segment,
+                                                     bool fillCache) {
     std::string storeKey =
         NameSpaceStorageCodec::EncodeSegmentStoreKey(id, off);
-    int errCode = EtcdErrCode::EtcdOK;
-    std::string out;
-    if (!cache_->Get(storeKey, &out)) {
-        errCode = client_->Get(storeKey, &out);
+    CachedObject cached;
+    if (cache_->Get(storeKey, &cached)) {
+        *segment = static_cast<const PageFileSegment &>(*cached);
+        return StoreStatus::OK;
     }
 
+    std::string out;
+    int errCode = client_->Get(storeKey, &out);
     if (errCode == EtcdErrCode::EtcdOK) {
-        bool decodeOK = NameSpaceStorageCodec::DecodeSegment(out, segment);
+        auto parsed = std::make_shared<PageFileSegment>();
+        bool decodeOK =
+            NameSpaceStorageCodec::DecodeSegment(out, parsed.get());
         if (decodeOK) {
+            *segment = *parsed;
+            if (fillCache) {
+                cache_->Put(storeKey, parsed);
+            }
             return StoreStatus::OK;
         } else {
             LOG(ERROR) << "decode segment inodeid: " << id << ", off: " << off
@@ -641,8 +709,9 @@ StoreStatus NameServerStorageImp::SnapShotFile(const FileInfo *originFInfo,
                    << ", fileinfo: " << originFInfo->filename() << "err";
     } else {
         // update cache at last
-        cache_->Put(originFileKey, encodeFileInfo);
-        cache_->Put(snapshotFileKey, encodeSnapshot);
+        cache_->Put(originFileKey, std::make_shared<FileInfo>(*originFInfo));
+        cache_->Put(snapshotFileKey,
+                    std::make_shared<FileInfo>(*snapshotFInfo));
     }
     return getErrorCode(errCode);
 }
@@ -37,12 +37,29 @@
 #include "src/common/lru_cache.h"
 
 namespace curve {
+namespace common {
+
+template<>
+struct CacheTraits<std::shared_ptr<const ::google::protobuf::Message>> {
+    static uint64_t CountBytes(
+        const std::shared_ptr<const ::google::protobuf::Message> &v) {
+        return v == nullptr ? 0 : v->ByteSizeLong();
+    }
+};
+
+}  // namespace common
+
 namespace mds {
 
 using ::curve::kvstorage::EtcdClientImp;
 using ::curve::kvstorage::KVStorageClient;
+
+// The cache holds parsed FileInfo and PageFileSegment which are never
+// modified once inserted, so a cache hit only copies the object out
+// instead of decoding it from the serialized value again
+using CachedObject = std::shared_ptr<const ::google::protobuf::Message>;
 using Cache =
-    ::curve::common::LRUCacheInterface<std::string, std::string>;
+    ::curve::common::LRUCacheInterface<std::string, CachedObject>;
 
 enum class StoreStatus {
     OK = 0,
@@ -196,6 +213,23 @@ class NameServerStorage {
                                     uint64_t off,
                                     PageFileSegment *segment) = 0;
 
+    /**
+     * @brief GetSegmentWithoutFillCache: Obtain specified segment
+     *        information like GetSegment, but don't put it into cache on a
+     *        miss, used by one-pass scans such as cleaning a file
+     *
+     * @param[in] id: Inode ID of the target file
+     * @param[in] off: Offset of the target segment
+     * @param[out] segment: Segment info
+     *
+     * @return StoreStatus: error code
+     */
+    virtual StoreStatus GetSegmentWithoutFillCache(InodeID id,
+                                                   uint64_t off,
+                                                   PageFileSegment *segment) {
+        return GetSegment(id, off, segment);
+    }
+
     /**
      * @brief PutSegment: Store specified segment information
      *
@@ -211,6 +245,19 @@ class NameServerStorage {
                                     const PageFileSegment * segment,
                                     int64_t *revision) = 0;
 
+    /**
+     * @brief PutSegments: Store several segments of a file in one transaction
+     *
+     * @param[in] id: Inode ID of the target file
+     * @param[in] segments: Segments info, keyed by their start offset
+     * @param[out] revision: The version number of this operation
+     *
+     * @return StoreStatus: error code
+     */
+    virtual StoreStatus PutSegments(
+        InodeID id, const std::vector<PageFileSegment> &segments,
+        int64_t *revision) = 0;
+
     /**
      * @brief DeleteSegment: Delete the specified segment metadata
      *
@@ -321,11 +368,19 @@ class NameServerStorageImp : public NameServerStorage {
                             uint64_t off,
                             PageFileSegment *segment) override;
 
+    StoreStatus GetSegmentWithoutFillCache(InodeID id,
+                                           uint64_t off,
+                                           PageFileSegment *segment) override;
+
     StoreStatus PutSegment(InodeID id,
                             uint64_t off,
                             const PageFileSegment * segment,
                             int64_t *revision) override;
 
+    StoreStatus PutSegments(InodeID id,
+                            const std::vector<PageFileSegment> &segments,
+                            int64_t *revision) override;
+
     StoreStatus DeleteSegment(
         InodeID id, uint64_t off, int64_t *revision) override;
 
@@ -348,6 +403,10 @@ class NameServerStorageImp : public NameServerStorage {
     StoreStatus ListFileInternal(const std::string& startStoreKey,
                                  const std::string& endStoreKey,
                                  std::vector<FileInfo> *files);
+    StoreStatus GetSegmentInternal(InodeID id,
+                                   uint64_t off,
+                                   PageFileSegment *segment,
+                                   bool fillCache);
     StoreStatus GetStoreKey(FileType filetype,
                             InodeID id,
                             const std::string& filename,
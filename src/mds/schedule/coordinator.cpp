@@ -93,6 +93,20 @@ void Coordinator::InitScheduler(
             std::make_shared<ScanScheduler>(conf, topo_, opController_);
         LOG(INFO) << "init scan scheduler ok!";
     }
+
+    if (conf.enableEventDrivenSchedule) {
+        // copyset and scan schedulers are not triggered by topology changes,
+        // they keep running at their intervals
+        for (auto type : {SchedulerType::RecoverSchedulerType,
+                          SchedulerType::ReplicaSchedulerType,
+                          SchedulerType::LeaderSchedulerType}) {
+            if (schedulerController_.count(type) != 0) {
+                eventQueues_[type] = std::make_shared<ScheduleEventQueue>();
+            }
+        }
+        LOG(INFO) << "enable event driven schedule, full schedule interval: "
+                  << conf.fullScheduleIntervalSec << "s";
+    }
 }
 
 void Coordinator::Run() {
@@ -104,6 +118,9 @@ void Coordinator::Run() {
 
 void Coordinator::Stop() {
     sleeper_.interrupt();
+    for (auto &v : eventQueues_) {
+        v.second->Stop();
+    }
     for (auto &v : schedulerController_) {
         if (runSchedulerThreads_.find(v.first) == runSchedulerThreads_.end()) {
             continue;
@@ -237,6 +254,13 @@ int Coordinator::QueryChunkServerRecoverStatus(
 
 void Coordinator::RunScheduler(
     const std::shared_ptr<Scheduler> &s, SchedulerType type) {
+    auto it = eventQueues_.find(type);
+    if (it != eventQueues_.end()) {
+        RunSchedulerByEvents(s, type, it->second);
+        LOG(INFO) << ScheduleName(type) << " exit.";
+        return;
+    }
+
     while (sleeper_.wait_for(std::chrono::seconds(s->GetRunningInterval()))) {
         if (ScheduleNeedRun(type)) {
             s->Schedule();
@@ -245,6 +269,115 @@ void Coordinator::RunScheduler(
     LOG(INFO) << ScheduleName(type) << " exit.";
 }
 
+void Coordinator::RunSchedulerByEvents(const std::shared_ptr<Scheduler> &s,
+    SchedulerType type, const std::shared_ptr<ScheduleEventQueue> &queue) {
+    // scan the whole cluster in the first round
+    bool first = true;
+    std::chrono::steady_clock::time_point lastFullSchedule;
+    // offline events whose copysets are not all recovered, they are handled
+    // again after the running interval
+    std::vector<ScheduleEvent> retries;
+    std::chrono::steady_clock::time_point lastRetry;
+    std::vector<ScheduleEvent> events;
+    while (queue->Wait(
+        std::chrono::seconds(s->GetRunningInterval()), &events)) {
+        if (!ScheduleNeedRun(type)) {
+            continue;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (first || now - lastFullSchedule >=
+                std::chrono::seconds(conf_.fullScheduleIntervalSec)) {
+            // the events are covered by the full schedule
+            queue->Clear();
+            retries.clear();
+            s->Schedule();
+            lastFullSchedule = now;
+            first = false;
+            continue;
+        }
+
+        if (!retries.empty() && now - lastRetry >=
+                std::chrono::seconds(s->GetRunningInterval())) {
+            events.insert(events.end(), retries.begin(), retries.end());
+            retries.clear();
+        }
+        if (events.empty()) {
+            continue;
+        }
+        s->ScheduleEvents(events);
+
+        if (type != SchedulerType::RecoverSchedulerType) {
+            continue;
+        }
+        std::set<ChunkServerIdType> retried;
+        for (const auto &event : events) {
+            if (event.type == ScheduleEventType::ChunkServerOffline &&
+                retried.insert(event.csId).second &&
+                ChunkServerNeedRecover(event.csId)) {
+                retries.push_back(event);
+            }
+        }
+        lastRetry = now;
+    }
+}
+
+bool Coordinator::ChunkServerNeedRecover(ChunkServerIdType csId) {
+    // operators may not be generated for all the copysets in one round,
+    // e.g. limited by the operator concurrency
+    ChunkServerInfo info;
+    if (!topo_->GetChunkServerInfo(csId, &info) || !info.IsOffline()) {
+        return false;
+    }
+    return !topo_->GetCopySetInfosInChunkServer(csId).empty();
+}
+
+void Coordinator::PushEvent(SchedulerType type, ScheduleEvent event,
+    ScheduleEventPriority priority) {
+    auto it = eventQueues_.find(type);
+    if (it == eventQueues_.end()) {
+        return;
+    }
+    event.priority = priority;
+    it->second->Push(event);
+}
+
+void Coordinator::ChunkServerOnlineStateChanged(
+    ChunkServerIdType csId, OnlineState state) {
+    if (eventQueues_.empty()) {
+        return;
+    }
+
+    if (state == OnlineState::OFFLINE) {
+        auto event = ScheduleEvent::ChunkServerEvent(
+            ScheduleEventType::ChunkServerOffline, csId);
+        // replicas on the chunkserver need to be recovered as soon as
+        // possible, and the leaders on it have moved to others
+        PushEvent(SchedulerType::RecoverSchedulerType, event,
+            ScheduleEventPriority::HighPriority);
+        PushEvent(SchedulerType::LeaderSchedulerType, event,
+            ScheduleEventPriority::NormalPriority);
+    } else if (state == OnlineState::ONLINE) {
+        // a restarted chunkserver has no leader
+        auto event = ScheduleEvent::ChunkServerEvent(
+            ScheduleEventType::ChunkServerOnline, csId);
+        PushEvent(SchedulerType::LeaderSchedulerType, event,
+            ScheduleEventPriority::NormalPriority);
+    }
+}
+
+void Coordinator::CopySetTopoChanged(const CopySetKey &key) {
+    if (eventQueues_.empty()) {
+        return;
+    }
+
+    auto event = ScheduleEvent::CopySetEvent(key);
+    PushEvent(SchedulerType::RecoverSchedulerType, event,
+        ScheduleEventPriority::NormalPriority);
+    PushEvent(SchedulerType::ReplicaSchedulerType, event,
+        ScheduleEventPriority::NormalPriority);
+}
+
 bool Coordinator::BuildCopySetConf(
     const CopySetConf &res, ::curve::mds::heartbeat::CopySetConf *out) {
     // build the copysetConf need to be returned in heartbeat
@@ -366,6 +499,14 @@ std::string Coordinator::ScheduleName(SchedulerType type) {
     }
 }
 
+std::vector<CopySetKey> Coordinator::GetOperatorCopySets() {
+    std::vector<CopySetKey> keys;
+    for (const Operator &op : opController_->GetOperators()) {
+        keys.emplace_back(op.copysetID);
+    }
+    return keys;
+}
+
 std::shared_ptr<OperatorController> Coordinator::GetOpController() {
     return opController_;
 }
@@ -35,6 +35,7 @@
 #include "src/mds/topology/topology_item.h"
 #include "src/mds/schedule/topoAdapter.h"
 #include "src/mds/schedule/scheduleMetrics.h"
+#include "src/mds/schedule/scheduleEventQueue.h"
 #include "src/common/interruptible_sleeper.h"
 
 
@@ -43,6 +44,7 @@ namespace mds {
 namespace schedule {
 using ::curve::mds::heartbeat::ConfigChangeType;
 using ::curve::common::InterruptibleSleeper;
+using ::curve::mds::topology::OnlineState;
 class Coordinator {
  public:
     Coordinator() = default;
@@ -84,6 +86,31 @@ class Coordinator {
      */
     virtual bool ChunkserverGoingToAdd(ChunkServerIdType csId, CopySetKey key);
 
+    /**
+     * @brief get the copysets which have pending operators
+     *
+     * @return keys of the copysets
+     */
+    virtual std::vector<CopySetKey> GetOperatorCopySets();
+
+    /**
+     * @brief notify the schedulers that the online state of a chunkserver
+     *        changed, only works if event driven scheduling is enabled
+     *
+     * @param[in] csId Chunkserver changed
+     * @param[in] state New online state
+     */
+    virtual void ChunkServerOnlineStateChanged(
+        ChunkServerIdType csId, OnlineState state);
+
+    /**
+     * @brief notify the schedulers that the leader or the members of a
+     *        copyset changed, only works if event driven scheduling is enabled
+     *
+     * @param[in] key Copyset changed
+     */
+    virtual void CopySetTopoChanged(const CopySetKey &key);
+
     /**
      * @brief Initialize the scheduler according to the configuration
      *
@@ -140,6 +167,29 @@ class Coordinator {
      */
     void RunScheduler(const std::shared_ptr<Scheduler> &s, SchedulerType type);
 
+    /**
+     * @brief run the scheduler when there're events, and scan the whole
+     *        cluster every fullScheduleIntervalSec
+     *
+     * @param[in] s Schedulers for running
+     * @param[in] type Scheduler type
+     * @param[in] queue Events of the scheduler
+     */
+    void RunSchedulerByEvents(const std::shared_ptr<Scheduler> &s,
+        SchedulerType type, const std::shared_ptr<ScheduleEventQueue> &queue);
+
+    /**
+     * @brief whether the chunkserver is still offline and has copysets
+     *        not recovered yet
+     */
+    bool ChunkServerNeedRecover(ChunkServerIdType csId);
+
+    /**
+     * @brief push the event to the queue of specified type of scheduler
+     */
+    void PushEvent(SchedulerType type, ScheduleEvent event,
+        ScheduleEventPriority priority);
+
     /**
      * @brief BuildCopySetConf Build copyset configuration for chunkserver
      *
@@ -179,6 +229,9 @@ class Coordinator {
     std::map<SchedulerType, std::shared_ptr<Scheduler>> schedulerController_;
     std::map<SchedulerType, common::Thread> runSchedulerThreads_;
     std::shared_ptr<OperatorController> opController_;
+    // pending events of every scheduler, empty if event driven scheduling is
+    // disabled. it's not modified after InitScheduler
+    std::map<SchedulerType, std::shared_ptr<ScheduleEventQueue>> eventQueues_;
 
     InterruptibleSleeper sleeper_;
 };
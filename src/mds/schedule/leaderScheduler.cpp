@@ -25,18 +25,44 @@
 #include <sys/time.h>
 #include <glog/logging.h>
 #include <algorithm>
+#include <cmath>
 #include <random>
 #include <limits>
 #include "src/mds/schedule/scheduler.h"
 #include "src/mds/schedule/operatorFactory.h"
+#include "src/common/timeutility.h"
+
+using ::curve::common::TimeUtility;
 
 namespace curve {
 namespace mds {
 namespace schedule {
+namespace {
+// bandwidth is counted in I/Os of this size when calculating the load,
+// so that large I/Os weigh more than small ones
+const double kLoadBytesPerIO = 64 * 1024;
+// logical pool with less load than this is regarded as idle
+const double kMinLeaderLoad = 1;
+
+double CopySetLoadSample(const CopysetStatistics &stat) {
+    return static_cast<double>(stat.readiops()) + stat.writeiops() +
+           (static_cast<double>(stat.readrate()) + stat.writerate()) /
+               kLoadBytesPerIO;
+}
+}  // namespace
+
 int LeaderScheduler::Schedule() {
     LOG(INFO) << "schedule: leaderScheduler begin.";
     int oneRoundGenOp = 0;
     for (auto lid : topo_->GetLogicalpools()) {
+        // balance the leader number if the logical pool carries no I/O
+        if (enableLoadSchedule_) {
+            int genOp = DoLoadLeaderSchedule(lid);
+            if (genOp >= 0) {
+                oneRoundGenOp += genOp;
+                continue;
+            }
+        }
         oneRoundGenOp += DoLeaderSchedule(lid);
     }
 
@@ -137,6 +163,155 @@ int LeaderScheduler::DoLeaderSchedule(PoolIdType lid) {
     return oneRoundGenOp;
 }
 
+int LeaderScheduler::DoLoadLeaderSchedule(PoolIdType lid) {
+    std::vector<CopySetInfo> copysets =
+        topo_->GetCopySetInfosInLogicalPool(lid);
+    UpdateCopySetLoad(lid, copysets);
+
+    // leader load of the chunkservers which can be source or target
+    std::map<ChunkServerIdType, ChunkServerInfo> csInfos;
+    std::map<ChunkServerIdType, double> csLoads;
+    for (auto &csInfo : topo_->GetChunkServersInLogicalPool(lid)) {
+        if (csInfo.IsOffline() || csInfo.IsPendding()) {
+            continue;
+        }
+        csInfos.emplace(csInfo.info.id, csInfo);
+        csLoads[csInfo.info.id] = 0;
+    }
+
+    double totalLoad = 0;
+    for (auto &copyset : copysets) {
+        auto it = csLoads.find(copyset.leader);
+        if (it != csLoads.end()) {
+            it->second += copysetLoad_[copyset.id];
+            totalLoad += copysetLoad_[copyset.id];
+        }
+    }
+    if (csLoads.empty() || totalLoad < kMinLeaderLoad) {
+        return -1;
+    }
+
+    ChunkServerIdType source = UNINTIALIZE_ID;
+    double sourceLoad = -1;
+    for (auto &csLoad : csLoads) {
+        if (csLoad.second > sourceLoad) {
+            source = csLoad.first;
+            sourceLoad = csLoad.second;
+        }
+    }
+
+    double avgLoad = totalLoad / csLoads.size();
+    LOG(INFO) << "leaderScheduler select chunkserver " << source
+              << " with max leader load " << sourceLoad
+              << ", average leader load " << avgLoad
+              << " in logical pool " << lid;
+    if (sourceLoad <= avgLoad * (1 + loadRangePercent_)) {
+        LOG(INFO) << "leaderScheduler no need to generate transferLeader op";
+        return 0;
+    }
+
+    // choose the leader copyset on source and the follower to transfer it
+    // to, which make the load of the source and target closest. the move
+    // must lower the max load of them, or it just moves the hotspot around
+    uint64_t now = TimeUtility::GetTimeofDaySec();
+    const CopySetInfo *selected = nullptr;
+    ChunkServerIdType target = UNINTIALIZE_ID;
+    double minDiff = sourceLoad;
+    for (auto &copyset : copysets) {
+        if (copyset.leader != source || copyset.HasCandidate()) {
+            continue;
+        }
+
+        auto transferTime = loadTransferTime_.find(copyset.id);
+        if (transferTime != loadTransferTime_.end() &&
+            now - transferTime->second < loadCoolingTimeSec_) {
+            continue;
+        }
+
+        double load = copysetLoad_[copyset.id];
+        if (load <= 0 || !copySetHealthy(copyset)) {
+            continue;
+        }
+
+        for (auto &peer : copyset.peers) {
+            auto it = csLoads.find(peer.id);
+            if (peer.id == source || it == csLoads.end() ||
+                !coolingTimeExpired(csInfos.at(peer.id).startUpTime)) {
+                continue;
+            }
+
+            if (it->second + load >= sourceLoad) {
+                continue;
+            }
+
+            double diff = std::fabs(sourceLoad - it->second - 2 * load);
+            if (diff < minDiff) {
+                minDiff = diff;
+                selected = &copyset;
+                target = peer.id;
+            }
+        }
+    }
+
+    if (selected == nullptr) {
+        LOG(INFO) << "leaderScheduler can not find copyset to transfer"
+                  << " leader out of chunkserver " << source;
+        return 0;
+    }
+
+    Operator op = operatorFactory.CreateTransferLeaderOperator(
+        *selected, target, OperatorPriority::NormalPriority);
+    op.timeLimit = std::chrono::seconds(transTimeSec_);
+    if (!opController_->AddOperator(op)) {
+        return 0;
+    }
+
+    loadTransferTime_[selected->id] = now;
+    LOG(INFO) << "leaderScheduler generatre operator " << op.OpToString()
+              << " for " << selected->CopySetInfoStr() << " with load "
+              << copysetLoad_[selected->id] << " from transfer leader load";
+    return 1;
+}
+
+void LeaderScheduler::UpdateCopySetLoad(
+    PoolIdType lid, const std::vector<CopySetInfo> &copysets) {
+    std::map<CopySetKey, CopysetStatistics> stats;
+    topo_->GetCopySetStatisticsInLogicalPool(lid, &stats);
+
+    std::map<CopySetKey, double> loads;
+    for (auto &copyset : copysets) {
+        auto old = copysetLoad_.find(copyset.id);
+        auto stat = stats.find(copyset.id);
+        if (stat == stats.end()) {
+            // keep the load until its leader reports
+            loads[copyset.id] =
+                old == copysetLoad_.end() ? 0 : old->second;
+        } else if (old == copysetLoad_.end()) {
+            loads[copyset.id] = CopySetLoadSample(stat->second);
+        } else {
+            loads[copyset.id] = loadEwmaAlpha_ *
+                CopySetLoadSample(stat->second) +
+                (1 - loadEwmaAlpha_) * old->second;
+        }
+    }
+
+    // replace the load of copysets in the logical pool
+    auto begin = copysetLoad_.lower_bound(CopySetKey(lid, 0));
+    auto end = copysetLoad_.upper_bound(
+        CopySetKey(lid, std::numeric_limits<CopySetIdType>::max()));
+    copysetLoad_.erase(begin, end);
+    copysetLoad_.insert(loads.begin(), loads.end());
+
+    uint64_t now = TimeUtility::GetTimeofDaySec();
+    for (auto it = loadTransferTime_.begin(); it != loadTransferTime_.end();) {
+        if (now - it->second >= loadCoolingTimeSec_) {
+            it = loadTransferTime_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 bool LeaderScheduler::transferLeaderOut(ChunkServerIdType source, int count,
                                         PoolIdType lid, Operator *op,
                                         CopySetInfo *selectedCopySet) {
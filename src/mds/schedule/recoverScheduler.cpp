@@ -32,6 +32,18 @@ namespace mds {
 namespace schedule {
 int RecoverScheduler::Schedule() {
     LOG(INFO) << "recoverScheduler begin.";
+    return ScheduleCopySets(topo_->GetCopySetInfos());
+}
+
+int RecoverScheduler::ScheduleEvents(
+    const std::vector<ScheduleEvent> &events) {
+    LOG(INFO) << "recoverScheduler begin with " << events.size()
+              << " events.";
+    return ScheduleCopySets(GetCopySetsOfEvents(events));
+}
+
+int RecoverScheduler::ScheduleCopySets(
+    const std::vector<CopySetInfo> &copysets) {
     int oneRoundGenOp = 0;
 
     // if over certain amount of chunkserver are downed on a server, these
@@ -39,7 +51,7 @@ int RecoverScheduler::Schedule() {
     std::set<ChunkServerIdType> excludes;
     CalculateExcludesChunkServer(&excludes);
 
-    for (auto copysetInfo : topo_->GetCopySetInfos()) {
+    for (const auto &copysetInfo : copysets) {
         // skip the copyset under configuration change
         Operator op;
         if (opController_->GetOperatorById(copysetInfo.id, &op)) {
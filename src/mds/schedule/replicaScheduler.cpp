@@ -31,8 +31,20 @@ namespace mds {
 namespace schedule {
 int ReplicaScheduler::Schedule() {
     LOG(INFO) << "replicaScheduelr begin.";
+    return ScheduleCopySets(topo_->GetCopySetInfos());
+}
+
+int ReplicaScheduler::ScheduleEvents(
+    const std::vector<ScheduleEvent> &events) {
+    LOG(INFO) << "replicaScheduelr begin with " << events.size()
+              << " events.";
+    return ScheduleCopySets(GetCopySetsOfEvents(events));
+}
+
+int ReplicaScheduler::ScheduleCopySets(
+    const std::vector<CopySetInfo> &copysets) {
     int oneRoundGenOp = 0;
-    for (auto info : topo_->GetCopySetInfos()) {
+    for (const auto &info : copysets) {
         // skip if there's any operator on a copyset
         Operator op;
         if (opController_->GetOperatorById(info.id, &op)) {
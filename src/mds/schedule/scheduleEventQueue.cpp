@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-26
+ */
+
+#include "src/mds/schedule/scheduleEventQueue.h"
+
+#include <algorithm>
+
+namespace curve {
+namespace mds {
+namespace schedule {
+void ScheduleEventQueue::Push(const ScheduleEvent &event) {
+    ::curve::common::LockGuard lk(mutex_);
+    EventKey key(event.type, event.csId, event.copysetId);
+    auto it = events_.find(key);
+    if (it == events_.end()) {
+        events_.emplace(key, event);
+    } else if (it->second.priority < event.priority) {
+        it->second.priority = event.priority;
+    }
+    cond_.notify_one();
+}
+
+bool ScheduleEventQueue::Wait(std::chrono::milliseconds timeout,
+                              std::vector<ScheduleEvent> *events) {
+    ::curve::common::UniqueLock lk(mutex_);
+    cond_.wait_for(lk, timeout,
+        [this] { return stopped_ || !events_.empty(); });
+    if (stopped_) {
+        return false;
+    }
+
+    events->clear();
+    events->reserve(events_.size());
+    for (const auto &e : events_) {
+        events->push_back(e.second);
+    }
+    events_.clear();
+    std::stable_sort(events->begin(), events->end(),
+        [](const ScheduleEvent &a, const ScheduleEvent &b) {
+            return a.priority > b.priority;
+        });
+    return true;
+}
+
+void ScheduleEventQueue::Clear() {
+    ::curve::common::LockGuard lk(mutex_);
+    events_.clear();
+}
+
+void ScheduleEventQueue::Stop() {
+    ::curve::common::LockGuard lk(mutex_);
+    stopped_ = true;
+    cond_.notify_all();
+}
+
+size_t ScheduleEventQueue::Size() {
+    ::curve::common::LockGuard lk(mutex_);
+    return events_.size();
+}
+}  // namespace schedule
+}  // namespace mds
+}  // namespace curve
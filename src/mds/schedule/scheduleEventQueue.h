@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-26
+ */
+
+#ifndef SRC_MDS_SCHEDULE_SCHEDULEEVENTQUEUE_H_
+#define SRC_MDS_SCHEDULE_SCHEDULEEVENTQUEUE_H_
+
+#include <chrono>  //NOLINT
+#include <map>
+#include <tuple>
+#include <vector>
+#include "src/common/concurrent/concurrent.h"
+#include "src/mds/topology/topology_item.h"
+
+namespace curve {
+namespace mds {
+namespace schedule {
+using ::curve::mds::topology::ChunkServerIdType;
+using ::curve::mds::topology::CopySetKey;
+
+// topology changes which trigger scheduling of the affected copysets
+enum class ScheduleEventType {
+    // a chunkserver becomes offline, its copysets need to be recovered
+    ChunkServerOffline,
+    // a chunkserver becomes online, e.g. it has no leader after restarting
+    ChunkServerOnline,
+    // the leader or the members of a copyset changed
+    CopySetChanged,
+};
+
+// events with higher priority are handled first
+enum class ScheduleEventPriority {
+    LowPriority,
+    NormalPriority,
+    HighPriority,
+};
+
+struct ScheduleEvent {
+    ScheduleEvent() : ScheduleEvent(ScheduleEventType::CopySetChanged,
+        ::curve::mds::topology::UNINTIALIZE_ID, CopySetKey()) {}
+    ScheduleEvent(ScheduleEventType type, ChunkServerIdType csId,
+                  const CopySetKey &copysetId)
+        : type(type), csId(csId), copysetId(copysetId),
+          priority(ScheduleEventPriority::NormalPriority) {}
+
+    static ScheduleEvent ChunkServerEvent(ScheduleEventType type,
+                                          ChunkServerIdType csId) {
+        return ScheduleEvent(type, csId, CopySetKey());
+    }
+
+    static ScheduleEvent CopySetEvent(const CopySetKey &copysetId) {
+        return ScheduleEvent(ScheduleEventType::CopySetChanged,
+            ::curve::mds::topology::UNINTIALIZE_ID, copysetId);
+    }
+
+    ScheduleEventType type;
+    // valid for ChunkServerOffline and ChunkServerOnline
+    ChunkServerIdType csId;
+    // valid for CopySetChanged
+    CopySetKey copysetId;
+    ScheduleEventPriority priority;
+};
+
+// ScheduleEventQueue keeps the pending events of a scheduler. The same event
+// is only kept once with its highest priority, so a flapping chunkserver or
+// a copyset reported many times doesn't make the scheduler do the same work
+// again and again.
+class ScheduleEventQueue {
+ public:
+    ScheduleEventQueue() : stopped_(false) {}
+
+    void Push(const ScheduleEvent &event);
+
+    /**
+     * @brief wait until there are events or timeout or stopped
+     *
+     * @param[in] timeout The longest time to wait
+     * @param[out] events Pending events, the ones with higher priority first
+     *
+     * @return false if the queue is stopped, true otherwise
+     */
+    bool Wait(std::chrono::milliseconds timeout,
+              std::vector<ScheduleEvent> *events);
+
+    /**
+     * @brief drop all pending events, e.g. before scanning the whole cluster
+     */
+    void Clear();
+
+    /**
+     * @brief wake up the waiters and make them return false
+     */
+    void Stop();
+
+    size_t Size();
+
+ private:
+    // type, chunkserver, copyset
+    using EventKey =
+        std::tuple<ScheduleEventType, ChunkServerIdType, CopySetKey>;
+
+    ::curve::common::Mutex mutex_;
+    ::curve::common::ConditionVariable cond_;
+    std::map<EventKey, ScheduleEvent> events_;
+    bool stopped_;
+};
+
+}  // namespace schedule
+}  // namespace mds
+}  // namespace curve
+
+#endif  // SRC_MDS_SCHEDULE_SCHEDULEEVENTQUEUE_H_
@@ -101,6 +101,28 @@ struct ScheduleOption {
     // ScanScheduler: maximum number of scan copysets at the same time
     // for every chunkserver
     uint32_t scanConcurrentPerChunkserver;
+
+    // if enabled, the recover, replica and leader schedulers only examine
+    // the copysets affected by topology change events (e.g. chunkserver
+    // offline) as soon as they happen, and scan the whole cluster every
+    // fullScheduleIntervalSec. the other schedulers run at their intervals
+    bool enableEventDrivenSchedule = false;
+    // must be non-zero, 0 would make every wake-up a full schedule
+    uint32_t fullScheduleIntervalSec = 600;
+
+    // if enabled, LeaderScheduler balances the I/O load carried by leaders
+    // on chunkservers rather than the number of leaders. the load of a
+    // copyset is the EWMA of its IOPS plus bandwidth counted in 64KB I/Os,
+    // leader number is still balanced if the logical pool has no I/O
+    bool enableLoadAwareLeaderSchedule = false;
+    // weight of the latest sample in EWMA, in (0, 1]
+    float leaderLoadEwmaAlpha = 0.3;
+    // leaders are transferred for load only if the maximum leader load
+    // exceeds average leader load * (1 + leaderLoadRangePercent)
+    float leaderLoadRangePercent = 0.2;
+    // the leader of a copyset transferred for load will not be transferred
+    // for load again within leaderLoadCoolingTimeSec
+    uint32_t leaderLoadCoolingTimeSec = 600;
 };
 
 }  // namespace schedule
@@ -36,10 +36,38 @@ int Scheduler::Schedule() {
     return 0;
 }
 
+int Scheduler::ScheduleEvents(const std::vector<ScheduleEvent> &events) {
+    return Schedule();
+}
+
 int64_t Scheduler::GetRunningInterval() {
     return 0;
 }
 
+std::vector<CopySetInfo> Scheduler::GetCopySetsOfEvents(
+    const std::vector<ScheduleEvent> &events) {
+    std::vector<CopySetInfo> copysets;
+    std::set<CopySetKey> added;
+    for (const auto &event : events) {
+        std::vector<CopySetInfo> infos;
+        if (event.type == ScheduleEventType::CopySetChanged) {
+            CopySetInfo info;
+            if (topo_->GetCopySetInfo(event.copysetId, &info)) {
+                infos.emplace_back(info);
+            }
+        } else {
+            infos = topo_->GetCopySetInfosInChunkServer(event.csId);
+        }
+
+        for (auto &info : infos) {
+            if (added.emplace(info.id).second) {
+                copysets.emplace_back(info);
+            }
+        }
+    }
+    return copysets;
+}
+
 /**
  * process for SelectBestPlacementChunkServer process description:
  * Purpose: For copyset-m(1, 2, 3), select a chunkserver-n in chunkserverList{1,
@@ -35,6 +35,7 @@
 #include "src/mds/schedule/operatorController.h"
 #include "src/mds/topology/topology.h"
 #include "src/mds/schedule/operator.h"
+#include "src/mds/schedule/scheduleEventQueue.h"
 
 namespace curve {
 namespace mds {
@@ -85,12 +86,31 @@ class Scheduler {
      */
     virtual int Schedule();
 
+    /**
+     * @brief producing operator for the copysets affected by the topology
+     *        change events, the whole cluster is scanned by default
+     *
+     * @param[in] events Events happened since last round
+     */
+    virtual int ScheduleEvents(const std::vector<ScheduleEvent> &events);
+
     /**
      * @brief time interval of generating operations
      */
     virtual int64_t GetRunningInterval();
 
  protected:
+    /**
+     * @brief GetCopySetsOfEvents Get the copysets affected by the events,
+     *                            the ones of higher priority events first
+     *
+     * @param[in] events Topology change events
+     *
+     * @return copysets affected without duplication
+     */
+    std::vector<CopySetInfo> GetCopySetsOfEvents(
+        const std::vector<ScheduleEvent> &events);
+
     /**
      * @brief SelectBestPlacementChunkServer Select a healthy chunkserver in
      *                                       the cluster to replace the oldPeer
@@ -300,6 +320,10 @@ class LeaderScheduler : public Scheduler {
         : Scheduler(opt, topo, opController) {
         runInterval_ = opt.leaderSchedulerIntervalSec;
         chunkserverCoolingTimeSec_ = opt.chunkserverCoolingTimeSec;
+        enableLoadSchedule_ = opt.enableLoadAwareLeaderSchedule;
+        loadEwmaAlpha_ = opt.leaderLoadEwmaAlpha;
+        loadRangePercent_ = opt.leaderLoadRangePercent;
+        loadCoolingTimeSec_ = opt.leaderLoadCoolingTimeSec;
     }
 
     /**
@@ -379,6 +403,30 @@ class LeaderScheduler : public Scheduler {
      */
     int DoLeaderSchedule(PoolIdType lid);
 
+    /**
+     * @brief DoLoadLeaderSchedule Balance the I/O load carried by the leaders
+     *        of chunkservers in specified logical pool. pick the chunkserver
+     *        with the highest leader load, and transfer one of its leaders to
+     *        the follower which makes the load of them closest
+     *
+     * @param[in] lid The ID of the logical pool specified
+     *
+     * @return The number of the effective operator generated,
+     *         -1 if the copysets in the logical pool carry no I/O
+     */
+    int DoLoadLeaderSchedule(PoolIdType lid);
+
+    /**
+     * @brief UpdateCopySetLoad Update the EWMA load of the copysets in
+     *        specified logical pool with the latest I/O statistics reported
+     *        by their leaders, and drop the load of removed copysets
+     *
+     * @param[in] lid The ID of the logical pool specified
+     * @param[in] copysets The copysets in the logical pool
+     */
+    void UpdateCopySetLoad(PoolIdType lid,
+                           const std::vector<CopySetInfo> &copysets);
+
  private:
     int64_t runInterval_;
 
@@ -386,6 +434,17 @@ class LeaderScheduler : public Scheduler {
     // leader after it started
     uint32_t chunkserverCoolingTimeSec_;
 
+    // balance leader load instead of leader number
+    bool enableLoadSchedule_;
+    float loadEwmaAlpha_;
+    float loadRangePercent_;
+    uint32_t loadCoolingTimeSec_;
+
+    // EWMA load of copysets
+    std::map<CopySetKey, double> copysetLoad_;
+    // the last time(s) the leader of copyset was transferred for load
+    std::map<CopySetKey, uint64_t> loadTransferTime_;
+
     // retry times of method transferLeaderout
     const int maxRetryTransferLeader = 10;
 };
@@ -409,6 +468,14 @@ class RecoverScheduler : public Scheduler {
      */
     int Schedule() override;
 
+    /**
+     * @brief recovering the offline replica of the copysets affected by the
+     *        events, e.g. the copysets on a chunkserver just became offline
+     *
+     * @return the number of operators generated
+     */
+    int ScheduleEvents(const std::vector<ScheduleEvent> &events) override;
+
     /**
      * @brief running time interval of the scheduler
      *
@@ -417,6 +484,15 @@ class RecoverScheduler : public Scheduler {
     int64_t GetRunningInterval() override;
 
  private:
+    /**
+     * @brief recovering the offline replica of the specified copysets
+     *
+     * @param[in] copysets The copysets to check
+     *
+     * @return the number of operators generated
+     */
+    int ScheduleCopySets(const std::vector<CopySetInfo> &copysets);
+
     /**
      * @brief fix the specified replica
      *
@@ -467,6 +543,13 @@ class ReplicaScheduler : public Scheduler {
      */
     int Schedule() override;
 
+    /**
+     * @brief Check the replica number of the copysets affected by the events
+     *
+     * @return the number of operators generated
+     */
+    int ScheduleEvents(const std::vector<ScheduleEvent> &events) override;
+
     /**
      * @brief get running time interval of the scheduler
      *
@@ -474,6 +557,16 @@ class ReplicaScheduler : public Scheduler {
      */
     int64_t GetRunningInterval() override;
 
+ private:
+    /**
+     * @brief Check the replica number of the specified copysets
+     *
+     * @param[in] copysets The copysets to check
+     *
+     * @return the number of operators generated
+     */
+    int ScheduleCopySets(const std::vector<CopySetInfo> &copysets);
+
  private:
     // time interval of replicaScheduler
     int64_t runInterval_;
@@ -432,6 +432,35 @@ void TopoAdapterImpl::GetChunkServerScatterMap(
         }
     }
 }
+
+void TopoAdapterImpl::GetCopySetStatisticsInLogicalPool(
+    PoolIdType lid, std::map<CopySetKey, CopysetStatistics> *out) {
+    assert(out != nullptr);
+
+    for (auto csId : topo_->GetChunkServerInLogicalPool(lid)) {
+        ChunkServerStat stat;
+        if (!topoStat_->GetChunkServerStat(csId, &stat)) {
+            continue;
+        }
+
+        // client I/O is served by the leader, so only the statistics
+        // reported by the leader make sense. statistics carried over by a
+        // delta heartbeat are stale and would be sampled again, skip them
+        for (const auto &copysetStat : stat.copysetStats) {
+            if (copysetStat.logicalPoolId != lid ||
+                copysetStat.leader != csId || copysetStat.carried) {
+                continue;
+            }
+
+            CopysetStatistics &statistics =
+                (*out)[CopySetKey(lid, copysetStat.copysetId)];
+            statistics.set_readrate(copysetStat.readRate);
+            statistics.set_writerate(copysetStat.writeRate);
+            statistics.set_readiops(copysetStat.readIOPS);
+            statistics.set_writeiops(copysetStat.writeIOPS);
+        }
+    }
+}
 }  // namespace schedule
 }  // namespace mds
 }  // namespace curve
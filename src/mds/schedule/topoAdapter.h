@@ -338,6 +338,19 @@ class TopoAdapter {
      */
     virtual void GetChunkServerScatterMap(const ChunkServerIdType &cs,
         std::map<ChunkServerIdType, int> *out) = 0;
+
+    /**
+     * @brief GetCopySetStatisticsInLogicalPool Get the latest I/O statistics
+     *                                          of copysets in the logical
+     *                                          pool reported by their leaders
+     *
+     * @param[in] lid ID of logical pool
+     * @param[out] out key is the copyset, value is its I/O statistics.
+     *                 copysets not reported by their leaders in the
+     *                 latest heartbeat are absent
+     */
+    virtual void GetCopySetStatisticsInLogicalPool(PoolIdType lid,
+        std::map<CopySetKey, CopysetStatistics> *out) = 0;
 };
 
 // implementation of virtual class TopoAdapter
@@ -393,6 +406,9 @@ class TopoAdapterImpl : public TopoAdapter {
     void GetChunkServerScatterMap(const ChunkServerIdType &cs,
         std::map<ChunkServerIdType, int> *out) override;
 
+    void GetCopySetStatisticsInLogicalPool(PoolIdType lid,
+        std::map<CopySetKey, CopysetStatistics> *out) override;
+
  private:
     bool GetPeerInfo(ChunkServerIdType id, PeerInfo *peerInfo);
 
@@ -39,7 +39,8 @@ using ::curve::mds::topology::ChunkServerRegistInfoBuilder;
 namespace curve {
 namespace mds {
 
-using LRUCache = ::curve::common::LRUCache<std::string, std::string>;
+using ShardedLRUCache =
+    ::curve::common::ShardedLRUCache<std::string, CachedObject>;
 using CacheMetrics = ::curve::common::CacheMetrics;
 using ::curve::common::BLOCKSIZEKEY;
 using ::curve::common::CHUNKSIZEKEY;
@@ -70,6 +71,24 @@ void MDS::InitMdsOptions(std::shared_ptr<Configuration> conf) {
 
     // cache size of namestorage
     conf_->GetValueFatalIfFail("mds.cache.count", &options_.mdsCacheCount);
+    if (!conf_->GetUInt32Value("mds.cache.shardNum",
+                               &options_.mdsCacheShardNum)) {
+        LOG(WARNING) << "Not found mds.cache.shardNum in conf"
+                     << ", use default value " << options_.mdsCacheShardNum;
+    }
+
+    if (!conf_->GetUInt32Value("mds.etcd.batch.maxOps",
+                               &options_.etcdBatchOption.maxBatchOps)) {
+        LOG(WARNING) << "Not found mds.etcd.batch.maxOps in conf"
+                     << ", use default value "
+                     << options_.etcdBatchOption.maxBatchOps;
+    }
+    if (!conf_->GetUInt32Value("mds.etcd.batch.windowUs",
+                               &options_.etcdBatchOption.batchWindowUs)) {
+        LOG(WARNING) << "Not found mds.etcd.batch.windowUs in conf"
+                     << ", use default value "
+                     << options_.etcdBatchOption.batchWindowUs;
+    }
 
     conf_->GetValueFatalIfFail("mds.listen.addr", &options_.mdsListenAddr);
 
@@ -131,7 +150,8 @@ void MDS::Init() {
 
     InitSegmentAllocStatistic(options_.retryInterTimes,
                               options_.periodicPersistInterMs);
-    InitNameServerStorage(options_.mdsCacheCount);
+    InitNameServerStorage(options_.mdsCacheCount,
+                          options_.mdsCacheShardNum);
     InitTopology(options_.topologyOption);
     InitTopologyStat();
     InitTopologyChunkAllocator(options_.topologyOption);
@@ -284,6 +304,9 @@ void MDS::InitEtcdClient(const EtcdConf& etcdConf,
             << ", operation timeout: " << etcdTimeout
             << ", etcd retrytimes: " << retryTimes
             << ", auth enable = " << etcdConf.authEnable;
+
+    kvStorageClient_ = std::make_shared<BatchKVStorageClient>(
+        etcdClient_, options_.etcdBatchOption, "mds_etcd_client");
 }
 
 void MDS::InitLeaderElection(const LeaderElectionOptions& leaderElectionOp) {
@@ -343,7 +366,7 @@ void MDS::InitTopology(const TopologyOption& option) {
 
     auto codec = std::make_shared<TopologyStorageCodec>();
     auto topologyStorage =
-        std::make_shared<TopologyStorageEtcd>(etcdClient_, codec);
+        std::make_shared<TopologyStorageEtcd>(kvStorageClient_, codec);
 
     LOG(INFO) << "init topologyStorage success.";
 
@@ -422,16 +445,16 @@ void MDS::InitTopologyChunkAllocator(const TopologyOption& option) {
     LOG(INFO) << "init topologyChunkAllocator success.";
 }
 
-void MDS::InitNameServerStorage(int mdsCacheCount) {
+void MDS::InitNameServerStorage(int mdsCacheCount, uint32_t shardNum) {
     // init LRUCache
 
-    auto cache = std::make_shared<LRUCache>(mdsCacheCount,
+    auto cache = std::make_shared<ShardedLRUCache>(mdsCacheCount, shardNum,
         std::make_shared<CacheMetrics>("mds_nameserver_cache_metric"));
-    LOG(INFO) << "init LRUCache success.";
+    LOG(INFO) << "init LRUCache success, shard num: " << shardNum;
 
     // init NameServerStorage
-    nameServerStorage_ = std::make_shared<NameServerStorageImp>(etcdClient_,
-                                                                cache);
+    nameServerStorage_ =
+        std::make_shared<NameServerStorageImp>(kvStorageClient_, cache);
     LOG(INFO) << "init NameServerStorage success.";
 }
 
@@ -534,6 +557,12 @@ void MDS::InitCurveFSOptions(CurveFSOption *curveFSOptions) {
     conf_->GetValueFatalIfFail(
         "mds.curvefs.maxFileLength", &curveFSOptions->maxFileLength);
     conf_->GetValueFatalIfFail("mds.curvefs.blockSize", &g_block_size);
+    if (!conf_->GetUInt32Value("mds.curvefs.maxPreallocateSegmentNum",
+                               &curveFSOptions->maxPreallocateSegmentNum)) {
+        LOG(WARNING) << "Not found mds.curvefs.maxPreallocateSegmentNum in conf"
+                     << ", use default value "
+                     << curveFSOptions->maxPreallocateSegmentNum;
+    }
 
     if (g_block_size != 4096 && g_block_size != 512) {
         LOG(FATAL) << "mds.curvefs.blockSize only supports 512 and 4096";
@@ -570,9 +599,12 @@ void MDS::InitCleanManager() {
         std::make_shared<CopysetClient>(topology_, chunkServerClientOption,
                                                         channelPool);
 
+    CleanCoreOption cleanCoreOption;
+    InitCleanCoreOption(&cleanCoreOption);
     auto cleanCore = std::make_shared<CleanCore>(nameServerStorage_,
                                                  copysetClient,
-                                                 segmentAllocStatistic_);
+                                                 segmentAllocStatistic_,
+                                                 cleanCoreOption);
 
     // init dlock options
     auto dlockOpts = std::make_shared<DLockOpts>();
@@ -584,6 +616,27 @@ void MDS::InitCleanManager() {
     LOG(INFO) << "init CleanManager success.";
 }
 
+void MDS::InitCleanCoreOption(CleanCoreOption *option) {
+    if (!conf_->GetUInt32Value("mds.clean.deleteChunk.concurrency",
+                               &option->deleteChunkConcurrency)) {
+        LOG(WARNING) << "Not found mds.clean.deleteChunk.concurrency in conf"
+                     << ", use default value "
+                     << option->deleteChunkConcurrency;
+    }
+    if (!conf_->GetUInt64Value("mds.clean.deleteChunk.limitPerSec",
+                               &option->deleteChunkLimitPerSec)) {
+        LOG(WARNING) << "Not found mds.clean.deleteChunk.limitPerSec in conf"
+                     << ", use default value "
+                     << option->deleteChunkLimitPerSec;
+    }
+    if (!conf_->GetUInt32Value("mds.clean.deleteChunk.batchSize",
+                               &option->deleteChunkBatchSize)) {
+        LOG(WARNING) << "Not found mds.clean.deleteChunk.batchSize in conf"
+                     << ", use default value "
+                     << option->deleteChunkBatchSize;
+    }
+}
+
 void MDS::InitChunkServerClientOption(ChunkServerClientOption *option) {
     conf_->GetValueFatalIfFail("mds.chunkserverclient.rpcTimeoutMs",
         &option->rpcTimeoutMs);
@@ -664,6 +717,56 @@ void MDS::InitScheduleOption(ScheduleOption *scheduleOption) {
         &scheduleOption->scanConcurrentPerPool);
     conf_->GetValueFatalIfFail("mds.scheduler.scan.concurrent.per.chunkserver",
         &scheduleOption->scanConcurrentPerChunkserver);
+
+    if (!conf_->GetBoolValue("mds.scheduler.eventDriven.enable",
+                             &scheduleOption->enableEventDrivenSchedule)) {
+        LOG(WARNING) << "Not found mds.scheduler.eventDriven.enable in conf"
+                     << ", use default value "
+                     << scheduleOption->enableEventDrivenSchedule;
+    }
+    const uint32_t defaultFullScheduleIntervalSec =
+        scheduleOption->fullScheduleIntervalSec;
+    if (!conf_->GetUInt32Value("mds.scheduler.full.intervalSec",
+                               &scheduleOption->fullScheduleIntervalSec)) {
+        LOG(WARNING) << "Not found mds.scheduler.full.intervalSec in conf"
+                     << ", use default value "
+                     << scheduleOption->fullScheduleIntervalSec;
+    } else if (scheduleOption->fullScheduleIntervalSec == 0) {
+        scheduleOption->fullScheduleIntervalSec =
+            defaultFullScheduleIntervalSec;
+        LOG(WARNING) << "mds.scheduler.full.intervalSec must be positive"
+                     << ", use default value "
+                     << scheduleOption->fullScheduleIntervalSec;
+    }
+    if (!conf_->GetBoolValue("mds.scheduler.leader.loadAware.enable",
+                             &scheduleOption->enableLoadAwareLeaderSchedule)) {
+        LOG(WARNING) << "Not found mds.scheduler.leader.loadAware.enable"
+                     << " in conf, use default value "
+                     << scheduleOption->enableLoadAwareLeaderSchedule;
+    }
+    if (!conf_->GetFloatValue("mds.scheduler.leader.load.ewmaAlpha",
+                              &scheduleOption->leaderLoadEwmaAlpha)) {
+        LOG(WARNING) << "Not found mds.scheduler.leader.load.ewmaAlpha"
+                     << " in conf, use default value "
+                     << scheduleOption->leaderLoadEwmaAlpha;
+    }
+    if (!conf_->GetFloatValue("mds.scheduler.leader.load.rangePercent",
+                              &scheduleOption->leaderLoadRangePercent)) {
+        LOG(WARNING) << "Not found mds.scheduler.leader.load.rangePercent"
+                     << " in conf, use default value "
+                     << scheduleOption->leaderLoadRangePercent;
+    }
+    if (!conf_->GetUInt32Value("mds.scheduler.leader.load.cooling.timeSec",
+                               &scheduleOption->leaderLoadCoolingTimeSec)) {
+        LOG(WARNING) << "Not found mds.scheduler.leader.load.cooling.timeSec"
+                     << " in conf, use default value "
+                     << scheduleOption->leaderLoadCoolingTimeSec;
+    }
+    if (scheduleOption->leaderLoadEwmaAlpha <= 0 ||
+        scheduleOption->leaderLoadEwmaAlpha > 1) {
+        LOG(FATAL) << "mds.scheduler.leader.load.ewmaAlpha must be in (0, 1]"
+                   << ", but got " << scheduleOption->leaderLoadEwmaAlpha;
+    }
 }
 
 void MDS::InitHeartbeatManager() {
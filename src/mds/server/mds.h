@@ -58,6 +58,7 @@
 #include "src/common/channel_pool.h"
 #include "src/mds/schedule/scheduleService/scheduleService.h"
 #include "src/common/concurrent/dlock.h"
+#include "src/kvstorageclient/batch_kvstorage_client.h"
 
 using ::curve::mds::topology::TopologyChunkAllocatorImpl;
 using ::curve::mds::topology::TopologyServiceImpl;
@@ -84,6 +85,8 @@ using ::curve::election::LeaderElectionOptions;
 using ::curve::election::LeaderElection;
 using ::curve::common::Configuration;
 using ::curve::common::DLockOpts;
+using ::curve::kvstorage::BatchKVStorageClient;
+using ::curve::kvstorage::BatchKVStorageClientOption;
 
 namespace curve {
 namespace mds {
@@ -98,7 +101,11 @@ struct MDSOptions {
     uint64_t periodicPersistInterMs;
     // cache size of namestorage
     int mdsCacheCount;
+    // shard number of namestorage cache
+    uint32_t mdsCacheShardNum = 16;
     int mdsFilelockBucketNum;
+    // group commit of etcd writes
+    BatchKVStorageClientOption etcdBatchOption;
 
     FileRecordOptions fileRecordOptions;
     RootAuthOption authOptions;
@@ -170,6 +177,8 @@ class MDS {
 
     void InitChunkServerClientOption(ChunkServerClientOption *option);
 
+    void InitCleanCoreOption(CleanCoreOption *option);
+
     void InitSnapshotCloneClientOption(SnapshotCloneClientOption *option);
 
     void InitEtcdClient(const EtcdConf& etcdConf,
@@ -181,7 +190,7 @@ class MDS {
     void InitSegmentAllocStatistic(uint64_t retryInterTimes,
                                    uint64_t periodicPersistInterMs);
 
-    void InitNameServerStorage(int mdsCacheCount);
+    void InitNameServerStorage(int mdsCacheCount, uint32_t shardNum);
 
     void StartServer();
 
@@ -223,6 +232,8 @@ class MDS {
     MDSOptions options_;
 
     std::shared_ptr<EtcdClientImp> etcdClient_;
+    // etcdClient_ with concurrent writes merged, used by metadata storage
+    std::shared_ptr<KVStorageClient> kvStorageClient_;
     std::shared_ptr<LeaderElection> leaderElection_;
     std::shared_ptr<AllocStatistic> segmentAllocStatistic_;
     std::shared_ptr<NameServerStorage> nameServerStorage_;
@@ -23,6 +23,8 @@
 
 #include <glog/logging.h>
 
+#include <atomic>
+#include <string>
 #include <utility>
 
 #include "src/common/namespace_define.h"
@@ -33,11 +35,48 @@
 using ::curve::common::UUIDGenerator;
 using ::curve::common::kDefaultPoolsetId;
 using ::curve::common::kDefaultPoolsetName;
+using ::curve::common::TimeUtility;
 
 namespace curve {
 namespace mds {
 namespace topology {
 
+namespace {
+
+// record how long a lock is held, declare it after the lock guard
+class LockHoldTimer {
+ public:
+    explicit LockHoldTimer(bvar::LatencyRecorder *recorder)
+        : recorder_(recorder), start_(TimeUtility::GetTimeofDayUs()) {}
+
+    ~LockHoldTimer() {
+        *recorder_ << TimeUtility::GetTimeofDayUs() - start_;
+    }
+
+ private:
+    bvar::LatencyRecorder *recorder_;
+    uint64_t start_;
+};
+
+// distinguish the metrics of topologies in the same process
+std::atomic<uint64_t> topologyId{0};
+
+}  // namespace
+
+TopologyImpl::TopologyImpl(
+    std::shared_ptr<TopologyIdGenerator> idGenerator,
+    std::shared_ptr<TopologyTokenGenerator> tokenGenerator,
+    std::shared_ptr<TopologyStorage> storage)
+    : idGenerator_(idGenerator),
+      tokenGenerator_(tokenGenerator),
+      storage_(storage),
+      isStop_(true) {
+    std::string prefix =
+        "topology_" + std::to_string(topologyId.fetch_add(1));
+    copySetWriteLockHold_.expose(prefix, "copyset_write_lock_hold");
+    copySetScanLockHold_.expose(prefix, "copyset_scan_lock_hold");
+}
+
 PoolsetIdType TopologyImpl::AllocatePoolsetId() {
     return idGenerator_->GenPoolsetId();
 }
@@ -208,6 +247,18 @@ int TopologyImpl::RemoveLogicalPool(PoolIdType id) {
             return kTopoErrCodeStorgeFail;
         }
         logicalPoolMap_.erase(it);
+
+        // no copyset can be added to the pool any more, drop its shard
+        WriteLockGuard wlockCopySetMap(copySetMutex_);
+        auto shardIt = copySetShards_.find(id);
+        if (shardIt != copySetShards_.end()) {
+            // keep the shard alive until its lock is released
+            CopySetShardPtr shard = shardIt->second;
+            ReadLockGuard rlockShard(shard->mutex);
+            if (shard->copySets.empty()) {
+                copySetShards_.erase(shardIt);
+            }
+        }
         return kTopoErrCodeSuccess;
     } else {
         return kTopoErrCodeLogicalPoolNotFound;
@@ -1135,14 +1186,24 @@ int TopologyImpl::Init(const TopologyOption &option) {
     }
     LOG(INFO) << "Calc physicalPool capacity success.";
 
+    std::map<CopySetKey, CopySetInfo> copySetMap;
     std::map<PoolIdType, CopySetIdType> copySetIdMaxMap;
-    if (!storage_->LoadCopySet(&copySetMap_, &copySetIdMaxMap)) {
+    if (!storage_->LoadCopySet(&copySetMap, &copySetIdMaxMap)) {
         LOG(ERROR) << "[TopologyImpl::init], LoadCopySet fail.";
         return kTopoErrCodeStorgeFail;
     }
     idGenerator_->initCopySetIdGenerator(copySetIdMaxMap);
     LOG(INFO) << "[TopologyImpl::init], LoadCopySet success, "
-              << "copyset num = " << copySetMap_.size();
+              << "copyset num = " << copySetMap.size();
+
+    copySetShards_.clear();
+    for (auto &c : copySetMap) {
+        CopySetShardPtr &shard = copySetShards_[c.first.first];
+        if (shard == nullptr) {
+            shard = std::make_shared<CopySetShard>();
+        }
+        shard->copySets.emplace(c.first, c.second);
+    }
 
     for (auto& phy : physicalPoolMap_) {
         auto pid = phy.second.GetPoolsetId();
@@ -1194,15 +1255,16 @@ void TopologyImpl::SetChunkServerExternalIp() {
 int TopologyImpl::CleanInvalidLogicalPoolAndCopyset() {
     for (auto ix = logicalPoolMap_.begin(); ix != logicalPoolMap_.end();) {
         if (false == ix->second.GetLogicalPoolAvaliableFlag()) {
-            for (auto it = copySetMap_.begin(); it != copySetMap_.end();) {
-                if (it->second.GetLogicalPoolId() == ix->first) {
+            auto shardIt = copySetShards_.find(ix->first);
+            if (shardIt != copySetShards_.end()) {
+                auto &copySets = shardIt->second->copySets;
+                for (auto it = copySets.begin(); it != copySets.end();) {
                     if (!storage_->DeleteCopySet(it->first)) {
                         return kTopoErrCodeStorgeFail;
                     }
-                    it = copySetMap_.erase(it);
-                } else {
-                    it++;
+                    it = copySets.erase(it);
                 }
+                copySetShards_.erase(shardIt);
             }
             if (!storage_->DeleteLogicalPool(ix->first)) {
                 return kTopoErrCodeStorgeFail;
@@ -1222,15 +1284,18 @@ CopySetIdType TopologyImpl::AllocateCopySetId(PoolIdType logicalPoolId) {
 
 int TopologyImpl::AddCopySet(const CopySetInfo &data) {
     ReadLockGuard rlockLogicalPool(logicalPoolMutex_);
-    WriteLockGuard wlockCopySetMap(copySetMutex_);
     auto it = logicalPoolMap_.find(data.GetLogicalPoolId());
     if (it != logicalPoolMap_.end()) {
+        CopySetShardPtr shard = GetOrCreateCopySetShard(it->first);
+        WriteLockGuard wlockShard(shard->mutex);
+        LockHoldTimer timer(&copySetWriteLockHold_);
         CopySetKey key(data.GetLogicalPoolId(), data.GetId());
-        if (copySetMap_.find(key) == copySetMap_.end()) {
+        if (shard->copySets.find(key) == shard->copySets.end()) {
             if (!storage_->StorageCopySet(data)) {
                 return kTopoErrCodeStorgeFail;
             }
-            copySetMap_[key] = data;
+            shard->copySets[key] = data;
+            shard->version++;
             return kTopoErrCodeSuccess;
         } else {
             return kTopoErrCodeIdDuplicated;
@@ -1241,13 +1306,19 @@ int TopologyImpl::AddCopySet(const CopySetInfo &data) {
 }
 
 int TopologyImpl::RemoveCopySet(CopySetKey key) {
-    WriteLockGuard wlockCopySetMap(copySetMutex_);
-    auto it = copySetMap_.find(key);
-    if (it != copySetMap_.end()) {
+    CopySetShardPtr shard = GetCopySetShard(key.first);
+    if (shard == nullptr) {
+        return kTopoErrCodeCopySetNotFound;
+    }
+    WriteLockGuard wlockShard(shard->mutex);
+    LockHoldTimer timer(&copySetWriteLockHold_);
+    auto it = shard->copySets.find(key);
+    if (it != shard->copySets.end()) {
         if (!storage_->DeleteCopySet(key)) {
             return kTopoErrCodeStorgeFail;
         }
-        copySetMap_.erase(key);
+        shard->copySets.erase(it);
+        shard->version++;
         return kTopoErrCodeSuccess;
     } else {
         return kTopoErrCodeCopySetNotFound;
@@ -1255,11 +1326,19 @@ int TopologyImpl::RemoveCopySet(CopySetKey key) {
 }
 
 int TopologyImpl::UpdateCopySetTopo(const CopySetInfo &data) {
-    ReadLockGuard rlockCopySetMap(copySetMutex_);
     CopySetKey key(data.GetLogicalPoolId(), data.GetId());
-    auto it = copySetMap_.find(key);
-    if (it != copySetMap_.end()) {
+    CopySetShardPtr shard = GetCopySetShard(key.first);
+    if (shard == nullptr) {
+        LOG(WARNING) << "UpdateCopySetTopo can not find copyset, "
+                     << "logicalPoolId = " << data.GetLogicalPoolId()
+                     << ", copysetId = " << data.GetId();
+        return kTopoErrCodeCopySetNotFound;
+    }
+    ReadLockGuard rlockShard(shard->mutex);
+    auto it = shard->copySets.find(key);
+    if (it != shard->copySets.end()) {
         WriteLockGuard wlockCopySet(it->second.GetRWLockRef());
+        LockHoldTimer timer(&copySetWriteLockHold_);
         it->second.SetLeader(data.GetLeader());
         it->second.SetEpoch(data.GetEpoch());
         it->second.SetCopySetMembers(data.GetCopySetMembers());
@@ -1279,6 +1358,7 @@ int TopologyImpl::UpdateCopySetTopo(const CopySetInfo &data) {
         }
 
         it->second.SetDirtyFlag(true);
+        shard->version++;
         return kTopoErrCodeSuccess;
     } else {
         LOG(WARNING) << "UpdateCopySetTopo can not find copyset, "
@@ -1289,10 +1369,18 @@ int TopologyImpl::UpdateCopySetTopo(const CopySetInfo &data) {
 }
 
 int TopologyImpl::SetCopySetAvalFlag(const CopySetKey &key, bool aval) {
-    ReadLockGuard rlockCopySetMap(copySetMutex_);
-    auto it = copySetMap_.find(key);
-    if (it != copySetMap_.end()) {
+    CopySetShardPtr shard = GetCopySetShard(key.first);
+    if (shard == nullptr) {
+        LOG(WARNING) << "SetCopySetAvalFlag can not find copyset, "
+                     << "logicalPoolId = " << key.first
+                     << ", copysetId = " << key.second;
+        return kTopoErrCodeCopySetNotFound;
+    }
+    ReadLockGuard rlockShard(shard->mutex);
+    auto it = shard->copySets.find(key);
+    if (it != shard->copySets.end()) {
         WriteLockGuard wlockCopySet(it->second.GetRWLockRef());
+        LockHoldTimer timer(&copySetWriteLockHold_);
         auto copysetInfo = it->second;
         copysetInfo.SetAvailableFlag(aval);
         bool ret = storage_->UpdateCopySet(copysetInfo);
@@ -1301,6 +1389,7 @@ int TopologyImpl::SetCopySetAvalFlag(const CopySetKey &key, bool aval) {
             return kTopoErrCodeStorgeFail;
         }
         it->second.SetAvailableFlag(aval);
+        shard->version++;
         return kTopoErrCodeSuccess;
     } else {
         LOG(WARNING) << "SetCopySetAvalFlag can not find copyset, "
@@ -1311,9 +1400,13 @@ int TopologyImpl::SetCopySetAvalFlag(const CopySetKey &key, bool aval) {
 }
 
 bool TopologyImpl::GetCopySet(CopySetKey key, CopySetInfo *out) const {
-    ReadLockGuard rlockCopySetMap(copySetMutex_);
-    auto it = copySetMap_.find(key);
-    if (it != copySetMap_.end()) {
+    CopySetShardPtr shard = GetCopySetShard(key.first);
+    if (shard == nullptr) {
+        return false;
+    }
+    ReadLockGuard rlockShard(shard->mutex);
+    auto it = shard->copySets.find(key);
+    if (it != shard->copySets.end()) {
         ReadLockGuard rlockCopySet(it->second.GetRWLockRef());
         *out = it->second;
         return true;
@@ -1322,14 +1415,77 @@ bool TopologyImpl::GetCopySet(CopySetKey key, CopySetInfo *out) const {
     }
 }
 
+TopologyImpl::CopySetShardPtr TopologyImpl::GetCopySetShard(
+    PoolIdType logicalPoolId) const {
+    ReadLockGuard rlockCopySetMap(copySetMutex_);
+    auto it = copySetShards_.find(logicalPoolId);
+    if (it != copySetShards_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+TopologyImpl::CopySetShardPtr TopologyImpl::GetOrCreateCopySetShard(
+    PoolIdType logicalPoolId) {
+    CopySetShardPtr shard = GetCopySetShard(logicalPoolId);
+    if (shard != nullptr) {
+        return shard;
+    }
+    WriteLockGuard wlockCopySetMap(copySetMutex_);
+    CopySetShardPtr &ret = copySetShards_[logicalPoolId];
+    if (ret == nullptr) {
+        ret = std::make_shared<CopySetShard>();
+    }
+    return ret;
+}
+
+std::vector<TopologyImpl::CopySetShardPtr>
+TopologyImpl::GetCopySetShards() const {
+    std::vector<CopySetShardPtr> ret;
+    ReadLockGuard rlockCopySetMap(copySetMutex_);
+    ret.reserve(copySetShards_.size());
+    for (const auto &shard : copySetShards_) {
+        ret.push_back(shard.second);
+    }
+    return ret;
+}
+
+TopologyImpl::CopySetSnapshot TopologyImpl::GetCopySetSnapshot(
+    const CopySetShard &shard) const {
+    curve::common::LockGuard lockSnapshot(shard.snapshotMutex);
+    // read the version before copying, so a change during the copy
+    // makes the next call rebuild the snapshot again
+    uint64_t version = shard.version.load();
+    if (shard.snapshot != nullptr && shard.snapshotVersion == version) {
+        return shard.snapshot;
+    }
+
+    auto snapshot = std::make_shared<std::vector<CopySetInfo>>();
+    {
+        ReadLockGuard rlockShard(shard.mutex);
+        LockHoldTimer timer(&copySetScanLockHold_);
+        snapshot->reserve(shard.copySets.size());
+        for (const auto &c : shard.copySets) {
+            ReadLockGuard rlockCopySet(c.second.GetRWLockRef());
+            snapshot->push_back(c.second);
+        }
+    }
+    shard.snapshot = snapshot;
+    shard.snapshotVersion = version;
+    return shard.snapshot;
+}
+
 std::vector<CopySetIdType> TopologyImpl::GetCopySetsInLogicalPool(
     PoolIdType logicalPoolId,
     CopySetFilter filter) const {
     std::vector<CopySetIdType> ret;
-    ReadLockGuard rlockCopySet(copySetMutex_);
-    for (auto it : copySetMap_) {
-        if (filter(it.second) && it.first.first == logicalPoolId) {
-            ret.push_back(it.first.second);
+    CopySetShardPtr shard = GetCopySetShard(logicalPoolId);
+    if (shard == nullptr) {
+        return ret;
+    }
+    for (const auto &c : *GetCopySetSnapshot(*shard)) {
+        if (filter(c)) {
+            ret.push_back(c.GetId());
         }
     }
     return ret;
@@ -1339,10 +1495,13 @@ std::vector<CopySetInfo> TopologyImpl::GetCopySetInfosInLogicalPool(
     PoolIdType logicalPoolId,
     CopySetFilter filter) const {
     std::vector<CopySetInfo> ret;
-    ReadLockGuard rlockCopySet(copySetMutex_);
-    for (auto it : copySetMap_) {
-        if (filter(it.second) && it.first.first == logicalPoolId) {
-            ret.push_back(it.second);
+    CopySetShardPtr shard = GetCopySetShard(logicalPoolId);
+    if (shard == nullptr) {
+        return ret;
+    }
+    for (const auto &c : *GetCopySetSnapshot(*shard)) {
+        if (filter(c)) {
+            ret.push_back(c);
         }
     }
     return ret;
@@ -1351,10 +1510,11 @@ std::vector<CopySetInfo> TopologyImpl::GetCopySetInfosInLogicalPool(
 std::vector<CopySetKey> TopologyImpl::GetCopySetsInCluster(
     CopySetFilter filter) const {
     std::vector<CopySetKey> ret;
-    ReadLockGuard rlockCopySet(copySetMutex_);
-    for (auto it : copySetMap_) {
-        if (filter(it.second)) {
-            ret.push_back(it.first);
+    for (const auto &shard : GetCopySetShards()) {
+        for (const auto &c : *GetCopySetSnapshot(*shard)) {
+            if (filter(c)) {
+                ret.emplace_back(c.GetLogicalPoolId(), c.GetId());
+            }
         }
     }
     return ret;
@@ -1364,10 +1524,11 @@ std::vector<CopySetKey> TopologyImpl::GetCopySetsInChunkServer(
     ChunkServerIdType id,
     CopySetFilter filter) const {
     std::vector<CopySetKey> ret;
-    ReadLockGuard rlockCopySet(copySetMutex_);
-    for (auto it : copySetMap_) {
-        if (filter(it.second) && it.second.GetCopySetMembers().count(id) > 0) {
-            ret.push_back(it.first);
+    for (const auto &shard : GetCopySetShards()) {
+        for (const auto &c : *GetCopySetSnapshot(*shard)) {
+            if (filter(c) && c.GetCopySetMembers().count(id) > 0) {
+                ret.emplace_back(c.GetLogicalPoolId(), c.GetId());
+            }
         }
     }
     return ret;
@@ -1400,20 +1561,24 @@ void TopologyImpl::BackEndFunc() {
 }
 
 void TopologyImpl::FlushCopySetToStorage() {
-    std::vector<PoolIdType> pools = GetLogicalPoolInCluster();
-    for (const auto poolId : pools) {
-        ReadLockGuard rlockCopySetMap(copySetMutex_);
-        for (auto &c : copySetMap_) {
+    for (const auto &shard : GetCopySetShards()) {
+        // keep the shard and copyset locks across the storage write, so a
+        // stale copy can not overwrite a concurrent RemoveCopySet or
+        // SetCopySetAvalFlag; other shards are not blocked meanwhile
+        ReadLockGuard rlockShard(shard->mutex);
+        LockHoldTimer timer(&copySetScanLockHold_);
+        for (auto &c : shard->copySets) {
             WriteLockGuard wlockCopySet(c.second.GetRWLockRef());
-            if (c.second.GetDirtyFlag() &&
-                        c.second.GetLogicalPoolId() == poolId) {
-                c.second.SetDirtyFlag(false);
-                if (!storage_->UpdateCopySet(c.second)) {
-                    LOG(WARNING) << "update copyset("
-                                 << c.second.GetLogicalPoolId()
-                                 << "," << c.second.GetId() << ") to repo fail";
-                }
+            if (!c.second.GetDirtyFlag()) {
+                continue;
+            }
+            if (!storage_->UpdateCopySet(c.second)) {
+                LOG(WARNING) << "update copyset("
+                             << c.second.GetLogicalPoolId()
+                             << "," << c.second.GetId() << ") to repo fail";
+                continue;
             }
+            c.second.SetDirtyFlag(false);
         }
     }
 }
@@ -22,6 +22,7 @@
 #ifndef SRC_MDS_TOPOLOGY_TOPOLOGY_H_
 #define SRC_MDS_TOPOLOGY_TOPOLOGY_H_
 
+#include <atomic>
 #include <unordered_map>
 #include <string>
 #include <list>
@@ -29,6 +30,8 @@
 #include <vector>
 #include <map>
 
+#include <bvar/bvar.h>
+
 #include "proto/topology.pb.h"
 #include "src/mds/common/mds_define.h"
 #include "src/mds/topology/topology_item.h"
@@ -389,12 +392,7 @@ class TopologyImpl : public Topology {
  public:
     TopologyImpl(std::shared_ptr<TopologyIdGenerator> idGenerator,
                  std::shared_ptr<TopologyTokenGenerator> tokenGenerator,
-                 std::shared_ptr<TopologyStorage> storage)
-        : idGenerator_(idGenerator),
-          tokenGenerator_(tokenGenerator),
-          storage_(storage),
-          isStop_(true) {
-    }
+                 std::shared_ptr<TopologyStorage> storage);
 
     ~TopologyImpl() {
         Stop();
@@ -686,6 +684,36 @@ class TopologyImpl : public Topology {
 
     void FlushChunkServerToStorage();
 
+    // copysets of a logical pool, guarded by its own lock
+    struct CopySetShard {
+        CopySetShard() : version(0), snapshotVersion(0) {}
+
+        mutable RWLock mutex;
+        std::map<CopySetKey, CopySetInfo> copySets;
+        // increased after any change of the copysets
+        std::atomic<uint64_t> version;
+
+        // immutable copy of the copysets for full scans, rebuilt
+        // lazily when the version changes
+        mutable curve::common::Mutex snapshotMutex;
+        mutable std::shared_ptr<const std::vector<CopySetInfo>> snapshot;
+        mutable uint64_t snapshotVersion;
+    };
+    using CopySetShardPtr = std::shared_ptr<CopySetShard>;
+    using CopySetSnapshot = std::shared_ptr<const std::vector<CopySetInfo>>;
+
+    CopySetShardPtr GetCopySetShard(PoolIdType logicalPoolId) const;
+
+    CopySetShardPtr GetOrCreateCopySetShard(PoolIdType logicalPoolId);
+
+    std::vector<CopySetShardPtr> GetCopySetShards() const;
+
+    /**
+     * @brief get the snapshot of copysets in a shard, the caller can scan it
+     *        without holding any lock
+     */
+    CopySetSnapshot GetCopySetSnapshot(const CopySetShard &shard) const;
+
     void SetChunkServerExternalIp();
 
     bool CreateDefaultPoolset();
@@ -698,7 +726,8 @@ class TopologyImpl : public Topology {
     std::unordered_map<ServerIdType, Server> serverMap_;
     std::unordered_map<ChunkServerIdType, ChunkServer> chunkServerMap_;
 
-    std::map<CopySetKey, CopySetInfo> copySetMap_;
+    // copysets sharded by logical pool
+    std::map<PoolIdType, CopySetShardPtr> copySetShards_;
 
     // cluster info
     ClusterInformation clusterInfo;
@@ -714,8 +743,14 @@ class TopologyImpl : public Topology {
     mutable curve::common::RWLock zoneMutex_;
     mutable curve::common::RWLock serverMutex_;
     mutable curve::common::RWLock chunkServerMutex_;
+    // guards copySetShards_ only, then the lock of a shard and the lock of
+    // a copyset in it are fetched
     mutable curve::common::RWLock copySetMutex_;
 
+    // how long the copyset shard locks are held by writers and scans
+    mutable bvar::LatencyRecorder copySetWriteLockHold_;
+    mutable bvar::LatencyRecorder copySetScanLockHold_;
+
     TopologyOption option_;
     curve::common::Thread backEndThread_;
     curve::common::Atomic<bool> isStop_;
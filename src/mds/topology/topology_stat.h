@@ -54,6 +54,9 @@ struct CopysetStat {
     uint32_t readIOPS;
     // Writing IOPS
     uint32_t writeIOPS;
+    // Kept from an earlier heartbeat, the latest (delta) heartbeat
+    // didn't report the copyset, so the I/O statistics are stale
+    bool carried;
     CopysetStat() :
         logicalPoolId(UNINTIALIZE_ID),
         copysetId(UNINTIALIZE_ID),
@@ -61,7 +64,8 @@ struct CopysetStat {
         readRate(0),
         writeRate(0),
         readIOPS(0),
-        writeIOPS(0) {}
+        writeIOPS(0),
+        carried(false) {}
 };
 
 struct ChunkServerStat {
@@ -147,6 +147,21 @@ void SnapShotCloneServer::InitAllSnapshotCloneOptions(void) {
     conf_->GetValueFatalIfFail("etcd.retry.times",
         &(snapshotCloneServerOptions_.etcdRetryTimes));
 
+    if (!conf_->GetUInt32Value("etcd.batch.maxOps",
+        &(snapshotCloneServerOptions_.etcdBatchOption.maxBatchOps))) {
+        LOG(WARNING) << "Not found etcd.batch.maxOps in conf"
+                     << ", use default value "
+                     << snapshotCloneServerOptions_.etcdBatchOption.maxBatchOps;
+    }
+
+    if (!conf_->GetUInt32Value("etcd.batch.windowUs",
+        &(snapshotCloneServerOptions_.etcdBatchOption.batchWindowUs))) {
+        LOG(WARNING) << "Not found etcd.batch.windowUs in conf"
+                     << ", use default value "
+                     << snapshotCloneServerOptions_.etcdBatchOption
+                            .batchWindowUs;
+    }
+
     conf_->GetValueFatalIfFail("server.dummy.listen.port",
         &(snapshotCloneServerOptions_.dummyPort));
 
@@ -215,6 +230,10 @@ bool SnapShotCloneServer::InitEtcdClient(void) {
             snapshotCloneServerOptions_.etcdClientTimeout
         << ", etcd retrytimes: " <<
             snapshotCloneServerOptions_.etcdRetryTimes;
+
+    kvStorageClient_ = std::make_shared<BatchKVStorageClient>(etcdClient_,
+        snapshotCloneServerOptions_.etcdBatchOption,
+        "snapshotcloneserver_etcd_client");
     return true;
 }
 
@@ -252,8 +271,8 @@ bool SnapShotCloneServer::Init() {
     }
     auto codec = std::make_shared<SnapshotCloneCodec>();
 
-    metaStore_ = std::make_shared<SnapshotCloneMetaStoreEtcd>(etcdClient_,
-        codec);
+    metaStore_ = std::make_shared<SnapshotCloneMetaStoreEtcd>(
+        kvStorageClient_, codec);
     if (metaStore_->Init() < 0) {
         LOG(ERROR) << "metaStore init fail.";
         return false;
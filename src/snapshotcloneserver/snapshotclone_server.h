@@ -46,6 +46,7 @@
 #include "src/snapshotcloneserver/snapshot/snapshot_service_manager.h"
 #include "src/snapshotcloneserver/clone/clone_service_manager.h"
 #include "src/snapshotcloneserver/common/snapshotclone_meta_store_etcd.h"
+#include "src/kvstorageclient/batch_kvstorage_client.h"
 
 namespace curve {
 namespace snapshotcloneserver {
@@ -58,6 +59,9 @@ extern const char STANDBY[];
 
 
 using EtcdClientImp = ::curve::kvstorage::EtcdClientImp;
+using BatchKVStorageClient = ::curve::kvstorage::BatchKVStorageClient;
+using BatchKVStorageClientOption =
+    ::curve::kvstorage::BatchKVStorageClientOption;
 using Configuration = ::curve::common::Configuration;
 using LeaderElection = ::curve::election::LeaderElection;
 
@@ -69,6 +73,8 @@ struct SnapShotCloneServerOptions {
     EtcdConf etcdConf;
     int etcdClientTimeout;
     int etcdRetryTimes;
+    // group commit of etcd writes
+    BatchKVStorageClientOption etcdBatchOption;
 
     // leaderelections options
     std::string campaginPrefix;
@@ -132,6 +138,8 @@ class SnapShotCloneServer {
     bvar::Status<std::string> status_;
     // 与etcd交互的client
     std::shared_ptr<EtcdClientImp> etcdClient_;
+    // 合并并发写请求的etcd client，用于元数据存储
+    std::shared_ptr<KVStorageClient> kvStorageClient_;
     std::shared_ptr<LeaderElection> leaderElection_;
 
     std::shared_ptr<SnapshotClient> snapClient_;
@@ -33,6 +33,7 @@
 #include "test/chunkserver/mock_copyset_node.h"
 #include "test/chunkserver/clone/clone_test_util.h"
 #include "test/chunkserver/clone/mock_clone_copyer.h"
+#include "test/chunkserver/clone/mock_clone_prefetcher.h"
 #include "test/chunkserver/datastore/mock_datastore.h"
 #include "src/fs/local_filesystem.h"
 
@@ -774,6 +775,201 @@ TEST_P(CloneCoreTest, DisablePasteTest) {
     }
 }
 
+/**
+ * 测试clone chunk的后台预取
+ * case1:read请求读到未拷贝的区域
+ * result1:提交该chunk的预取任务
+ * case2:read请求读取的区域全部被写过
+ * result2:不会提交预取任务
+ * case3:recover请求需要从源端拷贝数据并产生paste请求
+ * result3:不会提交预取任务
+ * case4:未配置prefetcher
+ * result4:read请求正常从源端读取数据
+ */
+TEST_P(CloneCoreTest, PrefetchTest) {
+    off_t offset = 0;
+    size_t length = 5 * blocksize_;
+    CSChunkInfo info;
+    info.isClone = true;
+    info.metaPageSize = pagesize_;
+    info.chunkSize = chunksize_;
+    info.blockSize = blocksize_;
+    info.location = "test@cs";
+    info.bitmap = std::make_shared<Bitmap>(chunksize_ / blocksize_);
+    auto prefetcher = std::make_shared<MockClonePrefetcher>();
+    std::shared_ptr<CloneCore> core
+        = std::make_shared<CloneCore>(SLICE_SIZE, false, copyer_, prefetcher);
+    char *cloneData = new char[length];
+    memset(cloneData, 'b', length);
+    auto fakeDownload = [&](DownloadClosure *closure) {
+        brpc::ClosureGuard guard(closure);
+        AsyncDownloadContext *context = closure->GetDownloadContext();
+        memcpy(context->buf, cloneData, length);
+    };
+
+    // case1
+    {
+        info.bitmap->Clear();
+        // 每次调HandleReadRequest后会被closure释放
+        std::shared_ptr<ReadChunkRequest> readRequest =
+            GenerateReadRequest(CHUNK_OP_TYPE::CHUNK_OP_READ, offset, length);
+        EXPECT_CALL(*prefetcher, Prefetch(_, _, _))
+            .WillOnce(Invoke([&](std::shared_ptr<CopysetNode> node,
+                                 const ChunkRequest &request,
+                                 const std::string &location) {
+                EXPECT_EQ(node_.get(), node.get());
+                EXPECT_EQ(LOGICPOOL_ID, request.logicpoolid());
+                EXPECT_EQ(COPYSET_ID, request.copysetid());
+                EXPECT_EQ(CHUNK_ID, request.chunkid());
+                EXPECT_EQ(info.location, location);
+                return true;
+            }));
+        EXPECT_CALL(*prefetcher, JoinInflight(_)).WillOnce(Return(false));
+        EXPECT_CALL(*copyer_, DownloadAsync(_)).WillOnce(Invoke(fakeDownload));
+        EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+            .Times(2)
+            .WillRepeatedly(
+                DoAll(SetArgPointee<1>(info), Return(CSErrorCode::Success)));
+        EXPECT_CALL(*node_, UpdateAppliedIndex(_)).Times(1);
+        EXPECT_CALL(*node_, Propose(_)).Times(0);
+
+        ASSERT_EQ(0,
+                  core->HandleReadRequest(readRequest, readRequest->Closure()));
+        FakeChunkClosure *closure =
+            reinterpret_cast<FakeChunkClosure *>(readRequest->Closure());
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  closure->resContent_.status);
+        Mock::VerifyAndClearExpectations(prefetcher.get());
+    }
+
+    // case2
+    {
+        info.bitmap->Set();
+        // 每次调HandleReadRequest后会被closure释放
+        std::shared_ptr<ReadChunkRequest> readRequest =
+            GenerateReadRequest(CHUNK_OP_TYPE::CHUNK_OP_READ, offset, length);
+        EXPECT_CALL(*prefetcher, Prefetch(_, _, _)).Times(0);
+        EXPECT_CALL(*copyer_, DownloadAsync(_)).Times(0);
+        EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+            .WillOnce(
+                DoAll(SetArgPointee<1>(info), Return(CSErrorCode::Success)));
+        EXPECT_CALL(*datastore_, ReadChunk(_, _, _, offset, length))
+            .WillOnce(Return(CSErrorCode::Success));
+        EXPECT_CALL(*node_, UpdateAppliedIndex(_)).Times(1);
+
+        ASSERT_EQ(0,
+                  core->HandleReadRequest(readRequest, readRequest->Closure()));
+        FakeChunkClosure *closure =
+            reinterpret_cast<FakeChunkClosure *>(readRequest->Closure());
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  closure->resContent_.status);
+        Mock::VerifyAndClearExpectations(prefetcher.get());
+    }
+
+    // case3
+    {
+        info.bitmap->Clear();
+        // 每次调HandleReadRequest后会被closure释放
+        std::shared_ptr<ReadChunkRequest> readRequest = GenerateReadRequest(
+            CHUNK_OP_TYPE::CHUNK_OP_RECOVER, offset, length);  // NOLINT
+        EXPECT_CALL(*prefetcher, Prefetch(_, _, _)).Times(0);
+        EXPECT_CALL(*prefetcher, JoinInflight(_)).WillOnce(Return(false));
+        EXPECT_CALL(*copyer_, DownloadAsync(_)).WillOnce(Invoke(fakeDownload));
+        EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+            .WillOnce(
+                DoAll(SetArgPointee<1>(info), Return(CSErrorCode::Success)));
+        // 产生PasteChunkRequest
+        braft::Task task;
+        butil::IOBuf iobuf;
+        task.data = &iobuf;
+        EXPECT_CALL(*node_, Propose(_)).WillOnce(SaveBraftTask<0>(&task));
+
+        ASSERT_EQ(0,
+                  core->HandleReadRequest(readRequest, readRequest->Closure()));
+        FakeChunkClosure *closure =
+            reinterpret_cast<FakeChunkClosure *>(readRequest->Closure());
+        ASSERT_FALSE(closure->isDone_);
+        CheckTask(task, offset, length, cloneData);
+        ASSERT_NE(nullptr, task.done);
+        task.done->Run();
+        ASSERT_TRUE(closure->isDone_);
+        Mock::VerifyAndClearExpectations(prefetcher.get());
+    }
+
+    // case4 相同的源数据正在被预取，等待预取的下载结果，不再自己下载
+    {
+        info.bitmap->Clear();
+        // 每次调HandleReadRequest后会被closure释放
+        std::shared_ptr<ReadChunkRequest> readRequest =
+            GenerateReadRequest(CHUNK_OP_TYPE::CHUNK_OP_READ, offset, length);
+        DownloadClosure* waiter = nullptr;
+        EXPECT_CALL(*prefetcher, Prefetch(_, _, _)).WillOnce(Return(true));
+        EXPECT_CALL(*prefetcher, JoinInflight(_))
+            .WillOnce(DoAll(SaveArg<0>(&waiter), Return(true)));
+        EXPECT_CALL(*copyer_, DownloadAsync(_)).Times(0);
+        EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+            .Times(2)
+            .WillRepeatedly(
+                DoAll(SetArgPointee<1>(info), Return(CSErrorCode::Success)));
+        EXPECT_CALL(*node_, UpdateAppliedIndex(_)).Times(1);
+        EXPECT_CALL(*node_, Propose(_)).Times(0);
+
+        ASSERT_EQ(0,
+                  core->HandleReadRequest(readRequest, readRequest->Closure()));
+        FakeChunkClosure *closure =
+            reinterpret_cast<FakeChunkClosure *>(readRequest->Closure());
+        ASSERT_FALSE(closure->isDone_);
+        // 预取的下载完成后执行等待的请求
+        ASSERT_NE(nullptr, waiter);
+        fakeDownload(waiter);
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  closure->resContent_.status);
+        ASSERT_EQ(
+            memcmp(
+                cloneData,
+                closure->resContent_.attachment.to_string().c_str(),  // NOLINT
+                length),
+            0);
+        Mock::VerifyAndClearExpectations(prefetcher.get());
+    }
+
+    // case5
+    {
+        core = std::make_shared<CloneCore>(SLICE_SIZE, false, copyer_,
+                                           nullptr);
+        info.bitmap->Clear();
+        // 每次调HandleReadRequest后会被closure释放
+        std::shared_ptr<ReadChunkRequest> readRequest =
+            GenerateReadRequest(CHUNK_OP_TYPE::CHUNK_OP_READ, offset, length);
+        EXPECT_CALL(*prefetcher, Prefetch(_, _, _)).Times(0);
+        EXPECT_CALL(*copyer_, DownloadAsync(_)).WillOnce(Invoke(fakeDownload));
+        EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+            .Times(2)
+            .WillRepeatedly(
+                DoAll(SetArgPointee<1>(info), Return(CSErrorCode::Success)));
+        EXPECT_CALL(*node_, UpdateAppliedIndex(_)).Times(1);
+        EXPECT_CALL(*node_, Propose(_)).Times(0);
+
+        ASSERT_EQ(0,
+                  core->HandleReadRequest(readRequest, readRequest->Closure()));
+        FakeChunkClosure *closure =
+            reinterpret_cast<FakeChunkClosure *>(readRequest->Closure());
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  closure->resContent_.status);
+        ASSERT_EQ(
+            memcmp(
+                cloneData,
+                closure->resContent_.attachment.to_string().c_str(),  // NOLINT
+                length),
+            0);
+    }
+    delete[] cloneData;
+}
+
 INSTANTIATE_TEST_CASE_P(
     CloneCoreTest,
     CloneCoreTest,
@@ -0,0 +1,428 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-28
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "src/chunkserver/clone_prefetcher.h"
+#include "src/chunkserver/chunk_closure.h"
+#include "src/chunkserver/op_request.h"
+#include "src/common/bitmap.h"
+#include "src/common/concurrent/count_down_event.h"
+#include "test/chunkserver/mock_copyset_node.h"
+#include "test/chunkserver/clone/clone_test_util.h"
+#include "test/chunkserver/clone/mock_clone_copyer.h"
+#include "test/chunkserver/datastore/mock_datastore.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::common::Bitmap;
+using curve::common::CountDownEvent;
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Invoke;
+using ::testing::Return;
+
+const uint32_t kBlockSize = 4096;
+const uint32_t kPrefetchSize = 4 * kBlockSize;
+const uint32_t kChunkSize = 4 * kPrefetchSize;
+
+// 记录下载结果并通知等待者
+class FakeDownloadClosure : public DownloadClosure {
+ public:
+    explicit FakeDownloadClosure(AsyncDownloadContext* downloadCtx)
+        : DownloadClosure(nullptr, nullptr, downloadCtx, nullptr)
+        , event_(1) {}
+
+    void Run() override {
+        event_.Signal();
+    }
+
+    void Wait() {
+        event_.Wait();
+    }
+
+    bool IsFailed() const {
+        return isFailed_;
+    }
+
+ private:
+    CountDownEvent event_;
+};
+
+class ClonePrefetcherTest : public testing::Test {
+ public:
+    void SetUp() {
+        datastore_ = std::make_shared<MockDataStore>();
+        copyer_ = std::make_shared<MockChunkCopyer>();
+        node_ = std::make_shared<MockCopysetNode>();
+        bitmap_ = std::make_shared<Bitmap>(kChunkSize / kBlockSize);
+
+        EXPECT_CALL(*node_, GetDataStore()).WillRepeatedly(Return(datastore_));
+        EXPECT_CALL(*node_, GetConcurrentApplyModule())
+            .WillRepeatedly(Return(nullptr));
+        EXPECT_CALL(*node_, GetAppliedIndex())
+            .WillRepeatedly(Return(LAST_INDEX));
+        EXPECT_CALL(*node_, UpdateAppliedIndex(_)).Times(AnyNumber());
+
+        ClonePrefetchOptions options;
+        options.prefetchSize = kPrefetchSize;
+        options.threadNum = 1;
+        options.queueCapacity = 10;
+        options.bandwidthBps = 0;
+        prefetcher_ = std::make_shared<ClonePrefetcher>();
+        ASSERT_EQ(0, prefetcher_->Init(options, copyer_));
+    }
+
+    void TearDown() {
+        prefetcher_->Fini();
+    }
+
+    ChunkRequest GenerateRequest() {
+        ChunkRequest request;
+        request.set_logicpoolid(1);
+        request.set_copysetid(1);
+        request.set_chunkid(1);
+        request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_READ);
+        return request;
+    }
+
+    // GetChunkInfo返回当前的bitmap
+    void FakeGetChunkInfo() {
+        EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+            .WillRepeatedly(Invoke([this](ChunkID id, CSChunkInfo* info) {
+                std::lock_guard<std::mutex> lock(mtx_);
+                info->chunkId = id;
+                info->chunkSize = kChunkSize;
+                info->blockSize = kBlockSize;
+                info->isClone = true;
+                info->location = "test@cs";
+                info->bitmap = std::make_shared<Bitmap>(*bitmap_);
+                return CSErrorCode::Success;
+            }));
+    }
+
+    // 下载成功并记录每次下载的区域
+    void FakeDownload() {
+        EXPECT_CALL(*copyer_, DownloadAsync(_))
+            .WillRepeatedly(Invoke([this](DownloadClosure* closure) {
+                AsyncDownloadContext* context =
+                    closure->GetDownloadContext();
+                memset(context->buf, 'a', context->size);
+                {
+                    std::lock_guard<std::mutex> lock(mtx_);
+                    downloads_.emplace_back(context->offset, context->size);
+                }
+                closure->Run();
+            }));
+    }
+
+    // 直接apply paste请求，paste成功后更新bitmap,
+    // chunk全部拷贝完时通知done
+    void FakePaste(CountDownEvent* done) {
+        EXPECT_CALL(*datastore_, PasteChunk(_, _, _, _))
+            .WillRepeatedly(Invoke([this, done](ChunkID, const char*,
+                                                off_t offset, size_t length) {
+                std::lock_guard<std::mutex> lock(mtx_);
+                bitmap_->Set(offset / kBlockSize,
+                             (offset + length) / kBlockSize - 1);
+                if (bitmap_->NextClearBit(0, kChunkSize / kBlockSize - 1)
+                    == Bitmap::NO_POS) {
+                    done->Signal();
+                }
+                return CSErrorCode::Success;
+            }));
+        EXPECT_CALL(*node_, Propose(_))
+            .WillRepeatedly(Invoke([](const braft::Task& task) {
+                ChunkClosure* closure =
+                    dynamic_cast<ChunkClosure*>(task.done);
+                closure->request_->OnApply(LAST_INDEX + 1, closure);
+            }));
+    }
+
+ protected:
+    std::shared_ptr<MockDataStore> datastore_;
+    std::shared_ptr<MockCopysetNode> node_;
+    std::shared_ptr<MockChunkCopyer> copyer_;
+    std::shared_ptr<ClonePrefetcher> prefetcher_;
+    std::mutex mtx_;
+    std::shared_ptr<Bitmap> bitmap_;
+    // 每次下载的(offset, size)
+    std::vector<std::pair<off_t, size_t>> downloads_;
+};
+
+TEST_F(ClonePrefetcherTest, FillUncopiedPieces) {
+    // 第一段已经拷贝过，第二段拷贝了部分block
+    bitmap_->Set(0, 3);
+    bitmap_->Set(5);
+
+    CountDownEvent done(1);
+    EXPECT_CALL(*node_, IsLeaderTerm()).WillRepeatedly(Return(true));
+    FakeGetChunkInfo();
+    FakeDownload();
+    FakePaste(&done);
+
+    // 未启动时不接受预取请求
+    ASSERT_FALSE(prefetcher_->Prefetch(node_, GenerateRequest(), "test@cs"));
+
+    ASSERT_EQ(0, prefetcher_->Run());
+    ASSERT_TRUE(prefetcher_->Prefetch(node_, GenerateRequest(), "test@cs"));
+    done.Wait();
+    ASSERT_EQ(0, prefetcher_->Fini());
+
+    // 只下载分段中未拷贝过的区域，已拷贝过的block不会重复下载
+    std::vector<std::pair<off_t, size_t>> expected{
+        {kPrefetchSize, kBlockSize},
+        {kPrefetchSize + 2 * kBlockSize, 2 * kBlockSize},
+        {2 * kPrefetchSize, kPrefetchSize},
+        {3 * kPrefetchSize, kPrefetchSize}};
+    ASSERT_EQ(expected, downloads_);
+}
+
+TEST_F(ClonePrefetcherTest, StopWhenDownloadFailed) {
+    EXPECT_CALL(*node_, IsLeaderTerm()).WillRepeatedly(Return(true));
+    FakeGetChunkInfo();
+    EXPECT_CALL(*node_, Propose(_)).Times(0);
+
+    CountDownEvent failed(1);
+    EXPECT_CALL(*copyer_, DownloadAsync(_))
+        .WillOnce(Invoke([&failed](DownloadClosure* closure) {
+            closure->SetFailed();
+            closure->Run();
+            failed.Signal();
+        }));
+
+    ASSERT_EQ(0, prefetcher_->Run());
+    ASSERT_TRUE(prefetcher_->Prefetch(node_, GenerateRequest(), "test@cs"));
+    failed.Wait();
+    ASSERT_EQ(0, prefetcher_->Fini());
+}
+
+TEST_F(ClonePrefetcherTest, OnlyPrefetchOnLeader) {
+    CountDownEvent leaderChecked(1);
+    EXPECT_CALL(*node_, IsLeaderTerm())
+        .WillOnce(Invoke([&leaderChecked]() {
+            leaderChecked.Signal();
+            return false;
+        }));
+    EXPECT_CALL(*datastore_, GetChunkInfo(_, _)).Times(0);
+    EXPECT_CALL(*copyer_, DownloadAsync(_)).Times(0);
+
+    ASSERT_EQ(0, prefetcher_->Run());
+    ASSERT_TRUE(prefetcher_->Prefetch(node_, GenerateRequest(), "test@cs"));
+    leaderChecked.Wait();
+    ASSERT_EQ(0, prefetcher_->Fini());
+}
+
+TEST_F(ClonePrefetcherTest, OnePrefetchPerChunk) {
+    // 第一个预取任务阻塞在下载上，同一个chunk的预取请求会被拒绝
+    CountDownEvent done(1);
+    EXPECT_CALL(*node_, IsLeaderTerm()).WillRepeatedly(Return(true));
+    FakeGetChunkInfo();
+    FakePaste(&done);
+
+    CountDownEvent downloading(1);
+    CountDownEvent release(1);
+    EXPECT_CALL(*copyer_, DownloadAsync(_))
+        .WillRepeatedly(Invoke([&](DownloadClosure* closure) {
+            downloading.Signal();
+            release.Wait();
+            closure->Run();
+        }));
+
+    ASSERT_EQ(0, prefetcher_->Run());
+    ChunkRequest request = GenerateRequest();
+    ASSERT_TRUE(prefetcher_->Prefetch(node_, request, "test@cs"));
+    downloading.Wait();
+    ASSERT_FALSE(prefetcher_->Prefetch(node_, request, "test@cs"));
+
+    // 其他chunk不受影响
+    request.set_chunkid(2);
+    ASSERT_TRUE(prefetcher_->Prefetch(node_, request, "test@cs"));
+
+    release.Signal();
+    done.Wait();
+    ASSERT_EQ(0, prefetcher_->Fini());
+}
+
+TEST_F(ClonePrefetcherTest, JoinInflightDownload) {
+    ClonePrefetchOptions options;
+    options.prefetchSize = kPrefetchSize;
+    options.threadNum = 2;
+    options.queueCapacity = 10;
+    options.bandwidthBps = 0;
+    prefetcher_ = std::make_shared<ClonePrefetcher>();
+    ASSERT_EQ(0, prefetcher_->Init(options, copyer_));
+
+    // 只有第一段没有拷贝过，预取阻塞在第一段的下载上
+    bitmap_->Set(4, kChunkSize / kBlockSize - 1);
+    CountDownEvent done(1);
+    EXPECT_CALL(*node_, IsLeaderTerm()).WillRepeatedly(Return(true));
+    FakeGetChunkInfo();
+    FakePaste(&done);
+
+    CountDownEvent downloading(1);
+    CountDownEvent release(1);
+    EXPECT_CALL(*copyer_, DownloadAsync(_))
+        .WillRepeatedly(Invoke([&](DownloadClosure* closure) {
+            AsyncDownloadContext* context = closure->GetDownloadContext();
+            memset(context->buf, 'a', context->size);
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                downloads_.emplace_back(context->offset, context->size);
+            }
+            downloading.Signal();
+            release.Wait();
+            closure->Run();
+        }));
+
+    ASSERT_EQ(0, prefetcher_->Run());
+    ChunkRequest request = GenerateRequest();
+    ASSERT_TRUE(prefetcher_->Prefetch(node_, request, "test@cs"));
+    downloading.Wait();
+
+    // 读取的区域包含在正在下载的区域中，等待其完成
+    char readBuf[kBlockSize];
+    memset(readBuf, 0, kBlockSize);
+    AsyncDownloadContext readCtx;
+    readCtx.location = "test@cs";
+    readCtx.offset = kBlockSize;
+    readCtx.size = kBlockSize;
+    readCtx.buf = readBuf;
+    FakeDownloadClosure reader(&readCtx);
+    ASSERT_TRUE(prefetcher_->JoinInflight(&reader));
+
+    // 源chunk不同或超出正在下载的区域时需要自己下载
+    char otherBuf[kBlockSize];
+    AsyncDownloadContext otherCtx;
+    otherCtx.location = "other@cs";
+    otherCtx.offset = kBlockSize;
+    otherCtx.size = kBlockSize;
+    otherCtx.buf = otherBuf;
+    FakeDownloadClosure other(&otherCtx);
+    ASSERT_FALSE(prefetcher_->JoinInflight(&other));
+    otherCtx.location = "test@cs";
+    otherCtx.offset = kPrefetchSize - kBlockSize;
+    otherCtx.size = 2 * kBlockSize;
+    ASSERT_FALSE(prefetcher_->JoinInflight(&other));
+
+    release.Signal();
+    reader.Wait();
+    ASSERT_FALSE(reader.IsFailed());
+    for (uint32_t i = 0; i < kBlockSize; ++i) {
+        ASSERT_EQ('a', readBuf[i]);
+    }
+    done.Wait();
+    ASSERT_EQ(0, prefetcher_->Fini());
+
+    // 只从源端下载了一次
+    std::vector<std::pair<off_t, size_t>> expected{{0, kPrefetchSize}};
+    ASSERT_EQ(expected, downloads_);
+}
+
+TEST_F(ClonePrefetcherTest, PrefetchJoinOtherChunk) {
+    ClonePrefetchOptions options;
+    options.prefetchSize = kPrefetchSize;
+    options.threadNum = 2;
+    options.queueCapacity = 10;
+    options.bandwidthBps = 0;
+    prefetcher_ = std::make_shared<ClonePrefetcher>();
+    ASSERT_EQ(0, prefetcher_->Init(options, copyer_));
+
+    // 两个chunk克隆自同一个源chunk，都只有第一段没有拷贝过
+    bitmap_->Set(4, kChunkSize / kBlockSize - 1);
+    EXPECT_CALL(*node_, IsLeaderTerm()).WillRepeatedly(Return(true));
+    CountDownEvent secondChecked(1);
+    EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+        .WillRepeatedly(Invoke([&](ChunkID id, CSChunkInfo* info) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            info->chunkId = id;
+            info->chunkSize = kChunkSize;
+            info->blockSize = kBlockSize;
+            info->isClone = true;
+            info->location = "test@cs";
+            info->bitmap = std::make_shared<Bitmap>(*bitmap_);
+            if (id == 2) {
+                secondChecked.Signal();
+            }
+            return CSErrorCode::Success;
+        }));
+    CountDownEvent pasted(2);
+    EXPECT_CALL(*datastore_, PasteChunk(_, _, 0, kPrefetchSize))
+        .Times(2)
+        .WillRepeatedly(Invoke([&](ChunkID, const char*, off_t, size_t) {
+            pasted.Signal();
+            return CSErrorCode::Success;
+        }));
+    EXPECT_CALL(*node_, Propose(_))
+        .WillRepeatedly(Invoke([](const braft::Task& task) {
+            ChunkClosure* closure =
+                dynamic_cast<ChunkClosure*>(task.done);
+            closure->request_->OnApply(LAST_INDEX + 1, closure);
+        }));
+
+    // 第一个chunk的下载阻塞到第二个chunk开始预取之后
+    CountDownEvent downloading(1);
+    CountDownEvent release(1);
+    EXPECT_CALL(*copyer_, DownloadAsync(_))
+        .WillOnce(Invoke([&](DownloadClosure* closure) {
+            memset(closure->GetDownloadContext()->buf, 'a',
+                   closure->GetDownloadContext()->size);
+            downloading.Signal();
+            release.Wait();
+            closure->Run();
+        }));
+
+    ASSERT_EQ(0, prefetcher_->Run());
+    ChunkRequest request = GenerateRequest();
+    ASSERT_TRUE(prefetcher_->Prefetch(node_, request, "test@cs"));
+    downloading.Wait();
+    request.set_chunkid(2);
+    ASSERT_TRUE(prefetcher_->Prefetch(node_, request, "test@cs"));
+    secondChecked.Wait();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    release.Signal();
+
+    // 两个chunk都完成了paste，源端只下载了一次
+    pasted.Wait();
+    ASSERT_EQ(0, prefetcher_->Fini());
+}
+
+TEST_F(ClonePrefetcherTest, InvalidOptions) {
+    ClonePrefetcher prefetcher;
+    ClonePrefetchOptions options;
+    options.prefetchSize = 0;
+    ASSERT_EQ(-1, prefetcher.Init(options, copyer_));
+    options.prefetchSize = kPrefetchSize;
+    ASSERT_EQ(-1, prefetcher.Init(options, nullptr));
+    ASSERT_EQ(0, prefetcher.Init(options, copyer_));
+}
+
+}  // namespace chunkserver
+}  // namespace curve
@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-07-12
+ */
+
+#ifndef TEST_CHUNKSERVER_CLONE_MOCK_CLONE_PREFETCHER_H_
+#define TEST_CHUNKSERVER_CLONE_MOCK_CLONE_PREFETCHER_H_
+
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+
+#include "src/chunkserver/clone_prefetcher.h"
+
+namespace curve {
+namespace chunkserver {
+
+class MockClonePrefetcher : public ClonePrefetcher {
+ public:
+    MockClonePrefetcher() = default;
+    ~MockClonePrefetcher() = default;
+    MOCK_METHOD3(Prefetch, bool(std::shared_ptr<CopysetNode>,
+                                const ChunkRequest&,
+                                const std::string&));
+    MOCK_METHOD1(JoinInflight, bool(DownloadClosure*));
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // TEST_CHUNKSERVER_CLONE_MOCK_CLONE_PREFETCHER_H_
@@ -208,6 +208,154 @@ TEST(HeartbeatHelperTest, test_ChunkServerLoadCopySetFin) {
     delete copysetNodeManager;
 }
 
+namespace {
+CopySetInfo BuildCopySetInfo(CopysetID copysetId, uint64_t epoch) {
+    CopySetInfo info;
+    info.set_logicalpoolid(1);
+    info.set_copysetid(copysetId);
+    info.set_epoch(epoch);
+    info.mutable_leaderpeer()->set_address("127.0.0.1:8200:0");
+    for (int i = 0; i < 3; i++) {
+        info.add_peers()->set_address(
+            "127.0.0.1:" + std::to_string(8200 + i) + ":0");
+    }
+    info.set_scaning(false);
+    info.set_lastscansec(0);
+    return info;
+}
+
+void CommitOK(CopysetReportTracker *tracker, bool isDelta,
+              bool needFullReport = false) {
+    ChunkServerHeartbeatRequest request;
+    request.set_isdelta(isDelta);
+    ChunkServerHeartbeatResponse response;
+    response.set_statuscode(::curve::mds::heartbeat::hbOK);
+    response.set_needfullreport(needFullReport);
+    tracker->Commit(request, response);
+}
+}  // namespace
+
+TEST(CopysetReportTrackerTest, test_ReportChangedCopysetOnly) {
+    CopysetReportTracker tracker;
+    tracker.Init(10);
+
+    // 1. 第一次心跳全量上报
+    ASSERT_TRUE(tracker.BeginReport());
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 1)));
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 2), BuildCopySetInfo(2, 1)));
+    CommitOK(&tracker, false);
+
+    // 2. 增量心跳只上报状态有变化的copyset
+    ASSERT_FALSE(tracker.BeginReport());
+    ASSERT_FALSE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 1)));
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 2), BuildCopySetInfo(2, 2)));
+    // 新增的copyset需要上报
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 3), BuildCopySetInfo(3, 1)));
+    CommitOK(&tracker, true);
+
+    // 3. 已上报的变化不再上报, leader变化、配置变更和scan结果需要上报
+    ASSERT_FALSE(tracker.BeginReport());
+    ASSERT_FALSE(tracker.AddCopyset(ToGroupNid(1, 2), BuildCopySetInfo(2, 2)));
+    ASSERT_FALSE(tracker.AddCopyset(ToGroupNid(1, 3), BuildCopySetInfo(3, 1)));
+    CopySetInfo info = BuildCopySetInfo(1, 1);
+    info.mutable_leaderpeer()->set_address("127.0.0.1:8201:0");
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1), info));
+    info = BuildCopySetInfo(2, 2);
+    info.mutable_configchangeinfo()->mutable_peer()->set_address(
+        "127.0.0.1:8203:0");
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 2), info));
+    info = BuildCopySetInfo(3, 1);
+    info.add_scanmap();
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 3), info));
+}
+
+TEST(CopysetReportTrackerTest, test_FullReportInterval) {
+    // 0或1每次心跳都全量上报
+    for (uint32_t interval : {0, 1}) {
+        CopysetReportTracker tracker;
+        tracker.Init(interval);
+        for (int i = 0; i < 3; i++) {
+            ASSERT_TRUE(tracker.BeginReport());
+            ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1),
+                                           BuildCopySetInfo(1, 1)));
+            CommitOK(&tracker, false);
+        }
+    }
+
+    // 每3次心跳全量上报一次
+    CopysetReportTracker tracker;
+    tracker.Init(3);
+    for (int i = 0; i < 6; i++) {
+        bool full = tracker.BeginReport();
+        ASSERT_EQ(i % 3 == 0, full);
+        ASSERT_EQ(full, tracker.AddCopyset(ToGroupNid(1, 1),
+                                           BuildCopySetInfo(1, 1)));
+        CommitOK(&tracker, !full);
+    }
+}
+
+TEST(CopysetReportTrackerTest, test_CommitAfterFailedSend) {
+    CopysetReportTracker tracker;
+    tracker.Init(10);
+    ASSERT_TRUE(tracker.BeginReport());
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 1)));
+    CommitOK(&tracker, false);
+
+    // 1. 心跳发送失败时不commit, 下次心跳仍然上报上次未送达的变化
+    ASSERT_FALSE(tracker.BeginReport());
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 2)));
+    ASSERT_FALSE(tracker.BeginReport());
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 2)));
+    CommitOK(&tracker, true);
+    ASSERT_FALSE(tracker.BeginReport());
+    ASSERT_FALSE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 2)));
+
+    // 2. mds返回错误时下次心跳全量上报
+    ChunkServerHeartbeatRequest request;
+    request.set_isdelta(true);
+    ChunkServerHeartbeatResponse response;
+    response.set_statuscode(::curve::mds::heartbeat::hbChunkserverUnknown);
+    tracker.Commit(request, response);
+    ASSERT_TRUE(tracker.BeginReport());
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 2)));
+    CommitOK(&tracker, false);
+
+    // 3. mds下发了配置的copyset下次心跳继续上报
+    ASSERT_FALSE(tracker.BeginReport());
+    ASSERT_FALSE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 2)));
+    response.Clear();
+    response.set_statuscode(::curve::mds::heartbeat::hbOK);
+    CopySetConf *conf = response.add_needupdatecopysets();
+    conf->set_logicalpoolid(1);
+    conf->set_copysetid(1);
+    conf->set_epoch(2);
+    tracker.Commit(request, response);
+    ASSERT_FALSE(tracker.BeginReport());
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 2)));
+}
+
+TEST(CopysetReportTrackerTest, test_MdsRequestFullReport) {
+    CopysetReportTracker tracker;
+    tracker.Init(10);
+    ASSERT_TRUE(tracker.BeginReport());
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 1)));
+    CommitOK(&tracker, false);
+
+    // 1. mds在回应中要求全量上报
+    ASSERT_FALSE(tracker.BeginReport());
+    ASSERT_FALSE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 1)));
+    CommitOK(&tracker, true, true);
+    ASSERT_TRUE(tracker.BeginReport());
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 1)));
+    CommitOK(&tracker, false);
+    ASSERT_FALSE(tracker.BeginReport());
+
+    // 2. 切换mds后全量上报
+    tracker.ForceFullReport();
+    ASSERT_TRUE(tracker.BeginReport());
+    ASSERT_TRUE(tracker.AddCopyset(ToGroupNid(1, 1), BuildCopySetInfo(1, 1)));
+}
+
 }  // namespace chunkserver
 }  // namespace curve
 
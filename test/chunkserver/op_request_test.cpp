@@ -834,5 +834,133 @@ TEST(ChunkOpRequestTest, OnApplyFromLogTest) {
     }
 }
 
+TEST(ChunkOpRequestTest, BatchChunkOpTest) {
+    LogicPoolID logicPoolId = 1;
+    CopysetID copysetId = 10001;
+    uint64_t sn = 1;
+    uint64_t appliedIndex = 12;
+    uint32_t chunkSize = 16 * 1024 * 1024;
+
+    Configuration conf;
+    std::shared_ptr<CopysetNode> nodePtr =
+        std::make_shared<CopysetNode>(logicPoolId, copysetId, conf);
+    std::shared_ptr<LocalFileSystem>
+        fs(LocalFsFactory::CreateFs(FileSystemType::EXT4, ""));    //NOLINT
+    DataStoreOptions options;
+    options.baseDir = "./test-temp";
+    options.chunkSize = chunkSize;
+    options.metaPageSize = 4 * 1024;
+    options.blockSize = 4 * 1024;
+    std::shared_ptr<FakeCSDataStore> dataStore =
+        std::make_shared<FakeCSDataStore>(options, fs);
+    nodePtr->SetCSDateStore(dataStore);
+
+    auto buildBatch = [&](CHUNK_OP_TYPE subOpType, ChunkRequest *request) {
+        request->set_optype(CHUNK_OP_TYPE::CHUNK_OP_BATCH);
+        request->set_logicpoolid(logicPoolId);
+        request->set_copysetid(copysetId);
+        request->set_chunkid(1);
+        for (uint64_t chunkId = 1; chunkId <= 3; ++chunkId) {
+            ChunkRequest *subRequest = request->add_subrequests();
+            subRequest->set_optype(subOpType);
+            subRequest->set_logicpoolid(logicPoolId);
+            subRequest->set_copysetid(copysetId);
+            subRequest->set_chunkid(chunkId);
+            subRequest->set_sn(sn);
+            subRequest->set_correctedsn(sn);
+            subRequest->set_size(chunkSize);
+            subRequest->set_location("test@cs");
+        }
+    };
+
+    // encode and decode as one log entry
+    {
+        ChunkRequest request;
+        buildBatch(CHUNK_OP_TYPE::CHUNK_OP_DELETE, &request);
+        butil::IOBuf log;
+        ASSERT_EQ(0, ChunkOpRequest::Encode(&request, nullptr, &log));
+
+        ChunkRequest decoded;
+        butil::IOBuf data;
+        auto req = ChunkOpRequest::Decode(log, &decoded, &data, 0,
+                                          PeerId("127.0.0.1:9010:0"));
+        ASSERT_TRUE(dynamic_cast<BatchChunkOpRequest*>(req.get()) != nullptr);
+        ASSERT_EQ(3, decoded.subrequests_size());
+        ASSERT_EQ(3, decoded.subrequests(2).chunkid());
+        ASSERT_EQ(ApplyTaskType::WRITE,
+                  ChunkOpRequest::Schedule(decoded.optype()));
+    }
+    // only delete, delete snapshot and create clone can be batched
+    {
+        ChunkRequest subRequest;
+        subRequest.set_optype(CHUNK_OP_TYPE::CHUNK_OP_DELETE);
+        subRequest.set_logicpoolid(logicPoolId);
+        subRequest.set_copysetid(copysetId);
+        subRequest.set_chunkid(1);
+        ASSERT_TRUE(BatchChunkOpRequest::IsSupportedSubRequest(subRequest));
+        subRequest.set_optype(CHUNK_OP_TYPE::CHUNK_OP_DELETE_SNAP);
+        ASSERT_FALSE(BatchChunkOpRequest::IsSupportedSubRequest(subRequest));
+        subRequest.set_correctedsn(sn);
+        ASSERT_TRUE(BatchChunkOpRequest::IsSupportedSubRequest(subRequest));
+        subRequest.set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+        ASSERT_FALSE(BatchChunkOpRequest::IsSupportedSubRequest(subRequest));
+    }
+    // create clone chunks in one entry
+    {
+        ChunkRequest request;
+        ChunkResponse response;
+        buildBatch(CHUNK_OP_TYPE::CHUNK_OP_CREATE_CLONE, &request);
+        ChunkOpRequest *opReq = new BatchChunkOpRequest(nodePtr,
+                                                        nullptr,
+                                                        &request,
+                                                        &response,
+                                                        nullptr);
+        OpFakeClosure done;
+        opReq->OnApply(appliedIndex, &done);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  response.status());
+        ASSERT_EQ(3, response.subresponses_size());
+        for (const auto &subResponse : response.subresponses()) {
+            ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                      subResponse.status());
+        }
+        ASSERT_EQ(appliedIndex, response.appliedindex());
+        delete opReq;
+    }
+    // delete chunks, the failure of one chunk doesn't affect the others
+    {
+        ChunkRequest request;
+        ChunkResponse response;
+        buildBatch(CHUNK_OP_TYPE::CHUNK_OP_DELETE, &request);
+        ChunkOpRequest *opReq = new BatchChunkOpRequest(nodePtr,
+                                                        nullptr,
+                                                        &request,
+                                                        &response,
+                                                        nullptr);
+        dataStore->InjectError(CSErrorCode::ChunkNotExistError);
+        OpFakeClosure done;
+        opReq->OnApply(appliedIndex + 1, &done);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  response.status());
+        ASSERT_EQ(3, response.subresponses_size());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN,
+                  response.subresponses(0).status());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  response.subresponses(1).status());
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  response.subresponses(2).status());
+        delete opReq;
+    }
+    // apply from log
+    {
+        ChunkRequest request;
+        buildBatch(CHUNK_OP_TYPE::CHUNK_OP_DELETE, &request);
+        butil::IOBuf data;
+        BatchChunkOpRequest req;
+        req.OnApplyFromLog(dataStore, request, data);
+        ASSERT_FALSE(dataStore->HasInjectError());
+    }
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -20,14 +20,47 @@
  * Author: wuhanqing
  */
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "src/client/client_common.h"
 #include "src/client/splitor.h"
+#include "test/client/mock/mock_mdsclient.h"
 
 namespace curve {
 namespace client {
 
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::ElementsAre;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+
+namespace {
+
+constexpr uint32_t kChunkSize = 16 * 1024 * 1024;
+constexpr uint32_t kSegmentSize = 2 * kChunkSize;
+
+// segment at |offset| whose chunk ids start from |firstChunkId|, and all
+// chunks are in copyset |copysetId| of logical pool 1
+SegmentInfo MakeSegment(uint64_t offset, ChunkID firstChunkId,
+                        CopysetID copysetId) {
+    SegmentInfo segment;
+    segment.segmentsize = kSegmentSize;
+    segment.chunksize = kChunkSize;
+    segment.startoffset = offset;
+    segment.lpcpIDInfo.lpid = 1;
+    segment.lpcpIDInfo.cpidVec = {copysetId};
+    for (uint32_t i = 0; i < kSegmentSize / kChunkSize; ++i) {
+        segment.chunkvec.emplace_back(firstChunkId + i, 1, copysetId);
+    }
+    return segment;
+}
+
+}  // namespace
+
 TEST(SplitorTest, NeedGetOrAllocateSegmentTest_ChunkNotAllocated) {
     MetaCache metaCache;
 
@@ -62,5 +95,93 @@ TEST(SplitorTest, NeedGetOrAllocateSegmentTest_ChunkAllocatedButInvalid) {
         MetaCacheErrorType::OK, OpType::READ, chunkInfo, &metaCache));
 }
 
+TEST(SplitorTest, IsSequentialAllocateTest) {
+    MetaCache metaCache;
+    FInfo finfo;
+    finfo.chunksize = kChunkSize;
+    finfo.segmentsize = kSegmentSize;
+
+    // the first segment
+    EXPECT_FALSE(Splitor::IsSequentialAllocate(0, &metaCache, &finfo));
+
+    // last chunk of the previous segment isn't cached
+    EXPECT_FALSE(
+        Splitor::IsSequentialAllocate(kSegmentSize, &metaCache, &finfo));
+
+    // last chunk of the previous segment isn't allocated
+    ChunkIDInfo chunkInfo(0, 0, 0);
+    chunkInfo.chunkExist = false;
+    metaCache.UpdateChunkInfoByIndex(1, chunkInfo);
+    EXPECT_FALSE(
+        Splitor::IsSequentialAllocate(kSegmentSize, &metaCache, &finfo));
+
+    // any offset in a segment following an allocated one
+    metaCache.UpdateChunkInfoByIndex(1, ChunkIDInfo(2, 1, 1));
+    EXPECT_TRUE(
+        Splitor::IsSequentialAllocate(kSegmentSize, &metaCache, &finfo));
+    EXPECT_TRUE(Splitor::IsSequentialAllocate(kSegmentSize + kChunkSize + 4096,
+                                              &metaCache, &finfo));
+    EXPECT_FALSE(
+        Splitor::IsSequentialAllocate(2 * kSegmentSize, &metaCache, &finfo));
+}
+
+TEST(SplitorTest, GetOrAllocateSegmentCachePreallocatedSegments) {
+    IOSplitOption opt;
+    opt.fileIOSplitMaxSizeKB = 64;
+    opt.preallocateSegmentNum = 2;
+    Splitor::Init(opt);
+
+    MetaCache metaCache;
+    FInfo finfo;
+    finfo.filename = "/file";
+    finfo.chunksize = kChunkSize;
+    finfo.segmentsize = kSegmentSize;
+    metaCache.UpdateChunkInfoByIndex(1, ChunkIDInfo(2, 1, 1));
+
+    SegmentInfo segment = MakeSegment(kSegmentSize, 3, 2);
+    std::vector<SegmentInfo> preallocated{
+        MakeSegment(2 * kSegmentSize, 5, 3),
+        MakeSegment(3 * kSegmentSize, 7, 2)};
+    std::vector<CopysetInfo<ChunkServerID>> copysets(2);
+    copysets[0].cpid_ = 2;
+    copysets[1].cpid_ = 3;
+
+    // sequential allocation asks mds to preallocate, and server lists of
+    // copysets of all segments are fetched in one request
+    MockMDSClient mdsClient;
+    EXPECT_CALL(mdsClient,
+                GetOrAllocateSegment(true, kSegmentSize, _, _, _, 2, _))
+        .WillOnce(DoAll(SetArgPointee<4>(segment),
+                        SetArgPointee<6>(preallocated),
+                        Return(LIBCURVE_ERROR::OK)));
+    EXPECT_CALL(mdsClient, GetServerList(1, ElementsAre(2, 3), _))
+        .WillOnce(DoAll(SetArgPointee<2>(copysets),
+                        Return(LIBCURVE_ERROR::OK)));
+
+    ASSERT_TRUE(Splitor::GetOrAllocateSegment(
+        true, kSegmentSize, &mdsClient, &metaCache, &finfo, nullptr, 2));
+
+    for (ChunkIndex idx = 2; idx < 8; ++idx) {
+        ChunkIDInfo chunkInfo;
+        ASSERT_EQ(MetaCacheErrorType::OK,
+                  metaCache.GetChunkInfoByIndex(idx, &chunkInfo));
+        ASSERT_EQ(idx + 1, chunkInfo.cid_);
+    }
+    ASSERT_EQ(2u, metaCache.GetCopysetinfo(1, 2).cpid_);
+    ASSERT_EQ(3u, metaCache.GetCopysetinfo(1, 3).cpid_);
+
+    // not sequential, no preallocation
+    EXPECT_CALL(mdsClient,
+                GetOrAllocateSegment(true, 8 * kSegmentSize, _, _, _, 0, _))
+        .WillOnce(DoAll(SetArgPointee<4>(MakeSegment(8 * kSegmentSize, 17, 2)),
+                        Return(LIBCURVE_ERROR::OK)));
+    EXPECT_CALL(mdsClient, GetServerList(1, ElementsAre(2), _))
+        .WillOnce(Return(LIBCURVE_ERROR::OK));
+    ASSERT_TRUE(Splitor::GetOrAllocateSegment(
+        true, 8 * kSegmentSize, &mdsClient, &metaCache, &finfo, nullptr, 16));
+
+    Splitor::Init(IOSplitOption());
+}
+
 }  // namespace client
 }  // namespace curve
@@ -415,5 +415,32 @@ TEST(BitmapTEST, divide_test) {
     }
 }
 
+TEST(BitmapTEST, next_bit_across_word_test) {
+    Bitmap bitmap(300);
+    bitmap.Set(0, 299);
+
+    // clear bits in different bytes and 64-bit words
+    for (uint32_t index : {5, 64, 71, 200, 299}) {
+        bitmap.Clear(index);
+    }
+    ASSERT_EQ(bitmap.NextClearBit(0), 5);
+    ASSERT_EQ(bitmap.NextClearBit(6), 64);
+    ASSERT_EQ(bitmap.NextClearBit(65), 71);
+    ASSERT_EQ(bitmap.NextClearBit(72), 200);
+    ASSERT_EQ(bitmap.NextClearBit(201), 299);
+    ASSERT_EQ(bitmap.NextClearBit(72, 199), Bitmap::NO_POS);
+    ASSERT_EQ(bitmap.NextClearBit(72, 200), 200);
+
+    bitmap.Clear();
+    for (uint32_t index : {63, 128, 298}) {
+        bitmap.Set(index);
+    }
+    ASSERT_EQ(bitmap.NextSetBit(0), 63);
+    ASSERT_EQ(bitmap.NextSetBit(64), 128);
+    ASSERT_EQ(bitmap.NextSetBit(129), 298);
+    ASSERT_EQ(bitmap.NextSetBit(129, 297), Bitmap::NO_POS);
+    ASSERT_EQ(bitmap.NextSetBit(299), Bitmap::NO_POS);
+}
+
 }  // namespace common
 }  // namespace curve
@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "src/common/crc32.h"
 
 namespace curve {
@@ -92,5 +94,22 @@ TEST(Crc32TEST, Extend) {
             CRC32(CRC32("hello ", 6), "world", 5));
 }
 
+TEST(Crc32TEST, IOBuf) {
+  butil::IOBuf buf;
+  ASSERT_EQ(CRC32("", 0), CRC32(buf));
+
+  // data spans several backing blocks
+  std::string data;
+  for (int i = 0; i < 10; ++i) {
+    std::string piece(3000 + i, 'a' + i);
+    buf.append(piece);
+    data.append(piece);
+  }
+  ASSERT_GT(buf.backing_block_num(), 1u);
+  ASSERT_EQ(CRC32(data.data(), data.size()), CRC32(buf));
+  ASSERT_EQ(CRC32(CRC32("hello ", 6), data.data(), data.size()),
+            CRC32(CRC32("hello ", 6), buf));
+}
+
 }  // namespace common
 }  // namespace curve
@@ -212,6 +212,38 @@ TEST(CaCheTest, TestCacheGetLastKVWithFunction) {
     ASSERT_EQ(false, ok);
 }
 
+TEST(ShardedCaCheTest, test_put_get_remove) {
+    auto cache = std::make_shared<ShardedLRUCache<std::string, std::string>>(
+        0, 4, std::make_shared<CacheMetrics>("ShardedLruCache"));
+
+    std::string res;
+    for (int i = 0; i < 100; i++) {
+        cache->Put(std::to_string(i), std::to_string(i));
+    }
+    ASSERT_EQ(100, cache->Size());
+    ASSERT_EQ(100, cache->GetCacheMetrics()->cacheCount.get_value());
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(cache->Get(std::to_string(i), &res));
+        ASSERT_EQ(std::to_string(i), res);
+    }
+    ASSERT_EQ(100, cache->GetCacheMetrics()->cacheHit.get_value());
+
+    cache->Remove("1");
+    ASSERT_FALSE(cache->Get("1", &res));
+    ASSERT_EQ(99, cache->Size());
+    ASSERT_EQ(1, cache->GetCacheMetrics()->cacheMiss.get_value());
+
+    // each shard eliminates its oldest items, total count is limited
+    auto limited =
+        std::make_shared<ShardedLRUCache<std::string, std::string>>(100, 4);
+    for (int i = 0; i < 1000; i++) {
+        limited->Put(std::to_string(i), std::to_string(i));
+    }
+    ASSERT_LE(limited->Size(), 100);
+    ASSERT_TRUE(limited->Get("999", &res));
+    ASSERT_EQ("999", res);
+}
+
 TEST(SglCaCheTest, TestGetBefore) {
     auto cache = std::make_shared<SglLRUCache<int>>(
         std::make_shared<CacheMetrics>("LruCache"));
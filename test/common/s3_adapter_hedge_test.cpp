@@ -0,0 +1,252 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-07-10
+ */
+
+#include <brpc/server.h>
+#include <bthread/bthread.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+
+#include "proto/snapshotcloneserver.pb.h"
+#include "src/common/concurrent/count_down_event.h"
+#include "src/common/s3_adapter.h"
+
+namespace curve {
+namespace common {
+
+using ::curve::snapshotcloneserver::HttpRequest;
+using ::curve::snapshotcloneserver::HttpResponse;
+using ::curve::snapshotcloneserver::SnapshotCloneService;
+using ::google::protobuf::Closure;
+using ::google::protobuf::RpcController;
+
+namespace {
+
+const char kBucket[] = "bucket";
+const size_t kLen = 4096;
+
+// A local stand-in of s3 serving ranged gets of any object in kBucket. The
+// n-th request is delayed by |delays[n]| ms, and its body is filled with
+// 'a' + n, so the request whose data is returned can be told.
+class FakeS3Service : public SnapshotCloneService {
+ public:
+    void default_method(RpcController* cntlBase, const HttpRequest*,
+                        HttpResponse*, Closure* done) override {
+        brpc::ClosureGuard doneGuard(done);
+        brpc::Controller* cntl = static_cast<brpc::Controller*>(cntlBase);
+        int index = requests_.fetch_add(1);
+
+        uint64_t delayMs = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            auto it = delays_.find(index);
+            if (it != delays_.end()) {
+                delayMs = it->second;
+            }
+        }
+        if (delayMs > 0) {
+            bthread_usleep(delayMs * 1000);
+        }
+
+        uint64_t begin = 0;
+        uint64_t end = 0;
+        const std::string* range = cntl->http_request().GetHeader("Range");
+        if (range == nullptr ||
+            sscanf(range->c_str(), "bytes=%lu-%lu", &begin, &end) != 2) {
+            cntl->http_response().set_status_code(brpc::HTTP_STATUS_OK);
+            return;
+        }
+        cntl->response_attachment().append(std::string(end - begin,
+                                                       'a' + index));
+        cntl->http_response().set_status_code(brpc::HTTP_STATUS_OK);
+        finished_.fetch_add(1);
+    }
+
+    void SetDelay(int index, uint64_t delayMs) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        delays_[index] = delayMs;
+    }
+
+    int Requests() const { return requests_.load(); }
+
+    int Finished() const { return finished_.load(); }
+
+ private:
+    std::mutex mtx_;
+    std::map<int, uint64_t> delays_;
+    std::atomic<int> requests_{0};
+    std::atomic<int> finished_{0};
+};
+
+}  // namespace
+
+class S3AdapterHedgeTest : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        server_.reset(new brpc::Server());
+        ASSERT_EQ(0, server_->AddService(&service_,
+                                         brpc::SERVER_DOESNT_OWN_SERVICE,
+                                         "/bucket/* => default_method"));
+        ASSERT_EQ(0, server_->Start("127.0.0.1", {9700, 9799}, nullptr));
+
+        option_.ak = "ak";
+        option_.sk = "sk";
+        option_.s3Address = "127.0.0.1:" +
+            std::to_string(server_->listen_address().port);
+        option_.bucketName = kBucket;
+        option_.region = "us-east-1";
+        option_.loglevel = 0;
+        option_.logPrefix = "/tmp/s3_adapter_hedge_test_aws_";
+        option_.scheme = 0;
+        option_.verifySsl = false;
+        option_.userAgent = "S3 Browser";
+        option_.maxConnections = 32;
+        option_.connectTimeout = 1000;
+        option_.requestTimeout = 10000;
+        option_.asyncThreadNum = 4;
+        option_.maxAsyncRequestInflightBytes = 0;
+        option_.iopsTotalLimit = 0;
+        option_.iopsReadLimit = 0;
+        option_.iopsWriteLimit = 0;
+        option_.bpsTotalMB = 0;
+        option_.bpsReadMB = 0;
+        option_.bpsWriteMB = 0;
+        option_.useVirtualAddressing = false;
+        option_.getHedgePercentile = 0.99;
+        option_.getHedgeMinDelayMs = 100;
+        option_.getHedgeMinSamples = 5;
+    }
+
+    void TearDown() override {
+        if (adapter_ != nullptr) {
+            adapter_->Deinit();
+        }
+        server_->Stop(0);
+        server_->Join();
+    }
+
+    void InitAdapter() {
+        adapter_.reset(new S3Adapter());
+        adapter_->Init(option_);
+    }
+
+    // record enough latency samples to enable hedging
+    void WarmUp() {
+        char buf[kLen];
+        for (uint64_t i = 0; i < option_.getHedgeMinSamples; ++i) {
+            ASSERT_EQ(0, adapter_->GetObject("warmup", buf, 0, kLen));
+        }
+    }
+
+    // send an async get into |buf|, and wait until it's called back
+    int GetAsync(char* buf, std::atomic<int>* calls) {
+        CountDownEvent done(1);
+        auto context = std::make_shared<GetObjectAsyncContext>(
+            "object", buf, 0, kLen,
+            [&done, calls](const S3Adapter*,
+                           const std::shared_ptr<GetObjectAsyncContext>&) {
+                calls->fetch_add(1);
+                done.Signal();
+            });
+        adapter_->GetObjectAsync(context);
+        done.Wait();
+        return context->retCode;
+    }
+
+    static bool Filled(const char* buf, char c) {
+        return std::string(buf, kLen) == std::string(kLen, c);
+    }
+
+ protected:
+    FakeS3Service service_;
+    std::unique_ptr<brpc::Server> server_;
+    S3AdapterOption option_;
+    std::unique_ptr<S3Adapter> adapter_;
+};
+
+TEST_F(S3AdapterHedgeTest, NotHedgeWithoutEnoughSamples) {
+    option_.getHedgeMinSamples = 1000;
+    InitAdapter();
+
+    service_.SetDelay(0, 500);
+    char buf[kLen];
+    std::atomic<int> calls(0);
+    ASSERT_EQ(0, GetAsync(buf, &calls));
+
+    ASSERT_EQ(1, service_.Requests());
+    ASSERT_EQ(1, calls.load());
+    ASSERT_TRUE(Filled(buf, 'a'));
+}
+
+TEST_F(S3AdapterHedgeTest, FirstResponseWins) {
+    InitAdapter();
+    WarmUp();
+
+    // the first request is slow, the hedged one returns first
+    const int first = option_.getHedgeMinSamples;
+    service_.SetDelay(first, 2000);
+
+    char buf[kLen];
+    std::atomic<int> calls(0);
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(0, GetAsync(buf, &calls));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(first + 2, service_.Requests());
+    ASSERT_LT(elapsed, std::chrono::milliseconds(2000));
+    ASSERT_TRUE(Filled(buf, 'a' + first + 1));
+
+    // data of the slow request is dropped, and the caller isn't called again
+    for (int i = 0; i < 300 && service_.Finished() < first + 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(first + 2, service_.Finished());
+    ASSERT_EQ(1, calls.load());
+    ASSERT_TRUE(Filled(buf, 'a' + first + 1));
+}
+
+TEST_F(S3AdapterHedgeTest, CancelHedgeWhenFinishedInTime) {
+    option_.getHedgeMinDelayMs = 200;
+    InitAdapter();
+    WarmUp();
+
+    const int first = option_.getHedgeMinSamples;
+    char buf[kLen];
+    std::atomic<int> calls(0);
+    ASSERT_EQ(0, GetAsync(buf, &calls));
+    ASSERT_TRUE(Filled(buf, 'a' + first));
+
+    // the hedge timer is cancelled, no more request is sent after the delay
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    ASSERT_EQ(first + 1, service_.Requests());
+    ASSERT_EQ(1, calls.load());
+}
+
+}  // namespace common
+}  // namespace curve
@@ -0,0 +1,188 @@
+/*
+ *  Copyright (c) 2023 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2023-06-20
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>  //NOLINT
+#include <memory>
+#include <string>
+#include <thread>  //NOLINT
+#include <vector>
+
+#include "src/kvstorageclient/batch_kvstorage_client.h"
+#include "test/mds/mock/mock_etcdclient.h"
+
+namespace curve {
+namespace kvstorage {
+
+using ::curve::mds::MockEtcdClient;
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+
+class TestBatchKVStorageClient : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        etcd_ = std::make_shared<MockEtcdClient>();
+        BatchKVStorageClientOption option;
+        option.maxBatchOps = 64;
+        option.batchWindowUs = 0;
+        client_ = std::make_shared<BatchKVStorageClient>(
+            etcd_, option, "test_batch_kvstorage_client");
+    }
+
+    // The first put blocks in etcd until others are queued,
+    // then they are committed in next batch
+    void PutConcurrently(const std::vector<std::string> &keys,
+                         std::vector<int> *rets) {
+        std::atomic<bool> release(false);
+        EXPECT_CALL(*etcd_, PutRewithRevision("first", _, _))
+            .WillOnce(Invoke([&release](const std::string &,
+                                        const std::string &, int64_t *rev) {
+                while (!release.load()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                *rev = 1;
+                return EtcdErrCode::EtcdOK;
+            }));
+
+        std::thread first([this] { client_->Put("first", "value"); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        rets->resize(keys.size());
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            threads.emplace_back([this, &keys, rets, i] {
+                (*rets)[i] = client_->Put(keys[i], "value");
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        release.store(true);
+
+        first.join();
+        for (auto &t : threads) {
+            t.join();
+        }
+    }
+
+ protected:
+    std::shared_ptr<MockEtcdClient> etcd_;
+    std::shared_ptr<BatchKVStorageClient> client_;
+};
+
+TEST_F(TestBatchKVStorageClient, test_SingleWrite) {
+    int64_t revision = 0;
+    EXPECT_CALL(*etcd_, PutRewithRevision("key", "value", _))
+        .WillOnce(DoAll(SetArgPointee<2>(10), Return(EtcdErrCode::EtcdOK)));
+    ASSERT_EQ(EtcdErrCode::EtcdOK,
+              client_->PutRewithRevision("key", "value", &revision));
+    ASSERT_EQ(10, revision);
+
+    EXPECT_CALL(*etcd_, DeleteRewithRevision("key", _))
+        .WillOnce(Return(EtcdErrCode::EtcdDeadlineExceeded));
+    ASSERT_EQ(EtcdErrCode::EtcdDeadlineExceeded, client_->Delete("key"));
+
+    std::string k1 = "k1", k2 = "k2";
+    std::vector<Operation> ops{
+        Operation{OpType::OpPut, const_cast<char *>(k1.c_str()),
+                  const_cast<char *>(k1.c_str()), 2, 2},
+        Operation{OpType::OpDelete, const_cast<char *>(k2.c_str()), "", 2, 0}};
+    EXPECT_CALL(*etcd_, TxnNWithRevision(_, _))
+        .WillOnce(Return(EtcdErrCode::EtcdOK));
+    ASSERT_EQ(EtcdErrCode::EtcdOK, client_->TxnN(ops));
+
+    ASSERT_EQ(EtcdErrCode::EtcdInvalidArgument,
+              client_->TxnN(std::vector<Operation>{}));
+    ASSERT_EQ(2, client_->GetMetric().put.count() +
+                 client_->GetMetric().del.count());
+}
+
+TEST_F(TestBatchKVStorageClient, test_MergeConcurrentWrites) {
+    size_t mergedOps = 0;
+    EXPECT_CALL(*etcd_, TxnNWithRevision(_, _))
+        .WillOnce(Invoke([&mergedOps](const std::vector<Operation> &ops,
+                                      int64_t *rev) {
+            mergedOps = ops.size();
+            *rev = 2;
+            return EtcdErrCode::EtcdOK;
+        }));
+
+    std::vector<int> rets;
+    PutConcurrently({"k1", "k2", "k3", "k4"}, &rets);
+    ASSERT_EQ(4, mergedOps);
+    for (auto ret : rets) {
+        ASSERT_EQ(EtcdErrCode::EtcdOK, ret);
+    }
+    ASSERT_EQ(0, client_->GetMetric().batchFallback.get_value());
+}
+
+TEST_F(TestBatchKVStorageClient, test_ConflictKeyNotMerged) {
+    // writes to the same key are committed in order by separate batches
+    std::vector<std::string> committed;
+    EXPECT_CALL(*etcd_, PutRewithRevision("k1", _, _))
+        .Times(2)
+        .WillRepeatedly(Invoke([&committed](const std::string &key,
+                                            const std::string &,
+                                            int64_t *) {
+            committed.push_back(key);
+            return EtcdErrCode::EtcdOK;
+        }));
+
+    std::vector<int> rets;
+    PutConcurrently({"k1", "k1"}, &rets);
+    ASSERT_EQ(2, committed.size());
+    for (auto ret : rets) {
+        ASSERT_EQ(EtcdErrCode::EtcdOK, ret);
+    }
+}
+
+TEST_F(TestBatchKVStorageClient, test_FallbackWhenMergedTxnFailed) {
+    EXPECT_CALL(*etcd_, TxnNWithRevision(_, _))
+        .WillOnce(Return(EtcdErrCode::EtcdInvalidArgument));
+    EXPECT_CALL(*etcd_, PutRewithRevision("k1", _, _))
+        .WillOnce(Return(EtcdErrCode::EtcdOK));
+    EXPECT_CALL(*etcd_, PutRewithRevision("k2", _, _))
+        .WillOnce(Return(EtcdErrCode::EtcdPermissionDenied));
+
+    std::vector<int> rets;
+    PutConcurrently({"k1", "k2"}, &rets);
+    ASSERT_EQ(EtcdErrCode::EtcdOK, rets[0]);
+    ASSERT_EQ(EtcdErrCode::EtcdPermissionDenied, rets[1]);
+    ASSERT_EQ(1, client_->GetMetric().batchFallback.get_value());
+}
+
+TEST_F(TestBatchKVStorageClient, test_TransientErrorNotFallback) {
+    EXPECT_CALL(*etcd_, TxnNWithRevision(_, _))
+        .WillOnce(Return(EtcdErrCode::EtcdDeadlineExceeded));
+
+    std::vector<int> rets;
+    PutConcurrently({"k1", "k2"}, &rets);
+    for (auto ret : rets) {
+        ASSERT_EQ(EtcdErrCode::EtcdDeadlineExceeded, ret);
+    }
+}
+
+}  // namespace kvstorage
+}  // namespace curve
@@ -287,10 +287,24 @@ TEST_F(TestEtcdClinetImp, test_EtcdClientInterface) {
     ASSERT_EQ(newFileInfo7.filename(), fileinfo.filename());
     ASSERT_EQ(newFileInfo7.filetype(), fileinfo.filetype());
 
-    // 9. test more Txn err
-    ops.emplace_back(op8);
-    ops.emplace_back(op9);
-    ASSERT_EQ(EtcdErrCode::EtcdInvalidArgument, client_->TxnN(ops));
+    // 9. test Txn with more than 3 operations
+    std::vector<std::string> txnKeys{"05", "06", "07"};
+    ops.clear();
+    for (const auto& key : txnKeys) {
+        char* data = const_cast<char *>(key.c_str());
+        int len = static_cast<int>(key.size());
+        ops.emplace_back(Operation{OpType::OpPut, data, data, len, len});
+    }
+    ops.emplace_back(Operation{OpType::OpDelete, const_cast<char *>("04"),
+                               const_cast<char *>(""), 2, 0});
+    ASSERT_EQ(EtcdErrCode::EtcdOK, client_->TxnN(ops));
+    for (const auto& key : txnKeys) {
+        ASSERT_EQ(EtcdErrCode::EtcdOK, client_->Get(key, &out));
+        ASSERT_EQ(key, out);
+    }
+    ASSERT_EQ(EtcdErrCode::EtcdKeyNotExist, client_->Get("04", &out));
+    ASSERT_EQ(EtcdErrCode::EtcdInvalidArgument,
+              client_->TxnN(std::vector<Operation>{}));
 
     // 10. abnormal
     ops.clear();
@@ -29,6 +29,7 @@
 
 #include <chrono>  //NOLINT
 #include <thread>  //NOLINT
+#include <vector>
 
 #include "proto/cli.pb.h"
 #include "proto/chunk.pb.h"
@@ -795,6 +796,86 @@ TEST_F(TestChunkServerClient, TestDeleteChunkReturnNotLeader) {
     ASSERT_EQ(kCsClientNotLeader, ret);
 }
 
+TEST_F(TestChunkServerClient, TestBatchDeleteChunk) {
+    uint32_t port = listenAddr_.port;
+    ChunkServerIdType csId = 0x01;
+    LogicalPoolID logicalPoolId = 0x11;
+    CopysetID copysetId = 0x21;
+    std::vector<ChunkID> chunkIds = {0x31, 0x32, 0x33};
+    uint64_t sn = 100;
+
+    ChunkServer chunkserver(
+        csId, "", "", 0x101, "127.0.0.1", port, "", READWRITE);
+    ChunkServerState csState;
+    csState.SetDiskState(DISKNORMAL);
+    chunkserver.SetOnlineState(ONLINE);
+    chunkserver.SetChunkServerState(csState);
+
+    EXPECT_CALL(*topo_, GetChunkServer(csId, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkserver),
+            Return(true)));
+
+    // reply every chunk with the given status
+    auto replyWith = [](CHUNK_OP_STATUS status, CHUNK_OP_STATUS subStatus) {
+        return Invoke([status, subStatus](RpcController *controller,
+                                          const ChunkRequest *request,
+                                          ChunkResponse *response,
+                                          Closure *done) {
+            brpc::ClosureGuard doneGuard(done);
+            response->set_status(status);
+            for (int i = 0; i < request->subrequests_size(); ++i) {
+                ChunkResponse *subResponse = response->add_subresponses();
+                subResponse->set_status(
+                    CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+                if (i == 0) {
+                    subResponse->set_status(subStatus);
+                }
+            }
+        });
+    };
+
+    // all chunks in one request
+    {
+        ChunkRequest request;
+        EXPECT_CALL(*chunkService, BatchChunkOp(_, _, _, _))
+            .WillOnce(DoAll(
+                Invoke([&request](RpcController *controller,
+                                  const ChunkRequest *req,
+                                  ChunkResponse *response, Closure *done) {
+                    request = *req;
+                }),
+                replyWith(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                          CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_NOTEXIST)));
+        ASSERT_EQ(kMdsSuccess, client_->BatchDeleteChunk(
+            csId, logicalPoolId, copysetId, chunkIds, sn));
+        ASSERT_EQ(CHUNK_OP_TYPE::CHUNK_OP_BATCH, request.optype());
+        ASSERT_EQ(3, request.subrequests_size());
+        ASSERT_EQ(CHUNK_OP_TYPE::CHUNK_OP_DELETE,
+                  request.subrequests(1).optype());
+        ASSERT_EQ(0x32, request.subrequests(1).chunkid());
+        ASSERT_EQ(sn, request.subrequests(1).sn());
+    }
+    // one chunk failed
+    {
+        EXPECT_CALL(*chunkService, BatchChunkOp(_, _, _, _))
+            .WillOnce(replyWith(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN));
+        ASSERT_EQ(kCsClientReturnFail, client_->BatchDeleteChunk(
+            csId, logicalPoolId, copysetId, chunkIds, sn));
+    }
+    // not leader
+    {
+        EXPECT_CALL(*chunkService, BatchChunkOp(_, _, _, _))
+            .WillOnce(replyWith(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED,
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS));
+        ASSERT_EQ(kCsClientNotLeader,
+                  client_->BatchDeleteChunkSnapshotOrCorrectSn(
+                      csId, logicalPoolId, copysetId, chunkIds, sn));
+    }
+}
+
 }  // namespace chunkserverclient
 }  // namespace mds
 }  // namespace curve
@@ -35,6 +35,7 @@ using ::testing::Return;
 using ::testing::SetArgPointee;
 using ::testing::DoAll;
 using ::testing::_;
+using ::testing::SaveArg;
 using ::curve::mds::topology::MockTopology;
 using ::curve::mds::topology::MockTopologyStat;
 
@@ -934,6 +935,88 @@ TEST_F(TestHeartbeatManager, test_patrol_copySetInfo_return_order) {
     ASSERT_EQ(TRANSFER_LEADER, response.needupdatecopysets(0).type());
     ASSERT_EQ(3, response.needupdatecopysets(0).peers_size());
 }
+
+TEST_F(TestHeartbeatManager, test_delta_heartbeat) {
+    auto request = GetChunkServerHeartbeatRequestForTest();
+    request.clear_copysetinfos();
+    request.set_isdelta(true);
+    ::curve::mds::topology::ChunkServer chunkServer1(
+        1, "hello", "", 1, "192.168.10.1", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+
+    // 1. no stats of the chunkserver, ask for a full report
+    {
+        ChunkServerHeartbeatResponse response;
+        EXPECT_CALL(*topology_, GetChunkServer(1, _))
+            .WillOnce(DoAll(SetArgPointee<1>(chunkServer1), Return(true)));
+        EXPECT_CALL(*topologyStat_, GetChunkServerStat(1, _))
+            .WillOnce(Return(false));
+        EXPECT_CALL(*coordinator_, GetOperatorCopySets())
+            .WillOnce(Return(std::vector<CopySetKey>{}));
+        heartbeatManager_->ChunkServerHeartbeat(request, &response);
+        ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+        ASSERT_TRUE(response.needfullreport());
+        ASSERT_EQ(0, response.needupdatecopysets_size());
+    }
+
+    // 2. stats of unreported copysets are kept, and operator of the
+    //    unreported copyset led by the chunkserver is dispatched
+    {
+        ChunkServerHeartbeatResponse response;
+        ::curve::mds::topology::ChunkServerStat lastStat;
+        lastStat.copysetStats.resize(2);
+        lastStat.copysetStats[0].logicalPoolId = 1;
+        lastStat.copysetStats[0].copysetId = 1;
+        lastStat.copysetStats[1].logicalPoolId = 1;
+        lastStat.copysetStats[1].copysetId = 2;
+        ::curve::mds::topology::ChunkServerStat newStat;
+        EXPECT_CALL(*topology_, GetChunkServer(1, _))
+            .WillRepeatedly(
+                DoAll(SetArgPointee<1>(chunkServer1), Return(true)));
+        EXPECT_CALL(*topologyStat_, GetChunkServerStat(1, _))
+            .WillOnce(DoAll(SetArgPointee<1>(lastStat), Return(true)));
+        EXPECT_CALL(*topologyStat_, UpdateChunkServerStat(1, _))
+            .WillOnce(SaveArg<1>(&newStat));
+
+        ::curve::mds::topology::CopySetInfo ledByCs1(1, 1);
+        ledByCs1.SetEpoch(10);
+        ledByCs1.SetLeader(1);
+        ledByCs1.SetCopySetMembers({1, 2, 3});
+        ledByCs1.SetCandidate(4);
+        ::curve::mds::topology::CopySetInfo ledByCs2(1, 2);
+        ledByCs2.SetLeader(2);
+        EXPECT_CALL(*coordinator_, GetOperatorCopySets())
+            .WillOnce(Return(std::vector<CopySetKey>{
+                CopySetKey(1, 1), CopySetKey(1, 2)}));
+        EXPECT_CALL(*topology_, GetCopySet(CopySetKey(1, 1), _))
+            .WillRepeatedly(DoAll(SetArgPointee<1>(ledByCs1), Return(true)));
+        EXPECT_CALL(*topology_, GetCopySet(CopySetKey(1, 2), _))
+            .WillOnce(DoAll(SetArgPointee<1>(ledByCs2), Return(true)));
+
+        ::curve::mds::topology::CopySetInfo reportInfo;
+        ::curve::mds::heartbeat::CopySetConf res;
+        res.set_logicalpoolid(1);
+        res.set_copysetid(1);
+        res.set_epoch(10);
+        res.set_type(TRANSFER_LEADER);
+        EXPECT_CALL(*coordinator_, CopySetHeartbeat(_, _, _))
+            .WillOnce(DoAll(SaveArg<0>(&reportInfo), SetArgPointee<2>(res),
+                            Return(2)));
+        EXPECT_CALL(*topology_, UpdateCopySetTopo(_))
+            .WillOnce(Return(::curve::mds::topology::kTopoErrCodeSuccess));
+
+        heartbeatManager_->ChunkServerHeartbeat(request, &response);
+        ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+        ASSERT_FALSE(response.needfullreport());
+        ASSERT_EQ(2, newStat.copysetStats.size());
+        ASSERT_TRUE(newStat.copysetStats[0].carried);
+        ASSERT_TRUE(newStat.copysetStats[1].carried);
+        ASSERT_EQ(1, response.needupdatecopysets_size());
+        ASSERT_EQ(TRANSFER_LEADER, response.needupdatecopysets(0).type());
+        ASSERT_EQ(10, reportInfo.GetEpoch());
+        ASSERT_FALSE(reportInfo.HasCandidate());
+    }
+}
 }  // namespace heartbeat
 }  // namespace mds
 }  // namespace curve
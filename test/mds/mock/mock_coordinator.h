@@ -46,6 +46,13 @@ class MockCoordinator : public ::curve::mds::schedule::Coordinator {
 
     MOCK_METHOD2(ChunkserverGoingToAdd, bool(ChunkServerIdType, CopySetKey));
 
+    MOCK_METHOD0(GetOperatorCopySets, std::vector<CopySetKey>());
+
+    MOCK_METHOD2(ChunkServerOnlineStateChanged,
+        void(ChunkServerIdType, ::curve::mds::topology::OnlineState));
+
+    MOCK_METHOD1(CopySetTopoChanged, void(const CopySetKey &));
+
     MOCK_METHOD1(RapidLeaderSchedule, int(PoolIdType));
 
     MOCK_METHOD2(QueryChunkServerRecoverStatus,
@@ -30,13 +30,12 @@
 #include <utility>
 #include "src/kvstorageclient/etcd_client.h"
 #include "src/common/lru_cache.h"
+#include "src/mds/nameserver2/namespace_storage.h"
 
 namespace curve {
 namespace mds {
 
 using ::curve::kvstorage::EtcdClientImp;
-using Cache =
-    ::curve::common::LRUCacheInterface<std::string, std::string>;
 
 class MockEtcdClient : public EtcdClientImp {
  public:
@@ -49,6 +48,8 @@ class MockEtcdClient : public EtcdClientImp {
                            std::vector<std::pair<std::string, std::string>>*));
     MOCK_METHOD1(Delete, int(const std::string&));
     MOCK_METHOD1(TxnN, int(const std::vector<Operation>&));
+    MOCK_METHOD2(TxnNWithRevision,
+                 int(const std::vector<Operation>&, int64_t*));
     MOCK_METHOD3(CompareAndSwap, int(const std::string&, const std::string&,
         const std::string&));
     MOCK_METHOD5(CampaignLeader, int(const std::string&, const std::string&,
@@ -69,10 +70,10 @@ class MockLRUCache : public Cache {
  public:
     virtual ~MockLRUCache() {}
     MOCK_METHOD2(Put, void(
-        const std::string&, const std::string&));
+        const std::string&, const CachedObject&));
     MOCK_METHOD3(Put, bool(
-        const std::string&, const std::string&, std::string*));
-    MOCK_METHOD2(Get, bool(const std::string&, std::string*));
+        const std::string&, const CachedObject&, CachedObject*));
+    MOCK_METHOD2(Get, bool(const std::string&, CachedObject*));
     MOCK_METHOD0(Size, uint64_t());
     MOCK_METHOD1(Remove, void(const std::string&));
 };
@@ -380,5 +380,156 @@ TEST_F(CleanCoreTest, TestCleanDiscardSegment) {
     }
 }
 
+TEST_F(CleanCoreTest, TestDeleteChunksConcurrently) {
+    CleanCoreOption option;
+    option.deleteChunkConcurrency = 4;
+    auto cleanCore = std::make_shared<CleanCore>(
+        storage_, client_, allocStatistic_, option);
+    ASSERT_TRUE(cleanCore->Start());
+    client_->SetChunkServerClient(csClient_);
+
+    const int kDefaultChunkSize = 16 * 1024 * 1024;
+    FileInfo fileInfo;
+    fileInfo.set_filename("/test_file");
+    fileInfo.set_id(1234);
+    fileInfo.set_segmentsize(DefaultSegmentSize);
+    fileInfo.set_length(kMiniFileLength);
+
+    // 64 chunks in 8 copysets
+    PageFileSegment segment;
+    segment.set_logicalpoolid(1);
+    segment.set_segmentsize(DefaultSegmentSize);
+    segment.set_chunksize(kDefaultChunkSize);
+    segment.set_startoffset(0);
+    for (int i = 0; i < DefaultSegmentSize / kDefaultChunkSize; ++i) {
+        auto* chunk = segment.add_chunks();
+        chunk->set_copysetid(i % 8);
+        chunk->set_chunkid(i);
+    }
+
+    DiscardSegmentInfo discardSegmentInfo;
+    discardSegmentInfo.set_allocated_fileinfo(new FileInfo(fileInfo));
+    discardSegmentInfo.set_allocated_pagefilesegment(
+        new PageFileSegment(segment));
+
+    CopySetInfo copyset;
+    copyset.SetLeader(1);
+    EXPECT_CALL(*topology_, GetCopySet(_, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(copyset), Return(true)));
+
+    // all chunks deleted
+    {
+        EXPECT_CALL(*csClient_, DeleteChunk(_, _, _, _, _))
+            .Times(segment.chunks_size())
+            .WillRepeatedly(Return(kMdsSuccess));
+        EXPECT_CALL(*storage_, CleanDiscardSegment(_, _, _))
+            .WillOnce(Return(StoreStatus::OK));
+        EXPECT_CALL(*allocStatistic_, DeAllocSpace(_, _, _))
+            .Times(1);
+
+        TaskProgress progress;
+        ASSERT_EQ(StatusCode::kOK, cleanCore->CleanDiscardSegment(
+                                       "fakekey", discardSegmentInfo,
+                                       &progress));
+        ASSERT_EQ(TaskStatus::SUCCESS, progress.GetStatus());
+    }
+
+    // chunks of a copyset failed to delete, the segment is kept
+    {
+        EXPECT_CALL(*csClient_, DeleteChunk(_, _, 3, _, _))
+            .WillOnce(Return(kMdsFail));
+        EXPECT_CALL(*csClient_, DeleteChunk(_, _, ::testing::Ne(3), _, _))
+            .Times(::testing::AtMost(segment.chunks_size()))
+            .WillRepeatedly(Return(kMdsSuccess));
+        EXPECT_CALL(*storage_, CleanDiscardSegment(_, _, _))
+            .Times(0);
+
+        TaskProgress progress;
+        ASSERT_EQ(StatusCode::KInternalError, cleanCore->CleanDiscardSegment(
+                                       "fakekey", discardSegmentInfo,
+                                       &progress));
+        ASSERT_EQ(TaskStatus::FAILED, progress.GetStatus());
+    }
+
+    cleanCore->Stop();
+}
+
+TEST_F(CleanCoreTest, TestDeleteChunksInBatch) {
+    CleanCoreOption option;
+    option.deleteChunkBatchSize = 5;
+    auto cleanCore = std::make_shared<CleanCore>(
+        storage_, client_, allocStatistic_, option);
+    client_->SetChunkServerClient(csClient_);
+
+    const int kDefaultChunkSize = 16 * 1024 * 1024;
+    FileInfo fileInfo;
+    fileInfo.set_filename("/test_file");
+    fileInfo.set_id(1234);
+    fileInfo.set_segmentsize(DefaultSegmentSize);
+    fileInfo.set_length(kMiniFileLength);
+
+    // 64 chunks in 8 copysets, every copyset is deleted in 2 batches
+    PageFileSegment segment;
+    segment.set_logicalpoolid(1);
+    segment.set_segmentsize(DefaultSegmentSize);
+    segment.set_chunksize(kDefaultChunkSize);
+    segment.set_startoffset(0);
+    for (int i = 0; i < DefaultSegmentSize / kDefaultChunkSize; ++i) {
+        auto* chunk = segment.add_chunks();
+        chunk->set_copysetid(i % 8);
+        chunk->set_chunkid(i);
+    }
+
+    DiscardSegmentInfo discardSegmentInfo;
+    discardSegmentInfo.set_allocated_fileinfo(new FileInfo(fileInfo));
+    discardSegmentInfo.set_allocated_pagefilesegment(
+        new PageFileSegment(segment));
+
+    CopySetInfo copyset;
+    copyset.SetLeader(1);
+    EXPECT_CALL(*topology_, GetCopySet(_, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(copyset), Return(true)));
+
+    // all chunks deleted
+    {
+        size_t deleted = 0;
+        EXPECT_CALL(*csClient_, BatchDeleteChunk(_, _, _, _, _))
+            .Times(16)
+            .WillRepeatedly(::testing::Invoke(
+                [&deleted](ChunkServerIdType, LogicalPoolID, CopysetID,
+                           const std::vector<ChunkID>& chunkIds, uint64_t) {
+                    deleted += chunkIds.size();
+                    return kMdsSuccess;
+                }));
+        EXPECT_CALL(*csClient_, DeleteChunk(_, _, _, _, _))
+            .Times(0);
+        EXPECT_CALL(*storage_, CleanDiscardSegment(_, _, _))
+            .WillOnce(Return(StoreStatus::OK));
+        EXPECT_CALL(*allocStatistic_, DeAllocSpace(_, _, _))
+            .Times(1);
+
+        TaskProgress progress;
+        ASSERT_EQ(StatusCode::kOK, cleanCore->CleanDiscardSegment(
+                                       "fakekey", discardSegmentInfo,
+                                       &progress));
+        ASSERT_EQ(TaskStatus::SUCCESS, progress.GetStatus());
+        ASSERT_EQ(segment.chunks_size(), deleted);
+    }
+
+    // a batch failed, the segment is kept
+    {
+        EXPECT_CALL(*csClient_, BatchDeleteChunk(_, _, _, _, _))
+            .WillOnce(Return(kMdsFail));
+        EXPECT_CALL(*storage_, CleanDiscardSegment(_, _, _))
+            .Times(0);
+
+        TaskProgress progress;
+        ASSERT_EQ(StatusCode::KInternalError, cleanCore->CleanDiscardSegment(
+                                       "fakekey", discardSegmentInfo,
+                                       &progress));
+        ASSERT_EQ(TaskStatus::FAILED, progress.GetStatus());
+    }
+}
+
 }  // namespace mds
 }  // namespace curve
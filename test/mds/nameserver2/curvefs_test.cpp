@@ -47,6 +47,7 @@ using ::testing::DoAll;
 using ::testing::SetArgPointee;
 using ::testing::SaveArg;
 using ::testing::Invoke;
+using ::testing::SizeIs;
 using curve::common::Authenticator;
 
 using curve::common::TimeUtility;
@@ -2509,6 +2510,49 @@ TEST_F(CurveFSTest, testGetOrAllocateSegment) {
         ASSERT_EQ(curvefs_->GetOrAllocateSegment("/user1/file2",
                   0, true,  &segment), StatusCode::kStorageError);
     }
+
+    // allocate with the following segments, stop at an allocated one
+    {
+        PageFileSegment segment;
+        std::vector<PageFileSegment> preallocated;
+
+        FileInfo fileInfo1;
+        fileInfo1.set_filetype(FileType::INODE_DIRECTORY);
+
+        FileInfo fileInfo2;
+        fileInfo2.set_filetype(FileType::INODE_PAGEFILE);
+        fileInfo2.set_length(kMiniFileLength);
+        fileInfo2.set_segmentsize(DefaultSegmentSize);
+        fileInfo2.set_poolset("default");
+
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                        Return(StoreStatus::OK)))
+        .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                        Return(StoreStatus::OK)));
+
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
+        .Times(3)
+        .WillOnce(Return(StoreStatus::KeyNotExist))
+        .WillOnce(Return(StoreStatus::KeyNotExist))
+        .WillOnce(Return(StoreStatus::OK));
+
+        EXPECT_CALL(*mockChunkAllocator_,
+            AllocateChunkSegment(_, _, _, _, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(true));
+
+        EXPECT_CALL(*storage_, PutSegment(_, _, _, _))
+        .Times(0);
+        EXPECT_CALL(*storage_, PutSegments(_, SizeIs(2), _))
+        .Times(1)
+        .WillOnce(Return(StoreStatus::OK));
+
+        ASSERT_EQ(curvefs_->GetOrAllocateSegment("/user1/file2",
+                  0, true,  &segment, 4, &preallocated), StatusCode::kOK);
+        ASSERT_EQ(1, preallocated.size());
+    }
 }
 
 TEST_F(CurveFSTest, TestDeAllocateSegment) {
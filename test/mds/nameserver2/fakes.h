@@ -393,6 +393,15 @@ class FakeNameServerStorage : public NameServerStorage {
         return StoreStatus::OK;
     }
 
+    StoreStatus PutSegments(InodeID id,
+                            const std::vector<PageFileSegment> &segments,
+                            int64_t *revision) override {
+        for (const auto &segment : segments) {
+            PutSegment(id, segment.startoffset(), &segment, revision);
+        }
+        return StoreStatus::OK;
+    }
+
     StoreStatus DeleteSegment(
         InodeID id, uint64_t off, int64_t *revision) override {
         std::lock_guard<std::mutex> guard(lock_);
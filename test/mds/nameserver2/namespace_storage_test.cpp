@@ -190,8 +190,9 @@ TEST_F(TestNameServerStorageImp, test_GetFile) {
     ASSERT_EQ(fileinfo.parentid(), getInfo.parentid());
 
     // 3. get file from cache ok
+    CachedObject cachedFileInfo = std::make_shared<FileInfo>(fileinfo);
     EXPECT_CALL(*cache_, Get(_, _))
-        .WillOnce(DoAll(SetArgPointee<1>(encodeFileinfo), Return(true)));
+        .WillOnce(DoAll(SetArgPointee<1>(cachedFileInfo), Return(true)));
     ASSERT_EQ(StoreStatus::OK, storage_->GetFile(fileinfo.parentid(),
                                                  fileinfo.filename(),
                                                  &getInfo));
@@ -382,6 +383,8 @@ TEST_F(TestNameServerStorageImp, test_getSegment) {
     GetPageFileSegmentForTest(&key, &segment);
     ASSERT_TRUE(NameSpaceStorageCodec::EncodeSegment(segment, &encodeSegment));
     EXPECT_CALL(*cache_, Get(_, _)).WillOnce(Return(false));
+    EXPECT_CALL(*cache_, Put(_, _))
+        .Times(1);
     EXPECT_CALL(*client_, Get(_, _))
         .WillOnce(DoAll(SetArgPointee<1>(encodeSegment),
                         Return(EtcdErrCode::EtcdOK)));
@@ -390,11 +393,30 @@ TEST_F(TestNameServerStorageImp, test_getSegment) {
     ASSERT_EQ(segment.chunks_size(), getSegment.chunks_size());
 
     // 3. get file from cache ok
+    CachedObject cachedSegment = std::make_shared<PageFileSegment>(segment);
     EXPECT_CALL(*cache_, Get(_, _))
-        .WillOnce(DoAll(SetArgPointee<1>(encodeSegment), Return(true)));
+        .WillOnce(DoAll(SetArgPointee<1>(cachedSegment), Return(true)));
     ASSERT_EQ(StoreStatus::OK, storage_->GetSegment(0, 0, &getSegment));
     ASSERT_EQ(segment.chunksize(), getSegment.chunksize());
     ASSERT_EQ(segment.chunks_size(), getSegment.chunks_size());
+
+    // 4. get without filling cache on a miss
+    EXPECT_CALL(*cache_, Get(_, _)).WillOnce(Return(false));
+    EXPECT_CALL(*cache_, Put(_, _)).Times(0);
+    EXPECT_CALL(*client_, Get(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(encodeSegment),
+                        Return(EtcdErrCode::EtcdOK)));
+    ASSERT_EQ(StoreStatus::OK,
+              storage_->GetSegmentWithoutFillCache(0, 0, &getSegment));
+    ASSERT_EQ(segment.chunksize(), getSegment.chunksize());
+    ASSERT_EQ(segment.chunks_size(), getSegment.chunks_size());
+
+    // 5. get without filling cache still reads from cache
+    EXPECT_CALL(*cache_, Get(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(cachedSegment), Return(true)));
+    ASSERT_EQ(StoreStatus::OK,
+              storage_->GetSegmentWithoutFillCache(0, 0, &getSegment));
+    ASSERT_EQ(segment.chunks_size(), getSegment.chunks_size());
 }
 
 TEST_F(TestNameServerStorageImp, test_deleteSegment) {
@@ -603,6 +603,95 @@ TEST(CoordinatorTest, test_QueryChunkServerRecoverStatus) {
     }
 }
 
+TEST(CoordinatorTest, test_EventDrivenSchedule) {
+    auto topo = std::make_shared<MockTopology>();
+    auto metric = std::make_shared<ScheduleMetrics>(topo);
+    auto topoAdapter = std::make_shared<MockTopoAdapter>();
+    auto coordinator = std::make_shared<Coordinator>(topoAdapter);
+    ScheduleOption scheduleOption = GetScheduleOption();
+    scheduleOption.enableRecoverScheduler = true;
+    scheduleOption.enableScanScheduler = false;
+    scheduleOption.recoverSchedulerIntervalSec = 1;
+    scheduleOption.chunkserverFailureTolerance = 3;
+    scheduleOption.enableEventDrivenSchedule = true;
+    scheduleOption.fullScheduleIntervalSec = 3600;
+    coordinator->InitScheduler(scheduleOption, metric);
+    gflags::SetCommandLineOption("enableRecoverScheduler", "true");
+
+    // the whole cluster is scanned only in the first round
+    EXPECT_CALL(*topoAdapter, GetCopySetInfos())
+        .WillOnce(Return(std::vector<CopySetInfo>{}));
+    EXPECT_CALL(*topoAdapter, GetChunkServerInfos())
+        .Times(2)
+        .WillRepeatedly(Return(std::vector<ChunkServerInfo>{}));
+    // chunkserver 1 has no copyset to recover, the event is not retried
+    EXPECT_CALL(*topoAdapter, GetCopySetInfosInChunkServer(1))
+        .Times(2)
+        .WillRepeatedly(Return(std::vector<CopySetInfo>{}));
+    PeerInfo peer(1, 1, 1, "127.0.0.1", 9000);
+    ChunkServerInfo csInfo(peer, OnlineState::OFFLINE, DiskState::DISKNORMAL,
+                           ChunkServerStatus::READWRITE,
+                           1, 10, 1, ChunkServerStatisticInfo{});
+    EXPECT_CALL(*topoAdapter, GetChunkServerInfo(1, _))
+        .WillOnce(DoAll(SetArgPointee<1>(csInfo), Return(true)));
+
+    coordinator->Run();
+    ::sleep(2);
+    // online and unstable chunkservers are not handled by recover scheduler
+    coordinator->ChunkServerOnlineStateChanged(2, OnlineState::ONLINE);
+    coordinator->ChunkServerOnlineStateChanged(3, OnlineState::UNSTABLE);
+    coordinator->ChunkServerOnlineStateChanged(1, OnlineState::OFFLINE);
+    ::usleep(500 * 1000);
+    coordinator->Stop();
+}
+
+TEST(CoordinatorTest, test_EventDrivenSchedule_RetryOfflineChunkServer) {
+    auto topo = std::make_shared<MockTopology>();
+    auto metric = std::make_shared<ScheduleMetrics>(topo);
+    auto topoAdapter = std::make_shared<MockTopoAdapter>();
+    auto coordinator = std::make_shared<Coordinator>(topoAdapter);
+    ScheduleOption scheduleOption = GetScheduleOption();
+    scheduleOption.enableRecoverScheduler = true;
+    scheduleOption.enableScanScheduler = false;
+    scheduleOption.recoverSchedulerIntervalSec = 1;
+    scheduleOption.chunkserverFailureTolerance = 3;
+    scheduleOption.enableEventDrivenSchedule = true;
+    scheduleOption.fullScheduleIntervalSec = 3600;
+    coordinator->InitScheduler(scheduleOption, metric);
+    gflags::SetCommandLineOption("enableRecoverScheduler", "true");
+
+    EXPECT_CALL(*topoAdapter, GetCopySetInfos())
+        .WillOnce(Return(std::vector<CopySetInfo>{}));
+    // the full round and two rounds of the offline event
+    EXPECT_CALL(*topoAdapter, GetChunkServerInfos())
+        .Times(3)
+        .WillRepeatedly(Return(std::vector<ChunkServerInfo>{}));
+
+    // the copyset on chunkserver 1 is not recovered in the first round, so
+    // the event is handled again after the running interval, and it's not
+    // retried any more after the chunkserver is online
+    CopySetInfo copyset;
+    copyset.id = CopySetKey{1, 1};
+    EXPECT_CALL(*topoAdapter, GetCopySetInfosInChunkServer(1))
+        .Times(3)
+        .WillRepeatedly(Return(std::vector<CopySetInfo>{copyset}));
+    PeerInfo peer(1, 1, 1, "127.0.0.1", 9000);
+    ChunkServerInfo offline(peer, OnlineState::OFFLINE, DiskState::DISKNORMAL,
+                            ChunkServerStatus::READWRITE,
+                            1, 10, 1, ChunkServerStatisticInfo{});
+    ChunkServerInfo online = offline;
+    online.state = OnlineState::ONLINE;
+    EXPECT_CALL(*topoAdapter, GetChunkServerInfo(1, _))
+        .WillOnce(DoAll(SetArgPointee<1>(offline), Return(true)))
+        .WillOnce(DoAll(SetArgPointee<1>(online), Return(true)));
+
+    coordinator->Run();
+    ::sleep(2);
+    coordinator->ChunkServerOnlineStateChanged(1, OnlineState::OFFLINE);
+    ::sleep(3);
+    coordinator->Stop();
+}
+
 }  // namespace schedule
 }  // namespace mds
 }  // namespace curve
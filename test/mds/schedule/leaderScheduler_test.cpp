@@ -600,6 +600,94 @@ TEST_F(TestLeaderSchedule, test_transferLeaderIn_pendding) {
     ASSERT_EQ(1, res->GetTargetPeer());
 }
 
+TEST_F(TestLeaderSchedule, test_load_aware_leader_schedule) {
+    ScheduleOption opt;
+    opt.transferLeaderTimeLimitSec = 10;
+    opt.leaderSchedulerIntervalSec = 1;
+    opt.chunkserverCoolingTimeSec = 0;
+    opt.enableLoadAwareLeaderSchedule = true;
+    opt.leaderLoadEwmaAlpha = 1;
+    opt.leaderLoadRangePercent = 0.2;
+    opt.leaderLoadCoolingTimeSec = 600;
+    auto leaderScheduler = std::make_shared<LeaderScheduler>(
+        opt, topoAdapter_, opController_);
+
+    PeerInfo peer1(1, 1, 1, "192.168.10.1", 9000);
+    PeerInfo peer2(2, 2, 2, "192.168.10.2", 9000);
+    PeerInfo peer3(3, 3, 3, "192.168.10.3", 9000);
+    auto onlineState = ::curve::mds::topology::OnlineState::ONLINE;
+    auto statInfo = ::curve::mds::heartbeat::ChunkServerStatisticInfo();
+    auto diskState = ::curve::mds::topology::DiskState::DISKNORMAL;
+    // the leader number is balanced
+    ChunkServerInfo csInfo1(
+        peer1, onlineState, diskState, ChunkServerStatus::READWRITE,
+        2, 100, 10, statInfo);
+    ChunkServerInfo csInfo2(
+        peer2, onlineState, diskState, ChunkServerStatus::READWRITE,
+        1, 100, 10, statInfo);
+    ChunkServerInfo csInfo3(
+        peer3, onlineState, diskState, ChunkServerStatus::READWRITE,
+        1, 100, 10, statInfo);
+    uint64_t startUpTime = ::curve::common::TimeUtility::GetTimeofDaySec() - 4;
+    csInfo1.startUpTime = startUpTime;
+    csInfo2.startUpTime = startUpTime;
+    csInfo3.startUpTime = startUpTime;
+    std::vector<ChunkServerInfo> csInfos({csInfo1, csInfo2, csInfo3});
+
+    std::vector<CopySetInfo> copySetInfos;
+    std::vector<ChunkServerIdType> leaders({1, 1, 2, 3});
+    for (CopySetIdType id = 1; id <= leaders.size(); id++) {
+        copySetInfos.emplace_back(CopySetKey(1, id), 1, leaders[id - 1],
+            std::vector<PeerInfo>({peer1, peer2, peer3}),
+            ConfigChangeInfo{}, CopysetStatistics{});
+    }
+
+    // but the leader load of chunkserver1 is much higher
+    std::map<CopySetKey, CopysetStatistics> stats;
+    std::vector<uint32_t> iops({100, 50, 5, 5});
+    for (CopySetIdType id = 1; id <= iops.size(); id++) {
+        CopysetStatistics stat;
+        stat.set_readrate(0);
+        stat.set_writerate(0);
+        stat.set_readiops(iops[id - 1]);
+        stat.set_writeiops(iops[id - 1]);
+        stats[CopySetKey(1, id)] = stat;
+    }
+
+    EXPECT_CALL(*topoAdapter_, GetLogicalpools())
+        .WillRepeatedly(Return(std::vector<PoolIdType>({1})));
+    EXPECT_CALL(*topoAdapter_, GetChunkServersInLogicalPool(1))
+        .WillRepeatedly(Return(csInfos));
+    std::vector<CopySetInfo> transferred(copySetInfos);
+    transferred[1].leader = 2;
+    EXPECT_CALL(*topoAdapter_, GetCopySetInfosInLogicalPool(1))
+        .WillOnce(Return(copySetInfos))
+        .WillOnce(Return(transferred));
+    EXPECT_CALL(*topoAdapter_, GetChunkServerInfo(1, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(csInfo1), Return(true)));
+    EXPECT_CALL(*topoAdapter_, GetChunkServerInfo(2, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(csInfo2), Return(true)));
+    EXPECT_CALL(*topoAdapter_, GetChunkServerInfo(3, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(csInfo3), Return(true)));
+    EXPECT_CALL(*topoAdapter_, GetCopySetStatisticsInLogicalPool(1, _))
+        .Times(2)
+        .WillRepeatedly(SetArgPointee<1>(stats));
+
+    // 1. transfer the copyset which makes the load of chunkserver1
+    //    and chunkserver2 closest
+    ASSERT_EQ(1, leaderScheduler->Schedule());
+    Operator op;
+    ASSERT_TRUE(opController_->GetOperatorById(CopySetKey(1, 2), &op));
+    TransferLeader *res = dynamic_cast<TransferLeader *>(op.step.get());
+    ASSERT_TRUE(res != nullptr);
+    ASSERT_EQ(2, res->GetTargetPeer());
+
+    // 2. the load of chunkserver1 is still the highest, but transferring
+    //    its last leader only moves the hotspot to another chunkserver
+    ASSERT_EQ(0, leaderScheduler->Schedule());
+    ASSERT_EQ(1, opController_->GetOperators().size());
+}
+
 }  // namespace schedule
 }  // namespace mds
 }  // namespace curve
@@ -78,6 +78,9 @@ class MockTopoAdapter : public TopoAdapter {
 
     MOCK_METHOD1(GetChunkServersInLogicalPool,
         std::vector<ChunkServerInfo>(PoolIdType));
+
+    MOCK_METHOD2(GetCopySetStatisticsInLogicalPool, void(PoolIdType,
+                std::map<CopySetKey, CopysetStatistics> *));
 };
 }  // namespace schedule
 }  // namespace mds
@@ -332,6 +332,46 @@ TEST_F(TestRecoverSheduler, test_all_chunkServer_online_offline) {
         ASSERT_EQ(0, opController_->GetOperators().size());
     }
 }
+TEST_F(TestRecoverSheduler, test_ScheduleEvents) {
+    auto testCopySetInfo = GetCopySetInfoForTest();
+    ChunkServerInfo csInfo1(testCopySetInfo.peers[0], OnlineState::OFFLINE,
+                            DiskState::DISKNORMAL, ChunkServerStatus::READWRITE,
+                            2, 100, 100, ChunkServerStatisticInfo{});
+    ChunkServerInfo csInfo2(testCopySetInfo.peers[1], OnlineState::ONLINE,
+                            DiskState::DISKNORMAL, ChunkServerStatus::READWRITE,
+                            2, 100, 100, ChunkServerStatisticInfo{});
+    ChunkServerInfo csInfo3(testCopySetInfo.peers[2], OnlineState::ONLINE,
+                            DiskState::DISKNORMAL, ChunkServerStatus::READWRITE,
+                            2, 100, 100, ChunkServerStatisticInfo{});
+
+    // only the copysets on the offline chunkserver and the changed one are
+    // checked, and each of them is checked once
+    EXPECT_CALL(*topoAdapter_, GetCopySetInfos()).Times(0);
+    EXPECT_CALL(*topoAdapter_, GetCopySetInfosInChunkServer(1))
+        .WillOnce(Return(std::vector<CopySetInfo>({testCopySetInfo})));
+    EXPECT_CALL(*topoAdapter_, GetCopySetInfo(testCopySetInfo.id, _))
+        .WillOnce(DoAll(SetArgPointee<1>(testCopySetInfo), Return(true)));
+    EXPECT_CALL(*topoAdapter_, GetChunkServerInfos())
+        .WillOnce(Return(std::vector<ChunkServerInfo>{}));
+    EXPECT_CALL(*topoAdapter_, GetChunkServerInfo(1, _))
+        .WillOnce(DoAll(SetArgPointee<1>(csInfo1), Return(true)));
+    EXPECT_CALL(*topoAdapter_, GetChunkServerInfo(2, _))
+        .WillOnce(DoAll(SetArgPointee<1>(csInfo2), Return(true)));
+    EXPECT_CALL(*topoAdapter_, GetChunkServerInfo(3, _))
+        .WillOnce(DoAll(SetArgPointee<1>(csInfo3), Return(true)));
+    EXPECT_CALL(*topoAdapter_, GetStandardReplicaNumInLogicalPool(_))
+        .WillOnce(Return(2));
+
+    std::vector<ScheduleEvent> events{
+        ScheduleEvent::CopySetEvent(testCopySetInfo.id),
+        ScheduleEvent::ChunkServerEvent(
+            ScheduleEventType::ChunkServerOffline, 1)};
+    recoverScheduler_->ScheduleEvents(events);
+    Operator op;
+    ASSERT_TRUE(opController_->GetOperatorById(testCopySetInfo.id, &op));
+    ASSERT_TRUE(dynamic_cast<RemovePeer *>(op.step.get()) != nullptr);
+}
+
 }  // namespace schedule
 }  // namespace mds
 }  // namespace curve
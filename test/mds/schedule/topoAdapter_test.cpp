@@ -464,6 +464,35 @@ TEST_F(TestTopoAdapterImpl, test_other_functions) {
     }
 }
 
+TEST_F(TestTopoAdapterImpl, test_copyset_statistics_with_delta_heartbeat) {
+    // chunkserver1 leads copyset(1,1) and copyset(1,2), its last heartbeat
+    // is a delta one which only reported copyset(1,1)
+    ::curve::mds::topology::ChunkServerStat stat;
+    stat.copysetStats.resize(3);
+    stat.copysetStats[0].logicalPoolId = 1;
+    stat.copysetStats[0].copysetId = 1;
+    stat.copysetStats[0].leader = 1;
+    stat.copysetStats[0].writeIOPS = 100;
+    stat.copysetStats[1].logicalPoolId = 1;
+    stat.copysetStats[1].copysetId = 2;
+    stat.copysetStats[1].leader = 1;
+    stat.copysetStats[1].writeIOPS = 200;
+    stat.copysetStats[1].carried = true;
+    // copyset(1,3) is led by another chunkserver
+    stat.copysetStats[2].logicalPoolId = 1;
+    stat.copysetStats[2].copysetId = 3;
+    stat.copysetStats[2].leader = 2;
+    EXPECT_CALL(*mockTopo_, GetChunkServerInLogicalPool(1, _))
+        .WillOnce(Return(std::list<ChunkServerIdType>({1})));
+    EXPECT_CALL(*mockTopoStat_, GetChunkServerStat(1, _))
+        .WillOnce(DoAll(SetArgPointee<1>(stat), Return(true)));
+
+    std::map<CopySetKey, CopysetStatistics> stats;
+    topoAdapter_->GetCopySetStatisticsInLogicalPool(1, &stats);
+    ASSERT_EQ(1, stats.size());
+    ASSERT_EQ(100, stats[CopySetKey(1, 1)].writeiops());
+}
+
 TEST(TestCopySetInfo, test_copySetInfo_function) {
     auto testcopySetInfo = GetCopySetInfoForTest();
 